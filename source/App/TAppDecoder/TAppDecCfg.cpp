@@ -94,6 +94,9 @@ Bool TAppDecCfg::parseCfg( Int argc, TChar* argv[] )
 #if MCTS_ENC_CHECK
   ("TMCTSCheck",                  m_tmctsCheck,                          false,    "If enabled, the decoder checks for violations of mc_exact_sample_value_match_flag in Temporal MCTS ")
 #endif
+  ("NumWorkerThreads",          m_numWorkerThreads,                    0,          "Number of threads used to decode tiles or WPP CTU rows in parallel, or to reconstruct CTUs behind the parser (0 or 1: single-threaded)")
+  ("LoopFilterCtuRows",         m_loopFilterCtuRows,                   false,      "If true, deblock and SAO-filter each CTU row as soon as the row below has been reconstructed, instead of the whole picture once it has been decoded")
+  ("OutputQueueFrames",         m_outputQueueFrames,                   0,          "Number of decoded frames that can be queued for writing on a separate thread (0: write on the decoding thread)")
   ;
 
   po::setDefaults(opts);
@@ -133,6 +136,18 @@ Bool TAppDecCfg::parseCfg( Int argc, TChar* argv[] )
     return false;
   }
 
+  if (m_numWorkerThreads < 0)
+  {
+    fprintf(stderr, "NumWorkerThreads must not be negative\n");
+    return false;
+  }
+
+  if (m_outputQueueFrames < 0)
+  {
+    fprintf(stderr, "OutputQueueFrames must not be negative\n");
+    return false;
+  }
+
   if ( !cfg_TargetDecLayerIdSetFile.empty() )
   {
     FILE* targetDecLayerIdSetFile = fopen ( cfg_TargetDecLayerIdSetFile.c_str(), "r" );
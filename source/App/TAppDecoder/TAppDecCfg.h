@@ -76,6 +76,9 @@ protected:
 #if MCTS_ENC_CHECK
   Bool          m_tmctsCheck;
 #endif
+  Int           m_numWorkerThreads;                   ///< number of threads used to decode substreams in parallel (0 or 1: single-threaded)
+  Bool          m_loopFilterCtuRows;                  ///< filter each CTU row while the picture is decoded
+  Int           m_outputQueueFrames;                  ///< number of frames queued for writing on a separate thread (0: synchronous)
 
 public:
   TAppDecCfg()
@@ -98,6 +101,9 @@ public:
 #if MCTS_ENC_CHECK
   , m_tmctsCheck(false)
 #endif
+  , m_numWorkerThreads(0)
+  , m_loopFilterCtuRows(false)
+  , m_outputQueueFrames(2)
   {
     for (UInt channelTypeIndex = 0; channelTypeIndex < MAX_NUM_CHANNEL_TYPE; channelTypeIndex++)
     {
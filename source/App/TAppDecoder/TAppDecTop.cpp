@@ -88,15 +88,13 @@ Void TAppDecTop::decode()
   Int                 poc;
   TComList<TComPic*>* pcListPic = NULL;
 
-  ifstream bitstreamFile(m_bitstreamFileName.c_str(), ifstream::in | ifstream::binary);
-  if (!bitstreamFile)
+  MappedInputByteStream bytestream;
+  if (!bytestream.open(m_bitstreamFileName))
   {
     fprintf(stderr, "\nfailed to open bitstream file `%s' for reading\n", m_bitstreamFileName.c_str());
     exit(EXIT_FAILURE);
   }
 
-  InputByteStream bytestream(bitstreamFile);
-
   if (!m_outputDecodedSEIMessagesFilename.empty() && m_outputDecodedSEIMessagesFilename!="-")
   {
     m_seiMessageFileStream.open(m_outputDecodedSEIMessagesFilename.c_str(), std::ios::out);
@@ -110,6 +108,7 @@ Void TAppDecTop::decode()
   // create & initialize internal classes
   xCreateDecLib();
   xInitDecLib  ();
+  m_cOutputWriter.create( m_reconFileName.empty() ? 0 : m_outputQueueFrames );
   m_iPOCLastDisplay += m_iSkipFrame;      // set the last displayed POC correctly for skip forward.
 
   // clear contents of colour-remap-information-SEI output file
@@ -127,7 +126,7 @@ Void TAppDecTop::decode()
   Bool openedReconFile = false; // reconstruction file not yet opened. (must be performed after SPS is seen)
   Bool loopFiltered = false;
 
-  while (!!bitstreamFile)
+  while (!bytestream.eof())
   {
     /* location serves to work around a design fault in the decoder, whereby
      * the process of reading a new slice that is the first slice of a new frame
@@ -135,18 +134,18 @@ Void TAppDecTop::decode()
      * nal unit. */
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     TComCodingStatistics::TComCodingStatisticsData backupStats(TComCodingStatistics::GetStatistics());
-    streampos location = bitstreamFile.tellg() - streampos(bytestream.GetNumBufferedBytes());
-#else
-    streampos location = bitstreamFile.tellg();
 #endif
+    const std::size_t location = bytestream.getPosition();
     AnnexBStats stats = AnnexBStats();
 
     InputNALUnit nalu;
-    byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
+    const uint8_t* nalUnitData = NULL;
+    std::size_t nalUnitSize = 0;
+    byteStreamNALUnit(bytestream, nalUnitData, nalUnitSize, stats);
 
     // call actual decoding function
     Bool bNewPicture = false;
-    if (nalu.getBitstream().getFifo().empty())
+    if (nalUnitSize == 0)
     {
       /* this can happen if the following occur:
        *  - empty input file
@@ -157,7 +156,7 @@ Void TAppDecTop::decode()
     }
     else
     {
-      read(nalu);
+      read(nalu, nalUnitData, nalUnitSize);
       if( (m_iMaxTemporalLayer >= 0 && nalu.m_temporalId > m_iMaxTemporalLayer) || !isNaluWithinTargetDecLayerIdSet(&nalu)  )
       {
         bNewPicture = false;
@@ -167,27 +166,20 @@ Void TAppDecTop::decode()
         bNewPicture = m_cTDecTop.decode(nalu, m_iSkipFrame, m_iPOCLastDisplay);
         if (bNewPicture)
         {
-          bitstreamFile.clear();
-          /* location points to the current nalunit payload[1] due to the
-           * need for the annexB parser to read three extra bytes.
-           * [1] except for the first NAL unit in the file
-           *     (but bNewPicture doesn't happen then) */
+          /* location points to the start code of the current nal unit,
+           * which is fed to the decoder again on the next iteration */
+          bytestream.setPosition(location);
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-          bitstreamFile.seekg(location);
-          bytestream.reset();
           TComCodingStatistics::SetStatistics(backupStats);
-#else
-          bitstreamFile.seekg(location-streamoff(3));
-          bytestream.reset();
 #endif
         }
       }
     }
 
-    if ( (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS) &&
+    if ( (bNewPicture || bytestream.eof() || nalu.m_nalUnitType == NAL_UNIT_EOS) &&
         !m_cTDecTop.getFirstSliceInSequence () )
     {
-      if (!loopFiltered || bitstreamFile)
+      if (!loopFiltered || !bytestream.eof())
       {
         m_cTDecTop.executeLoopFilters(poc, pcListPic);
       }
@@ -197,7 +189,7 @@ Void TAppDecTop::decode()
         m_cTDecTop.setFirstSliceInSequence(true);
       }
     }
-    else if ( (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
+    else if ( (bNewPicture || bytestream.eof() || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
               m_cTDecTop.getFirstSliceInSequence () ) 
     {
       m_cTDecTop.setFirstSliceInPicture (true);
@@ -252,6 +244,11 @@ Void TAppDecTop::decode()
   }
 
   xFlushOutput( pcListPic );
+  m_cOutputWriter.destroy();
+  if ( !m_reconFileName.empty() )
+  {
+    printf("\n Output blocked: %9.3f sec.\n", m_cOutputWriter.getBlockedTime());
+  }
   // delete buffers
   m_cTDecTop.deletePicBuffer();
 
@@ -266,6 +263,8 @@ Void TAppDecTop::decode()
 Void TAppDecTop::xCreateDecLib()
 {
   // create decoder class
+  m_cTDecTop.setNumWorkerThreads(m_numWorkerThreads);
+  m_cTDecTop.setLoopFilterCtuRows(m_loopFilterCtuRows);
   m_cTDecTop.create();
 }
 
@@ -398,12 +397,12 @@ Void TAppDecTop::xWriteOutput( TComList<TComPic*>* pcListPic, UInt tId )
 
           if (display)
           {
-            m_cTVideoIOYuvReconFile.write( pcPicTop->getPicYuvRec(), pcPicBottom->getPicYuvRec(),
-                                           m_outputColourSpaceConvert,
-                                           conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(),
-                                           conf.getWindowRightOffset() + defDisp.getWindowRightOffset(),
-                                           conf.getWindowTopOffset() + defDisp.getWindowTopOffset(),
-                                           conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(), NUM_CHROMA_FORMAT, isTff );
+            m_cOutputWriter.write( &m_cTVideoIOYuvReconFile, pcPicTop->getPicYuvRec(), pcPicBottom->getPicYuvRec(),
+                                   m_outputColourSpaceConvert,
+                                   conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(),
+                                   conf.getWindowRightOffset() + defDisp.getWindowRightOffset(),
+                                   conf.getWindowTopOffset() + defDisp.getWindowTopOffset(),
+                                   conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(), NUM_CHROMA_FORMAT, isTff );
           }
         }
 
@@ -453,13 +452,13 @@ Void TAppDecTop::xWriteOutput( TComList<TComPic*>* pcListPic, UInt tId )
           const Window &conf    = pcPic->getConformanceWindow();
           const Window  defDisp = m_respectDefDispWindow ? pcPic->getDefDisplayWindow() : Window();
 
-          m_cTVideoIOYuvReconFile.write( pcPic->getPicYuvRec(),
-                                         m_outputColourSpaceConvert,
-                                         conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(),
-                                         conf.getWindowRightOffset() + defDisp.getWindowRightOffset(),
-                                         conf.getWindowTopOffset() + defDisp.getWindowTopOffset(),
-                                         conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
-                                         NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range  );
+          m_cOutputWriter.write( &m_cTVideoIOYuvReconFile, pcPic->getPicYuvRec(),
+                                 m_outputColourSpaceConvert,
+                                 conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(),
+                                 conf.getWindowRightOffset() + defDisp.getWindowRightOffset(),
+                                 conf.getWindowTopOffset() + defDisp.getWindowTopOffset(),
+                                 conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
+                                 NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range  );
         }
 
         if (!m_colourRemapSEIFileName.empty())
@@ -518,12 +517,12 @@ Void TAppDecTop::xFlushOutput( TComList<TComPic*>* pcListPic )
           const Window &conf = pcPicTop->getConformanceWindow();
           const Window  defDisp = m_respectDefDispWindow ? pcPicTop->getDefDisplayWindow() : Window();
           const Bool isTff = pcPicTop->isTopField();
-          m_cTVideoIOYuvReconFile.write( pcPicTop->getPicYuvRec(), pcPicBottom->getPicYuvRec(),
-                                         m_outputColourSpaceConvert,
-                                         conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(),
-                                         conf.getWindowRightOffset() + defDisp.getWindowRightOffset(),
-                                         conf.getWindowTopOffset() + defDisp.getWindowTopOffset(),
-                                         conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(), NUM_CHROMA_FORMAT, isTff );
+          m_cOutputWriter.write( &m_cTVideoIOYuvReconFile, pcPicTop->getPicYuvRec(), pcPicBottom->getPicYuvRec(),
+                                 m_outputColourSpaceConvert,
+                                 conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(),
+                                 conf.getWindowRightOffset() + defDisp.getWindowRightOffset(),
+                                 conf.getWindowTopOffset() + defDisp.getWindowTopOffset(),
+                                 conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(), NUM_CHROMA_FORMAT, isTff );
         }
 
         // update POC of display order
@@ -576,13 +575,13 @@ Void TAppDecTop::xFlushOutput( TComList<TComPic*>* pcListPic )
           const Window &conf    = pcPic->getConformanceWindow();
           const Window  defDisp = m_respectDefDispWindow ? pcPic->getDefDisplayWindow() : Window();
 
-          m_cTVideoIOYuvReconFile.write( pcPic->getPicYuvRec(),
-                                         m_outputColourSpaceConvert,
-                                         conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(),
-                                         conf.getWindowRightOffset() + defDisp.getWindowRightOffset(),
-                                         conf.getWindowTopOffset() + defDisp.getWindowTopOffset(),
-                                         conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
-                                         NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+          m_cOutputWriter.write( &m_cTVideoIOYuvReconFile, pcPic->getPicYuvRec(),
+                                 m_outputColourSpaceConvert,
+                                 conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(),
+                                 conf.getWindowRightOffset() + defDisp.getWindowRightOffset(),
+                                 conf.getWindowTopOffset() + defDisp.getWindowTopOffset(),
+                                 conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
+                                 NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
         }
 
         if (!m_colourRemapSEIFileName.empty())
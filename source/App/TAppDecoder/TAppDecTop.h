@@ -43,6 +43,7 @@
 #endif // _MSC_VER > 1000
 
 #include "TLibVideoIO/TVideoIOYuv.h"
+#include "TLibVideoIO/TVideoIOYuvAsync.h"
 #include "TLibCommon/TComList.h"
 #include "TLibCommon/TComPicYuv.h"
 #include "TLibDecoder/TDecTop.h"
@@ -62,6 +63,7 @@ private:
   // class interface
   TDecTop                         m_cTDecTop;                     ///< decoder class
   TVideoIOYuv                     m_cTVideoIOYuvReconFile;        ///< reconstruction YUV class
+  TVideoIOYuvAsyncWriter          m_cOutputWriter;                ///< writes the reconstruction on a separate thread
 
   // for output control
   Int                             m_iPOCLastDisplay;              ///< last POC in display order
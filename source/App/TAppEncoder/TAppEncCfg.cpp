@@ -787,6 +787,8 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("TemporalSubsampleRatio,-ts",                      m_temporalSubsampleRatio,                            1u, "Temporal sub-sample ratio when reading input YUV")
   ("FramesToBeEncoded,f",                             m_framesToBeEncoded,                                  0, "Number of frames to be encoded (default=all)")
   ("ClipInputVideoToRec709Range",                     m_bClipInputVideoToRec709Range,                   false, "If true then clip input video to the Rec. 709 Range on loading when InternalBitDepth is less than MSBExtendedBitDepth")
+  ("InputReadAhead",                                  m_inputReadAhead,                                    0u, "Number of input frames read ahead on a separate thread (0: read each frame before it is encoded)")
+  ("OutputQueueFrames",                               m_outputQueueFrames,                                 0u, "Number of reconstructed frames and access units that can be queued for writing on a separate thread (0: write on the encoding thread)")
   ("ClipOutputVideoToRec709Range",                    m_bClipOutputVideoToRec709Range,                  false, "If true then clip output video to the Rec. 709 Range on saving when OutputBitDepth is less than InternalBitDepth")
   ("SummaryOutFilename",                              m_summaryOutFilename,                          string(), "Filename to use for producing summary output file. If empty, do not produce a file.")
   ("SummaryPicFilenameBase",                          m_summaryPicFilenameBase,                      string(), "Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended. If empty, do not produce a file.")
@@ -844,6 +846,12 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("RestrictMESampling",                              m_bRestrictMESampling,                            false, "Restrict ME Sampling for selective inter motion search")
   ("ClipForBiPredMEEnabled",                          m_bClipForBiPredMeEnabled,                        false, "Enables clipping in the Bi-Pred ME. It is disabled to reduce encoder run-time")
   ("FastMEAssumingSmootherMVEnabled",                 m_bFastMEAssumingSmootherMVEnabled,                true, "Enables fast ME assuming a smoother MV.")
+  ("SubPelPlaneCache",                                m_subPelPlaneCache,                               false, "Interpolate the sub-sample planes of each reference picture once and use them in the fractional ME")
+  ("HierarchicalME",                                  m_hierarchicalME,                                 false, "Seed the TZ search with a per-CTU search on half- and quarter-resolution pictures")
+  ("Lookahead",                                       m_lookahead,                                      false, "Estimate intra and inter costs and motion of the source pictures ahead of encoding, to seed the ME and weight the CTU bit allocation of rate control")
+  ("LookaheadThreads",                                m_lookaheadThreads,                                   1, "Number of threads of the lookahead pre-analysis")
+  ("LookaheadDepth",                                  m_lookaheadDepth,                                     0, "Number of source pictures passed to the lookahead pre-analysis ahead of the encoder (0: each picture when it is received)")
+  ("LookaheadModeHints",                              m_lookaheadModeHints,                             false, "Skip the intra modes of CUs in inter slices whose lookahead inter cost is well below their intra cost")
 
   ("HadamardME",                                      m_bUseHADME,                                       true, "Hadamard ME for fractional-pel")
   ("ASR",                                             m_bUseASR,                                        false, "Adaptive motion search range");
@@ -900,6 +908,7 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("RDOQ",                                            m_useRDOQ,                                         true)
   ("RDOQTS",                                          m_useRDOQTS,                                       true)
   ("SelectiveRDOQ",                                   m_useSelectiveRDOQ,                               false, "Enable selective RDOQ")
+  ("RDOQFixedPoint",                                  m_useRDOQFixedPoint,                              false, "Evaluate the RDOQ costs in fixed-point integer arithmetic")
   ("RDpenalty",                                       m_rdPenalty,                                          0,  "RD-penalty for 32x32 TU for intra in non-intra slices. 0:disabled  1:RD-penalty  2:maximum RD-penalty")
 
   // Deblocking filter parameters
@@ -973,6 +982,8 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("TileRowHeightArray",                              cfg_RowHeight,                            cfg_RowHeight, "Array containing tile row height values in units of CTU")
   ("LFCrossTileBoundaryFlag",                         m_bLFCrossTileBoundaryFlag,                        true, "1: cross-tile-boundary loop filtering. 0:non-cross-tile-boundary loop filtering")
   ("WaveFrontSynchro",                                m_entropyCodingSyncEnabledFlag,                   false, "0: entropy coding sync disabled; 1 entropy coding sync enabled")
+  ("NumWorkerThreads",                                m_numWorkerThreads,                                   0, "Number of threads used to compress and entropy code tiles or WPP CTU rows in parallel (0 or 1: single-threaded)")
+  ("NumParallelPictures",                             m_numParallelPictures,                                0, "Number of pictures of a GOP that are encoded concurrently once the pictures they reference are encoded (0 or 1: one after another). The bitstream differs from the serial one")
   ("ScalingList",                                     m_useScalingListId,                    SCALING_LIST_OFF, "0/off: no scaling list, 1/default: default scaling lists, 2/file: scaling lists specified in ScalingListFile")
   ("ScalingListFile",                                 m_scalingListFileName,                       string(""), "Scaling list file name. Use an empty string to produce help.")
   ("SignHideFlag,-SBH",                               m_signDataHidingEnabledFlag,                                    true)
@@ -2221,6 +2232,11 @@ Void TAppEncCfg::xCheckParameter()
   {
     xConfirmPara( tileFlag && m_entropyCodingSyncEnabledFlag, "Tiles and entropy-coding-sync (Wavefronts) can not be applied together, except in the High Throughput Intra 4:4:4 16 profile");
   }
+  xConfirmPara( m_numWorkerThreads < 0, "NumWorkerThreads must not be negative");
+  xConfirmPara( m_numParallelPictures < 0, "NumParallelPictures must not be negative");
+  xConfirmPara( m_lookahead && m_lookaheadThreads < 1, "LookaheadThreads must be at least 1");
+  xConfirmPara( m_lookaheadModeHints && !m_lookahead, "LookaheadModeHints requires Lookahead");
+  xConfirmPara( m_lookaheadDepth < 0, "LookaheadDepth must not be negative");
 
   xConfirmPara( m_iSourceWidth  % TComSPS::getWinUnitX(m_chromaFormatIDC) != 0, "Picture width must be an integer multiple of the specified chroma subsampling");
   xConfirmPara( m_iSourceHeight % TComSPS::getWinUnitY(m_chromaFormatIDC) != 0, "Picture height must be an integer multiple of the specified chroma subsampling");
@@ -2999,12 +3015,20 @@ Void TAppEncCfg::xPrintParameter()
   printf("HAD:%d ", m_bUseHADME                          );
   printf("RDQ:%d ", m_useRDOQ                            );
   printf("RDQTS:%d ", m_useRDOQTS                        );
+  printf("RDQFP:%d ", m_useRDOQFixedPoint                );
   printf("RDpenalty:%d ", m_rdPenalty                    );
   printf("LQP:%d ", m_lumaLevelToDeltaQPMapping.mode     );
   printf("SQP:%d ", m_uiDeltaQpRD                        );
   printf("ASR:%d ", m_bUseASR                            );
   printf("MinSearchWindow:%d ", m_minSearchWindow        );
   printf("RestrictMESampling:%d ", m_bRestrictMESampling );
+  printf("SubPelPlaneCache:%d ", m_subPelPlaneCache      );
+  printf("HierarchicalME:%d ", m_hierarchicalME          );
+  printf("Lookahead:%d ", m_lookahead               );
+  if (m_lookahead)
+  {
+    printf("LookaheadThreads:%d LookaheadDepth:%d LookaheadModeHints:%d ", m_lookaheadThreads, m_lookaheadDepth, m_lookaheadModeHints);
+  }
   printf("FEN:%d ", Int(m_fastInterSearchMode)           );
   printf("ECU:%d ", m_bUseEarlyCU                        );
   printf("FDM:%d ", m_useFastDecisionForMerge            );
@@ -3042,6 +3066,8 @@ Void TAppEncCfg::xPrintParameter()
   printf("PME:%d ", m_log2ParallelMergeLevel);
   const Int iWaveFrontSubstreams = m_entropyCodingSyncEnabledFlag ? (m_iSourceHeight + m_uiMaxCUHeight - 1) / m_uiMaxCUHeight : 1;
   printf(" WaveFrontSynchro:%d WaveFrontSubstreams:%d", m_entropyCodingSyncEnabledFlag?1:0, iWaveFrontSubstreams);
+  printf(" NumWorkerThreads:%d", m_numWorkerThreads);
+  printf(" NumParallelPictures:%d", m_numParallelPictures);
   printf(" ScalingList:%d ", m_useScalingListId );
   printf("TMVPMode:%d ", m_TMVPModeId     );
 #if ADAPTIVE_QP_SELECTION
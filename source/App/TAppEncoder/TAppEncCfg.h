@@ -122,6 +122,8 @@ protected:
 
   Bool      m_cabacZeroWordPaddingEnabled;
   Bool      m_bClipInputVideoToRec709Range;
+  UInt      m_inputReadAhead;                                 ///< number of input frames read ahead on a separate thread
+  UInt      m_outputQueueFrames;                              ///< number of outputs queued for writing on a separate thread
   Bool      m_bClipOutputVideoToRec709Range;
 
   // profile/level
@@ -257,10 +259,17 @@ protected:
   Bool      m_useRDOQ;                                        ///< flag for using RD optimized quantization
   Bool      m_useRDOQTS;                                      ///< flag for using RD optimized quantization for transform skip
   Bool      m_useSelectiveRDOQ;                               ///< flag for using selective RDOQ
+  Bool      m_useRDOQFixedPoint;                              ///< flag for evaluating the RDOQ costs in fixed-point arithmetic
   Int       m_rdPenalty;                                      ///< RD-penalty for 32x32 TU for intra in non-intra slices (0: no RD-penalty, 1: RD-penalty, 2: maximum RD-penalty)
   Bool      m_bDisableIntraPUsInInterSlices;                  ///< Flag for disabling intra predicted PUs in inter slices.
   MESearchMethod m_motionEstimationSearchMethod;
   Bool      m_bRestrictMESampling;                            ///< Restrict sampling for the Selective ME
+  Bool      m_subPelPlaneCache;                               ///< Cache the sub-sample planes of reference pictures for the fractional ME
+  Bool      m_hierarchicalME;                                 ///< Seed the integer ME with a search on downscaled pictures
+  Bool      m_lookahead;                                      ///< Run the lookahead pre-analysis of the source pictures
+  Int       m_lookaheadThreads;                               ///< Number of threads of the lookahead pre-analysis
+  Int       m_lookaheadDepth;                                 ///< Number of source pictures passed to the pre-analysis ahead of the encoder
+  Bool      m_lookaheadModeHints;                             ///< Skip intra modes in inter slices where the pre-analysis favours inter prediction
   Int       m_iSearchRange;                                   ///< ME search range
   Int       m_bipredSearchRange;                              ///< ME search range for bipred refinement
   Int       m_minSearchWindow;                                ///< ME minimum search window size for the Adaptive Window ME
@@ -284,6 +293,8 @@ protected:
   std::vector<Int> m_tileColumnWidth;
   std::vector<Int> m_tileRowHeight;
   Bool      m_entropyCodingSyncEnabledFlag;
+  Int       m_numWorkerThreads;                               ///< number of threads used to compress the CTUs of a slice in parallel
+  Int       m_numParallelPictures;                            ///< number of pictures of a GOP encoded concurrently
 
   Bool      m_bUseConstrainedIntraPred;                       ///< flag for using constrained intra prediction
   Bool      m_bFastUDIUseMPMEnabled;
@@ -42,6 +42,8 @@
 #include <fcntl.h>
 #include <assert.h>
 #include <iomanip>
+#include <sstream>
+#include <memory>
 
 #include "TAppEncTop.h"
 #include "TLibEncoder/AnnexBwrite.h"
@@ -177,6 +179,11 @@ Void TAppEncTop::xInitLibCfg()
   m_cTEncTop.setFastMEAssumingSmootherMVEnabled                   ( m_bFastMEAssumingSmootherMVEnabled );
   m_cTEncTop.setMinSearchWindow                                   ( m_minSearchWindow );
   m_cTEncTop.setRestrictMESampling                                ( m_bRestrictMESampling );
+  m_cTEncTop.setSubPelPlaneCache                                  ( m_subPelPlaneCache );
+  m_cTEncTop.setHierarchicalME                                    ( m_hierarchicalME );
+  m_cTEncTop.setLookahead                                         ( m_lookahead );
+  m_cTEncTop.setLookaheadThreads                                  ( m_lookaheadThreads );
+  m_cTEncTop.setLookaheadModeHints                                ( m_lookaheadModeHints );
 
   //====== Quality control ========
   m_cTEncTop.setMaxDeltaQP                                        ( m_iMaxDeltaQP  );
@@ -213,6 +220,7 @@ Void TAppEncTop::xInitLibCfg()
   m_cTEncTop.setUseRDOQ                                           ( m_useRDOQ     );
   m_cTEncTop.setUseRDOQTS                                         ( m_useRDOQTS   );
   m_cTEncTop.setUseSelectiveRDOQ                                  ( m_useSelectiveRDOQ );
+  m_cTEncTop.setUseRDOQFixedPoint                                 ( m_useRDOQFixedPoint );
   m_cTEncTop.setRDpenalty                                         ( m_rdPenalty );
   m_cTEncTop.setMaxCUWidth                                        ( m_uiMaxCUWidth );
   m_cTEncTop.setMaxCUHeight                                       ( m_uiMaxCUHeight );
@@ -464,6 +472,8 @@ Void TAppEncTop::xInitLibCfg()
   }
   m_cTEncTop.setLFCrossTileBoundaryFlag                           ( m_bLFCrossTileBoundaryFlag );
   m_cTEncTop.setEntropyCodingSyncEnabledFlag                      ( m_entropyCodingSyncEnabledFlag );
+  m_cTEncTop.setNumWorkerThreads                                  ( m_numWorkerThreads );
+  m_cTEncTop.setNumParallelPictures                               ( m_numParallelPictures );
   m_cTEncTop.setTMVPModeId                                        ( m_TMVPModeId );
   m_cTEncTop.setUseScalingListId                                  ( m_useScalingListId  );
   m_cTEncTop.setScalingListFileName                               ( m_scalingListFileName );
@@ -583,6 +593,8 @@ Void TAppEncTop::encode()
 
   printChromaFormat();
 
+  m_cOutputWriter.create( m_outputQueueFrames );
+
   // main encoder loop
   Int   iNumEncoded = 0;
   Bool  bEos = false;
@@ -610,24 +622,62 @@ Void TAppEncTop::encode()
   TExt360AppEncTop           ext360(*this, m_cTEncTop.getGOPEncoder()->getExt360Data(), *(m_cTEncTop.getGOPEncoder()), *pcPicYuvOrg);
 #endif
 
+  // read the input on a separate thread, into a ring of buffers holding the frame being encoded and those read ahead
+  TVideoIOYuvAsyncReader cInputReader;
+#if EXTENSION_360_VIDEO
+  const Bool bAsyncInputPossible = !ext360.isEnabled();
+#else
+  const Bool bAsyncInputPossible = true;
+#endif
+  // with frame coding, the pictures read ahead are passed to the lookahead pre-analysis, which needs as many buffers
+  const Int  iLookaheadDepth = (bAsyncInputPossible && m_lookahead && !m_isField) ? m_lookaheadDepth : 0;
+  const Bool bAsyncInput = bAsyncInputPossible && (m_inputReadAhead > 0 || iLookaheadDepth > 0);
+  Int        iNumLookaheadPics = 0;
+  if (bAsyncInput)
+  {
+    cInputReader.create( std::max<Int>( m_inputReadAhead, iLookaheadDepth ) + 1, pcPicYuvOrg->getWidth(COMPONENT_Y), pcPicYuvOrg->getHeight(COMPONENT_Y), m_chromaFormatIDC, m_uiMaxCUWidth, m_uiMaxCUHeight, m_uiMaxTotalCUDepth );
+    cInputReader.start( &m_cTVideoIOYuvInputFile, m_isField ? (m_framesToBeEncoded >> 1) : m_framesToBeEncoded, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range,
+                        m_temporalSubsampleRatio - 1, m_inputFileWidth, m_inputFileHeight );
+  }
+
   while ( !bEos )
   {
     // get buffers
     xGetBuffer(pcPicYuvRec);
 
     // read input YUV file
-#if EXTENSION_360_VIDEO
-    if (ext360.isEnabled())
+    TComPicYuv* pcPicYuvIn     = pcPicYuvOrg;
+    TComPicYuv* pcPicYuvTrueIn = &cPicYuvTrueOrg;
+    Bool        bInputEof;
+    if (bAsyncInput)
     {
-      ext360.read(m_cTVideoIOYuvInputFile, *pcPicYuvOrg, cPicYuvTrueOrg, ipCSC);
+      bInputEof = !cInputReader.getPicture( pcPicYuvIn, pcPicYuvTrueIn );
+
+      // pass the pictures up to iLookaheadDepth frames ahead of this one to the pre-analysis, starting with this one
+      TComPicYuv* pcPicYuvAhead;
+      while (iLookaheadDepth > 0 && !bInputEof && iNumLookaheadPics <= m_iFrameRcvd + iLookaheadDepth &&
+             cInputReader.peekPicture( iNumLookaheadPics - m_iFrameRcvd, pcPicYuvAhead ))
+      {
+        m_cTEncTop.addLookaheadPicture( pcPicYuvAhead );
+        iNumLookaheadPics++;
+      }
     }
     else
     {
-      m_cTVideoIOYuvInputFile.read( pcPicYuvOrg, &cPicYuvTrueOrg, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
-    }
+#if EXTENSION_360_VIDEO
+      if (ext360.isEnabled())
+      {
+        ext360.read(m_cTVideoIOYuvInputFile, *pcPicYuvOrg, cPicYuvTrueOrg, ipCSC);
+      }
+      else
+      {
+        m_cTVideoIOYuvInputFile.read( pcPicYuvOrg, &cPicYuvTrueOrg, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
+      }
 #else
-    m_cTVideoIOYuvInputFile.read( pcPicYuvOrg, &cPicYuvTrueOrg, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
+      m_cTVideoIOYuvInputFile.read( pcPicYuvOrg, &cPicYuvTrueOrg, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
 #endif
+      bInputEof = m_cTVideoIOYuvInputFile.isEof();
+    }
 
     // increase number of received frames
     m_iFrameRcvd++;
@@ -636,7 +686,7 @@ Void TAppEncTop::encode()
 
     Bool flush = 0;
     // if end of file (which is only detected on a read failure) flush the encoder of any queued pictures
-    if (m_cTVideoIOYuvInputFile.isEof())
+    if (bInputEof)
     {
       flush = true;
       bEos = true;
@@ -647,11 +697,17 @@ Void TAppEncTop::encode()
     // call encoding function for one frame
     if ( m_isField )
     {
-      m_cTEncTop.encode( bEos, flush ? 0 : pcPicYuvOrg, flush ? 0 : &cPicYuvTrueOrg, snrCSC, m_cListPicYuvRec, outputAccessUnits, iNumEncoded, m_isTopFieldFirst );
+      m_cTEncTop.encode( bEos, flush ? 0 : pcPicYuvIn, flush ? 0 : pcPicYuvTrueIn, snrCSC, m_cListPicYuvRec, outputAccessUnits, iNumEncoded, m_isTopFieldFirst );
     }
     else
     {
-      m_cTEncTop.encode( bEos, flush ? 0 : pcPicYuvOrg, flush ? 0 : &cPicYuvTrueOrg, snrCSC, m_cListPicYuvRec, outputAccessUnits, iNumEncoded );
+      m_cTEncTop.encode( bEos, flush ? 0 : pcPicYuvIn, flush ? 0 : pcPicYuvTrueIn, snrCSC, m_cListPicYuvRec, outputAccessUnits, iNumEncoded );
+    }
+
+    // the input frame has been copied by the encoder
+    if (bAsyncInput && pcPicYuvIn != NULL)
+    {
+      cInputReader.releasePicture();
     }
 
     // write bistream to file if necessary
@@ -661,7 +717,7 @@ Void TAppEncTop::encode()
       outputAccessUnits.clear();
     }
     // temporally skip frames
-    if( m_temporalSubsampleRatio > 1 )
+    if( !bAsyncInput && m_temporalSubsampleRatio > 1 )
     {
       m_cTVideoIOYuvInputFile.skipFrames(m_temporalSubsampleRatio-1, m_inputFileWidth, m_inputFileHeight, m_InputChromaFormatIDC);
     }
@@ -669,6 +725,12 @@ Void TAppEncTop::encode()
 
   m_cTEncTop.printSummary(m_isField);
 
+  // stop reading before the input file is closed
+  cInputReader.destroy();
+
+  // write the remaining output before the files are closed
+  m_cOutputWriter.destroy();
+
   // delete original YUV buffer
   pcPicYuvOrg->destroy();
   delete pcPicYuvOrg;
@@ -683,6 +745,7 @@ Void TAppEncTop::encode()
   xDestroyLib();
 
   printRateSummary();
+  printf("\n Output blocked: %9.3f sec.\n", m_cOutputWriter.getBlockedTime());
 
   return;
 }
@@ -742,6 +805,9 @@ Void TAppEncTop::xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, cons
 {
   const InputColourSpaceConversion ipCSC = (!m_outputInternalColourSpace) ? m_inputColourSpaceConvert : IPCOLOURSPACE_UNCHANGED;
 
+  // the access units are formatted here and written to the file by the output writer
+  std::shared_ptr<std::ostringstream> pcAuStream = std::make_shared<std::ostringstream>();
+
   if (m_isField)
   {
     //Reinterlace fields
@@ -761,15 +827,15 @@ Void TAppEncTop::xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, cons
 
       if (!m_reconFileName.empty())
       {
-        m_cTVideoIOYuvReconFile.write( pcPicYuvRecTop, pcPicYuvRecBottom, ipCSC, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, NUM_CHROMA_FORMAT, m_isTopFieldFirst );
+        m_cOutputWriter.write( &m_cTVideoIOYuvReconFile, pcPicYuvRecTop, pcPicYuvRecBottom, ipCSC, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, NUM_CHROMA_FORMAT, m_isTopFieldFirst );
       }
 
       const AccessUnit& auTop = *(iterBitstream++);
-      const vector<UInt>& statsTop = writeAnnexB(bitstreamFile, auTop);
+      const vector<UInt>& statsTop = writeAnnexB(*pcAuStream, auTop);
       rateStatsAccum(auTop, statsTop);
 
       const AccessUnit& auBottom = *(iterBitstream++);
-      const vector<UInt>& statsBottom = writeAnnexB(bitstreamFile, auBottom);
+      const vector<UInt>& statsBottom = writeAnnexB(*pcAuStream, auBottom);
       rateStatsAccum(auBottom, statsBottom);
     }
   }
@@ -790,15 +856,21 @@ Void TAppEncTop::xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, cons
       TComPicYuv*  pcPicYuvRec  = *(iterPicYuvRec++);
       if (!m_reconFileName.empty())
       {
-        m_cTVideoIOYuvReconFile.write( pcPicYuvRec, ipCSC, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom,
+        m_cOutputWriter.write( &m_cTVideoIOYuvReconFile, pcPicYuvRec, ipCSC, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom,
             NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range  );
       }
 
       const AccessUnit& au = *(iterBitstream++);
-      const vector<UInt>& stats = writeAnnexB(bitstreamFile, au);
+      const vector<UInt>& stats = writeAnnexB(*pcAuStream, au);
       rateStatsAccum(au, stats);
     }
   }
+
+  m_cOutputWriter.addJob( [&bitstreamFile, pcAuStream]()
+  {
+    const std::string data = pcAuStream->str();
+    bitstreamFile.write( data.data(), data.size() );
+  } );
 }
 
 /**
@@ -43,6 +43,7 @@
 
 #include "TLibEncoder/TEncTop.h"
 #include "TLibVideoIO/TVideoIOYuv.h"
+#include "TLibVideoIO/TVideoIOYuvAsync.h"
 #include "TLibCommon/AccessUnit.h"
 #include "TAppEncCfg.h"
 
@@ -61,6 +62,7 @@ private:
   TEncTop                    m_cTEncTop;                    ///< encoder class
   TVideoIOYuv                m_cTVideoIOYuvInputFile;       ///< input YUV file
   TVideoIOYuv                m_cTVideoIOYuvReconFile;       ///< output reconstruction file
+  TVideoIOYuvAsyncWriter     m_cOutputWriter;               ///< writes the reconstruction and the bitstream on a separate thread
 
   TComList<TComPicYuv*>      m_cListPicYuvRec;              ///< list of reconstruction YUV files
 
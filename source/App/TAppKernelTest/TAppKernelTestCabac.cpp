@@ -0,0 +1,329 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TAppKernelTestCabac.cpp
+    \brief    Kernel test application class: CABAC bin decoding of TDecBinCABAC
+*/
+
+#include <cstdio>
+#include <chrono>
+#include "TAppKernelTestTop.h"
+#include "TLibCommon/TComBitStream.h"
+#include "TLibCommon/ContextModel.h"
+#include "TLibEncoder/TEncBinCoderCABAC.h"
+#include "TLibDecoder/TDecBinCoderCABAC.h"
+
+//! \ingroup TAppKernelTest
+//! \{
+
+// ====================================================================================================================
+// Constants
+// ====================================================================================================================
+
+static const Int NUM_CABAC_CONTEXTS      = 28;        ///< 4 contexts for each probability of g_cabacProbabilities
+static const Int CABAC_TEST_SYMBOLS      = 1 << 14;   ///< symbols of each checked stream
+static const Int CABAC_BENCHMARK_SYMBOLS = 1 << 20;   ///< symbols of each measured stream
+static const Int CABAC_BENCHMARK_PASSES  = 16;        ///< number of times each measured stream is decoded
+static const Int MAX_REPORTED_MISMATCHES = 16;
+
+/// probabilities of a 1 of the context-coded bins, in 1/256
+static const Int g_cabacProbabilities[] = { 5, 26, 77, 128, 179, 230, 251 };
+
+enum CabacSymbolType
+{
+  CABAC_CONTEXT_BIN     = 0,                          ///< decodeBin
+  CABAC_BYPASS_BIN      = 1,                          ///< decodeBinEP
+  CABAC_BYPASS_BINS     = 2,                          ///< decodeBinsEP
+  CABAC_TERMINATING_BIN = 3                           ///< decodeBinTrm, always 0 before the end of the stream
+};
+
+enum CabacStreamType
+{
+  CABAC_STREAM_CONTEXT        = 0,
+  CABAC_STREAM_BYPASS         = 1,
+  CABAC_STREAM_BYPASS_GROUPS  = 2,
+  CABAC_STREAM_RESIDUAL       = 3,
+  NUM_CABAC_STREAM_TYPES      = 4
+};
+
+static const TChar* const g_cabacStreamNames[NUM_CABAC_STREAM_TYPES] =
+{
+  "context-coded bins",
+  "single bypass bins",
+  "groups of bypass bins",
+  "residual-like mix"
+};
+
+struct CabacSymbol
+{
+  UChar type;                                         ///< CabacSymbolType
+  UChar param;                                        ///< context index, or number of bypass bins
+  UInt  value;
+};
+
+// ====================================================================================================================
+// Private function definitions
+// ====================================================================================================================
+
+#if !RExt__DECODER_DEBUG_BIT_STATISTICS
+static Void xInitContexts( ContextModel* pcContexts, const std::vector<Int>& initValues )
+{
+  for (Int ctx = 0; ctx < NUM_CABAC_CONTEXTS; ctx++)
+  {
+    pcContexts[ctx].init(26, initValues[ctx]);
+  }
+}
+
+/// encodes the symbols as a slice segment: they are followed by end_of_slice_segment_flag and the rbsp trailing bits
+static Void xEncodeCabacSymbols( const std::vector<CabacSymbol>& symbols, const std::vector<Int>& initValues, TComOutputBitstream& rcBitstream )
+{
+  ContextModel acContexts[NUM_CABAC_CONTEXTS];
+  xInitContexts(acContexts, initValues);
+
+  TEncBinCABAC cEncoder;
+  cEncoder.init(&rcBitstream);
+  cEncoder.start();
+
+  for (std::vector<CabacSymbol>::const_iterator it = symbols.begin(); it != symbols.end(); it++)
+  {
+    switch (it->type)
+    {
+      case CABAC_CONTEXT_BIN:     cEncoder.encodeBin   (it->value, acContexts[it->param]); break;
+      case CABAC_BYPASS_BIN:      cEncoder.encodeBinEP (it->value);                        break;
+      case CABAC_BYPASS_BINS:     cEncoder.encodeBinsEP(it->value, it->param);             break;
+      default:                    cEncoder.encodeBinTrm(0);                                break;
+    }
+  }
+
+  cEncoder.encodeBinTrm(1);
+  cEncoder.finish();
+  rcBitstream.writeByteAlignment();
+}
+
+/** decodes the symbols through the TDecBinIf interface, like TDecSbac.
+ * \returns the number of symbols that differ from the encoded ones, plus one if the end of the slice segment is not
+ *          found at the end of the bitstream
+ */
+static UInt xDecodeCabacSymbols( const std::vector<CabacSymbol>& symbols, const std::vector<Int>& initValues, TComInputBitstream& rcBitstream )
+{
+  ContextModel acContexts[NUM_CABAC_CONTEXTS];
+  xInitContexts(acContexts, initValues);
+
+  TDecBinCABAC cDecoder;
+  TDecBinIf*   pcBinIf = &cDecoder;
+  pcBinIf->init(&rcBitstream);
+  pcBinIf->start();
+
+  UInt uiNumMismatches = 0;
+  UInt uiValue;
+
+  for (std::vector<CabacSymbol>::const_iterator it = symbols.begin(); it != symbols.end(); it++)
+  {
+    switch (it->type)
+    {
+      case CABAC_CONTEXT_BIN:     pcBinIf->decodeBin   (uiValue, acContexts[it->param]); break;
+      case CABAC_BYPASS_BIN:      pcBinIf->decodeBinEP (uiValue);                        break;
+      case CABAC_BYPASS_BINS:     pcBinIf->decodeBinsEP(uiValue, it->param);             break;
+      default:                    pcBinIf->decodeBinTrm(uiValue);                        break;
+    }
+    uiNumMismatches += uiValue != it->value ? 1 : 0;
+  }
+
+  pcBinIf->decodeBinTrm(uiValue);
+  if (uiValue != 1)
+  {
+    return uiNumMismatches + 1;
+  }
+  pcBinIf->finish();
+  rcBitstream.readOutTrailingBits();
+
+  return uiNumMismatches + (rcBitstream.getNumBitsLeft() != 0 ? 1 : 0);
+}
+
+static UInt xGetNumBins( const std::vector<CabacSymbol>& symbols )
+{
+  UInt uiNumBins = 0;
+  for (std::vector<CabacSymbol>::const_iterator it = symbols.begin(); it != symbols.end(); it++)
+  {
+    uiNumBins += it->type == CABAC_BYPASS_BINS ? it->param : 1;
+  }
+  return uiNumBins;
+}
+#endif
+
+// ====================================================================================================================
+// Protected member functions
+// ====================================================================================================================
+
+/** random symbols of a stream type. The residual-like mix has, for each coefficient group, the context-coded flags
+ * of the coefficients followed by the bypass-coded signs and remaining levels, and an end_of_slice_segment_flag
+ * after every 16 groups.
+ */
+Void TAppKernelTestTop::xGenerateCabacSymbols( Int streamType, Int numSymbols, std::vector<CabacSymbol>& symbols, std::vector<Int>& initValues )
+{
+  initValues.resize(NUM_CABAC_CONTEXTS);
+  for (Int ctx = 0; ctx < NUM_CABAC_CONTEXTS; ctx++)
+  {
+    initValues[ctx] = xRandom() & 255;
+  }
+
+  symbols.clear();
+  symbols.reserve(numSymbols);
+
+  CabacSymbol cSymbol;
+  for (Int group = 0; Int(symbols.size()) < numSymbols; group++)
+  {
+    const Int numContextBins = streamType == CABAC_STREAM_CONTEXT ? 1 : (streamType == CABAC_STREAM_RESIDUAL ? 4 + xRandom() % 12 : 0);
+    const Int numBypassBins  = streamType == CABAC_STREAM_BYPASS  ? 1 : 0;
+    const Int numBypassGroups= streamType == CABAC_STREAM_BYPASS_GROUPS ? 1 : (streamType == CABAC_STREAM_RESIDUAL ? 1 + xRandom() % 3 : 0);
+
+    for (Int i = 0; i < numContextBins; i++)
+    {
+      cSymbol.type  = CABAC_CONTEXT_BIN;
+      cSymbol.param = UChar(xRandom() % NUM_CABAC_CONTEXTS);
+      cSymbol.value = Int(xRandom() & 255) < g_cabacProbabilities[cSymbol.param % (NUM_CABAC_CONTEXTS / 4)] ? 1 : 0;
+      symbols.push_back(cSymbol);
+    }
+    for (Int i = 0; i < numBypassBins; i++)
+    {
+      cSymbol.type  = CABAC_BYPASS_BIN;
+      cSymbol.param = 1;
+      cSymbol.value = xRandom() & 1;
+      symbols.push_back(cSymbol);
+    }
+    for (Int i = 0; i < numBypassGroups; i++)
+    {
+      // mostly up to 16 bins, like the signs and coeff_abs_level_remaining, sometimes up to 32
+      cSymbol.type  = CABAC_BYPASS_BINS;
+      cSymbol.param = UChar(1 + ((xRandom() & 7) == 0 ? xRandom() % 32 : xRandom() % 16));
+      cSymbol.value = xRandom() & (cSymbol.param == 32 ? ~0u : (1u << cSymbol.param) - 1);
+      symbols.push_back(cSymbol);
+    }
+    if (streamType == CABAC_STREAM_RESIDUAL && (group & 15) == 15)
+    {
+      cSymbol.type  = CABAC_TERMINATING_BIN;
+      cSymbol.param = 1;
+      cSymbol.value = 0;
+      symbols.push_back(cSymbol);
+    }
+  }
+}
+
+/**
+ - random symbols of each stream type are encoded with TEncBinCABAC and decoded with TDecBinCABAC
+ - the decoded bins must be the encoded ones, and the decoder must stop at the end of the slice segment
+ */
+UInt TAppKernelTestTop::xTestCabac()
+{
+  printf("\nTDecBinCABAC bin decoding\n");
+
+#if !RExt__DECODER_DEBUG_BIT_STATISTICS
+  std::vector<CabacSymbol> symbols;
+  std::vector<Int>         initValues;
+
+  UInt uiNumMismatches = 0;
+
+  for (Int streamType = 0; streamType < NUM_CABAC_STREAM_TYPES; streamType++)
+  {
+    UInt uiNumBins           = 0;
+    UInt uiNumTypeMismatches = 0;
+
+    for (Int iteration = 0; iteration < m_iterations; iteration++)
+    {
+      xGenerateCabacSymbols(streamType, CABAC_TEST_SYMBOLS, symbols, initValues);
+
+      TComOutputBitstream cOutput;
+      xEncodeCabacSymbols(symbols, initValues, cOutput);
+
+      TComInputBitstream cInput;
+      cInput.getFifo() = cOutput.getFIFO();
+      const UInt uiStreamMismatches = xDecodeCabacSymbols(symbols, initValues, cInput);
+
+      if (uiStreamMismatches != 0 && uiNumMismatches < MAX_REPORTED_MISMATCHES)
+      {
+        printf("  %-22s stream %d: %u mismatches\n", g_cabacStreamNames[streamType], iteration, uiStreamMismatches);
+      }
+      uiNumBins           += xGetNumBins(symbols);
+      uiNumTypeMismatches += uiStreamMismatches;
+      uiNumMismatches     += uiStreamMismatches;
+    }
+
+    printf("  %-22s %10u bins %6u mismatches\n", g_cabacStreamNames[streamType], uiNumBins, uiNumTypeMismatches);
+  }
+
+  return uiNumMismatches;
+#else
+  printf("  not supported with RExt__DECODER_DEBUG_BIT_STATISTICS, skipped\n");
+  return 0;
+#endif
+}
+
+/** measures the decoding throughput of TDecBinCABAC for each stream type, through the TDecBinIf interface like
+ * TDecSbac. The time includes the bitstream reads but not the initialisation.
+ */
+Void TAppKernelTestTop::xBenchmarkCabac()
+{
+  printf("\nTDecBinCABAC decoding speed\n");
+
+#if !RExt__DECODER_DEBUG_BIT_STATISTICS
+  std::vector<CabacSymbol> symbols;
+  std::vector<Int>         initValues;
+
+  for (Int streamType = 0; streamType < NUM_CABAC_STREAM_TYPES; streamType++)
+  {
+    xGenerateCabacSymbols(streamType, CABAC_BENCHMARK_SYMBOLS, symbols, initValues);
+
+    TComOutputBitstream cOutput;
+    xEncodeCabacSymbols(symbols, initValues, cOutput);
+
+    Double dTime = 0;
+    for (Int pass = 0; pass < CABAC_BENCHMARK_PASSES; pass++)
+    {
+      TComInputBitstream cInput;
+      cInput.getFifo() = cOutput.getFIFO();
+
+      const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      xDecodeCabacSymbols(symbols, initValues, cInput);
+      dTime += std::chrono::duration<Double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    const Double dNumBins = Double(xGetNumBins(symbols)) * CABAC_BENCHMARK_PASSES;
+    printf("  %-22s %8.1f Mbins/s %6.3f bits per bin\n", g_cabacStreamNames[streamType], dNumBins / dTime * 1e-6,
+           Double(cOutput.getNumberOfWrittenBits()) * CABAC_BENCHMARK_PASSES / dNumBins);
+  }
+#else
+  printf("  not supported with RExt__DECODER_DEBUG_BIT_STATISTICS, skipped\n");
+#endif
+}
+
+//! \}
@@ -0,0 +1,280 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TAppKernelTestRdCost.cpp
+    \brief    Kernel test application class: distortion functions of TComRdCost
+*/
+
+#include <cstdio>
+#include <vector>
+#include "TAppKernelTestTop.h"
+#include "TLibCommon/TComRdCost.h"
+
+//! \ingroup TAppKernelTest
+//! \{
+
+#if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+
+// ====================================================================================================================
+// Constants
+// ====================================================================================================================
+
+static const Int MAX_TEST_BIT_DEPTH = 12;             ///< largest internal bit depth accepted by the encoder
+
+static const Int ANY_WIDTH          = 0;
+
+static const Int BLOCK_MARGIN       = 8;              ///< the blocks start at a random offset up to this value
+static const Int ORG_STRIDE         = MAX_CU_SIZE + 2 * BLOCK_MARGIN;
+static const Int CUR_STRIDE         = MAX_CU_SIZE + 4 * BLOCK_MARGIN;
+static const Int MAX_SUB_SHIFT      = 4;              ///< largest vertical subsampling of TEncSearch
+
+static const Int MAX_REPORTED_MISMATCHES = 16;
+
+/// block widths of the general size functions, including widths that are not multiples of 8 (and of 4, which the
+/// SIMD functions pass to the C code where the C code supports them)
+static const Int g_anyWidths[]  = { 1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 14, 16, 20, 24, 28, 32, 36, 40, 44, 48, 52, 56, 60, 64 };
+static const Int g_anyHeights[] = { 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 28, 32, 48, 64 };
+
+struct DistortionFunctionTest
+{
+  DFunc        eDFunc;
+  const TChar* pName;
+  Int          iWidth;                                ///< block width, or ANY_WIDTH
+  Int          iWidthMultiple;                        ///< the widths of ANY_WIDTH are multiples of this value
+  Bool         bSubSampled;                           ///< the function uses DistParam::iSubShift
+  Bool         bEvenHeight;                           ///< the function needs even block heights
+};
+
+static const DistortionFunctionTest g_distortionFunctionTests[] =
+{
+  { DF_SSE,     "DF_SSE",     ANY_WIDTH, 1,  false, false },
+  { DF_SSE4,    "DF_SSE4",    4,         1,  false, false },
+  { DF_SSE8,    "DF_SSE8",    8,         1,  false, false },
+  { DF_SSE16,   "DF_SSE16",   16,        1,  false, false },
+  { DF_SSE32,   "DF_SSE32",   32,        1,  false, false },
+  { DF_SSE64,   "DF_SSE64",   64,        1,  false, false },
+  { DF_SSE16N,  "DF_SSE16N",  ANY_WIDTH, 16, false, false },
+
+  { DF_SAD,     "DF_SAD",     ANY_WIDTH, 4,  false, false },
+  { DF_SAD4,    "DF_SAD4",    4,         1,  true,  false },
+  { DF_SAD8,    "DF_SAD8",    8,         1,  true,  false },
+  { DF_SAD16,   "DF_SAD16",   16,        1,  true,  false },
+  { DF_SAD32,   "DF_SAD32",   32,        1,  true,  false },
+  { DF_SAD64,   "DF_SAD64",   64,        1,  true,  false },
+  { DF_SAD16N,  "DF_SAD16N",  ANY_WIDTH, 16, true,  false },
+  { DF_SAD12,   "DF_SAD12",   12,        1,  true,  false },
+  { DF_SAD24,   "DF_SAD24",   24,        1,  true,  false },
+  { DF_SAD48,   "DF_SAD48",   48,        1,  true,  false },
+
+  { DF_SADS,    "DF_SADS",    ANY_WIDTH, 4,  false, false },
+  { DF_SADS4,   "DF_SADS4",   4,         1,  true,  false },
+  { DF_SADS8,   "DF_SADS8",   8,         1,  true,  false },
+  { DF_SADS16,  "DF_SADS16",  16,        1,  true,  false },
+  { DF_SADS32,  "DF_SADS32",  32,        1,  true,  false },
+  { DF_SADS64,  "DF_SADS64",  64,        1,  true,  false },
+  { DF_SADS16N, "DF_SADS16N", ANY_WIDTH, 16, true,  false },
+  { DF_SADS12,  "DF_SADS12",  12,        1,  true,  false },
+  { DF_SADS24,  "DF_SADS24",  24,        1,  true,  false },
+  { DF_SADS48,  "DF_SADS48",  48,        1,  true,  false },
+
+  { DF_HADS,    "DF_HADS",    ANY_WIDTH, 2,  false, true  },
+  { DF_HADS4,   "DF_HADS4",   4,         1,  false, true  },
+  { DF_HADS8,   "DF_HADS8",   8,         1,  false, true  },
+  { DF_HADS16,  "DF_HADS16",  16,        1,  false, true  },
+  { DF_HADS32,  "DF_HADS32",  32,        1,  false, true  },
+  { DF_HADS64,  "DF_HADS64",  64,        1,  false, true  },
+  { DF_HADS16N, "DF_HADS16N", ANY_WIDTH, 16, false, true  },
+};
+
+static const Int NUM_DISTORTION_FUNCTION_TESTS = sizeof(g_distortionFunctionTests) / sizeof(g_distortionFunctionTests[0]);
+
+// ====================================================================================================================
+// Private function definitions
+// ====================================================================================================================
+
+static Void xGetTestWidths( const DistortionFunctionTest& rcTest, std::vector<Int>& widths )
+{
+  widths.clear();
+  if (rcTest.iWidth > 0)
+  {
+    widths.push_back(rcTest.iWidth);
+    return;
+  }
+  for (Int i = 0; i < Int(sizeof(g_anyWidths) / sizeof(g_anyWidths[0])); i++)
+  {
+    const Int iWidth = g_anyWidths[i];
+    if ((iWidth % rcTest.iWidthMultiple) == 0)
+    {
+      widths.push_back(iWidth);
+    }
+  }
+}
+
+#endif
+
+// ====================================================================================================================
+// Protected member functions
+// ====================================================================================================================
+
+/**
+ - every function of the table above is called with the same blocks for the C code and for each extension
+ - the blocks have random alignments and strides larger than their widths, and the samples use uniformly random values,
+   or only the minimum and maximum values, at every bit depth up to the largest one of the build
+ */
+UInt TAppKernelTestTop::xTestRdCost()
+{
+  printf("\nTComRdCost distortion functions\n");
+
+#if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  setMaxSimdExtension(SIMD_NONE);
+  TComRdCost cReference;
+  cReference.init();
+
+  std::vector<Pel> orgBuffer(ORG_STRIDE * (MAX_CU_SIZE + 2 * BLOCK_MARGIN));
+  std::vector<Pel> curBuffer(CUR_STRIDE * (MAX_CU_SIZE + 2 * BLOCK_MARGIN));
+  std::vector<Int> widths;
+
+  UInt uiNumMismatches = 0;
+
+  for (Int ext = SIMD_SSE41; ext <= SIMD_AVX2; ext++)
+  {
+    const SimdExtension simdExtension = SimdExtension(ext);
+    if (simdExtension > m_simdExtension)
+    {
+      printf("  %-8s not supported by the CPU, skipped\n", getSimdExtensionName(simdExtension));
+      continue;
+    }
+
+    setMaxSimdExtension(simdExtension);
+    TComRdCost cTest;
+    cTest.init();
+
+    UInt auiNumBlocks    [NUM_DISTORTION_FUNCTION_TESTS] = { 0 };
+    UInt auiNumMismatches[NUM_DISTORTION_FUNCTION_TESTS] = { 0 };
+
+    for (Int bitDepth = 8; bitDepth <= MAX_TEST_BIT_DEPTH; bitDepth++)
+    {
+      const Int maxValue = (1 << bitDepth) - 1;
+
+      for (Int iteration = 0; iteration < m_iterations; iteration++)
+      {
+        // 0: random samples, 1: random minimum and maximum samples, 2: largest differences
+        const Int pattern = iteration % 3;
+        xFillRandom(&orgBuffer[0], ORG_STRIDE, ORG_STRIDE, MAX_CU_SIZE + 2 * BLOCK_MARGIN, bitDepth, pattern != 0);
+        if (pattern == 2)
+        {
+          for (Int y = 0; y < MAX_CU_SIZE + 2 * BLOCK_MARGIN; y++)
+          {
+            for (Int x = 0; x < ORG_STRIDE; x++)
+            {
+              curBuffer[y * CUR_STRIDE + x] = maxValue - orgBuffer[y * ORG_STRIDE + x];
+            }
+          }
+        }
+        else
+        {
+          xFillRandom(&curBuffer[0], CUR_STRIDE, CUR_STRIDE, MAX_CU_SIZE + 2 * BLOCK_MARGIN, bitDepth, pattern != 0);
+        }
+
+        // the same offset in both blocks keeps the largest differences of the last pattern
+        const Int orgOffset = (xRandom() % BLOCK_MARGIN) * (ORG_STRIDE + 1);
+        const Int curOffset = pattern == 2 ? orgOffset / (ORG_STRIDE + 1) * (CUR_STRIDE + 1) : (xRandom() % BLOCK_MARGIN) * (CUR_STRIDE + 1);
+
+        for (Int t = 0; t < NUM_DISTORTION_FUNCTION_TESTS; t++)
+        {
+          const DistortionFunctionTest& rcTest = g_distortionFunctionTests[t];
+          xGetTestWidths(rcTest, widths);
+
+          for (Int w = 0; w < Int(widths.size()); w++)
+          {
+            for (Int h = 0; h < Int(sizeof(g_anyHeights) / sizeof(g_anyHeights[0])); h++)
+            {
+              const Int iHeight = g_anyHeights[h];
+              if (rcTest.bEvenHeight && (iHeight & 1) != 0)
+              {
+                continue;
+              }
+
+              for (Int iSubShift = 0; iSubShift <= (rcTest.bSubSampled ? MAX_SUB_SHIFT : 0); iSubShift++)
+              {
+                if ((iHeight & ((1 << iSubShift) - 1)) != 0)
+                {
+                  break;
+                }
+
+                DistParam cDistParam;
+                cDistParam.pOrg       = &orgBuffer[orgOffset];
+                cDistParam.pCur       = &curBuffer[curOffset];
+                cDistParam.iStrideOrg = ORG_STRIDE;
+                cDistParam.iStrideCur = CUR_STRIDE;
+                cDistParam.iCols      = widths[w];
+                cDistParam.iRows      = iHeight;
+                cDistParam.bitDepth   = bitDepth;
+                cDistParam.compIdx    = COMPONENT_Y;
+                cDistParam.iSubShift  = iSubShift;
+
+                const Distortion uiExpected = cReference.getDistortionFunction(rcTest.eDFunc)(&cDistParam);
+                const Distortion uiResult   = cTest.getDistortionFunction(rcTest.eDFunc)(&cDistParam);
+
+                auiNumBlocks[t]++;
+                if (uiResult != uiExpected)
+                {
+                  if (uiNumMismatches < MAX_REPORTED_MISMATCHES)
+                  {
+                    printf("  %-8s %-10s %2dx%-2d bit depth %2d subsampling %d: %llu instead of %llu\n", getSimdExtensionName(simdExtension), rcTest.pName,
+                           widths[w], iHeight, bitDepth, iSubShift, (unsigned long long)uiResult, (unsigned long long)uiExpected);
+                  }
+                  auiNumMismatches[t]++;
+                  uiNumMismatches++;
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+
+    for (Int t = 0; t < NUM_DISTORTION_FUNCTION_TESTS; t++)
+    {
+      printf("  %-8s %-10s %8u blocks %6u mismatches\n", getSimdExtensionName(simdExtension), g_distortionFunctionTests[t].pName, auiNumBlocks[t], auiNumMismatches[t]);
+    }
+  }
+
+  return uiNumMismatches;
+#else
+  printf("  the SIMD distortion functions are not used in this build, skipped\n");
+  return 0;
+#endif
+}
+
+//! \}
@@ -0,0 +1,142 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TAppKernelTestTop.cpp
+    \brief    Kernel test application class
+*/
+
+#include <cstdio>
+#include "TAppKernelTestTop.h"
+
+//! \ingroup TAppKernelTest
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+TAppKernelTestTop::TAppKernelTestTop()
+ : m_randomState(1)
+ , m_simdExtension(SIMD_NONE)
+{
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/**
+ - the kernels of every extension up to the one supported by the CPU are compared with the C code
+ - with Benchmark, the speed of the kernels of the enabled tests is measured afterwards
+ - the same seed gives the same test data on every platform
+ */
+UInt TAppKernelTestTop::test()
+{
+  m_randomState   = m_seed != 0 ? m_seed : 1;
+  m_simdExtension = getSimdExtension();
+
+  printf("SIMD extension supported by the CPU: %s\n", getSimdExtensionName(m_simdExtension));
+
+  UInt uiNumMismatches = 0;
+
+  if (m_testRdCost)
+  {
+    uiNumMismatches += xTestRdCost();
+  }
+  if (m_testTransform)
+  {
+    uiNumMismatches += xTestTransform();
+  }
+  if (m_testCabac)
+  {
+    uiNumMismatches += xTestCabac();
+  }
+
+  if (m_benchmark)
+  {
+    if (m_testTransform)
+    {
+      xBenchmarkTransform();
+    }
+    if (m_testCabac)
+    {
+      xBenchmarkCabac();
+    }
+  }
+
+  setMaxSimdExtension(SIMD_AVX2);
+
+  printf("\n%s: %u mismatches\n", uiNumMismatches == 0 ? "PASSED" : "FAILED", uiNumMismatches);
+  return uiNumMismatches;
+}
+
+const TChar* getSimdExtensionName( SimdExtension simdExtension )
+{
+  switch (simdExtension)
+  {
+    case SIMD_SSE41: return "SSE4.1";
+    case SIMD_AVX2:  return "AVX2";
+    default:         return "none";
+  }
+}
+
+// ====================================================================================================================
+// Protected member functions
+// ====================================================================================================================
+
+UInt TAppKernelTestTop::xRandom()
+{
+  // xorshift32
+  m_randomState ^= m_randomState << 13;
+  m_randomState ^= m_randomState >> 17;
+  m_randomState ^= m_randomState << 5;
+  return m_randomState;
+}
+
+/** fills a block with samples of the given bit depth
+ * \param bExtreme only the minimum and maximum sample values, which give the largest differences and sums
+ */
+Void TAppKernelTestTop::xFillRandom( Pel* piDst, Int iStride, Int iWidth, Int iHeight, Int bitDepth, Bool bExtreme )
+{
+  const Int maxValue = (1 << bitDepth) - 1;
+
+  for (Int y = 0; y < iHeight; y++, piDst += iStride)
+  {
+    for (Int x = 0; x < iWidth; x++)
+    {
+      piDst[x] = bExtreme ? ((xRandom() & 1) ? maxValue : 0) : Pel(xRandom() & maxValue);
+    }
+  }
+}
+
+//! \}
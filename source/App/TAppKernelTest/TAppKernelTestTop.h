@@ -0,0 +1,93 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TAppKernelTestTop.h
+    \brief    Kernel test application class (header)
+*/
+
+#ifndef __TAPPKERNELTESTTOP__
+#define __TAPPKERNELTESTTOP__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <vector>
+#include "TLibCommon/TComSimd.h"
+#include "TAppKernelTestCfg.h"
+
+//! \ingroup TAppKernelTest
+//! \{
+
+struct CabacSymbol;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// kernel test application class: compares the SIMD kernels of each extension supported by the CPU with the C code
+class TAppKernelTestTop : public TAppKernelTestCfg
+{
+private:
+  UInt          m_randomState;                        ///< state of the random number generator
+  SimdExtension m_simdExtension;                      ///< most capable extension supported by the CPU
+
+public:
+  TAppKernelTestTop();
+  virtual ~TAppKernelTestTop() {}
+
+  UInt  test();                                       ///< runs the enabled tests, returns the number of mismatches
+
+protected:
+  UInt  xRandom();                                    ///< next pseudo-random number, the same on every platform
+  Void  xFillRandom( Pel* piDst, Int iStride, Int iWidth, Int iHeight, Int bitDepth, Bool bExtreme );
+
+  // TComRdCost distortion functions (TAppKernelTestRdCost.cpp)
+  UInt  xTestRdCost();
+
+  // TComTrQuant transforms (TAppKernelTestTransform.cpp)
+  UInt  xTestTransform();
+  Void  xBenchmarkTransform();
+
+  // TDecBinCABAC bin decoding (TAppKernelTestCabac.cpp)
+  UInt  xTestCabac();
+  Void  xBenchmarkCabac();
+  Void  xGenerateCabacSymbols( Int streamType, Int numSymbols, std::vector<CabacSymbol>& symbols, std::vector<Int>& initValues );
+};
+
+/// name of the extension for the output
+const TChar* getSimdExtensionName( SimdExtension simdExtension );
+
+//! \}
+
+#endif // __TAPPKERNELTESTTOP__
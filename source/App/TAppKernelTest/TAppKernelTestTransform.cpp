@@ -0,0 +1,300 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TAppKernelTestTransform.cpp
+    \brief    Kernel test application class: transforms of TComTrQuant
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include "TAppKernelTestTop.h"
+#include "TLibCommon/TComTrQuant.h"
+
+//! \ingroup TAppKernelTest
+//! \{
+
+#if VECTOR_CODING__TRANSFORM && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+
+// ====================================================================================================================
+// Constants
+// ====================================================================================================================
+
+static const Int MAX_TEST_BIT_DEPTH       = 12;       ///< largest internal bit depth accepted by the encoder
+static const Int NUM_TRANSFORM_SIZES      = 4;        ///< 4, 8, 16 and 32
+static const Int MAX_REPORTED_MISMATCHES  = 16;
+static const Int BENCHMARK_SAMPLES        = 1 << 23;  ///< number of samples transformed for each size and extension
+
+// ====================================================================================================================
+// Private function definitions
+// ====================================================================================================================
+
+static Bool xCompareBlocks( const TCoeff* piExpected, const TCoeff* piResult, Int iNumSamples, Int& riPosition )
+{
+  for (riPosition = 0; riPosition < iNumSamples; riPosition++)
+  {
+    if (piExpected[riPosition] != piResult[riPosition])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+#endif
+
+// ====================================================================================================================
+// Protected member functions
+// ====================================================================================================================
+
+/**
+ - xTrMxN and xITrMxN are called for every combination of the transform sizes, and with the DST for 4x4, once with the
+   C code (partialButterfly*, partialButterflyInverse*, fastForwardDst and fastInverseDst) and once with each extension
+ - the residuals are random, or only the minimum and maximum values, or small values; the coefficients are random over
+   the whole dynamic range, or only its limits, or sparse small values
+ - every bit depth up to the largest one of the build is tested, with the dynamic range of the coefficients with and
+   without extended precision processing
+ */
+UInt TAppKernelTestTop::xTestTransform()
+{
+  printf("\nTComTrQuant transforms\n");
+
+#if VECTOR_CODING__TRANSFORM && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  TCoeff aiResidual      [MAX_TU_SIZE * MAX_TU_SIZE];
+  TCoeff aiCoefficients  [MAX_TU_SIZE * MAX_TU_SIZE];
+  TCoeff aiInput         [MAX_TU_SIZE * MAX_TU_SIZE];
+  TCoeff aiExpected      [MAX_TU_SIZE * MAX_TU_SIZE];
+  TCoeff aiResult        [MAX_TU_SIZE * MAX_TU_SIZE];
+
+  UInt uiNumMismatches = 0;
+
+  for (Int ext = SIMD_SSE41; ext <= SIMD_AVX2; ext++)
+  {
+    const SimdExtension simdExtension = SimdExtension(ext);
+    if (simdExtension > m_simdExtension)
+    {
+      printf("  %-8s not supported by the CPU, skipped\n", getSimdExtensionName(simdExtension));
+      continue;
+    }
+
+    UInt auiNumBlocks    [NUM_TRANSFORM_SIZES][NUM_TRANSFORM_SIZES] = { { 0 } };
+    UInt auiNumMismatches[NUM_TRANSFORM_SIZES][NUM_TRANSFORM_SIZES] = { { 0 } };
+
+    for (Int bitDepth = 8; bitDepth <= MAX_TEST_BIT_DEPTH; bitDepth++)
+    {
+      const Int maxResidual = (1 << bitDepth) - 1;
+
+      for (Int extendedPrecision = 0; extendedPrecision < 2; extendedPrecision++)
+      {
+        const Int maxLog2TrDynamicRange = extendedPrecision ? std::max<Int>(15, bitDepth + 6) : 15;
+        if (extendedPrecision && maxLog2TrDynamicRange == 15)
+        {
+          continue;
+        }
+        const TCoeff coeffMinimum = -(1 << maxLog2TrDynamicRange);
+        const TCoeff coeffMaximum =  (1 << maxLog2TrDynamicRange) - 1;
+
+        for (Int iteration = 0; iteration < m_iterations; iteration++)
+        {
+          const Int pattern = iteration % 3;
+          for (Int n = 0; n < MAX_TU_SIZE * MAX_TU_SIZE; n++)
+          {
+            switch (pattern)
+            {
+              case 0:
+                aiResidual    [n] = TCoeff(xRandom() % (2 * maxResidual + 1)) - maxResidual;
+                aiCoefficients[n] = TCoeff(xRandom() & (2 * coeffMaximum + 1)) + coeffMinimum;
+                break;
+              case 1:
+                aiResidual    [n] = (xRandom() & 1) ? maxResidual : -maxResidual;
+                aiCoefficients[n] = (xRandom() & 1) ? coeffMaximum : coeffMinimum;
+                break;
+              default:
+                aiResidual    [n] = TCoeff(xRandom() % 33) - 16;
+                aiCoefficients[n] = (xRandom() & 7) == 0 ? TCoeff(xRandom() % 513) - 256 : 0;
+                break;
+            }
+          }
+
+          for (Int log2Width = 0; log2Width < NUM_TRANSFORM_SIZES; log2Width++)
+          {
+            for (Int log2Height = 0; log2Height < NUM_TRANSFORM_SIZES; log2Height++)
+            {
+              const Int iWidth      = 4 << log2Width;
+              const Int iHeight     = 4 << log2Height;
+              const Int iNumSamples = iWidth * iHeight;
+
+              for (Int dst = 0; dst < (iWidth == 4 && iHeight == 4 ? 2 : 1); dst++)
+              {
+                const Bool useDST = dst != 0;
+                Int iPosition;
+
+                // forward transform
+                setMaxSimdExtension(SIMD_NONE);
+                memcpy(aiInput, aiResidual, iNumSamples * sizeof(TCoeff));
+                xTrMxN(bitDepth, aiInput, aiExpected, iWidth, iHeight, useDST, maxLog2TrDynamicRange);
+
+                setMaxSimdExtension(simdExtension);
+                memcpy(aiInput, aiResidual, iNumSamples * sizeof(TCoeff));
+                xTrMxN(bitDepth, aiInput, aiResult, iWidth, iHeight, useDST, maxLog2TrDynamicRange);
+
+                auiNumBlocks[log2Width][log2Height]++;
+                if (!xCompareBlocks(aiExpected, aiResult, iNumSamples, iPosition))
+                {
+                  if (uiNumMismatches < MAX_REPORTED_MISMATCHES)
+                  {
+                    printf("  %-8s forward %s %2dx%-2d bit depth %2d dynamic range %2d: coefficient %d is %d instead of %d\n", getSimdExtensionName(simdExtension),
+                           useDST ? "DST" : "DCT", iWidth, iHeight, bitDepth, maxLog2TrDynamicRange, iPosition, aiResult[iPosition], aiExpected[iPosition]);
+                  }
+                  auiNumMismatches[log2Width][log2Height]++;
+                  uiNumMismatches++;
+                }
+
+                // inverse transform
+                setMaxSimdExtension(SIMD_NONE);
+                memcpy(aiInput, aiCoefficients, iNumSamples * sizeof(TCoeff));
+                xITrMxN(bitDepth, aiInput, aiExpected, iWidth, iHeight, useDST, maxLog2TrDynamicRange);
+
+                setMaxSimdExtension(simdExtension);
+                memcpy(aiInput, aiCoefficients, iNumSamples * sizeof(TCoeff));
+                xITrMxN(bitDepth, aiInput, aiResult, iWidth, iHeight, useDST, maxLog2TrDynamicRange);
+
+                auiNumBlocks[log2Width][log2Height]++;
+                if (!xCompareBlocks(aiExpected, aiResult, iNumSamples, iPosition))
+                {
+                  if (uiNumMismatches < MAX_REPORTED_MISMATCHES)
+                  {
+                    printf("  %-8s inverse %s %2dx%-2d bit depth %2d dynamic range %2d: sample %d is %d instead of %d\n", getSimdExtensionName(simdExtension),
+                           useDST ? "DST" : "DCT", iWidth, iHeight, bitDepth, maxLog2TrDynamicRange, iPosition, aiResult[iPosition], aiExpected[iPosition]);
+                  }
+                  auiNumMismatches[log2Width][log2Height]++;
+                  uiNumMismatches++;
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+
+    for (Int log2Width = 0; log2Width < NUM_TRANSFORM_SIZES; log2Width++)
+    {
+      for (Int log2Height = 0; log2Height < NUM_TRANSFORM_SIZES; log2Height++)
+      {
+        printf("  %-8s %2dx%-2d %8u blocks %6u mismatches\n", getSimdExtensionName(simdExtension), 4 << log2Width, 4 << log2Height,
+               auiNumBlocks[log2Width][log2Height], auiNumMismatches[log2Width][log2Height]);
+      }
+    }
+  }
+
+  return uiNumMismatches;
+#else
+  printf("  the SIMD transforms are not used in this build, skipped\n");
+  return 0;
+#endif
+}
+
+/** measures the time of xTrMxN and xITrMxN for the square transform sizes, with the C code and with each extension.
+ * The residuals are random 8-bit values, and the coefficients are their transforms.
+ */
+Void TAppKernelTestTop::xBenchmarkTransform()
+{
+  printf("\nTComTrQuant transform speed (ns per block, speed-up over the C code)\n");
+
+#if VECTOR_CODING__TRANSFORM && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  const Int bitDepth              = 8;
+  const Int maxLog2TrDynamicRange = 15;
+
+  TCoeff aiResidual    [MAX_TU_SIZE * MAX_TU_SIZE];
+  TCoeff aiCoefficients[MAX_TU_SIZE * MAX_TU_SIZE];
+  TCoeff aiOutput      [MAX_TU_SIZE * MAX_TU_SIZE];
+
+  printf("  %-13s", "");
+  for (Int ext = SIMD_NONE; ext <= m_simdExtension; ext++)
+  {
+    printf("  %10s %6s", ext == SIMD_NONE ? "C" : getSimdExtensionName(SimdExtension(ext)), "");
+  }
+  printf("\n");
+
+  for (Int size = 0; size <= NUM_TRANSFORM_SIZES; size++)
+  {
+    // the first row is the DST of the 4x4 luma intra blocks
+    const Bool useDST = size == 0;
+    const Int  iSize  = size == 0 ? 4 : 2 << size;
+    const Int  iCalls = BENCHMARK_SAMPLES / (iSize * iSize);
+
+    for (Int n = 0; n < iSize * iSize; n++)
+    {
+      aiResidual[n] = TCoeff(xRandom() % 511) - 255;
+    }
+    setMaxSimdExtension(SIMD_NONE);
+    xTrMxN(bitDepth, aiResidual, aiCoefficients, iSize, iSize, useDST, maxLog2TrDynamicRange);
+
+    for (Int inverse = 0; inverse < 2; inverse++)
+    {
+      printf("  %s %s %2dx%-2d", inverse ? "inv" : "fwd", useDST ? "DST" : "DCT", iSize, iSize);
+
+      Double dReferenceTime = 0;
+      for (Int ext = SIMD_NONE; ext <= m_simdExtension; ext++)
+      {
+        setMaxSimdExtension(SimdExtension(ext));
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (Int i = 0; i < iCalls; i++)
+        {
+          if (inverse)
+          {
+            xITrMxN(bitDepth, aiCoefficients, aiOutput, iSize, iSize, useDST, maxLog2TrDynamicRange);
+          }
+          else
+          {
+            xTrMxN(bitDepth, aiResidual, aiOutput, iSize, iSize, useDST, maxLog2TrDynamicRange);
+          }
+        }
+        const Double dTime = std::chrono::duration<Double, std::nano>(std::chrono::steady_clock::now() - start).count() / iCalls;
+
+        if (ext == SIMD_NONE)
+        {
+          dReferenceTime = dTime;
+        }
+        printf("  %10.1f %5.2fx", dTime, dReferenceTime / dTime);
+      }
+      printf("\n");
+    }
+  }
+#else
+  printf("  the SIMD transforms are not used in this build, skipped\n");
+#endif
+}
+
+//! \}
@@ -40,6 +40,13 @@
 #include "TComBitStream.h"
 #include <string.h>
 #include <memory.h>
+#if VECTOR_CODING__EMULATION_PREVENTION
+#include "TComSimd.h"
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 using namespace std;
 
@@ -92,11 +99,13 @@ Void TComInputBitstream::resetToStart()
 
 UChar* TComOutputBitstream::getByteStream() const
 {
+  xFlushBytes();
   return (UChar*) &m_fifo.front();
 }
 
 UInt TComOutputBitstream::getByteStreamLength()
 {
+  xFlushBytes();
   return UInt(m_fifo.size());
 }
 
@@ -112,43 +121,19 @@ Void TComOutputBitstream::write   ( UInt uiBits, UInt uiNumberOfBits )
   assert( uiNumberOfBits <= 32 );
   assert( uiNumberOfBits == 32 || (uiBits & (~0 << uiNumberOfBits)) == 0 );
 
-  /* any modulo 8 remainder of num_total_bits cannot be written this time,
-   * and will be held until next time. */
-  UInt num_total_bits = uiNumberOfBits + m_num_held_bits;
-  UInt next_num_held_bits = num_total_bits % 8;
+  /* fewer than 32 bits are held between calls, so the accumulator has room
+   * for the new bits. Once it holds a whole 32-bit word, the word is appended
+   * to the FIFO in one go. */
+  m_held_bits = (m_held_bits << uiNumberOfBits) | uiBits;
+  m_num_held_bits += uiNumberOfBits;
 
-  /* form a byte aligned word (write_bits), by concatenating any held bits
-   * with the new bits, discarding the bits that will form the next_held_bits.
-   * eg: H = held bits, V = n new bits        /---- next_held_bits
-   * len(H)=7, len(V)=1: ... ---- HHHH HHHV . 0000 0000, next_num_held_bits=0
-   * len(H)=7, len(V)=2: ... ---- HHHH HHHV . V000 0000, next_num_held_bits=1
-   * if total_bits < 8, the value of v_ is not used */
-  UChar next_held_bits = uiBits << (8 - next_num_held_bits);
-
-  if (!(num_total_bits >> 3))
-  {
-    /* insufficient bits accumulated to write out, append new_held_bits to
-     * current held_bits */
-    /* NB, this requires that v only contains 0 in bit positions {31..n} */
-    m_held_bits |= next_held_bits;
-    m_num_held_bits = next_num_held_bits;
-    return;
-  }
-
-  /* topword serves to justify held_bits to align with the msb of uiBits */
-  UInt topword = (uiNumberOfBits - next_num_held_bits) & ~((1 << 3) -1);
-  UInt write_bits = (m_held_bits << topword) | (uiBits >> next_num_held_bits);
-
-  switch (num_total_bits >> 3)
+  if (m_num_held_bits >= 32)
   {
-  case 4: m_fifo.push_back(write_bits >> 24);
-  case 3: m_fifo.push_back(write_bits >> 16);
-  case 2: m_fifo.push_back(write_bits >> 8);
-  case 1: m_fifo.push_back(write_bits);
+    m_num_held_bits -= 32;
+    const UInt word = UInt(m_held_bits >> m_num_held_bits);
+    const uint8_t bytes[4] = { uint8_t(word >> 24), uint8_t(word >> 16), uint8_t(word >> 8), uint8_t(word) };
+    m_fifo.insert(m_fifo.end(), bytes, bytes + 4);
   }
-
-  m_held_bits = next_held_bits;
-  m_num_held_bits = next_num_held_bits;
 }
 
 Void TComOutputBitstream::writeAlignOne()
@@ -160,13 +145,7 @@ Void TComOutputBitstream::writeAlignOne()
 
 Void TComOutputBitstream::writeAlignZero()
 {
-  if (0 == m_num_held_bits)
-  {
-    return;
-  }
-  m_fifo.push_back(m_held_bits);
-  m_held_bits = 0;
-  m_num_held_bits = 0;
+  write(0, getNumBitsUntilByteAligned());
 }
 
 /**
@@ -179,9 +158,24 @@ Void   TComOutputBitstream::addSubstream( TComOutputBitstream* pcSubstream )
   UInt uiNumBits = pcSubstream->getNumberOfWrittenBits();
 
   const vector<uint8_t>& rbsp = pcSubstream->getFIFO();
-  for (vector<uint8_t>::const_iterator it = rbsp.begin(); it != rbsp.end();)
+  if (getNumBitsUntilByteAligned() == 0)
   {
-    write(*it++, 8);
+    // the bytes of a substream added at a byte boundary are appended as they are
+    xFlushBytes();
+    m_fifo.insert(m_fifo.end(), rbsp.begin(), rbsp.end());
+  }
+  else
+  {
+    const uint8_t*       it  = rbsp.empty() ? NULL : &rbsp[0];
+    const uint8_t* const end = it + rbsp.size();
+    for (; end - it >= 4; it += 4)
+    {
+      write((UInt(it[0]) << 24) | (UInt(it[1]) << 16) | (UInt(it[2]) << 8) | UInt(it[3]), 32);
+    }
+    for (; it != end; it++)
+    {
+      write(*it, 8);
+    }
   }
   if (uiNumBits&0x7)
   {
@@ -199,34 +193,97 @@ Int TComOutputBitstream::countStartCodeEmulations()
 {
   UInt cnt = 0;
   vector<uint8_t>& rbsp   = getFIFO();
-  for (vector<uint8_t>::iterator it = rbsp.begin(); it != rbsp.end();)
+  if (rbsp.empty())
   {
-    vector<uint8_t>::iterator found = it;
-    do
-    {
-      // find the next emulated 00 00 {00,01,02,03}
-      // NB, end()-1, prevents finding a trailing two byte sequence
-      found = search_n(found, rbsp.end()-1, 2, 0);
-      found++;
-      // if not found, found == end, otherwise found = second zero byte
-      if (found == rbsp.end())
-      {
-        break;
-      }
-      if (*(++found) <= 3)
-      {
-        break;
-      }
-    } while (true);
-    it = found;
-    if (found != rbsp.end())
+    return 0;
+  }
+  const uint8_t* const end = &rbsp[0] + rbsp.size();
+  const uint8_t*       it  = &rbsp[0];
+  // find the emulated 00 00 {00,01,02,03}
+  // NB, a trailing two byte sequence is not counted
+  while (end - (it = findZeroBytePair(it, end)) > 2)
+  {
+    if (it[2] <= 3)
     {
       cnt++;
+      it += 2;
+    }
+    else
+    {
+      it += 3;
     }
   }
   return cnt;
 }
 
+static inline UInt64 xLoadBigEndian64(const uint8_t* p)
+{
+  return (UInt64(p[0]) << 56) | (UInt64(p[1]) << 48) | (UInt64(p[2]) << 40) | (UInt64(p[3]) << 32)
+       | (UInt64(p[4]) << 24) | (UInt64(p[5]) << 16) | (UInt64(p[6]) <<  8) |  UInt64(p[7]);
+}
+
+static inline UInt xLeadingZeros(UInt value)
+{
+  assert(value != 0);
+#if defined(_MSC_VER)
+  unsigned long idx;
+  _BitScanReverse(&idx, value);
+  return 31 - UInt(idx);
+#else
+  return UInt(__builtin_clz(value));
+#endif
+}
+
+Void TComInputBitstream::xRefill()
+{
+  /* whole bytes are appended below the held bits until no further byte fits.
+   * Only called when fewer than 32 bits are held, so at least 4 bytes fit. */
+  const UInt numBytes = (64 - m_num_held_bits) >> 3;
+  if (m_fifo_idx + 8 <= m_fifo.size())
+  {
+    const UInt64 word = xLoadBigEndian64(&m_fifo[m_fifo_idx]);
+    m_held_bits = (numBytes == 8) ? word : ((m_held_bits << (numBytes * 8)) | (word >> (64 - numBytes * 8)));
+    m_fifo_idx += numBytes;
+    m_num_held_bits += numBytes * 8;
+  }
+  else
+  {
+    for (UInt i = 0; i < numBytes && m_fifo_idx < m_fifo.size(); i++)
+    {
+      m_held_bits = (m_held_bits << 8) | m_fifo[m_fifo_idx++];
+      m_num_held_bits += 8;
+    }
+  }
+}
+
+Void TComInputBitstream::xReleaseBytes()
+{
+  const UInt numBytes = m_num_held_bits >> 3;
+  m_fifo_idx -= numBytes;
+  m_num_held_bits &= 7;
+  m_held_bits = (m_num_held_bits != 0) ? (m_held_bits >> (numBytes * 8)) : 0;
+}
+
+/**
+ * readByte() when bits are held. If the held bits are byte aligned, the next
+ * byte is held. Otherwise, like for a bitstream that holds the rest of a
+ * partially read byte, the byte after it is read and the held bits are kept.
+ */
+Void TComInputBitstream::xReadHeldByte( UInt &ruiBits )
+{
+  if ((m_num_held_bits & 7) == 0)
+  {
+    m_num_held_bits -= 8;
+    ruiBits = UInt(m_held_bits >> m_num_held_bits) & 0xff;
+  }
+  else
+  {
+    xReleaseBytes();
+    assert(m_fifo_idx < m_fifo.size());
+    ruiBits = m_fifo[m_fifo_idx++];
+  }
+}
+
 /**
  * read uiNumberOfBits from bitstream without updating the bitstream
  * state, storing the result in ruiBits.
@@ -237,17 +294,22 @@ Int TComOutputBitstream::countStartCodeEmulations()
  */
 Void TComInputBitstream::pseudoRead ( UInt uiNumberOfBits, UInt& ruiBits )
 {
-  UInt saved_num_held_bits = m_num_held_bits;
-  UChar saved_held_bits = m_held_bits;
-  UInt saved_fifo_idx = m_fifo_idx;
+  assert( uiNumberOfBits <= 32 );
 
-  UInt num_bits_to_read = min(uiNumberOfBits, getNumBitsLeft());
-  read(num_bits_to_read, ruiBits);
-  ruiBits <<= (uiNumberOfBits - num_bits_to_read);
+  /* loading bytes into the held bits does not change the read position */
+  if (uiNumberOfBits > m_num_held_bits)
+  {
+    xRefill();
+  }
 
-  m_fifo_idx = saved_fifo_idx;
-  m_held_bits = saved_held_bits;
-  m_num_held_bits = saved_num_held_bits;
+  if (uiNumberOfBits <= m_num_held_bits)
+  {
+    ruiBits = UInt(m_held_bits >> (m_num_held_bits - uiNumberOfBits)) & UInt((UInt64(1) << uiNumberOfBits) - 1);
+  }
+  else
+  {
+    ruiBits = (UInt(m_held_bits) & UInt((UInt64(1) << m_num_held_bits) - 1)) << (uiNumberOfBits - m_num_held_bits);
+  }
 }
 
 
@@ -257,60 +319,67 @@ Void TComInputBitstream::read (UInt uiNumberOfBits, UInt& ruiBits)
 
   m_numBitsRead += uiNumberOfBits;
 
-  /* NB, bits are extracted from the MSB of each byte. */
-  UInt retval = 0;
-  if (uiNumberOfBits <= m_num_held_bits)
+  /* NB, bits are extracted from the MSB of each byte.
+   * Fewer bits are held than requested only after the held bits have been
+   * read out, so refilling always leaves room for at least 4 bytes. */
+  if (uiNumberOfBits > m_num_held_bits)
   {
-    /* n=1, len(H)=7:   -VHH HHHH, shift_down=6, mask=0xfe
-     * n=3, len(H)=7:   -VVV HHHH, shift_down=4, mask=0xf8
-     */
-    retval = m_held_bits >> (m_num_held_bits - uiNumberOfBits);
-    retval &= ~(0xff << uiNumberOfBits);
-    m_num_held_bits -= uiNumberOfBits;
-    ruiBits = retval;
-    return;
+    xRefill();
+    if (uiNumberOfBits > m_num_held_bits)
+    {
+      /* reading beyond the end of the bitstream: the missing bits are zero */
+      assert(uiNumberOfBits <= m_num_held_bits);
+      const UInt numMissingBits = uiNumberOfBits - m_num_held_bits;
+      m_held_bits <<= numMissingBits;
+      m_num_held_bits += numMissingBits;
+    }
   }
 
-  /* all num_held_bits will go into retval
-   *   => need to mask leftover bits from previous extractions
-   *   => align retval with top of extracted word */
-  /* n=5, len(H)=3: ---- -VVV, mask=0x07, shift_up=5-3=2,
-   * n=9, len(H)=3: ---- -VVV, mask=0x07, shift_up=9-3=6 */
-  uiNumberOfBits -= m_num_held_bits;
-  retval = m_held_bits & ~(0xff << m_num_held_bits);
-  retval <<= uiNumberOfBits;
-
-  /* number of whole bytes that need to be loaded to form retval */
-  /* n=32, len(H)=0, load 4bytes, shift_down=0
-   * n=32, len(H)=1, load 4bytes, shift_down=1
-   * n=31, len(H)=1, load 4bytes, shift_down=1+1
-   * n=8,  len(H)=0, load 1byte,  shift_down=0
-   * n=8,  len(H)=3, load 1byte,  shift_down=3
-   * n=5,  len(H)=1, load 1byte,  shift_down=1+3
-   */
-  UInt aligned_word = 0;
-  UInt num_bytes_to_load = (uiNumberOfBits - 1) >> 3;
-  assert(m_fifo_idx + num_bytes_to_load < m_fifo.size());
-
-  switch (num_bytes_to_load)
-  {
-  case 3: aligned_word  = m_fifo[m_fifo_idx++] << 24;
-  case 2: aligned_word |= m_fifo[m_fifo_idx++] << 16;
-  case 1: aligned_word |= m_fifo[m_fifo_idx++] <<  8;
-  case 0: aligned_word |= m_fifo[m_fifo_idx++];
-  }
+  m_num_held_bits -= uiNumberOfBits;
+  ruiBits = UInt(m_held_bits >> m_num_held_bits) & UInt((UInt64(1) << uiNumberOfBits) - 1);
+}
 
-  /* resolve remainder bits */
-  UInt next_num_held_bits = (32 - uiNumberOfBits) % 8;
+/**
+ * move the read position of a byte aligned bitstream back by uiNumberOfBytes,
+ * so that bytes that were read ahead are read again.
+ */
+Void TComInputBitstream::rewindBytes( UInt uiNumberOfBytes )
+{
+  xReleaseBytes();
+  assert( m_num_held_bits == 0 );
+  assert( uiNumberOfBytes <= m_fifo_idx );
 
-  /* copy required part of aligned_word into retval */
-  retval |= aligned_word >> next_num_held_bits;
+  m_fifo_idx    -= uiNumberOfBytes;
+  m_numBitsRead -= 8 * uiNumberOfBytes;
+}
 
-  /* store held bits */
-  m_num_held_bits = next_num_held_bits;
-  m_held_bits = aligned_word;
+/**
+ * read an unsigned Exp-Golomb code, ue(v).
+ *
+ * The prefix is located by counting the leading zeros of the next 32 bits,
+ * so codes of up to 31 bits are read in one step.
+ */
+UInt TComInputBitstream::readUvlc()
+{
+  UInt uiBits;
+  pseudoRead(32, uiBits);
+  if (uiBits >= 0x00010000)
+  {
+    const UInt uiLength = xLeadingZeros(uiBits);
+    read(2 * uiLength + 1, uiBits);
+    return uiBits - 1;
+  }
 
-  ruiBits = retval;
+  UInt uiLength = 0;
+  UInt uiCode = 0;
+  read(1, uiCode);
+  while (!uiCode)
+  {
+    read(1, uiCode);
+    uiLength++;
+  }
+  read(uiLength, uiBits);
+  return uiBits + (1 << uiLength) - 1;
 }
 
 /**
@@ -322,6 +391,8 @@ Void TComOutputBitstream::insertAt(const TComOutputBitstream& src, UInt pos)
   UInt src_bits = src.getNumberOfWrittenBits();
   assert(0 == src_bits % 8);
 
+  src.xFlushBytes();
+  xFlushBytes();
   vector<uint8_t>::iterator at = m_fifo.begin() + pos;
   m_fifo.insert(at, src.m_fifo.begin(), src.m_fifo.end());
 }
@@ -363,6 +434,8 @@ TComInputBitstream *TComInputBitstream::extractSubstream( UInt uiNumBits )
   std::vector<uint8_t> &buf = pResult->getFifo();
   buf.reserve((uiNumBits+7)>>3);
 
+  xReleaseBytes();
+
   if (m_num_held_bits == 0)
   {
     std::size_t currentOutputBufferSize=buf.size();
@@ -409,4 +482,89 @@ UInt TComInputBitstream::readByteAlignment()
   return numBits+1;
 }
 
+// ====================================================================================================================
+// Search for start code emulations
+// ====================================================================================================================
+
+static const uint8_t* xFindZeroBytePairScalar(const uint8_t* p, const uint8_t* end)
+{
+  for (; end - p >= 2; p++)
+  {
+    if (p[1] != 0)
+    {
+      p++;                    // neither p nor p+1 can start a pair
+    }
+    else if (p[0] == 0)
+    {
+      return p;
+    }
+  }
+  return end;
+}
+
+#if VECTOR_CODING__EMULATION_PREVENTION
+static inline UInt xFirstSetBit(UInt mask)
+{
+#if defined(_MSC_VER)
+  unsigned long idx;
+  _BitScanForward(&idx, mask);
+  return UInt(idx);
+#else
+  return UInt(__builtin_ctz(mask));
+#endif
+}
+
+/// tests 16 positions at a time, comparing the chunk with the chunk one byte further on
+SIMD_TARGET_SSE41
+static const uint8_t* xFindZeroBytePairSse41(const uint8_t* p, const uint8_t* end)
+{
+  const __m128i zero = _mm_setzero_si128();
+  for (; end - p >= 17; p += 16)
+  {
+    const __m128i first  = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)p),       zero);
+    const __m128i second = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(p + 1)), zero);
+    const UInt    mask   = (UInt)_mm_movemask_epi8(_mm_and_si128(first, second));
+    if (mask)
+    {
+      return p + xFirstSetBit(mask);
+    }
+  }
+  return xFindZeroBytePairScalar(p, end);
+}
+
+/// tests 32 positions at a time
+SIMD_TARGET_AVX2
+static const uint8_t* xFindZeroBytePairAvx2(const uint8_t* p, const uint8_t* end)
+{
+  const __m256i zero = _mm256_setzero_si256();
+  for (; end - p >= 33; p += 32)
+  {
+    const __m256i first  = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)p),       zero);
+    const __m256i second = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(p + 1)), zero);
+    const UInt    mask   = (UInt)_mm256_movemask_epi8(_mm256_and_si256(first, second));
+    if (mask)
+    {
+      return p + xFirstSetBit(mask);
+    }
+  }
+  return xFindZeroBytePairSse41(p, end);
+}
+#endif
+
+const uint8_t* findZeroBytePair(const uint8_t* begin, const uint8_t* end)
+{
+#if VECTOR_CODING__EMULATION_PREVENTION
+  static const SimdExtension simdExtension = getSimdExtension();
+  if (simdExtension >= SIMD_AVX2)
+  {
+    return xFindZeroBytePairAvx2(begin, end);
+  }
+  if (simdExtension >= SIMD_SSE41)
+  {
+    return xFindZeroBytePairSse41(begin, end);
+  }
+#endif
+  return xFindZeroBytePairScalar(begin, end);
+}
+
 //! \}
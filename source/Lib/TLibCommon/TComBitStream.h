@@ -79,12 +79,26 @@ class TComOutputBitstream : public TComBitIf
    *  - fifo.clear() to empty the FIFO
    *  - &fifo.front() to get a pointer to the data array.
    *    NB, this pointer is only valid until the next push_back()/clear()
+   * write() only moves whole 32-bit words into the FIFO. The whole bytes still
+   * held are moved by xFlushBytes(), which every accessor of the FIFO calls
+   * first, so the FIFO and the held bits are mutable.
    */
-  std::vector<uint8_t> m_fifo;
+  mutable std::vector<uint8_t> m_fifo;
+
+  mutable UInt   m_num_held_bits; /// number of bits not flushed to bytestream, less than 32 between calls.
+  mutable UInt64 m_held_bits;     /// the bits held and not flushed to bytestream, in the m_num_held_bits lsbs.
+                                  /// the bits above them are undefined.
+
+  /** move the whole bytes held to the FIFO, leaving fewer than 8 bits held */
+  Void xFlushBytes() const
+  {
+    while (m_num_held_bits >= 8)
+    {
+      m_num_held_bits -= 8;
+      m_fifo.push_back(UChar(m_held_bits >> m_num_held_bits));
+    }
+  }
 
-  UInt m_num_held_bits; /// number of bits not flushed to bytestream.
-  UChar m_held_bits; /// the bits held and not flushed to bytestream.
-                             /// this value is always msb-aligned, bigendian.
 public:
   // create / destroy
   TComOutputBitstream();
@@ -137,18 +151,25 @@ public:
    */
   UInt getNumberOfWrittenBits() const { return UInt(m_fifo.size()) * 8 + m_num_held_bits; }
 
+  /**
+   * Reserve space for numBytes bytes, so that the bitstream can grow to that
+   * size without reallocation.
+   */
+  Void reserve(UInt numBytes) { m_fifo.reserve(numBytes); }
+
   Void insertAt(const TComOutputBitstream& src, UInt pos);
 
   /**
    * Return a reference to the internal fifo
    */
-  std::vector<uint8_t>& getFIFO() { return m_fifo; }
+  std::vector<uint8_t>& getFIFO() { xFlushBytes(); return m_fifo; }
 
-  UChar getHeldBits  ()          { return m_held_bits;          }
+  /** Return the bits held and not flushed to bytestream, msb-aligned */
+  UChar getHeldBits  ()          { xFlushBytes(); return UChar(m_held_bits << (8 - m_num_held_bits)); }
 
   //TComOutputBitstream& operator= (const TComOutputBitstream& src);
   /** Return a reference to the internal fifo */
-  const std::vector<uint8_t>& getFIFO() const { return m_fifo; }
+  const std::vector<uint8_t>& getFIFO() const { xFlushBytes(); return m_fifo; }
 
   Void          addSubstream    ( TComOutputBitstream* pcSubstream );
   Void writeByteAlignment();
@@ -169,9 +190,13 @@ protected:
 
   UInt m_fifo_idx; /// Read index into m_fifo
 
-  UInt m_num_held_bits;
-  UChar m_held_bits;
-  UInt  m_numBitsRead;
+  UInt   m_num_held_bits; /// number of bits loaded from m_fifo and not read yet, at most 64
+  UInt64 m_held_bits;     /// the bits loaded and not read yet, in the m_num_held_bits lsbs
+  UInt   m_numBitsRead;
+
+  Void xRefill();         ///< load as many whole bytes from m_fifo as the held bits leave room for
+  Void xReleaseBytes();   ///< return the whole bytes held to m_fifo, leaving fewer than 8 bits held
+  Void xReadHeldByte( UInt &ruiBits );
 
 public:
   /**
@@ -186,22 +211,32 @@ public:
   // interface for decoding
   Void        pseudoRead      ( UInt uiNumberOfBits, UInt& ruiBits );
   Void        read            ( UInt uiNumberOfBits, UInt& ruiBits );
+  Void        skip            ( UInt uiNumberOfBits ) { UInt tmp; read(uiNumberOfBits, tmp); }
+  Void        rewindBytes     ( UInt uiNumberOfBytes );
+  UInt        readUvlc        ();
   Void        readByte        ( UInt &ruiBits )
   {
-    assert(m_fifo_idx < m_fifo.size());
-    ruiBits = m_fifo[m_fifo_idx++];
+    if (m_num_held_bits == 0)
+    {
+      assert(m_fifo_idx < m_fifo.size());
+      ruiBits = m_fifo[m_fifo_idx++];
+    }
+    else
+    {
+      xReadHeldByte(ruiBits);
+    }
   }
 
   Void        peekPreviousByte( UInt &byte )
   {
-    assert(m_fifo_idx > 0);
-    byte = m_fifo[m_fifo_idx - 1];
+    assert(getByteLocation() > 0);
+    byte = m_fifo[getByteLocation() - 1];
   }
 
   UInt        readOutTrailingBits ();
   UChar getHeldBits  ()          { return m_held_bits;          }
   TComOutputBitstream& operator= (const TComOutputBitstream& src);
-  UInt  getByteLocation              ( )                     { return m_fifo_idx                    ; }
+  UInt  getByteLocation              ( )                     { return m_fifo_idx - (m_num_held_bits >> 3); }
 
   // Peek at bits in word-storage. Used in determining if we have completed reading of current bitstream and therefore slice in LCEC.
   UInt        peekBits (UInt uiBits) { UInt tmp; pseudoRead(uiBits, tmp); return tmp; }
@@ -226,6 +261,14 @@ public:
         std::vector<uint8_t> &getFifo()       { return m_fifo; }
 };
 
+// ====================================================================================================================
+// Function declarations
+// ====================================================================================================================
+
+/// returns the first position in [begin, end) at which two 0x00 bytes start, or end if there is none.
+/// Emulation prevention bytes can only follow such a pair, so the bytes before it can be copied unchanged.
+const uint8_t* findZeroBytePair(const uint8_t* begin, const uint8_t* end);
+
 //! \}
 
 #endif
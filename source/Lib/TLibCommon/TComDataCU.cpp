@@ -2948,7 +2948,7 @@ Bool TComDataCU::xAddMVPCandWithScaling( AMVPInfo &info, const RefPicList eRefPi
 
   const Int  currPOC            = m_pcSlice->getPOC();
   const Int  currRefPOC         = m_pcSlice->getRefPic( eRefPicList, iRefIdx)->getPOC();
-  const Bool bIsCurrRefLongTerm = m_pcSlice->getRefPic( eRefPicList, iRefIdx)->getIsLongTerm();
+  const Bool bIsCurrRefLongTerm = m_pcSlice->getIsUsedAsLongTerm( eRefPicList, iRefIdx );
   const Int  neibPOC            = currPOC;
 
   for(Int predictorSource=0; predictorSource<2; predictorSource++) // examine the indicated reference picture list, then if not available, examine the other list.
@@ -2957,7 +2957,7 @@ Bool TComDataCU::xAddMVPCandWithScaling( AMVPInfo &info, const RefPicList eRefPi
     const Int        neibRefIdx       = neibCU->getCUMvField(eRefPicListIndex)->getRefIdx(neibPUPartIdx);
     if( neibRefIdx >= 0)
     {
-      const Bool bIsNeibRefLongTerm = neibCU->getSlice()->getRefPic( eRefPicListIndex, neibRefIdx )->getIsLongTerm();
+      const Bool bIsNeibRefLongTerm = neibCU->getSlice()->getIsUsedAsLongTerm( eRefPicListIndex, neibRefIdx );
 
       if ( bIsCurrRefLongTerm == bIsNeibRefLongTerm )
       {
@@ -3042,7 +3042,7 @@ Bool TComDataCU::xGetColMVP( const RefPicList eRefPicList, const Int ctuRsAddr,
     }
   }
 
-  const Bool bIsCurrRefLongTerm = m_pcSlice->getRefPic(eRefPicList, refIdx)->getIsLongTerm();
+  const Bool bIsCurrRefLongTerm = m_pcSlice->getIsUsedAsLongTerm(eRefPicList, refIdx);
 #if REDUCED_ENCODER_MEMORY
   const Bool bIsColRefLongTerm  = pColSlice->getIsUsedAsLongTerm(eColRefPicList, iColRefIdx);
 #else
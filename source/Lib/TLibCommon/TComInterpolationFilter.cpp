@@ -46,8 +46,9 @@
 
 #include "TComChromaFormat.h"
 
-#if VECTOR_CODING__INTERPOLATION_FILTER && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
-#include <emmintrin.h>
+#if VECTOR_CODING__INTERPOLATION_FILTER
+#include "TComSimd.h"
+#include <immintrin.h>
 #endif
 
 //! \ingroup TLibCommon
@@ -178,6 +179,86 @@ inline __m128i simdClip3( __m128i mmMin , __m128i mmMax , __m128i mmPix )
 }
 #endif
 
+#if VECTOR_CODING__INTERPOLATION_FILTER
+// The AVX2 filter works on eight samples held in 32-bit lanes, so it is exact for every bit depth, and is used for the
+// bit depths that the 16-bit SSE2 code above does not support.
+static SIMD_TARGET_AVX2 inline __m256i simdLoadPel8Avx2( Pel const *src )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return _mm256_loadu_si256( ( __m256i const * )src );
+#else
+  return _mm256_cvtepi16_epi32( _mm_loadu_si128( ( __m128i const * )src ) );
+#endif
+}
+
+static SIMD_TARGET_AVX2 inline Void simdStorePel8Avx2( Pel *dst, __m256i mmPix )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  _mm256_storeu_si256( ( __m256i * )dst, mmPix );
+#else
+  // keep the low 16 bits of each lane, as the conversion to Pel does
+  const __m256i mmLowHalves = _mm256_setr_epi8( 0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1 );
+  mmPix = _mm256_permute4x64_epi64( _mm256_shuffle_epi8( mmPix, mmLowHalves ), 0x08 );
+  _mm_storeu_si128( ( __m128i * )dst, _mm256_castsi256_si128( mmPix ) );
+#endif
+}
+
+/// same as the C code of TComInterpolationFilter::filter, with the offset, shift and maximum it derives
+template<Int N, Bool isLast>
+static SIMD_TARGET_AVX2 Void simdFilterAvx2( Pel const *src, Int srcStride, Int cStride, Pel *dst, Int dstStride, Int width, Int height, Pel const *c, Int offset, Int shift, Pel maxVal )
+{
+  __m256i mmCoeff[N];
+  for( Int n = 0 ; n < N ; n++ )
+  {
+    mmCoeff[n] = _mm256_set1_epi32( c[n] );
+  }
+  const __m256i mmOffset = _mm256_set1_epi32( offset );
+  const __m256i mmMin    = _mm256_setzero_si256();
+  const __m256i mmMax    = _mm256_set1_epi32( maxVal );
+
+  for( Int row = 0 ; row < height ; row++ )
+  {
+    Int col = 0;
+    for( ; col + 8 <= width ; col += 8 )
+    {
+      __m256i mmSum = _mm256_mullo_epi32( simdLoadPel8Avx2( src + col ), mmCoeff[0] );
+      for( Int n = 1 ; n < N ; n++ )
+      {
+        mmSum = _mm256_add_epi32( mmSum, _mm256_mullo_epi32( simdLoadPel8Avx2( src + col + n * cStride ), mmCoeff[n] ) );
+      }
+      mmSum = _mm256_srai_epi32( _mm256_add_epi32( mmSum, mmOffset ), shift );
+      if( isLast )
+      {
+#if RExt__HIGH_BIT_DEPTH_SUPPORT==0
+        // the C code clips the value after its conversion to a 16-bit Pel
+        mmSum = _mm256_srai_epi32( _mm256_slli_epi32( mmSum, 16 ), 16 );
+#endif
+        mmSum = _mm256_min_epi32( _mm256_max_epi32( mmSum, mmMin ), mmMax );
+      }
+      simdStorePel8Avx2( dst + col, mmSum );
+    }
+    for( ; col < width ; col++ )
+    {
+      Int sum = 0;
+      for( Int n = 0 ; n < N ; n++ )
+      {
+        sum += src[ col + n * cStride] * c[n];
+      }
+      Pel val = ( sum + offset ) >> shift;
+      if ( isLast )
+      {
+        val = ( val < 0 ) ? 0 : val;
+        val = ( val > maxVal ) ? maxVal : val;
+      }
+      dst[col] = val;
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+#endif
+
 // ====================================================================================================================
 // Private member functions
 // ====================================================================================================================
@@ -322,6 +403,14 @@ Void TComInterpolationFilter::filter(Int bitDepth, Pel const *src, Int srcStride
     maxVal = 0;
   }
 
+#if VECTOR_CODING__INTERPOLATION_FILTER
+  if( ( RExt__HIGH_BIT_DEPTH_SUPPORT || bitDepth > 10 ) && getSimdExtension() >= SIMD_AVX2 )
+  {
+    simdFilterAvx2<N, isLast>( src, srcStride, cStride, dst, dstStride, width, height, c, offset, shift, maxVal );
+    return;
+  }
+#endif
+
 #if VECTOR_CODING__INTERPOLATION_FILTER && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
   if( bitDepth <= 10 )
   {
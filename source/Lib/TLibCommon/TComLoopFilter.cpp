@@ -73,6 +73,7 @@ const UChar TComLoopFilter::sm_betaTable[MAX_QP + 1] =
 TComLoopFilter::TComLoopFilter()
 : m_uiNumPartitions(0)
 , m_bLFCrossTileBoundary(true)
+, m_pcThreadPool(NULL)
 {
   for( Int edgeDir = 0; edgeDir < NUM_EDGE_DIR; edgeDir++ )
   {
@@ -93,7 +94,13 @@ Void TComLoopFilter::setCfg( Bool bLFCrossTileBoundary )
   m_bLFCrossTileBoundary = bLFCrossTileBoundary;
 }
 
-Void TComLoopFilter::create( UInt uiMaxCUDepth )
+/**
+ - allocate the Bs and edge-filter arrays
+ .
+ \param uiMaxCUDepth  maximum CU depth
+ \param pcThreadPool  when it has several threads, the picture-level deblocking is split across them
+ */
+Void TComLoopFilter::create( UInt uiMaxCUDepth, TComThreadPool* pcThreadPool )
 {
   destroy();
   m_uiNumPartitions = 1 << ( uiMaxCUDepth<<1 );
@@ -102,6 +109,17 @@ Void TComLoopFilter::create( UInt uiMaxCUDepth )
     m_aapucBS       [edgeDir] = new UChar[m_uiNumPartitions];
     m_aapbEdgeFilter[edgeDir] = new Bool [m_uiNumPartitions];
   }
+
+  if ( pcThreadPool != NULL && pcThreadPool->getNumThreads() > 1 )
+  {
+    m_pcThreadPool = pcThreadPool;
+    for ( Int threadIdx = 0; threadIdx < pcThreadPool->getNumThreads(); threadIdx++ )
+    {
+      TComLoopFilter* pcLoopFilter = new TComLoopFilter;
+      pcLoopFilter->create( uiMaxCUDepth );
+      m_apcThreadLoopFilters.push_back( pcLoopFilter );
+    }
+  }
 }
 
 Void TComLoopFilter::destroy()
@@ -120,6 +138,14 @@ Void TComLoopFilter::destroy()
       m_aapbEdgeFilter[edgeDir] = NULL;
     }
   }
+
+  for ( UInt threadIdx = 0; threadIdx < m_apcThreadLoopFilters.size(); threadIdx++ )
+  {
+    m_apcThreadLoopFilters[threadIdx]->destroy();
+    delete m_apcThreadLoopFilters[threadIdx];
+  }
+  m_apcThreadLoopFilters.clear();
+  m_pcThreadPool = NULL;
 }
 
 /**
@@ -129,28 +155,45 @@ Void TComLoopFilter::destroy()
  */
 Void TComLoopFilter::loopFilterPic( TComPic* pcPic )
 {
+  if ( m_pcThreadPool != NULL )
+  {
+    xLoopFilterPicParallel( pcPic );
+    return;
+  }
+
   // Horizontal filtering
   for ( UInt ctuRsAddr = 0; ctuRsAddr < pcPic->getNumberOfCtusInFrame(); ctuRsAddr++ )
   {
-    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
-
-    ::memset( m_aapucBS       [EDGE_VER], 0, sizeof( UChar ) * m_uiNumPartitions );
-    ::memset( m_aapbEdgeFilter[EDGE_VER], 0, sizeof( Bool  ) * m_uiNumPartitions );
-
-    // CU-based deblocking
-    xDeblockCU( pCtu, 0, 0, EDGE_VER );
+    xDeblockCtu( pcPic->getCtu( ctuRsAddr ), EDGE_VER );
   }
 
   // Vertical filtering
   for ( UInt ctuRsAddr = 0; ctuRsAddr < pcPic->getNumberOfCtusInFrame(); ctuRsAddr++ )
   {
-    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
+    xDeblockCtu( pcPic->getCtu( ctuRsAddr ), EDGE_HOR );
+  }
+}
 
-    ::memset( m_aapucBS       [EDGE_HOR], 0, sizeof( UChar ) * m_uiNumPartitions );
-    ::memset( m_aapbEdgeFilter[EDGE_HOR], 0, sizeof( Bool  ) * m_uiNumPartitions );
+/**
+ - deblocking filter of the CTUs of one CTU row
+ .
+ \param pcPic      picture class (TComPic) pointer
+ \param ctuRowIdx  CTU row to filter
+ \note The filtering of the horizontal edges at the top of the row modifies the bottom lines of the row above, and
+       the row below must not have been deblocked yet. Filtering all rows in order gives the same result as
+       loopFilterPic.
+ */
+Void TComLoopFilter::loopFilterCtuRow( TComPic* pcPic, UInt ctuRowIdx )
+{
+  const UInt frameWidthInCtus = pcPic->getFrameWidthInCtus();
+  const UInt firstCtuRsAddr   = ctuRowIdx * frameWidthInCtus;
 
-    // CU-based deblocking
-    xDeblockCU( pCtu, 0, 0, EDGE_HOR );
+  for ( Int edgeDir = EDGE_VER; edgeDir <= EDGE_HOR; edgeDir++ )
+  {
+    for ( UInt ctuRsAddr = firstCtuRsAddr; ctuRsAddr < firstCtuRsAddr + frameWidthInCtus; ctuRsAddr++ )
+    {
+      xDeblockCtu( pcPic->getCtu( ctuRsAddr ), DeblockEdgeDir( edgeDir ) );
+    }
   }
 }
 
@@ -159,6 +202,59 @@ Void TComLoopFilter::loopFilterPic( TComPic* pcPic )
 // Protected member functions
 // ====================================================================================================================
 
+/**
+ - deblocking filter of the edges of one direction in a CTU
+ .
+ \param pCtu     CTU to filter
+ \param edgeDir  the direction of the edges
+ */
+Void TComLoopFilter::xDeblockCtu( TComDataCU* pCtu, DeblockEdgeDir edgeDir )
+{
+  ::memset( m_aapucBS       [edgeDir], 0, sizeof( UChar ) * m_uiNumPartitions );
+  ::memset( m_aapbEdgeFilter[edgeDir], 0, sizeof( Bool  ) * m_uiNumPartitions );
+
+  // CU-based deblocking
+  xDeblockCU( pCtu, 0, 0, edgeDir );
+}
+
+/**
+ - picture-level deblocking with the CTU rows split across the worker threads
+ .
+ \param pcPic  picture class (TComPic) pointer
+ \note The vertical edges of a CTU modify at most three sample columns of the CTU on its left, which the vertical
+       edges of that CTU neither read nor modify (likewise for the horizontal edges), so the CTUs can be filtered in
+       any order within a direction. Each thread uses the Bs and edge-filter arrays of its own TComLoopFilter, and all
+       the vertical edges are filtered before the horizontal ones.
+ */
+Void TComLoopFilter::xLoopFilterPicParallel( TComPic* pcPic )
+{
+  const UInt frameWidthInCtus  = pcPic->getFrameWidthInCtus();
+  const UInt frameHeightInCtus = pcPic->getFrameHeightInCtus();
+
+  for ( UInt threadIdx = 0; threadIdx < m_apcThreadLoopFilters.size(); threadIdx++ )
+  {
+    m_apcThreadLoopFilters[threadIdx]->setCfg( m_bLFCrossTileBoundary );
+  }
+
+  for ( Int edgeDir = EDGE_VER; edgeDir <= EDGE_HOR; edgeDir++ )
+  {
+    for ( UInt ctuRowIdx = 0; ctuRowIdx < frameHeightInCtus; ctuRowIdx++ )
+    {
+      m_pcThreadPool->addJob( [=]( Int threadIdx )
+      {
+        TComLoopFilter* const pcLoopFilter = m_apcThreadLoopFilters[threadIdx];
+        for ( UInt ctuRsAddr = ctuRowIdx * frameWidthInCtus; ctuRsAddr < ( ctuRowIdx + 1 ) * frameWidthInCtus; ctuRsAddr++ )
+        {
+          pcLoopFilter->xDeblockCtu( pcPic->getCtu( ctuRsAddr ), DeblockEdgeDir( edgeDir ) );
+        }
+      } );
+    }
+
+    // barrier between the two edge directions
+    m_pcThreadPool->waitForAll();
+  }
+}
+
 /**
  Deblocking filter process in CU-based (the same function as conventional's)
 
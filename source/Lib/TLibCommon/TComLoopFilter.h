@@ -40,6 +40,9 @@
 
 #include "CommonDef.h"
 #include "TComPic.h"
+#include "TComThreadPool.h"
+
+#include <vector>
 
 //! \ingroup TLibCommon
 //! \{
@@ -62,7 +65,15 @@ private:
 
   Bool      m_bLFCrossTileBoundary;
 
+  TComThreadPool*              m_pcThreadPool;
+  std::vector<TComLoopFilter*> m_apcThreadLoopFilters;  ///< per-thread Bs and edge-filter arrays for the parallel deblocking
+
 protected:
+  /// CTU-level deblocking function for one edge direction
+  Void xDeblockCtu                ( TComDataCU* pCtu, DeblockEdgeDir edgeDir );
+  /// picture-level deblocking on the worker threads
+  Void xLoopFilterPicParallel     ( TComPic* pcPic );
+
   /// CU-level deblocking function
   Void xDeblockCU                 ( TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth, DeblockEdgeDir edgeDir );
 
@@ -122,7 +133,7 @@ public:
   TComLoopFilter();
   virtual ~TComLoopFilter();
 
-  Void  create                    ( UInt uiMaxCUDepth );
+  Void  create                    ( UInt uiMaxCUDepth, TComThreadPool* pcThreadPool = NULL );
   Void  destroy                   ();
 
   /// set configuration
@@ -131,6 +142,9 @@ public:
   /// picture-level deblocking filter
   Void loopFilterPic( TComPic* pcPic );
 
+  /// deblocking of one CTU row, the rows above must have been deblocked before
+  Void loopFilterCtuRow( TComPic* pcPic, UInt ctuRowIdx );
+
   static Int getBeta( Int qp )
   {
     Int indexB = Clip3( 0, MAX_QP, qp );
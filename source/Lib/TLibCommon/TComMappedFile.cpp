@@ -0,0 +1,117 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TComMappedFile.cpp
+    \brief    Read-only mapping of a file into memory
+*/
+
+#include "TComMappedFile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_FILE_SUPPORTED 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#else
+#define MAPPED_FILE_SUPPORTED 0
+#endif
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor
+// ====================================================================================================================
+
+TComMappedFile::TComMappedFile()
+: m_data( NULL )
+, m_size( 0 )
+{
+}
+
+TComMappedFile::~TComMappedFile()
+{
+  close();
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+Bool TComMappedFile::open( const std::string& fileName )
+{
+  close();
+
+#if MAPPED_FILE_SUPPORTED
+  const Int fd = ::open( fileName.c_str(), O_RDONLY );
+  if ( fd < 0 )
+  {
+    return false;
+  }
+
+  struct stat st;
+  if ( fstat( fd, &st ) == 0 && S_ISREG( st.st_mode ) && st.st_size > 0 )
+  {
+    void* addr = mmap( NULL, std::size_t( st.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+    if ( addr != MAP_FAILED )
+    {
+#ifdef MADV_SEQUENTIAL
+      madvise( addr, std::size_t( st.st_size ), MADV_SEQUENTIAL );
+#endif
+      m_data = static_cast<const UChar*>( addr );
+      m_size = std::size_t( st.st_size );
+    }
+  }
+  ::close( fd );
+#else
+  (Void)fileName;
+#endif
+
+  return m_data != NULL;
+}
+
+Void TComMappedFile::close()
+{
+#if MAPPED_FILE_SUPPORTED
+  if ( m_data != NULL )
+  {
+    munmap( const_cast<UChar*>( m_data ), m_size );
+  }
+#endif
+  m_data = NULL;
+  m_size = 0;
+}
+
+//! \}
@@ -51,6 +51,9 @@ TComPic::TComPic()
 , m_bIsLongTerm                           (false)
 , m_pcPicYuvPred                          (NULL)
 , m_pcPicYuvResi                          (NULL)
+, m_subPelPlanesCreated                   (false)
+, m_subPelRowValid                        (NULL)
+, m_numSubPelRows                         (0)
 , m_bReconstructed                        (false)
 , m_bNeededForOutput                      (false)
 , m_uiCurrSliceIdx                        (0)
@@ -60,6 +63,20 @@ TComPic::TComPic()
   {
     m_apcPicYuv[i]      = NULL;
   }
+  for(UInt fracY=0; fracY<4; fracY++)
+  {
+    for(UInt fracX=0; fracX<4; fracX++)
+    {
+      m_apcPicYuvSubPel[fracY][fracX] = NULL;
+    }
+  }
+  for(UInt i=0; i<=PIC_YUV_REC; i++)
+  {
+    for(UInt level=0; level<NUM_LOW_RES_LEVELS; level++)
+    {
+      m_apcPicYuvLowRes[i][level] = NULL;
+    }
+  }
 }
 
 TComPic::~TComPic()
@@ -182,10 +199,114 @@ Void TComPic::releaseAllReconstructionData()
     delete m_apcPicYuv[PIC_YUV_REC];
     m_apcPicYuv[PIC_YUV_REC] = NULL;
   }
+  destroySubPelPlanes();
+  destroyLowResPlanes();
   m_picSym.releaseAllReconstructionData();
 }
 #endif
 
+/** Allocate the luma sub-sample planes of the reconstruction. All CTU rows are marked as not interpolated.
+ * The planes are published to the CTU workers that check getSubPelPlanesCreated() without a lock.
+ */
+Void TComPic::createSubPelPlanes()
+{
+  const TComSPS &sps=m_picSym.getSPS();
+
+  for(UInt fracY=0; fracY<4; fracY++)
+  {
+    for(UInt fracX=0; fracX<4; fracX++)
+    {
+      if ((fracY|fracX) != 0 && m_apcPicYuvSubPel[fracY][fracX] == NULL)
+      {
+        m_apcPicYuvSubPel[fracY][fracX] = new TComPicYuv;
+        m_apcPicYuvSubPel[fracY][fracX]->createWithoutCUInfo( sps.getPicWidthInLumaSamples(), sps.getPicHeightInLumaSamples(), CHROMA_400, true, sps.getMaxCUWidth(), sps.getMaxCUHeight() );
+      }
+    }
+  }
+  if (m_subPelRowValid == NULL)
+  {
+    m_numSubPelRows  = getFrameHeightInCtus();
+    m_subPelRowValid = new std::atomic<Bool>[m_numSubPelRows];
+  }
+  invalidateSubPelPlanes();
+  m_subPelPlanesCreated.store(true, std::memory_order_release);
+}
+
+Void TComPic::destroySubPelPlanes()
+{
+  for(UInt fracY=0; fracY<4; fracY++)
+  {
+    for(UInt fracX=0; fracX<4; fracX++)
+    {
+      if (m_apcPicYuvSubPel[fracY][fracX])
+      {
+        m_apcPicYuvSubPel[fracY][fracX]->destroy();
+        delete m_apcPicYuvSubPel[fracY][fracX];
+        m_apcPicYuvSubPel[fracY][fracX] = NULL;
+      }
+    }
+  }
+  m_subPelPlanesCreated.store(false, std::memory_order_relaxed);
+  delete [] m_subPelRowValid;
+  m_subPelRowValid = NULL;
+  m_numSubPelRows  = 0;
+}
+
+/** Mark all CTU rows of the sub-sample planes as not interpolated.
+ */
+Void TComPic::invalidateSubPelPlanes()
+{
+  for (UInt ctuRow = 0; ctuRow < m_numSubPelRows; ctuRow++)
+  {
+    m_subPelRowValid[ctuRow].store(false, std::memory_order_relaxed);
+  }
+}
+
+/** Downscale the luma of the original or the reconstruction by 2 and 4 in each direction.
+ * Each level averages 2x2 samples of the previous one; the borders of the planes are extended.
+ * \param picYuvType PIC_YUV_ORG or PIC_YUV_REC
+ */
+Void TComPic::buildLowResPlanes( const PIC_YUV_T picYuvType )
+{
+  assert(picYuvType == PIC_YUV_ORG || picYuvType == PIC_YUV_REC);
+  const TComSPS &sps=m_picSym.getSPS();
+  const TComPicYuv *pcSrc = m_apcPicYuv[picYuvType];
+
+  for(UInt level=0; level<NUM_LOW_RES_LEVELS; level++)
+  {
+    const Int iSrcWidth  = pcSrc->getWidth (COMPONENT_Y);
+    const Int iSrcHeight = pcSrc->getHeight(COMPONENT_Y);
+    const Int iWidth     = (iSrcWidth  + 1) >> 1;
+    const Int iHeight    = (iSrcHeight + 1) >> 1;
+
+    if (m_apcPicYuvLowRes[picYuvType][level] == NULL)
+    {
+      m_apcPicYuvLowRes[picYuvType][level] = new TComPicYuv;
+      m_apcPicYuvLowRes[picYuvType][level]->createWithoutCUInfo( iWidth, iHeight, CHROMA_400, true, sps.getMaxCUWidth() >> (level+1), sps.getMaxCUHeight() >> (level+1) );
+    }
+    TComPicYuv *pcDst = m_apcPicYuvLowRes[picYuvType][level];
+
+    pcSrc->downscaleLumaTo( pcDst );
+    pcSrc = pcDst;
+  }
+}
+
+Void TComPic::destroyLowResPlanes()
+{
+  for(UInt i=0; i<=PIC_YUV_REC; i++)
+  {
+    for(UInt level=0; level<NUM_LOW_RES_LEVELS; level++)
+    {
+      if (m_apcPicYuvLowRes[i][level])
+      {
+        m_apcPicYuvLowRes[i][level]->destroy();
+        delete m_apcPicYuvLowRes[i][level];
+        m_apcPicYuvLowRes[i][level] = NULL;
+      }
+    }
+  }
+}
+
 Void TComPic::destroy()
 {
   m_picSym.destroy();
@@ -199,6 +320,8 @@ Void TComPic::destroy()
       m_apcPicYuv[i]  = NULL;
     }
   }
+  destroySubPelPlanes();
+  destroyLowResPlanes();
 
   deleteSEIs(m_SEIs);
 }
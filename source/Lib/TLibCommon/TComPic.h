@@ -44,6 +44,9 @@
 #include "TComPicYuv.h"
 #include "TComBitStream.h"
 
+#include <atomic>
+#include <mutex>
+
 //! \ingroup TLibCommon
 //! \{
 
@@ -60,6 +63,8 @@ public:
      // TRUE_ORG is the input file without any pre-encoder colour space conversion (but with possible bit depth increment)
   TComPicYuv*   getPicYuvTrueOrg()        { return  m_apcPicYuv[PIC_YUV_TRUE_ORG]; }
 
+  enum { NUM_LOW_RES_LEVELS=2 };  // downscaled luma planes: level 0 is scaled by 1/2 in each direction, level 1 by 1/4
+
 private:
   UInt                  m_uiTLayer;               //  Temporal layer
   Bool                  m_bUsedByCurr;            //  Used by current picture
@@ -69,6 +74,12 @@ private:
 
   TComPicYuv*           m_pcPicYuvPred;           //  Prediction
   TComPicYuv*           m_pcPicYuvResi;           //  Residual
+  TComPicYuv*           m_apcPicYuvSubPel[4][4];  //  Luma sub-sample planes of the reconstruction, indexed by vertical and horizontal quarter-sample phase ([0][0] unused)
+  std::atomic<Bool>     m_subPelPlanesCreated;    //  Set once the sub-sample planes have been allocated
+  std::atomic<Bool>*    m_subPelRowValid;         //  CTU rows of the sub-sample planes that have been interpolated
+  UInt                  m_numSubPelRows;          //  Number of entries of m_subPelRowValid
+  std::mutex            m_subPelMutex;            //  Guards the creation and interpolation of the sub-sample planes by concurrent CTU workers
+  TComPicYuv*           m_apcPicYuvLowRes[PIC_YUV_REC+1][NUM_LOW_RES_LEVELS]; //  Downscaled luma of the original and the reconstruction, used by the hierarchical motion search
   Bool                  m_bReconstructed;
   Bool                  m_bNeededForOutput;
   UInt                  m_uiCurrSliceIdx;         // Index of current slice
@@ -112,7 +123,7 @@ public:
   const TComPicSym* getPicSym() const              { return  &m_picSym;    }
   TComSlice*    getSlice(Int i)                    { return  m_picSym.getSlice(i);  }
   const TComSlice* getSlice(Int i) const           { return  m_picSym.getSlice(i);  }
-  Int           getPOC() const                     { return  m_picSym.getSlice(m_uiCurrSliceIdx)->getPOC();  }
+  Int           getPOC() const                     { return  m_picSym.getSlice(0)->getPOC();  }
   TComDataCU*   getCtu( UInt ctuRsAddr )           { return  m_picSym.getCtu( ctuRsAddr ); }
   const TComDataCU* getCtu( UInt ctuRsAddr ) const { return  m_picSym.getCtu( ctuRsAddr ); }
 
@@ -124,6 +135,19 @@ public:
   Void          setPicYuvPred( TComPicYuv* pcPicYuv )       { m_pcPicYuvPred = pcPicYuv; }
   Void          setPicYuvResi( TComPicYuv* pcPicYuv )       { m_pcPicYuvResi = pcPicYuv; }
 
+  Void          createSubPelPlanes();
+  Void          destroySubPelPlanes();
+  Void          invalidateSubPelPlanes();
+  Bool          getSubPelPlanesCreated() const             { return m_subPelPlanesCreated.load(std::memory_order_acquire); }
+  TComPicYuv*   getPicYuvSubPel( Int fracY, Int fracX )    { return m_apcPicYuvSubPel[fracY][fracX]; }
+  Bool          getSubPelRowValid( UInt ctuRow ) const     { return m_subPelRowValid[ctuRow].load(std::memory_order_acquire); }
+  Void          setSubPelRowValid( UInt ctuRow )           { m_subPelRowValid[ctuRow].store(true, std::memory_order_release); }
+  std::mutex&   getSubPelMutex()                           { return m_subPelMutex; }
+
+  Void          buildLowResPlanes( const PIC_YUV_T picYuvType );
+  Void          destroyLowResPlanes();
+  TComPicYuv*   getPicYuvLowRes( const PIC_YUV_T picYuvType, const Int level ) const { return m_apcPicYuvLowRes[picYuvType][level]; }
+
   UInt          getNumberOfCtusInFrame() const     { return m_picSym.getNumberOfCtusInFrame(); }
   UInt          getNumPartInCtuWidth() const       { return m_picSym.getNumPartInCtuWidth();   }
   UInt          getNumPartInCtuHeight() const      { return m_picSym.getNumPartInCtuHeight();  }
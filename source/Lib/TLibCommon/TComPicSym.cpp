@@ -118,6 +118,7 @@ Void TComPicSym::create  ( const TComSPS &sps, const TComPPS &pps, UInt uiMaxDep
 #endif
 
   clearSliceBuffer();
+  m_apSlices.reserve(m_numCtusInFrame);
   allocateNewSlice();
 
 #if ADAPTIVE_QP_SELECTION
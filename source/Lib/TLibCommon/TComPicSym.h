@@ -40,7 +40,7 @@
 
 
 // Include files
-#include <deque>
+#include <vector>
 #include "CommonDef.h"
 #include "TComSlice.h"
 #include "TComDataCU.h"
@@ -95,7 +95,7 @@ private:
   UInt          m_numPartInCtuHeight;
   UInt          m_numCtusInFrame;
 
-  std::deque<TComSlice*> m_apSlices;
+  std::vector<TComSlice*> m_apSlices;    ///< reserved for one slice segment per CTU, so that adding a slice segment does not reallocate the array while other threads read the first slice
   TComDataCU**  m_pictureCtuArray;        ///< array of CU data.
 
   Int           m_numTileColumnsMinus1;
@@ -225,10 +225,43 @@ Void  TComPicYuv::copyToPic (TComPicYuv*  pcPicYuvDst) const
   }
 }
 
+/** Downscale the luma by 2 in each direction.
+ * Each output sample is the rounded average of 2x2 input samples; the last row and column are repeated for odd sizes.
+ * \param pcPicYuvDst destination picture of (width+1)/2 x (height+1)/2 luma samples, whose border is extended
+ */
+Void TComPicYuv::downscaleLumaTo( TComPicYuv* pcPicYuvDst ) const
+{
+  const Int  iSrcWidth  = getWidth (COMPONENT_Y);
+  const Int  iSrcHeight = getHeight(COMPONENT_Y);
+  const Int  iSrcStride = getStride(COMPONENT_Y);
+  const Int  iWidth     = pcPicYuvDst->getWidth (COMPONENT_Y);
+  const Int  iHeight    = pcPicYuvDst->getHeight(COMPONENT_Y);
+  const Int  iDstStride = pcPicYuvDst->getStride(COMPONENT_Y);
+  const Pel *piSrc      = getAddr(COMPONENT_Y);
+        Pel *piDst      = pcPicYuvDst->getAddr(COMPONENT_Y);
+
+  assert(iWidth == (iSrcWidth + 1) >> 1 && iHeight == (iSrcHeight + 1) >> 1);
+
+  for(Int y=0; y<iHeight; y++)
+  {
+    const Pel *piSrc0 = piSrc + (2*y) * iSrcStride;
+    const Pel *piSrc1 = piSrc + std::min(2*y+1, iSrcHeight-1) * iSrcStride;
+    for(Int x=0; x<iWidth; x++)
+    {
+      const Int x1 = std::min(2*x+1, iSrcWidth-1);
+      piDst[x] = Pel((piSrc0[2*x] + piSrc0[x1] + piSrc1[2*x] + piSrc1[x1] + 2) >> 2);
+    }
+    piDst += iDstStride;
+  }
 
-Void TComPicYuv::extendPicBorder ()
+  pcPicYuvDst->setBorderExtension(false);
+  pcPicYuvDst->extendPicBorder();
+}
+
+
+Void TComPicYuv::extendPicBorder ( const Bool bForce )
 {
-  if ( m_bIsBorderExtended )
+  if ( m_bIsBorderExtended && !bForce )
   {
     return;
   }
@@ -272,7 +305,10 @@ Void TComPicYuv::extendPicBorder ()
     }
   }
 
-  m_bIsBorderExtended = true;
+  if ( !bForce )
+  {
+    m_bIsBorderExtended = true;
+  }
 }
 
 
@@ -160,8 +160,11 @@ public:
   //  Copy function to picture
   Void          copyToPic         ( TComPicYuv*  pcPicYuvDst ) const ;
 
-  //  Extend function of picture buffer
-  Void          extendPicBorder   ();
+  //  Write the luma, scaled by 1/2 in each direction, to a picture of (width+1)/2 x (height+1)/2 and extend its border
+  Void          downscaleLumaTo   ( TComPicYuv*  pcPicYuvDst ) const ;
+
+  //  Extend function of picture buffer. With bForce, the border is extended even if it is marked as already extended, and the mark is left unchanged.
+  Void          extendPicBorder   ( const Bool bForce = false );
 
   //  Dump picture
   Void          dump              (const std::string &fileName, const BitDepths &bitDepths, const Bool bAppend=false, const Bool bForceTo8Bit=false) const ;
@@ -45,6 +45,7 @@
 
 #include "TComSlice.h"
 #include "TComRdCostWeightPrediction.h"
+#include "TComSimd.h"
 
 //! \ingroup TLibCommon
 //! \{
@@ -146,6 +147,7 @@ public:
 
   // Distortion Functions
   Void    init();
+  FpDistFunc getDistortionFunction( DFunc eDFunc ) const { return m_afpDistortFunc[eDFunc]; }
 
   Void    setDistParam( UInt uiBlkWidth, UInt uiBlkHeight, DFunc eDFunc, DistParam& rcDistParam );
   Void    setDistParam( const TComPattern* const pcPatternKey, const Pel* piRefY, Int iRefStride,            DistParam& rcDistParam );
@@ -204,6 +206,15 @@ private:
 #endif
                                       );
 
+#if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  // SSE4.1 and AVX2 versions, selected in init() for the extensions supported by the CPU (TComRdCostSimd.cpp)
+  Void xInitSimdDistortionFunctions( SimdExtension simdExtension );
+
+  template<SimdExtension simdExtension>              static Distortion xGetSSESimd ( DistParam* pcDtParam );
+  template<SimdExtension simdExtension, DFunc eDFunc> static Distortion xGetSADSimd ( DistParam* pcDtParam );
+  template<SimdExtension simdExtension>              static Distortion xGetHADsSimd( DistParam* pcDtParam );
+#endif
+
 public:
 
   Distortion   getDistPart(Int bitDepth, const Pel* piCur, Int iCurStride, const Pel* piOrg, Int iOrgStride, UInt uiBlkWidth, UInt uiBlkHeight, const ComponentID compID, DFunc eDFunc = DF_SSE );
@@ -0,0 +1,629 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComRdCostSimd.cpp
+    \brief    SSE4.1 and AVX2 versions of the distortion functions of TComRdCost
+*/
+
+#include "TComRdCost.h"
+
+#if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include <immintrin.h>
+
+//! \ingroup TLibCommon
+//! \{
+
+// The kernels compute the differences of the samples with 16-bit arithmetic, so they are only used for bit depths
+// up to 10, like the SSE2 code in TComRdCost.cpp. The sums are accumulated in 32-bit lanes, which wrap around like the
+// 32-bit Distortion of the C functions.
+static const Int SIMD_MAX_BIT_DEPTH = 10;
+
+// ====================================================================================================================
+// SSE4.1 kernels
+// ====================================================================================================================
+
+static SIMD_TARGET_SSE41 inline UInt xHorizontalSumSse41( __m128i sum )
+{
+  sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+  sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+  return UInt( _mm_cvtsi128_si32( sum ) );
+}
+
+/// sum of the absolute differences of a block whose width is a multiple of 4
+static SIMD_TARGET_SSE41 UInt xSADSse41( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur, Int iCols, Int iRows )
+{
+  const __m128i one = _mm_set1_epi16( 1 );
+  __m128i sum = _mm_setzero_si128();
+
+  for( Int y = 0; y < iRows; y++, piOrg += iStrideOrg, piCur += iStrideCur )
+  {
+    Int x = 0;
+    for( ; x + 8 <= iCols; x += 8 )
+    {
+      const __m128i diff = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* )( piOrg + x ) ), _mm_loadu_si128( ( const __m128i* )( piCur + x ) ) );
+      sum = _mm_add_epi32( sum, _mm_madd_epi16( _mm_abs_epi16( diff ), one ) );
+    }
+    if( x < iCols )
+    {
+      const __m128i diff = _mm_sub_epi16( _mm_loadl_epi64( ( const __m128i* )( piOrg + x ) ), _mm_loadl_epi64( ( const __m128i* )( piCur + x ) ) );
+      sum = _mm_add_epi32( sum, _mm_madd_epi16( _mm_abs_epi16( diff ), one ) );
+    }
+  }
+
+  return xHorizontalSumSse41( sum );
+}
+
+/// squares of the 16-bit differences, shifted right by uiShift, added to the 32-bit lanes of sum
+static SIMD_TARGET_SSE41 inline __m128i xAccumulateSquaresSse41( __m128i sum, const __m128i diff, const UInt uiShift )
+{
+  if( uiShift == 0 )
+  {
+    return _mm_add_epi32( sum, _mm_madd_epi16( diff, diff ) );
+  }
+  const __m128i lo = _mm_mullo_epi16( diff, diff );
+  const __m128i hi = _mm_mulhi_epi16( diff, diff );
+  sum = _mm_add_epi32( sum, _mm_srli_epi32( _mm_unpacklo_epi16( lo, hi ), uiShift ) );
+  return _mm_add_epi32( sum, _mm_srli_epi32( _mm_unpackhi_epi16( lo, hi ), uiShift ) );
+}
+
+/// sum of the squared differences of a block whose width is a multiple of 4
+static SIMD_TARGET_SSE41 UInt xSSESse41( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur, Int iCols, Int iRows, UInt uiShift )
+{
+  __m128i sum = _mm_setzero_si128();
+
+  for( Int y = 0; y < iRows; y++, piOrg += iStrideOrg, piCur += iStrideCur )
+  {
+    Int x = 0;
+    for( ; x + 8 <= iCols; x += 8 )
+    {
+      const __m128i diff = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* )( piOrg + x ) ), _mm_loadu_si128( ( const __m128i* )( piCur + x ) ) );
+      sum = xAccumulateSquaresSse41( sum, diff, uiShift );
+    }
+    if( x < iCols )
+    {
+      // the upper half of the difference is zero
+      const __m128i diff = _mm_sub_epi16( _mm_loadl_epi64( ( const __m128i* )( piOrg + x ) ), _mm_loadl_epi64( ( const __m128i* )( piCur + x ) ) );
+      sum = xAccumulateSquaresSse41( sum, diff, uiShift );
+    }
+  }
+
+  return xHorizontalSumSse41( sum );
+}
+
+/// 4-point Hadamard transform of the columns held in the four registers
+static SIMD_TARGET_SSE41 inline Void xHadamard4Sse41( __m128i* m )
+{
+  const __m128i a0 = _mm_add_epi32( m[0], m[2] );
+  const __m128i a1 = _mm_add_epi32( m[1], m[3] );
+  const __m128i a2 = _mm_sub_epi32( m[0], m[2] );
+  const __m128i a3 = _mm_sub_epi32( m[1], m[3] );
+  m[0] = _mm_add_epi32( a0, a1 );
+  m[1] = _mm_sub_epi32( a0, a1 );
+  m[2] = _mm_add_epi32( a2, a3 );
+  m[3] = _mm_sub_epi32( a2, a3 );
+}
+
+static SIMD_TARGET_SSE41 inline Void xTranspose4x4Sse41( __m128i* m )
+{
+  const __m128i t0 = _mm_unpacklo_epi32( m[0], m[1] );
+  const __m128i t1 = _mm_unpackhi_epi32( m[0], m[1] );
+  const __m128i t2 = _mm_unpacklo_epi32( m[2], m[3] );
+  const __m128i t3 = _mm_unpackhi_epi32( m[2], m[3] );
+  m[0] = _mm_unpacklo_epi64( t0, t2 );
+  m[1] = _mm_unpackhi_epi64( t0, t2 );
+  m[2] = _mm_unpacklo_epi64( t1, t3 );
+  m[3] = _mm_unpackhi_epi64( t1, t3 );
+}
+
+/// same as TComRdCost::xCalcHADs4x4
+static SIMD_TARGET_SSE41 UInt xHADs4x4Sse41( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur )
+{
+  __m128i m[4];
+  for( Int k = 0; k < 4; k++, piOrg += iStrideOrg, piCur += iStrideCur )
+  {
+    m[k] = _mm_cvtepi16_epi32( _mm_sub_epi16( _mm_loadl_epi64( ( const __m128i* )piOrg ), _mm_loadl_epi64( ( const __m128i* )piCur ) ) );
+  }
+
+  xHadamard4Sse41( m );
+  xTranspose4x4Sse41( m );
+  xHadamard4Sse41( m );
+
+  const __m128i sum = _mm_add_epi32( _mm_add_epi32( _mm_abs_epi32( m[0] ), _mm_abs_epi32( m[1] ) ),
+                                     _mm_add_epi32( _mm_abs_epi32( m[2] ), _mm_abs_epi32( m[3] ) ) );
+  return ( xHorizontalSumSse41( sum ) + 1 ) >> 1;
+}
+
+/// 8-point Hadamard transform of the columns held in the eight registers
+static SIMD_TARGET_SSE41 inline Void xHadamard8Sse41( __m128i* m )
+{
+  __m128i a[8];
+  for( Int k = 0; k < 4; k++ )
+  {
+    a[k  ] = _mm_add_epi32( m[k], m[k+4] );
+    a[k+4] = _mm_sub_epi32( m[k], m[k+4] );
+  }
+  for( Int k = 0; k < 8; k += 4 )
+  {
+    m[k  ] = _mm_add_epi32( a[k  ], a[k+2] );
+    m[k+1] = _mm_add_epi32( a[k+1], a[k+3] );
+    m[k+2] = _mm_sub_epi32( a[k  ], a[k+2] );
+    m[k+3] = _mm_sub_epi32( a[k+1], a[k+3] );
+  }
+  for( Int k = 0; k < 8; k += 2 )
+  {
+    a[k  ] = _mm_add_epi32( m[k], m[k+1] );
+    a[k+1] = _mm_sub_epi32( m[k], m[k+1] );
+  }
+  for( Int k = 0; k < 8; k++ )
+  {
+    m[k] = a[k];
+  }
+}
+
+/// same as TComRdCost::xCalcHADs8x8, the left and right halves of the rows are held in separate registers
+static SIMD_TARGET_SSE41 UInt xHADs8x8Sse41( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur )
+{
+  __m128i left[8], right[8];
+  for( Int k = 0; k < 8; k++, piOrg += iStrideOrg, piCur += iStrideCur )
+  {
+    const __m128i diff = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* )piOrg ), _mm_loadu_si128( ( const __m128i* )piCur ) );
+    left [k] = _mm_cvtepi16_epi32( diff );
+    right[k] = _mm_cvtepi16_epi32( _mm_unpackhi_epi64( diff, diff ) );
+  }
+
+  xHadamard8Sse41( left );
+  xHadamard8Sse41( right );
+
+  // transpose the four 4x4 quadrants, and swap the top-right and bottom-left ones
+  xTranspose4x4Sse41( left );
+  xTranspose4x4Sse41( left + 4 );
+  xTranspose4x4Sse41( right );
+  xTranspose4x4Sse41( right + 4 );
+  for( Int k = 0; k < 4; k++ )
+  {
+    const __m128i tmp = right[k];
+    right[k]  = left[k+4];
+    left[k+4] = tmp;
+  }
+
+  xHadamard8Sse41( left );
+  xHadamard8Sse41( right );
+
+  __m128i sum = _mm_setzero_si128();
+  for( Int k = 0; k < 8; k++ )
+  {
+    sum = _mm_add_epi32( sum, _mm_add_epi32( _mm_abs_epi32( left[k] ), _mm_abs_epi32( right[k] ) ) );
+  }
+  return ( xHorizontalSumSse41( sum ) + 2 ) >> 2;
+}
+
+// ====================================================================================================================
+// AVX2 kernels
+// ====================================================================================================================
+
+static SIMD_TARGET_AVX2 inline UInt xHorizontalSumAvx2( const __m256i sum )
+{
+  __m128i sum128 = _mm_add_epi32( _mm256_castsi256_si128( sum ), _mm256_extracti128_si256( sum, 1 ) );
+  sum128 = _mm_add_epi32( sum128, _mm_shuffle_epi32( sum128, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+  sum128 = _mm_add_epi32( sum128, _mm_shuffle_epi32( sum128, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+  return UInt( _mm_cvtsi128_si32( sum128 ) );
+}
+
+/// sum of the absolute differences of a block whose width is a multiple of 4
+static SIMD_TARGET_AVX2 UInt xSADAvx2( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur, Int iCols, Int iRows )
+{
+  const __m256i one = _mm256_set1_epi16( 1 );
+  __m256i sum = _mm256_setzero_si256();
+  __m128i sum128 = _mm_setzero_si128();
+
+  for( Int y = 0; y < iRows; y++, piOrg += iStrideOrg, piCur += iStrideCur )
+  {
+    Int x = 0;
+    for( ; x + 16 <= iCols; x += 16 )
+    {
+      const __m256i diff = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* )( piOrg + x ) ), _mm256_loadu_si256( ( const __m256i* )( piCur + x ) ) );
+      sum = _mm256_add_epi32( sum, _mm256_madd_epi16( _mm256_abs_epi16( diff ), one ) );
+    }
+    if( x + 8 <= iCols )
+    {
+      const __m128i diff = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* )( piOrg + x ) ), _mm_loadu_si128( ( const __m128i* )( piCur + x ) ) );
+      sum128 = _mm_add_epi32( sum128, _mm_madd_epi16( _mm_abs_epi16( diff ), _mm256_castsi256_si128( one ) ) );
+      x += 8;
+    }
+    if( x < iCols )
+    {
+      const __m128i diff = _mm_sub_epi16( _mm_loadl_epi64( ( const __m128i* )( piOrg + x ) ), _mm_loadl_epi64( ( const __m128i* )( piCur + x ) ) );
+      sum128 = _mm_add_epi32( sum128, _mm_madd_epi16( _mm_abs_epi16( diff ), _mm256_castsi256_si128( one ) ) );
+    }
+  }
+
+  return xHorizontalSumAvx2( _mm256_add_epi32( sum, _mm256_zextsi128_si256( sum128 ) ) );
+}
+
+/// squares of the 16-bit differences, shifted right by uiShift, added to the 32-bit lanes of sum
+static SIMD_TARGET_AVX2 inline __m256i xAccumulateSquaresAvx2( __m256i sum, const __m256i diff, const UInt uiShift )
+{
+  if( uiShift == 0 )
+  {
+    return _mm256_add_epi32( sum, _mm256_madd_epi16( diff, diff ) );
+  }
+  const __m256i lo = _mm256_mullo_epi16( diff, diff );
+  const __m256i hi = _mm256_mulhi_epi16( diff, diff );
+  sum = _mm256_add_epi32( sum, _mm256_srli_epi32( _mm256_unpacklo_epi16( lo, hi ), uiShift ) );
+  return _mm256_add_epi32( sum, _mm256_srli_epi32( _mm256_unpackhi_epi16( lo, hi ), uiShift ) );
+}
+
+/// sum of the squared differences of a block whose width is a multiple of 4
+static SIMD_TARGET_AVX2 UInt xSSEAvx2( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur, Int iCols, Int iRows, UInt uiShift )
+{
+  __m256i sum = _mm256_setzero_si256();
+
+  for( Int y = 0; y < iRows; y++, piOrg += iStrideOrg, piCur += iStrideCur )
+  {
+    Int x = 0;
+    for( ; x + 16 <= iCols; x += 16 )
+    {
+      const __m256i diff = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* )( piOrg + x ) ), _mm256_loadu_si256( ( const __m256i* )( piCur + x ) ) );
+      sum = xAccumulateSquaresAvx2( sum, diff, uiShift );
+    }
+    if( x + 8 <= iCols )
+    {
+      const __m128i diff = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* )( piOrg + x ) ), _mm_loadu_si128( ( const __m128i* )( piCur + x ) ) );
+      sum = xAccumulateSquaresAvx2( sum, _mm256_zextsi128_si256( diff ), uiShift );
+      x += 8;
+    }
+    if( x < iCols )
+    {
+      const __m128i diff = _mm_sub_epi16( _mm_loadl_epi64( ( const __m128i* )( piOrg + x ) ), _mm_loadl_epi64( ( const __m128i* )( piCur + x ) ) );
+      sum = xAccumulateSquaresAvx2( sum, _mm256_zextsi128_si256( diff ), uiShift );
+    }
+  }
+
+  return xHorizontalSumAvx2( sum );
+}
+
+/// 4-point Hadamard transform of the columns held in the four registers
+static SIMD_TARGET_AVX2 inline Void xHadamard4Avx2( __m256i* m )
+{
+  const __m256i a0 = _mm256_add_epi32( m[0], m[2] );
+  const __m256i a1 = _mm256_add_epi32( m[1], m[3] );
+  const __m256i a2 = _mm256_sub_epi32( m[0], m[2] );
+  const __m256i a3 = _mm256_sub_epi32( m[1], m[3] );
+  m[0] = _mm256_add_epi32( a0, a1 );
+  m[1] = _mm256_sub_epi32( a0, a1 );
+  m[2] = _mm256_add_epi32( a2, a3 );
+  m[3] = _mm256_sub_epi32( a2, a3 );
+}
+
+/// transpose of the 4x4 blocks held in each 128-bit lane of the four registers
+static SIMD_TARGET_AVX2 inline Void xTranspose4x4LanesAvx2( __m256i* m )
+{
+  const __m256i t0 = _mm256_unpacklo_epi32( m[0], m[1] );
+  const __m256i t1 = _mm256_unpackhi_epi32( m[0], m[1] );
+  const __m256i t2 = _mm256_unpacklo_epi32( m[2], m[3] );
+  const __m256i t3 = _mm256_unpackhi_epi32( m[2], m[3] );
+  m[0] = _mm256_unpacklo_epi64( t0, t2 );
+  m[1] = _mm256_unpackhi_epi64( t0, t2 );
+  m[2] = _mm256_unpacklo_epi64( t1, t3 );
+  m[3] = _mm256_unpackhi_epi64( t1, t3 );
+}
+
+/// TComRdCost::xCalcHADs4x4 of two horizontally adjacent 4x4 blocks, one in each 128-bit lane
+static SIMD_TARGET_AVX2 UInt xHADs4x4PairAvx2( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur )
+{
+  __m256i m[4];
+  for( Int k = 0; k < 4; k++, piOrg += iStrideOrg, piCur += iStrideCur )
+  {
+    m[k] = _mm256_cvtepi16_epi32( _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* )piOrg ), _mm_loadu_si128( ( const __m128i* )piCur ) ) );
+  }
+
+  xHadamard4Avx2( m );
+  xTranspose4x4LanesAvx2( m );
+  xHadamard4Avx2( m );
+
+  __m256i sum = _mm256_add_epi32( _mm256_add_epi32( _mm256_abs_epi32( m[0] ), _mm256_abs_epi32( m[1] ) ),
+                                  _mm256_add_epi32( _mm256_abs_epi32( m[2] ), _mm256_abs_epi32( m[3] ) ) );
+  // each block is rounded separately
+  sum = _mm256_add_epi32( sum, _mm256_shuffle_epi32( sum, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+  sum = _mm256_add_epi32( sum, _mm256_shuffle_epi32( sum, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+  sum = _mm256_srli_epi32( _mm256_add_epi32( sum, _mm256_set1_epi32( 1 ) ), 1 );
+  return UInt( _mm_cvtsi128_si32( _mm256_castsi256_si128( sum ) ) + _mm_cvtsi128_si32( _mm256_extracti128_si256( sum, 1 ) ) );
+}
+
+/// 8-point Hadamard transform of the columns held in the eight registers
+static SIMD_TARGET_AVX2 inline Void xHadamard8Avx2( __m256i* m )
+{
+  __m256i a[8];
+  for( Int k = 0; k < 4; k++ )
+  {
+    a[k  ] = _mm256_add_epi32( m[k], m[k+4] );
+    a[k+4] = _mm256_sub_epi32( m[k], m[k+4] );
+  }
+  for( Int k = 0; k < 8; k += 4 )
+  {
+    m[k  ] = _mm256_add_epi32( a[k  ], a[k+2] );
+    m[k+1] = _mm256_add_epi32( a[k+1], a[k+3] );
+    m[k+2] = _mm256_sub_epi32( a[k  ], a[k+2] );
+    m[k+3] = _mm256_sub_epi32( a[k+1], a[k+3] );
+  }
+  for( Int k = 0; k < 8; k += 2 )
+  {
+    a[k  ] = _mm256_add_epi32( m[k], m[k+1] );
+    a[k+1] = _mm256_sub_epi32( m[k], m[k+1] );
+  }
+  for( Int k = 0; k < 8; k++ )
+  {
+    m[k] = a[k];
+  }
+}
+
+/// same as TComRdCost::xCalcHADs8x8, one row in each register
+static SIMD_TARGET_AVX2 UInt xHADs8x8Avx2( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur )
+{
+  __m256i m[8];
+  for( Int k = 0; k < 8; k++, piOrg += iStrideOrg, piCur += iStrideCur )
+  {
+    m[k] = _mm256_cvtepi16_epi32( _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* )piOrg ), _mm_loadu_si128( ( const __m128i* )piCur ) ) );
+  }
+
+  xHadamard8Avx2( m );
+
+  // transpose the 4x4 blocks of each lane, then exchange the top-right and bottom-left blocks
+  xTranspose4x4LanesAvx2( m );
+  xTranspose4x4LanesAvx2( m + 4 );
+  for( Int k = 0; k < 4; k++ )
+  {
+    const __m256i top = m[k];
+    m[k  ] = _mm256_permute2x128_si256( top, m[k+4], 0x20 );
+    m[k+4] = _mm256_permute2x128_si256( top, m[k+4], 0x31 );
+  }
+
+  xHadamard8Avx2( m );
+
+  __m256i sum = _mm256_setzero_si256();
+  for( Int k = 0; k < 8; k++ )
+  {
+    sum = _mm256_add_epi32( sum, _mm256_abs_epi32( m[k] ) );
+  }
+  return ( xHorizontalSumAvx2( sum ) + 2 ) >> 2;
+}
+
+// ====================================================================================================================
+// Distortion functions
+// ====================================================================================================================
+
+template<SimdExtension simdExtension>
+Distortion TComRdCost::xGetSSESimd( DistParam* pcDtParam )
+{
+  if( pcDtParam->bApplyWeight || pcDtParam->bitDepth > SIMD_MAX_BIT_DEPTH || ( pcDtParam->iCols & 3 ) != 0 )
+  {
+    return xGetSSE( pcDtParam );
+  }
+
+  const UInt uiShift = DISTORTION_PRECISION_ADJUSTMENT((pcDtParam->bitDepth-8) << 1);
+
+  if( simdExtension == SIMD_AVX2 )
+  {
+    return xSSEAvx2( pcDtParam->pOrg, pcDtParam->iStrideOrg, pcDtParam->pCur, pcDtParam->iStrideCur, pcDtParam->iCols, pcDtParam->iRows, uiShift );
+  }
+  return xSSESse41( pcDtParam->pOrg, pcDtParam->iStrideOrg, pcDtParam->pCur, pcDtParam->iStrideCur, pcDtParam->iCols, pcDtParam->iRows, uiShift );
+}
+
+/** SAD of the functions registered for eDFunc. The general size functions (DF_SAD and DF_SADS) ignore the vertical
+ * subsampling, like xGetSAD.
+ */
+template<SimdExtension simdExtension, DFunc eDFunc>
+Distortion TComRdCost::xGetSADSimd( DistParam* pcDtParam )
+{
+  const Bool bGeneralSize = ( eDFunc == DF_SAD || eDFunc == DF_SADS );
+
+  if( pcDtParam->bApplyWeight || pcDtParam->bitDepth > SIMD_MAX_BIT_DEPTH || ( pcDtParam->iCols & 3 ) != 0 )
+  {
+    switch( eDFunc )
+    {
+      case DF_SAD4:   case DF_SADS4:   return xGetSAD4  ( pcDtParam );
+      case DF_SAD8:   case DF_SADS8:   return xGetSAD8  ( pcDtParam );
+      case DF_SAD12:  case DF_SADS12:  return xGetSAD12 ( pcDtParam );
+      case DF_SAD16:  case DF_SADS16:  return xGetSAD16 ( pcDtParam );
+      case DF_SAD24:  case DF_SADS24:  return xGetSAD24 ( pcDtParam );
+      case DF_SAD32:  case DF_SADS32:  return xGetSAD32 ( pcDtParam );
+      case DF_SAD48:  case DF_SADS48:  return xGetSAD48 ( pcDtParam );
+      case DF_SAD64:  case DF_SADS64:  return xGetSAD64 ( pcDtParam );
+      case DF_SAD16N: case DF_SADS16N: return xGetSAD16N( pcDtParam );
+      default:                         return xGetSAD   ( pcDtParam );
+    }
+  }
+
+  const Int iSubShift = bGeneralSize ? 0 : pcDtParam->iSubShift;
+  const Int iRows     = pcDtParam->iRows >> iSubShift;
+
+  Distortion uiSum;
+  if( simdExtension == SIMD_AVX2 )
+  {
+    uiSum = xSADAvx2 ( pcDtParam->pOrg, pcDtParam->iStrideOrg << iSubShift, pcDtParam->pCur, pcDtParam->iStrideCur << iSubShift, pcDtParam->iCols, iRows );
+  }
+  else
+  {
+    uiSum = xSADSse41( pcDtParam->pOrg, pcDtParam->iStrideOrg << iSubShift, pcDtParam->pCur, pcDtParam->iStrideCur << iSubShift, pcDtParam->iCols, iRows );
+  }
+
+  uiSum <<= iSubShift;
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) );
+}
+
+template<SimdExtension simdExtension>
+Distortion TComRdCost::xGetHADsSimd( DistParam* pcDtParam )
+{
+  const Int iRows = pcDtParam->iRows;
+  const Int iCols = pcDtParam->iCols;
+
+  if( pcDtParam->bApplyWeight || pcDtParam->bitDepth > SIMD_MAX_BIT_DEPTH || pcDtParam->iStep != 1 || ( iRows & 3 ) != 0 || ( iCols & 3 ) != 0 )
+  {
+    return xGetHADs( pcDtParam );
+  }
+
+  const Pel* piOrg      = pcDtParam->pOrg;
+  const Pel* piCur      = pcDtParam->pCur;
+  const Int  iStrideOrg = pcDtParam->iStrideOrg;
+  const Int  iStrideCur = pcDtParam->iStrideCur;
+
+  Distortion uiSum = 0;
+
+  if( ( iRows & 7 ) == 0 && ( iCols & 7 ) == 0 )
+  {
+    for( Int y = 0; y < iRows; y += 8, piOrg += iStrideOrg*8, piCur += iStrideCur*8 )
+    {
+      for( Int x = 0; x < iCols; x += 8 )
+      {
+        uiSum += simdExtension == SIMD_AVX2 ? xHADs8x8Avx2 ( piOrg + x, iStrideOrg, piCur + x, iStrideCur )
+                                            : xHADs8x8Sse41( piOrg + x, iStrideOrg, piCur + x, iStrideCur );
+      }
+    }
+  }
+  else
+  {
+    for( Int y = 0; y < iRows; y += 4, piOrg += iStrideOrg*4, piCur += iStrideCur*4 )
+    {
+      Int x = 0;
+      if( simdExtension == SIMD_AVX2 )
+      {
+        for( ; x + 8 <= iCols; x += 8 )
+        {
+          uiSum += xHADs4x4PairAvx2( piOrg + x, iStrideOrg, piCur + x, iStrideCur );
+        }
+      }
+      for( ; x < iCols; x += 4 )
+      {
+        uiSum += xHADs4x4Sse41( piOrg + x, iStrideOrg, piCur + x, iStrideCur );
+      }
+    }
+  }
+
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) );
+}
+
+// ====================================================================================================================
+// Initialisation
+// ====================================================================================================================
+
+Void TComRdCost::xInitSimdDistortionFunctions( SimdExtension simdExtension )
+{
+  if( simdExtension >= SIMD_AVX2 )
+  {
+    m_afpDistortFunc[DF_SSE    ] = TComRdCost::xGetSSESimd<SIMD_AVX2>;
+    m_afpDistortFunc[DF_SSE4   ] = TComRdCost::xGetSSESimd<SIMD_AVX2>;
+    m_afpDistortFunc[DF_SSE8   ] = TComRdCost::xGetSSESimd<SIMD_AVX2>;
+    m_afpDistortFunc[DF_SSE16  ] = TComRdCost::xGetSSESimd<SIMD_AVX2>;
+    m_afpDistortFunc[DF_SSE32  ] = TComRdCost::xGetSSESimd<SIMD_AVX2>;
+    m_afpDistortFunc[DF_SSE64  ] = TComRdCost::xGetSSESimd<SIMD_AVX2>;
+    m_afpDistortFunc[DF_SSE16N ] = TComRdCost::xGetSSESimd<SIMD_AVX2>;
+
+    m_afpDistortFunc[DF_SAD    ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SAD    >;
+    m_afpDistortFunc[DF_SAD4   ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SAD4   >;
+    m_afpDistortFunc[DF_SAD8   ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SAD8   >;
+    m_afpDistortFunc[DF_SAD16  ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SAD16  >;
+    m_afpDistortFunc[DF_SAD32  ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SAD32  >;
+    m_afpDistortFunc[DF_SAD64  ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SAD64  >;
+    m_afpDistortFunc[DF_SAD16N ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SAD16N >;
+
+    m_afpDistortFunc[DF_SADS   ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SADS   >;
+    m_afpDistortFunc[DF_SADS4  ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SADS4  >;
+    m_afpDistortFunc[DF_SADS8  ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SADS8  >;
+    m_afpDistortFunc[DF_SADS16 ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SADS16 >;
+    m_afpDistortFunc[DF_SADS32 ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SADS32 >;
+    m_afpDistortFunc[DF_SADS64 ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SADS64 >;
+    m_afpDistortFunc[DF_SADS16N] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SADS16N>;
+
+    m_afpDistortFunc[DF_SAD12  ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SAD12  >;
+    m_afpDistortFunc[DF_SAD24  ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SAD24  >;
+    m_afpDistortFunc[DF_SAD48  ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SAD48  >;
+
+    m_afpDistortFunc[DF_SADS12 ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SADS12 >;
+    m_afpDistortFunc[DF_SADS24 ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SADS24 >;
+    m_afpDistortFunc[DF_SADS48 ] = TComRdCost::xGetSADSimd<SIMD_AVX2, DF_SADS48 >;
+
+    m_afpDistortFunc[DF_HADS   ] = TComRdCost::xGetHADsSimd<SIMD_AVX2>;
+    m_afpDistortFunc[DF_HADS4  ] = TComRdCost::xGetHADsSimd<SIMD_AVX2>;
+    m_afpDistortFunc[DF_HADS8  ] = TComRdCost::xGetHADsSimd<SIMD_AVX2>;
+    m_afpDistortFunc[DF_HADS16 ] = TComRdCost::xGetHADsSimd<SIMD_AVX2>;
+    m_afpDistortFunc[DF_HADS32 ] = TComRdCost::xGetHADsSimd<SIMD_AVX2>;
+    m_afpDistortFunc[DF_HADS64 ] = TComRdCost::xGetHADsSimd<SIMD_AVX2>;
+    m_afpDistortFunc[DF_HADS16N] = TComRdCost::xGetHADsSimd<SIMD_AVX2>;
+  }
+  else if( simdExtension >= SIMD_SSE41 )
+  {
+    m_afpDistortFunc[DF_SSE    ] = TComRdCost::xGetSSESimd<SIMD_SSE41>;
+    m_afpDistortFunc[DF_SSE4   ] = TComRdCost::xGetSSESimd<SIMD_SSE41>;
+    m_afpDistortFunc[DF_SSE8   ] = TComRdCost::xGetSSESimd<SIMD_SSE41>;
+    m_afpDistortFunc[DF_SSE16  ] = TComRdCost::xGetSSESimd<SIMD_SSE41>;
+    m_afpDistortFunc[DF_SSE32  ] = TComRdCost::xGetSSESimd<SIMD_SSE41>;
+    m_afpDistortFunc[DF_SSE64  ] = TComRdCost::xGetSSESimd<SIMD_SSE41>;
+    m_afpDistortFunc[DF_SSE16N ] = TComRdCost::xGetSSESimd<SIMD_SSE41>;
+
+    m_afpDistortFunc[DF_SAD    ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SAD    >;
+    m_afpDistortFunc[DF_SAD4   ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SAD4   >;
+    m_afpDistortFunc[DF_SAD8   ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SAD8   >;
+    m_afpDistortFunc[DF_SAD16  ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SAD16  >;
+    m_afpDistortFunc[DF_SAD32  ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SAD32  >;
+    m_afpDistortFunc[DF_SAD64  ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SAD64  >;
+    m_afpDistortFunc[DF_SAD16N ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SAD16N >;
+
+    m_afpDistortFunc[DF_SADS   ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SADS   >;
+    m_afpDistortFunc[DF_SADS4  ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SADS4  >;
+    m_afpDistortFunc[DF_SADS8  ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SADS8  >;
+    m_afpDistortFunc[DF_SADS16 ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SADS16 >;
+    m_afpDistortFunc[DF_SADS32 ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SADS32 >;
+    m_afpDistortFunc[DF_SADS64 ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SADS64 >;
+    m_afpDistortFunc[DF_SADS16N] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SADS16N>;
+
+    m_afpDistortFunc[DF_SAD12  ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SAD12  >;
+    m_afpDistortFunc[DF_SAD24  ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SAD24  >;
+    m_afpDistortFunc[DF_SAD48  ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SAD48  >;
+
+    m_afpDistortFunc[DF_SADS12 ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SADS12 >;
+    m_afpDistortFunc[DF_SADS24 ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SADS24 >;
+    m_afpDistortFunc[DF_SADS48 ] = TComRdCost::xGetSADSimd<SIMD_SSE41, DF_SADS48 >;
+
+    m_afpDistortFunc[DF_HADS   ] = TComRdCost::xGetHADsSimd<SIMD_SSE41>;
+    m_afpDistortFunc[DF_HADS4  ] = TComRdCost::xGetHADsSimd<SIMD_SSE41>;
+    m_afpDistortFunc[DF_HADS8  ] = TComRdCost::xGetHADsSimd<SIMD_SSE41>;
+    m_afpDistortFunc[DF_HADS16 ] = TComRdCost::xGetHADsSimd<SIMD_SSE41>;
+    m_afpDistortFunc[DF_HADS32 ] = TComRdCost::xGetHADsSimd<SIMD_SSE41>;
+    m_afpDistortFunc[DF_HADS64 ] = TComRdCost::xGetHADsSimd<SIMD_SSE41>;
+    m_afpDistortFunc[DF_HADS16N] = TComRdCost::xGetHADsSimd<SIMD_SSE41>;
+  }
+}
+
+//! \}
+
+#endif
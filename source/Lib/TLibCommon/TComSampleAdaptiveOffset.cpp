@@ -636,6 +636,61 @@ Void TComSampleAdaptiveOffset::SAOProcess(TComPic* pDecPic)
   } //ctu
 }
 
+/** Reconstruct the SAO parameters of the CTUs of one CTU row, see reconstructBlkSAOParams.
+ * The parameters of the rows above must have been reconstructed before, as a CTU can be merged with the CTU above.
+ * \param pic          picture (TComPic) pointer
+ * \param saoBlkParams SAO parameters of the CTUs of the picture
+ * \param ctuRowIdx    CTU row to reconstruct
+ */
+Void TComSampleAdaptiveOffset::reconstructBlkSAOParamsCtuRow(TComPic* pic, SAOBlkParam* saoBlkParams, Int ctuRowIdx)
+{
+  for(Int ctuRsAddr = ctuRowIdx*m_numCTUInWidth; ctuRsAddr < (ctuRowIdx+1)*m_numCTUInWidth; ctuRsAddr++)
+  {
+    SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES] = { NULL };
+    getMergeList(pic, ctuRsAddr, saoBlkParams, mergeList);
+
+    reconstructBlkSAOParam(saoBlkParams[ctuRsAddr], mergeList);
+  }
+}
+
+/** Apply SAO to the CTUs of one CTU row, see SAOProcess.
+ * Only the deblocked samples of the row and of the first line of the row below are saved, so the rows above must have
+ * been processed before, and the row below must have been deblocked.
+ * \param pDecPic   picture (TComPic) pointer
+ * \param ctuRowIdx CTU row to filter
+ */
+Void TComSampleAdaptiveOffset::SAOProcessCtuRow(TComPic* pDecPic, Int ctuRowIdx)
+{
+  SAOBlkParam* saoBlkParams = pDecPic->getPicSym()->getSAOBlkParam();
+  const Int    numberOfComponents = getNumberValidComponents(m_chromaFormatIDC);
+  const Int    firstCtuRsAddr = ctuRowIdx*m_numCTUInWidth;
+
+  // the row is saved even when SAO is off for all its CTUs, as the row below reads its deblocked samples
+  TComPicYuv* resYuv = pDecPic->getPicYuvRec();
+  TComPicYuv* srcYuv = m_tempPicYuv;
+  for(Int compIdx = 0; compIdx < numberOfComponents; compIdx++)
+  {
+    const ComponentID component = ComponentID(compIdx);
+    const UInt componentScaleY = getComponentScaleY(component, pDecPic->getChromaFormat());
+    const Int  firstLine = (ctuRowIdx*m_maxCUHeight) >> componentScaleY;
+    const Int  endLine   = std::min(((ctuRowIdx+1)*m_maxCUHeight >> componentScaleY) + 1, resYuv->getHeight(component));
+    const Int  resStride = resYuv->getStride(component);
+    const Int  srcStride = srcYuv->getStride(component);
+    const Pel* pRes = resYuv->getAddr(component) + firstLine*resStride;
+    Pel*       pSrc = srcYuv->getAddr(component) + firstLine*srcStride;
+
+    for(Int y = firstLine; y < endLine; y++, pRes += resStride, pSrc += srcStride)
+    {
+      ::memcpy(pSrc, pRes, sizeof(Pel)*resYuv->getWidth(component));
+    }
+  }
+
+  for(Int ctuRsAddr = firstCtuRsAddr; ctuRsAddr < firstCtuRsAddr + m_numCTUInWidth; ctuRsAddr++)
+  {
+    offsetCTU(ctuRsAddr, srcYuv, resYuv, saoBlkParams[ctuRsAddr], pDecPic);
+  } //ctu
+}
+
 
 /** PCM LF disable process.
  * \param pcPic picture (TComPic) pointer
@@ -652,9 +707,7 @@ Void TComSampleAdaptiveOffset::PCMLFDisableProcess (TComPic* pcPic)
  */
 Void TComSampleAdaptiveOffset::xPCMRestoration(TComPic* pcPic)
 {
-  Bool  bPCMFilter = (pcPic->getSlice(0)->getSPS()->getUsePCM() && pcPic->getSlice(0)->getSPS()->getPCMFilterDisableFlag())? true : false;
-
-  if(bPCMFilter || pcPic->getSlice(0)->getPPS()->getTransquantBypassEnabledFlag())
+  if(xUsePCMRestoration(pcPic))
   {
     for( UInt ctuRsAddr = 0; ctuRsAddr < pcPic->getNumberOfCtusInFrame() ; ctuRsAddr++ )
     {
@@ -665,6 +718,31 @@ Void TComSampleAdaptiveOffset::xPCMRestoration(TComPic* pcPic)
   }
 }
 
+/** Whether the filtered samples of PCM or lossless blocks have to be restored.
+ * \param pcPic picture (TComPic) pointer
+ */
+Bool TComSampleAdaptiveOffset::xUsePCMRestoration(TComPic* pcPic) const
+{
+  Bool  bPCMFilter = (pcPic->getSlice(0)->getSPS()->getUsePCM() && pcPic->getSlice(0)->getSPS()->getPCMFilterDisableFlag())? true : false;
+
+  return bPCMFilter || pcPic->getSlice(0)->getPPS()->getTransquantBypassEnabledFlag();
+}
+
+/** CTU-row-level PCM LF disable process, see PCMLFDisableProcess.
+ * \param pcPic     picture (TComPic) pointer
+ * \param ctuRowIdx CTU row to restore
+ */
+Void TComSampleAdaptiveOffset::PCMLFDisableProcessCtuRow(TComPic* pcPic, Int ctuRowIdx)
+{
+  if(xUsePCMRestoration(pcPic))
+  {
+    for(Int ctuRsAddr = ctuRowIdx*m_numCTUInWidth; ctuRsAddr < (ctuRowIdx+1)*m_numCTUInWidth; ctuRsAddr++)
+    {
+      xPCMCURestoration(pcPic->getCtu(ctuRsAddr), 0, 0);
+    }
+  }
+}
+
 /** PCM CU restoration.
  * \param pcCU            pointer to current CU
  * \param uiAbsZorderIdx  part index
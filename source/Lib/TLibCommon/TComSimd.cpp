@@ -0,0 +1,100 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComSimd.cpp
+    \brief    Run-time selection of the SIMD instruction set extensions
+*/
+
+#include "TComSimd.h"
+
+#if defined(_MSC_VER) && ( defined(_M_X64) || defined(_M_IX86) )
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+//! \ingroup TLibCommon
+//! \{
+
+static SimdExtension s_maxSimdExtension = SIMD_AVX2;
+
+// ====================================================================================================================
+// Private function definitions
+// ====================================================================================================================
+
+static SimdExtension xDetectSimdExtension()
+{
+#if defined(_MSC_VER) && ( defined(_M_X64) || defined(_M_IX86) )
+  Int cpuInfo[4];
+  __cpuid( cpuInfo, 0 );
+  const Int maxLeaf = cpuInfo[0];
+
+  __cpuid( cpuInfo, 1 );
+  const Bool sse41   = ( ( cpuInfo[2] >> 19 ) & 1 ) != 0;
+  const Bool osxsave = ( ( cpuInfo[2] >> 27 ) & 1 ) != 0;
+  const Bool avx     = ( ( cpuInfo[2] >> 28 ) & 1 ) != 0;
+
+  Bool avx2 = false;
+  // the operating system must save the YMM registers
+  if ( maxLeaf >= 7 && osxsave && avx && ( _xgetbv( 0 ) & 6 ) == 6 )
+  {
+    __cpuidex( cpuInfo, 7, 0 );
+    avx2 = ( ( cpuInfo[1] >> 5 ) & 1 ) != 0;
+  }
+#elif defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+  __builtin_cpu_init();
+  const Bool sse41 = __builtin_cpu_supports( "sse4.1" ) != 0;
+  const Bool avx2  = __builtin_cpu_supports( "avx2" ) != 0;
+#else
+  const Bool sse41 = false;
+  const Bool avx2  = false;
+#endif
+
+  return avx2 ? SIMD_AVX2 : ( sse41 ? SIMD_SSE41 : SIMD_NONE );
+}
+
+// ====================================================================================================================
+// Public function definitions
+// ====================================================================================================================
+
+SimdExtension getSimdExtension()
+{
+  static const SimdExtension simdExtension = xDetectSimdExtension();
+  return std::min( simdExtension, s_maxSimdExtension );
+}
+
+Void setMaxSimdExtension( SimdExtension maxSimdExtension )
+{
+  s_maxSimdExtension = maxSimdExtension;
+}
+
+//! \}
@@ -0,0 +1,95 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComSimd.h
+    \brief    Run-time selection of the SIMD instruction set extensions (header)
+*/
+
+#ifndef __TCOMSIMD__
+#define __TCOMSIMD__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "CommonDef.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Constants
+// ====================================================================================================================
+
+/// Functions using the instructions of an extension beyond the compiler's baseline must be marked with these
+/// attributes. Other compilers make all the intrinsics available without them.
+/// SIMD_FLATTEN additionally inlines the generic helpers called by such a function, so that they are compiled for
+/// the extension of the function.
+#if defined(__GNUC__)
+#define SIMD_TARGET_SSE41  __attribute__((target("sse4.1")))
+#define SIMD_TARGET_AVX2   __attribute__((target("avx2")))
+#define SIMD_FLATTEN       __attribute__((flatten))
+#else
+#define SIMD_TARGET_SSE41
+#define SIMD_TARGET_AVX2
+#define SIMD_FLATTEN
+#endif
+
+// ====================================================================================================================
+// Enumeration
+// ====================================================================================================================
+
+/// SIMD instruction set extensions, in increasing order of capability
+enum SimdExtension
+{
+  SIMD_NONE  = 0,
+  SIMD_SSE41 = 1,
+  SIMD_AVX2  = 2
+};
+
+// ====================================================================================================================
+// Function declarations
+// ====================================================================================================================
+
+/// most capable extension supported by the CPU and the operating system, detected on the first call, and limited by
+/// setMaxSimdExtension()
+SimdExtension getSimdExtension();
+
+/// limits the extension returned by getSimdExtension(), for example to compare the kernels of each extension with the C
+/// code. It must be called before the threads using the kernels are started; the functions keeping the extension of
+/// their first call (such as the file reading and writing) are not affected by later calls.
+Void setMaxSimdExtension( SimdExtension maxSimdExtension );
+
+//! \}
+
+#endif // __TCOMSIMD__
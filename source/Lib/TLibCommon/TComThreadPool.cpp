@@ -0,0 +1,174 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComThreadPool.cpp
+    \brief    Worker thread pool and wavefront progress tracking
+*/
+
+#include "TComThreadPool.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// TComThreadPool
+// ====================================================================================================================
+
+TComThreadPool::TComThreadPool()
+: m_numActiveJobs(0)
+, m_bTerminate   (false)
+{
+}
+
+TComThreadPool::~TComThreadPool()
+{
+  destroy();
+}
+
+Void TComThreadPool::create( Int numThreads )
+{
+  assert( m_threads.empty() );
+  m_bTerminate    = false;
+  m_numActiveJobs = 0;
+  for( Int threadIdx = 0; threadIdx < numThreads; threadIdx++ )
+  {
+    m_threads.push_back( std::thread( &TComThreadPool::xThreadLoop, this, threadIdx ) );
+  }
+}
+
+Void TComThreadPool::destroy()
+{
+  if( m_threads.empty() )
+  {
+    return;
+  }
+  waitForAll();
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_bTerminate = true;
+  }
+  m_jobAvailable.notify_all();
+  for( UInt threadIdx = 0; threadIdx < m_threads.size(); threadIdx++ )
+  {
+    m_threads[threadIdx].join();
+  }
+  m_threads.clear();
+}
+
+Void TComThreadPool::addJob( const Job &job )
+{
+  assert( !m_threads.empty() );
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_jobs.push_back( job );
+    m_numActiveJobs++;
+  }
+  m_jobAvailable.notify_one();
+}
+
+Void TComThreadPool::waitForAll()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  while( m_numActiveJobs > 0 )
+  {
+    m_jobsFinished.wait( lock );
+  }
+}
+
+Void TComThreadPool::xThreadLoop( Int threadIdx )
+{
+  for(;;)
+  {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      while( m_jobs.empty() && !m_bTerminate )
+      {
+        m_jobAvailable.wait( lock );
+      }
+      if( m_jobs.empty() )
+      {
+        return;
+      }
+      job = m_jobs.front();
+      m_jobs.pop_front();
+    }
+
+    job( threadIdx );
+
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_numActiveJobs--;
+      if( m_numActiveJobs == 0 )
+      {
+        m_jobsFinished.notify_all();
+      }
+    }
+  }
+}
+
+// ====================================================================================================================
+// TComWavefrontSync
+// ====================================================================================================================
+
+Void TComWavefrontSync::create( Int numRows, Int initialValue )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_progress.assign( numRows, initialValue );
+}
+
+Void TComWavefrontSync::setProgress( Int row, Int value )
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_progress[row] = value;
+  }
+  m_progressChanged.notify_all();
+}
+
+Void TComWavefrontSync::waitForProgress( Int row, Int value )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  while( m_progress[row] < value )
+  {
+    m_progressChanged.wait( lock );
+  }
+}
+
+Int TComWavefrontSync::getProgress( Int row )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  return m_progress[row];
+}
+
+//! \}
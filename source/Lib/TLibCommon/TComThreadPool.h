@@ -0,0 +1,115 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComThreadPool.h
+    \brief    Worker thread pool and wavefront progress tracking (header)
+*/
+
+#ifndef __TCOMTHREADPOOL__
+#define __TCOMTHREADPOOL__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "CommonDef.h"
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// fixed-size pool of worker threads executing jobs in FIFO order
+class TComThreadPool
+{
+public:
+  /// a job is called with the index of the worker thread executing it (0..getNumThreads()-1)
+  typedef std::function<Void(Int threadIdx)> Job;
+
+private:
+  std::vector<std::thread>  m_threads;
+  std::deque<Job>           m_jobs;
+  std::mutex                m_mutex;
+  std::condition_variable   m_jobAvailable;
+  std::condition_variable   m_jobsFinished;
+  Int                       m_numActiveJobs;
+  Bool                      m_bTerminate;
+
+  Void xThreadLoop          ( Int threadIdx );
+
+public:
+  TComThreadPool();
+  ~TComThreadPool();
+
+  Void create               ( Int numThreads );
+  Void destroy              ();
+
+  Int  getNumThreads        () const { return (Int)m_threads.size(); }
+
+  /// queue a job. Jobs are started in the order in which they were added.
+  Void addJob               ( const Job &job );
+
+  /// block until all queued jobs have finished
+  Void waitForAll           ();
+};
+
+/// per-row progress counters, used to let a row wait until the row above has advanced far enough (wavefront order)
+class TComWavefrontSync
+{
+private:
+  std::vector<Int>          m_progress;
+  std::mutex                m_mutex;
+  std::condition_variable   m_progressChanged;
+
+public:
+  TComWavefrontSync() {}
+
+  Void create               ( Int numRows, Int initialValue );
+  Void setProgress          ( Int row, Int value );
+  Void waitForProgress      ( Int row, Int value );
+  Int  getProgress          ( Int row );
+  Int  getNumRows           () const { return (Int)m_progress.size(); }
+};
+
+//! \}
+
+#endif // __TCOMTHREADPOOL__
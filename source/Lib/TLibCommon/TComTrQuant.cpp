@@ -45,6 +45,11 @@
 #include "TComTU.h"
 #include "Debug.h"
 
+#if VECTOR_CODING__TRANSFORM && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include "TComSimd.h"
+#include <immintrin.h>
+#endif
+
 typedef struct
 {
   Int    iNNZbeforePos0;
@@ -54,6 +59,15 @@ typedef struct
   Double d64SigCost_0;
 } coeffGroupRDStats;
 
+typedef struct
+{
+  Int    iNNZbeforePos0;
+  Int64  i64CodedLevelandDist; // distortion and level cost only
+  Int64  i64UncodedDist;    // all zero coded block distortion
+  Int64  i64SigCost;
+  Int64  i64SigCost_0;
+} coeffGroupRDStatsFixedPoint;
+
 //! \ingroup TLibCommon
 //! \{
 
@@ -63,6 +77,29 @@ typedef struct
 
 #define RDOQ_CHROMA                 1           ///< use of RDOQ in chroma
 
+#define RDOQ_FP_ERROR_FRAC_BITS     8           ///< fractional bits of a quantization step kept in the fixed-point RDOQ error
+#define RDOQ_FP_WEIGHT_BITS         16          ///< bits of the largest fixed-point RDOQ distortion weight of a TU
+#define RDOQ_FP_MIN_WEIGHT_SHIFT    2           ///< smallest scale of the fixed-point RDOQ weights that keeps the TU cost in 64 bits
+#define RDOQ_FP_MAX_WEIGHT_SHIFT    62          ///< largest scale of the fixed-point RDOQ weights
+#define RDOQ_FP_MAX_LEVEL           (1 << 10)   ///< largest level handled by the fixed-point RDOQ
+
+// ====================================================================================================================
+// Static functions
+// ====================================================================================================================
+
+/** Weighted squared quantization error of the fixed-point RDOQ, in units of the estimated rate
+ * \param error quantization error, scaled as the unrounded level
+ * \param errorShift number of bits dropped from the error before it is squared
+ * \param errorWeight distortion weight, including the inverse of lambda
+ * \param weightShift scale of errorWeight
+ * \returns distortion cost
+ */
+static inline Int64 fixedPointDistortion( const Intermediate_Int error, const Int errorShift, const Int64 errorWeight, const Int weightShift )
+{
+  const Int64 scaledError = (errorShift > 0) ? ((Int64(error) + (Int64(1) << (errorShift - 1))) >> errorShift) : Int64(error);
+  return (scaledError * scaledError * errorWeight + (Int64(1) << (weightShift - 1))) >> weightShift;
+}
+
 
 // ====================================================================================================================
 // QpParam constructor
@@ -847,6 +884,348 @@ Void partialButterflyInverse32(TCoeff *src, TCoeff *dst, Int shift, Int line, co
   }
 }
 
+#if VECTOR_CODING__TRANSFORM && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+// ====================================================================================================================
+// SSE4.1 and AVX2 versions of the transforms
+// ====================================================================================================================
+// Each vector holds the same position of 4 (SSE4.1) or 8 (AVX2) consecutive lines, so the butterflies above map to
+// vector additions and multiplications. The arithmetic is done in 32-bit lanes, which wrap around like the TCoeff
+// arithmetic of the C functions, so the results are identical for every maxLog2TrDynamicRange.
+
+struct TrVecSse41
+{
+  typedef __m128i Vec;
+  static const Int lanes = 4;
+
+  static SIMD_TARGET_SSE41 inline Vec  load ( const TCoeff *src )                      { return _mm_loadu_si128( ( const __m128i* )src ); }
+  static SIMD_TARGET_SSE41 inline Void store( TCoeff *dst, const Vec a )                { _mm_storeu_si128( ( __m128i* )dst, a ); }
+  static SIMD_TARGET_SSE41 inline Vec  set1 ( const Int value )                         { return _mm_set1_epi32( value ); }
+  static SIMD_TARGET_SSE41 inline Vec  add  ( const Vec a, const Vec b )                { return _mm_add_epi32( a, b ); }
+  static SIMD_TARGET_SSE41 inline Vec  sub  ( const Vec a, const Vec b )                { return _mm_sub_epi32( a, b ); }
+  static SIMD_TARGET_SSE41 inline Vec  mul  ( const Vec a, const Int coeff )            { return _mm_mullo_epi32( a, _mm_set1_epi32( coeff ) ); }
+  static SIMD_TARGET_SSE41 inline Vec  sra  ( const Vec a, const Int shift )            { return _mm_sra_epi32( a, _mm_cvtsi32_si128( shift ) ); }
+  static SIMD_TARGET_SSE41 inline Vec  clip ( const Vec a, const Vec min, const Vec max ) { return _mm_min_epi32( _mm_max_epi32( a, min ), max ); }
+
+  /// transpose of the 4x4 block held in m[0..3]
+  static SIMD_TARGET_SSE41 inline Void transpose( Vec *m )
+  {
+    const __m128i t0 = _mm_unpacklo_epi32( m[0], m[1] );
+    const __m128i t1 = _mm_unpackhi_epi32( m[0], m[1] );
+    const __m128i t2 = _mm_unpacklo_epi32( m[2], m[3] );
+    const __m128i t3 = _mm_unpackhi_epi32( m[2], m[3] );
+    m[0] = _mm_unpacklo_epi64( t0, t2 );
+    m[1] = _mm_unpackhi_epi64( t0, t2 );
+    m[2] = _mm_unpacklo_epi64( t1, t3 );
+    m[3] = _mm_unpackhi_epi64( t1, t3 );
+  }
+};
+
+struct TrVecAvx2
+{
+  typedef __m256i Vec;
+  static const Int lanes = 8;
+
+  static SIMD_TARGET_AVX2 inline Vec  load ( const TCoeff *src )                      { return _mm256_loadu_si256( ( const __m256i* )src ); }
+  static SIMD_TARGET_AVX2 inline Void store( TCoeff *dst, const Vec a )                { _mm256_storeu_si256( ( __m256i* )dst, a ); }
+  static SIMD_TARGET_AVX2 inline Vec  set1 ( const Int value )                         { return _mm256_set1_epi32( value ); }
+  static SIMD_TARGET_AVX2 inline Vec  add  ( const Vec a, const Vec b )                { return _mm256_add_epi32( a, b ); }
+  static SIMD_TARGET_AVX2 inline Vec  sub  ( const Vec a, const Vec b )                { return _mm256_sub_epi32( a, b ); }
+  static SIMD_TARGET_AVX2 inline Vec  mul  ( const Vec a, const Int coeff )            { return _mm256_mullo_epi32( a, _mm256_set1_epi32( coeff ) ); }
+  static SIMD_TARGET_AVX2 inline Vec  sra  ( const Vec a, const Int shift )            { return _mm256_sra_epi32( a, _mm_cvtsi32_si128( shift ) ); }
+  static SIMD_TARGET_AVX2 inline Vec  clip ( const Vec a, const Vec min, const Vec max ) { return _mm256_min_epi32( _mm256_max_epi32( a, min ), max ); }
+
+  /// transpose of the 8x8 block held in m[0..7]
+  static SIMD_TARGET_AVX2 inline Void transpose( Vec *m )
+  {
+    __m256i t[8], u[8];
+    for( Int k = 0; k < 8; k += 2 )
+    {
+      t[k  ] = _mm256_unpacklo_epi32( m[k], m[k+1] );
+      t[k+1] = _mm256_unpackhi_epi32( m[k], m[k+1] );
+    }
+    for( Int k = 0; k < 8; k += 4 )
+    {
+      u[k  ] = _mm256_unpacklo_epi64( t[k  ], t[k+2] );
+      u[k+1] = _mm256_unpackhi_epi64( t[k  ], t[k+2] );
+      u[k+2] = _mm256_unpacklo_epi64( t[k+1], t[k+3] );
+      u[k+3] = _mm256_unpackhi_epi64( t[k+1], t[k+3] );
+    }
+    for( Int k = 0; k < 4; k++ )
+    {
+      m[k  ] = _mm256_permute2x128_si256( u[k], u[k+4], 0x20 );
+      m[k+4] = _mm256_permute2x128_si256( u[k], u[k+4], 0x31 );
+    }
+  }
+};
+
+// The generic functions below are only compiled inlined into the SSE4.1 and AVX2 functions that call them, so the ABI
+// of their vector arguments never matters.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+/** N-point forward transform of the vectors x, using the N x N matrix T (partialButterfly4 to partialButterfly32,
+ *  or the DST matrix product of fastForwardDst). x is overwritten.
+ */
+template<class V, Int N, Bool useDST>
+static inline Void xForwardTransformVec( const TMatrixCoeff *T, typename V::Vec *x, typename V::Vec *y )
+{
+  typedef typename V::Vec Vec;
+
+  if( useDST )
+  {
+    for( Int row = 0; row < N; row++ )
+    {
+      Vec sum = V::mul( x[0], T[row*N] );
+      for( Int column = 1; column < N; column++ )
+      {
+        sum = V::add( sum, V::mul( x[column], T[row*N + column] ) );
+      }
+      y[row] = sum;
+    }
+    return;
+  }
+
+  // the odd outputs of each stage are computed from O, and the even ones from the next stage, which transforms E
+  for( Int M = N; M > 2; M >>= 1 )
+  {
+    const Int step = N / M;
+    Vec O[N/2];
+    for( Int k = 0; k < M/2; k++ )
+    {
+      O[k] = V::sub( x[k], x[M-1-k] );
+      x[k] = V::add( x[k], x[M-1-k] );
+    }
+    for( Int row = step; row < N; row += 2*step )
+    {
+      Vec sum = V::mul( O[0], T[row*N] );
+      for( Int k = 1; k < M/2; k++ )
+      {
+        sum = V::add( sum, V::mul( O[k], T[row*N + k] ) );
+      }
+      y[row] = sum;
+    }
+  }
+  y[0  ] = V::add( V::mul( x[0], T[0          ] ), V::mul( x[1], T[1              ] ) );
+  y[N/2] = V::add( V::mul( x[0], T[(N/2)*N] ), V::mul( x[1], T[(N/2)*N + 1] ) );
+}
+
+/** N-point inverse transform of the vectors x, using the N x N matrix T (partialButterflyInverse4 to
+ *  partialButterflyInverse32, or the DST matrix product of fastInverseDst).
+ */
+template<class V, Int N, Bool useDST>
+static inline Void xInverseTransformVec( const TMatrixCoeff *T, const typename V::Vec *x, typename V::Vec *y )
+{
+  typedef typename V::Vec Vec;
+
+  if( useDST )
+  {
+    for( Int column = 0; column < N; column++ )
+    {
+      Vec sum = V::mul( x[0], T[column] );
+      for( Int row = 1; row < N; row++ )
+      {
+        sum = V::add( sum, V::mul( x[row], T[row*N + column] ) );
+      }
+      y[column] = sum;
+    }
+    return;
+  }
+
+  // E holds the output of the transform of the rows that are multiples of 2*step, O the contribution of the odd ones
+  Vec E[N];
+  E[0] = V::add( V::mul( x[0], T[0] ), V::mul( x[N/2], T[(N/2)*N    ] ) );
+  E[1] = V::add( V::mul( x[0], T[1] ), V::mul( x[N/2], T[(N/2)*N + 1] ) );
+  for( Int M = 4; M <= N; M <<= 1 )
+  {
+    const Int step = N / M;
+    Vec O[N/2];
+    for( Int k = 0; k < M/2; k++ )
+    {
+      O[k] = V::mul( x[step], T[step*N + k] );
+      for( Int row = 3*step; row < N; row += 2*step )
+      {
+        O[k] = V::add( O[k], V::mul( x[row], T[row*N + k] ) );
+      }
+    }
+    for( Int k = M/2 - 1; k >= 0; k-- )
+    {
+      E[M-1-k] = V::sub( E[k], O[k] );
+      E[k    ] = V::add( E[k], O[k] );
+    }
+  }
+  for( Int k = 0; k < N; k++ )
+  {
+    y[k] = E[k];
+  }
+}
+
+/// same as partialButterflyN (or fastForwardDst), for a line count that is a multiple of V::lanes
+template<class V, Int N, Bool useDST>
+static inline Void xForwardTransformSimd( const TMatrixCoeff *T, const TCoeff *src, TCoeff *dst, Int shift, Int line )
+{
+  typedef typename V::Vec Vec;
+  const Vec add = V::set1( ( shift > 0 ) ? ( 1 << ( shift - 1 ) ) : 0 );
+
+  for( Int j = 0; j < line; j += V::lanes )
+  {
+    Vec x[N], y[N];
+    for( Int n = 0; n < N; n += V::lanes )
+    {
+      for( Int k = 0; k < V::lanes; k++ )
+      {
+        x[n + k] = V::load( src + ( j + k ) * N + n );
+      }
+      V::transpose( x + n );
+    }
+
+    xForwardTransformVec<V, N, useDST>( T, x, y );
+
+    for( Int k = 0; k < N; k++ )
+    {
+      V::store( dst + k * line + j, V::sra( V::add( y[k], add ), shift ) );
+    }
+  }
+}
+
+/// same as partialButterflyInverseN (or fastInverseDst), for a line count that is a multiple of V::lanes
+template<class V, Int N, Bool useDST>
+static inline Void xInverseTransformSimd( const TMatrixCoeff *T, const TCoeff *src, TCoeff *dst, Int shift, Int line, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  typedef typename V::Vec Vec;
+  const Vec add = V::set1( ( shift > 0 ) ? ( 1 << ( shift - 1 ) ) : 0 );
+  const Vec min = V::set1( outputMinimum );
+  const Vec max = V::set1( outputMaximum );
+
+  for( Int j = 0; j < line; j += V::lanes )
+  {
+    Vec x[N], y[N];
+    for( Int k = 0; k < N; k++ )
+    {
+      x[k] = V::load( src + k * line + j );
+    }
+
+    xInverseTransformVec<V, N, useDST>( T, x, y );
+
+    for( Int n = 0; n < N; n += V::lanes )
+    {
+      for( Int k = 0; k < V::lanes; k++ )
+      {
+        y[n + k] = V::clip( V::sra( V::add( y[n + k], add ), shift ), min, max );
+      }
+      V::transpose( y + n );
+      for( Int k = 0; k < V::lanes; k++ )
+      {
+        V::store( dst + ( j + k ) * N + n, y[n + k] );
+      }
+    }
+  }
+}
+
+template<Int N, Bool useDST>
+static SIMD_TARGET_SSE41 SIMD_FLATTEN Void xForwardTransformSse41( const TMatrixCoeff *T, const TCoeff *src, TCoeff *dst, Int shift, Int line )
+{
+  xForwardTransformSimd<TrVecSse41, N, useDST>( T, src, dst, shift, line );
+}
+
+template<Int N>
+static SIMD_TARGET_AVX2 SIMD_FLATTEN Void xForwardTransformAvx2( const TMatrixCoeff *T, const TCoeff *src, TCoeff *dst, Int shift, Int line )
+{
+  xForwardTransformSimd<TrVecAvx2, N, false>( T, src, dst, shift, line );
+}
+
+template<Int N, Bool useDST>
+static SIMD_TARGET_SSE41 SIMD_FLATTEN Void xInverseTransformSse41( const TMatrixCoeff *T, const TCoeff *src, TCoeff *dst, Int shift, Int line, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  xInverseTransformSimd<TrVecSse41, N, useDST>( T, src, dst, shift, line, outputMinimum, outputMaximum );
+}
+
+template<Int N>
+static SIMD_TARGET_AVX2 SIMD_FLATTEN Void xInverseTransformAvx2( const TMatrixCoeff *T, const TCoeff *src, TCoeff *dst, Int shift, Int line, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  xInverseTransformSimd<TrVecAvx2, N, false>( T, src, dst, shift, line, outputMinimum, outputMaximum );
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+/// 1D forward transform of size N, using AVX2 when it is supported and both N and the line count fill its vectors
+template<Int N, Bool useDST>
+static Void xForwardTransform1D( const TMatrixCoeff *T, const TCoeff *src, TCoeff *dst, Int shift, Int line, const SimdExtension simdExtension )
+{
+  if( simdExtension >= SIMD_AVX2 && N >= TrVecAvx2::lanes && ( line % TrVecAvx2::lanes ) == 0 )
+  {
+    xForwardTransformAvx2<N>( T, src, dst, shift, line );
+  }
+  else
+  {
+    xForwardTransformSse41<N, useDST>( T, src, dst, shift, line );
+  }
+}
+
+/// 1D inverse transform of size N, using AVX2 when it is supported and both N and the line count fill its vectors
+template<Int N, Bool useDST>
+static Void xInverseTransform1D( const TMatrixCoeff *T, const TCoeff *src, TCoeff *dst, Int shift, Int line, const TCoeff outputMinimum, const TCoeff outputMaximum, const SimdExtension simdExtension )
+{
+  if( simdExtension >= SIMD_AVX2 && N >= TrVecAvx2::lanes && ( line % TrVecAvx2::lanes ) == 0 )
+  {
+    xInverseTransformAvx2<N>( T, src, dst, shift, line, outputMinimum, outputMaximum );
+  }
+  else
+  {
+    xInverseTransformSse41<N, useDST>( T, src, dst, shift, line, outputMinimum, outputMaximum );
+  }
+}
+
+/// forward 1D transform of size iSize, as selected by the switches in xTrMxN
+static Void xForwardTransformSimd( const TCoeff *src, TCoeff *dst, Int shift, Int iSize, Int line, Bool useDST, const SimdExtension simdExtension )
+{
+  switch( iSize )
+  {
+    case 4:
+      if( useDST )
+      {
+        xForwardTransform1D< 4, true >( &g_as_DST_MAT_4[TRANSFORM_FORWARD][0][0], src, dst, shift, line, simdExtension );
+      }
+      else
+      {
+        xForwardTransform1D< 4, false>( &g_aiT4        [TRANSFORM_FORWARD][0][0], src, dst, shift, line, simdExtension );
+      }
+      break;
+    case  8: xForwardTransform1D< 8, false>( &g_aiT8 [TRANSFORM_FORWARD][0][0], src, dst, shift, line, simdExtension ); break;
+    case 16: xForwardTransform1D<16, false>( &g_aiT16[TRANSFORM_FORWARD][0][0], src, dst, shift, line, simdExtension ); break;
+    case 32: xForwardTransform1D<32, false>( &g_aiT32[TRANSFORM_FORWARD][0][0], src, dst, shift, line, simdExtension ); break;
+    default:
+      assert(0); exit (1); break;
+  }
+}
+
+/// inverse 1D transform of size iSize, as selected by the switches in xITrMxN
+static Void xInverseTransformSimd( const TCoeff *src, TCoeff *dst, Int shift, Int iSize, Int line, Bool useDST, const TCoeff outputMinimum, const TCoeff outputMaximum, const SimdExtension simdExtension )
+{
+  switch( iSize )
+  {
+    case 4:
+      if( useDST )
+      {
+        xInverseTransform1D< 4, true >( &g_as_DST_MAT_4[TRANSFORM_INVERSE][0][0], src, dst, shift, line, outputMinimum, outputMaximum, simdExtension );
+      }
+      else
+      {
+        xInverseTransform1D< 4, false>( &g_aiT4        [TRANSFORM_INVERSE][0][0], src, dst, shift, line, outputMinimum, outputMaximum, simdExtension );
+      }
+      break;
+    case  8: xInverseTransform1D< 8, false>( &g_aiT8 [TRANSFORM_INVERSE][0][0], src, dst, shift, line, outputMinimum, outputMaximum, simdExtension ); break;
+    case 16: xInverseTransform1D<16, false>( &g_aiT16[TRANSFORM_INVERSE][0][0], src, dst, shift, line, outputMinimum, outputMaximum, simdExtension ); break;
+    case 32: xInverseTransform1D<32, false>( &g_aiT32[TRANSFORM_INVERSE][0][0], src, dst, shift, line, outputMinimum, outputMaximum, simdExtension ); break;
+    default:
+      assert(0); exit (1); break;
+  }
+}
+#endif
+
 /** MxN forward transform (2D)
 *  \param bitDepth              [in]  bit depth
 *  \param block                 [in]  residual block
@@ -869,6 +1248,17 @@ Void xTrMxN(Int bitDepth, TCoeff *block, TCoeff *coeff, Int iWidth, Int iHeight,
 
   TCoeff tmp[ MAX_TU_SIZE * MAX_TU_SIZE ];
 
+#if VECTOR_CODING__TRANSFORM && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  const SimdExtension simdExtension = getSimdExtension();
+  if( simdExtension >= SIMD_SSE41 )
+  {
+    const Bool useDST4x4 = useDST && iWidth == 4 && iHeight == 4;
+    xForwardTransformSimd( block, tmp,   shift_1st, iWidth,  iHeight, useDST4x4, simdExtension );
+    xForwardTransformSimd( tmp,   coeff, shift_2nd, iHeight, iWidth,  useDST4x4, simdExtension );
+    return;
+  }
+#endif
+
   switch (iWidth)
   {
     case 4:
@@ -938,6 +1328,17 @@ Void xITrMxN(Int bitDepth, TCoeff *coeff, TCoeff *block, Int iWidth, Int iHeight
 
   TCoeff tmp[MAX_TU_SIZE * MAX_TU_SIZE];
 
+#if VECTOR_CODING__TRANSFORM && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  const SimdExtension simdExtension = getSimdExtension();
+  if( simdExtension >= SIMD_SSE41 )
+  {
+    const Bool useDST4x4 = useDST && iWidth == 4 && iHeight == 4;
+    xInverseTransformSimd( coeff, tmp,   shift_1st, iHeight, iWidth,  useDST4x4, clipMinimum, clipMaximum, simdExtension );
+    xInverseTransformSimd( tmp,   block, shift_2nd, iWidth,  iHeight, useDST4x4, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max(), simdExtension );
+    return;
+  }
+#endif
+
   switch (iHeight)
   {
     case 4:
@@ -1155,9 +1556,15 @@ Void TComTrQuant::xQuant(       TComTU       &rTu,
     if ( !m_useSelectiveRDOQ || xNeedRDOQ( rTu, piCoef, compID, cQP ) )
     {
 #if ADAPTIVE_QP_SELECTION
-      xRateDistOptQuant( rTu, piCoef, pDes, pArlDes, uiAbsSum, compID, cQP );
+      if ( !m_useRDOQFixedPoint || !xRateDistOptQuantFixedPoint( rTu, piCoef, pDes, pArlDes, uiAbsSum, compID, cQP ) )
+      {
+        xRateDistOptQuant( rTu, piCoef, pDes, pArlDes, uiAbsSum, compID, cQP );
+      }
 #else
-      xRateDistOptQuant( rTu, piCoef, pDes, uiAbsSum, compID, cQP );
+      if ( !m_useRDOQFixedPoint || !xRateDistOptQuantFixedPoint( rTu, piCoef, pDes, uiAbsSum, compID, cQP ) )
+      {
+        xRateDistOptQuant( rTu, piCoef, pDes, uiAbsSum, compID, cQP );
+      }
 #endif
     }
     else
@@ -1428,6 +1835,7 @@ Void TComTrQuant::init(   UInt  uiMaxTrSize,
                           Bool  bUseRDOQ,
                           Bool  bUseRDOQTS,
                           Bool  useSelectiveRDOQ,
+                          Bool  useRDOQFixedPoint,
                           Bool  bEnc,
                           Bool  useTransformSkipFast
 #if ADAPTIVE_QP_SELECTION
@@ -1440,6 +1848,7 @@ Void TComTrQuant::init(   UInt  uiMaxTrSize,
   m_useRDOQ      = bUseRDOQ;
   m_useRDOQTS    = bUseRDOQTS;
   m_useSelectiveRDOQ = useSelectiveRDOQ;
+  m_useRDOQFixedPoint = useRDOQFixedPoint;
 #if ADAPTIVE_QP_SELECTION
   m_bUseAdaptQpSelect = bUseAdaptQpSelect;
 #endif
@@ -2529,134 +2938,711 @@ Void TComTrQuant::xRateDistOptQuant                 (       TComTU       &rTu,
 
   if( pcCU->getSlice()->getPPS()->getSignDataHidingEnabledFlag() && uiAbsSum>=2)
   {
-    const Double inverseQuantScale = Double(g_invQuantScales[cQP.rem]);
-    Int64 rdFactor = (Int64)(inverseQuantScale * inverseQuantScale * (1 << (2 * cQP.per))
-                             / m_dLambda / 16 / (1 << (2 * DISTORTION_PRECISION_ADJUSTMENT(channelBitDepth - 8)))
-                             + 0.5);
+    xSignBitHidingRDOQ( piDstCoeff, plSrcCoeff, deltaU, rateIncUp, rateIncDown, sigRateDelta, codingParameters,
+                        uiMaxNumCoeff, cQP, channelBitDepth, entropyCodingMinimum, entropyCodingMaximum );
+  }
+}
 
-    Int lastCG = -1;
-    Int absSum = 0 ;
-    Int n ;
 
-    for( Int subSet = (uiWidth*uiHeight-1) >> MLS_CG_SIZE; subSet >= 0; subSet-- )
-    {
-      Int  subPos     = subSet << MLS_CG_SIZE;
-      Int  firstNZPosInCG=uiCGSize , lastNZPosInCG=-1 ;
-      absSum = 0 ;
+/** RDOQ with the costs evaluated in fixed-point integer arithmetic
+ * \param rTu reference to transform
+ * \param plSrcCoeff pointer to input buffer
+ * \param piDstCoeff reference to pointer to output buffer
+ * \param piArlDstCoeff
+ * \param uiAbsSum reference to absolute sum of quantized transform coefficient
+ * \param compID colour component ID
+ * \param cQP reference to quantization parameters
+ * \returns false, without quantizing, if the TU cannot be represented in the fixed-point range
+
+ * Follows the level, coefficient group and last position decisions of xRateDistOptQuant, with
+ * the costs expressed in units of the estimated rate (1/32768 bit) and the distortion weighted
+ * by the inverse of lambda.
+ * A pre-pass over each 4x4 coefficient group quantizes its coefficients and zeroes those
+ * for which a level of one cannot cost less than a level of zero; groups left empty are
+ * then coded as all-zero without a per-coefficient level decision.
+ */
+Bool TComTrQuant::xRateDistOptQuantFixedPoint       (       TComTU       &rTu,
+                                                            TCoeff      * plSrcCoeff,
+                                                            TCoeff      * piDstCoeff,
+#if ADAPTIVE_QP_SELECTION
+                                                            TCoeff      * piArlDstCoeff,
+#endif
+                                                            TCoeff       &uiAbsSum,
+                                                      const ComponentID   compID,
+                                                      const QpParam      &cQP  )
+{
+  const TComRectangle  & rect             = rTu.getRect(compID);
+  const UInt             uiWidth          = rect.width;
+  const UInt             uiHeight         = rect.height;
+        TComDataCU    *  pcCU             = rTu.getCU();
+  const UInt             uiAbsPartIdx     = rTu.GetAbsPartIdxTU();
+  const ChannelType      channelType      = toChannelType(compID);
+  const UInt             uiLog2TrSize     = rTu.GetEquivalentLog2TrSize(compID);
 
-      for(n = uiCGSize-1; n >= 0; --n )
-      {
-        if( piDstCoeff[ codingParameters.scan[ n + subPos ]] )
-        {
-          lastNZPosInCG = n;
-          break;
-        }
-      }
+  const Bool             extendedPrecision = pcCU->getSlice()->getSPS()->getSpsRangeExtension().getExtendedPrecisionProcessingFlag();
+  const Int              maxLog2TrDynamicRange = pcCU->getSlice()->getSPS()->getMaxLog2TrDynamicRange(toChannelType(compID));
+  const Int              channelBitDepth = rTu.getCU()->getSlice()->getSPS()->getBitDepth(channelType);
 
-      for(n = 0; n <uiCGSize; n++ )
-      {
-        if( piDstCoeff[ codingParameters.scan[ n + subPos ]] )
-        {
-          firstNZPosInCG = n;
-          break;
-        }
-      }
+  if ( extendedPrecision || m_dLambda <= 0 )
+  {
+    return false;
+  }
 
-      for(n = firstNZPosInCG; n <=lastNZPosInCG; n++ )
-      {
-        absSum += Int(piDstCoeff[ codingParameters.scan[ n + subPos ]]);
-      }
+  const Int  iTransformShift                   = getTransformShift(channelBitDepth, uiLog2TrSize, maxLog2TrDynamicRange);
+  const Bool bUseGolombRiceParameterAdaptation = pcCU->getSlice()->getSPS()->getSpsRangeExtension().getPersistentRiceAdaptationEnabledFlag();
+  const UInt initialGolombRiceParameter        = m_pcEstBitsSbac->golombRiceAdaptationStatistics[rTu.getGolombRiceStatisticsIndex(compID)] / RExt__GOLOMB_RICE_INCREMENT_DIVISOR;
+        UInt uiGoRiceParam                     = initialGolombRiceParameter;
+  const UInt uiLog2BlockWidth                  = g_aucConvertToBit[ uiWidth  ] + 2;
+  const UInt uiLog2BlockHeight                 = g_aucConvertToBit[ uiHeight ] + 2;
+  const UInt uiMaxNumCoeff                     = uiWidth * uiHeight;
+  assert(compID<MAX_NUM_COMPONENT);
 
-      if(lastNZPosInCG>=0 && lastCG==-1)
-      {
-        lastCG = 1;
-      }
+  Int scalingListType = getScalingListType(pcCU->getPredictionMode(uiAbsPartIdx), compID);
+  assert(scalingListType < SCALING_LIST_NUM);
 
-      if( lastNZPosInCG-firstNZPosInCG>=SBH_THRESHOLD )
-      {
-        UInt signbit = (piDstCoeff[codingParameters.scan[subPos+firstNZPosInCG]]>0?0:1);
-        if( signbit!=(absSum&0x1) )  // hide but need tune
-        {
-          // calculate the cost
-          Int64 minCostInc = std::numeric_limits<Int64>::max(), curCost = std::numeric_limits<Int64>::max();
-          Int minPos = -1, finalChange = 0, curChange = 0;
+  const Int iQBits = QUANT_SHIFT + cQP.per + iTransformShift;                   // Right shift of non-RDOQ quantizer;  level = (coeff*uiQ + offset)>>q_bits
+  const Double *const pdErrScale = getErrScaleCoeff(scalingListType, (uiLog2TrSize-2), cQP.rem);
+  const Int    *const piQCoef    = getQuantCoeff(scalingListType, cQP.rem, (uiLog2TrSize-2));
 
-          for( n = (lastCG==1?lastNZPosInCG:uiCGSize-1) ; n >= 0; --n )
-          {
-            UInt uiBlkPos   = codingParameters.scan[ n + subPos ];
-            if(piDstCoeff[ uiBlkPos ] != 0 )
-            {
-              Int64 costUp   = rdFactor * ( - deltaU[uiBlkPos] ) + rateIncUp[uiBlkPos];
-              Int64 costDown = rdFactor * (   deltaU[uiBlkPos] ) + rateIncDown[uiBlkPos]
-                               -   ((abs(piDstCoeff[uiBlkPos]) == 1) ? sigRateDelta[uiBlkPos] : 0);
+  const Bool   enableScalingLists             = getUseScalingList(uiWidth, uiHeight, (pcCU->getTransformSkip(uiAbsPartIdx, compID) != 0));
+  const Int    defaultQuantisationCoefficient = g_quantScales[cQP.rem];
+  const Double defaultErrorScale              = getErrScaleCoeffNoScalingList(scalingListType, (uiLog2TrSize-2), cQP.rem);
 
-              if(lastCG==1 && lastNZPosInCG==n && abs(piDstCoeff[uiBlkPos])==1)
-              {
-                costDown -= (4<<15);
-              }
+  const TCoeff entropyCodingMinimum = -(1 << maxLog2TrDynamicRange);
+  const TCoeff entropyCodingMaximum =  (1 << maxLog2TrDynamicRange) - 1;
 
-              if(costUp<costDown)
-              {
-                curCost = costUp;
-                curChange =  1;
-              }
-              else
-              {
-                curChange = -1;
-                if(n==firstNZPosInCG && abs(piDstCoeff[uiBlkPos])==1)
-                {
-                  curCost = std::numeric_limits<Int64>::max();
-                }
-                else
-                {
-                  curCost = costDown;
-                }
-              }
-            }
-            else
+  //===== distortion weights =====
+  // the quantization error keeps RDOQ_FP_ERROR_FRAC_BITS fractional bits of a quantization step, and the weight
+  // of its square is a RDOQ_FP_WEIGHT_BITS-bit integer scaled by 2^-weightShift
+  const Int    errorShift    = std::max<Int>(0, iQBits - RDOQ_FP_ERROR_FRAC_BITS);
+  const Double errorToRate   = ldexp(1.0, 2 * errorShift) / m_dLambda;
+  Double       maxErrorScale = defaultErrorScale;
+  if ( enableScalingLists )
+  {
+    maxErrorScale = *std::max_element(pdErrScale, pdErrScale + uiMaxNumCoeff);
+  }
+  Int weightExponent;
+  frexp(maxErrorScale * errorToRate, &weightExponent);
+  const Int weightShift = RDOQ_FP_WEIGHT_BITS - weightExponent;
+  if ( weightShift < RDOQ_FP_MIN_WEIGHT_SHIFT || weightShift > RDOQ_FP_MAX_WEIGHT_SHIFT )
+  {
+    return false;
+  }
+  const Double weightScale   = ldexp(errorToRate, weightShift);
+  const Int64  defaultWeight = Int64(defaultErrorScale * weightScale + 0.5);
+
+  Int64 piErrWeight[ MAX_TU_SIZE * MAX_TU_SIZE ];
+  if ( enableScalingLists )
+  {
+    for ( UInt uiBlkPos = 0; uiBlkPos < uiMaxNumCoeff; uiBlkPos++ )
+    {
+      piErrWeight[ uiBlkPos ] = Int64(pdErrScale[ uiBlkPos ] * weightScale + 0.5);
+    }
+  }
+
+  //===== rate tables =====
+  const Int iEPRate = Int(xGetIEPRate());
+
+  Int minSigRateDelta = 0;
+  for ( UInt ctx = 0; ctx < NUM_SIG_FLAG_CTX; ctx++ )
+  {
+    minSigRateDelta = std::min(minSigRateDelta, m_pcEstBitsSbac->significantBits[ ctx ][ 1 ] - m_pcEstBitsSbac->significantBits[ ctx ][ 0 ]);
+  }
+  Int minGreaterOneRate = std::numeric_limits<Int>::max();
+  for ( UInt ctx = 0; ctx < NUM_ONE_FLAG_CTX; ctx++ )
+  {
+    minGreaterOneRate = std::min(minGreaterOneRate, m_pcEstBitsSbac->m_greaterOneBits[ ctx ][ 0 ]);
+  }
+  // smallest rate increase of coding any coefficient of the TU with a level of one instead of zero
+  const Int minLevelOneRate = iEPRate + minGreaterOneRate + minSigRateDelta;
+
+  Int piLastRateX[ LAST_SIGNIFICANT_GROUPS ];
+  Int piLastRateY[ LAST_SIGNIFICANT_GROUPS ];
+  const UInt uiNumLastGroups = g_uiGroupIdx[ std::max(uiWidth, uiHeight) - 1 ] + 1;
+  for ( UInt uiGroup = 0; uiGroup < uiNumLastGroups; uiGroup++ )
+  {
+    const Int suffixRate = (uiGroup > 3) ? iEPRate * Int((uiGroup - 2) >> 1) : 0;
+    piLastRateX[ uiGroup ] = m_pcEstBitsSbac->lastXBits[ channelType ][ uiGroup ] + suffixRate;
+    piLastRateY[ uiGroup ] = m_pcEstBitsSbac->lastYBits[ channelType ][ uiGroup ] + suffixRate;
+  }
+
+  //===== pre-pass: quantize each coefficient group =====
+  // a coefficient below insignificantLevel costs less as a zero than as a one, whatever its contexts: the distortion
+  // saved by coding it, w * (2x - 1) for a level x in quantization steps, is below the smallest rate of coding it
+  const Intermediate_Int levelLimit = std::numeric_limits<Intermediate_Int>::max() - (Intermediate_Int(1) << (iQBits - 1));
+  Intermediate_Int insignificantLevel = Intermediate_Int(1) << (iQBits - 1);
+  if ( minLevelOneRate > 0 )
+  {
+    const Double stepWeight = maxErrorScale * ldexp(1.0, 2 * iQBits) / m_dLambda;
+    const Double threshold  = std::min(Double(minLevelOneRate) / stepWeight + 1.0, 3.0) * ldexp(1.0, iQBits - 1);
+    insignificantLevel      = std::max(insignificantLevel, Intermediate_Int(threshold));
+  }
+
+  TUEntropyCodingParameters codingParameters;
+  getTUEntropyCodingParameters(codingParameters, rTu, compID);
+  const UInt uiCGSize = (1 << MLS_CG_SIZE);
+
+  Intermediate_Int plLevelDouble[ MAX_TU_SIZE * MAX_TU_SIZE ];
+  UInt             uiCGCandidate[ MLS_GRP_NUM ];
+  Intermediate_Int lMaxLevelDouble = 0;
+
+#if ADAPTIVE_QP_SELECTION
+  const Int iQBitsC = iQBits - ARL_C_PRECISION;
+  const Int iAddC   = 1 << (iQBitsC-1);
+#endif
+
+  for ( UInt uiCGPosY = 0; uiCGPosY < codingParameters.heightInGroups; uiCGPosY++ )
+  {
+    for ( UInt uiCGPosX = 0; uiCGPosX < codingParameters.widthInGroups; uiCGPosX++ )
+    {
+      Intermediate_Int lCGMaxLevel = 0;
+
+      for ( UInt y = 0; y < (1 << MLS_CG_LOG2_HEIGHT); y++ )
+      {
+        const UInt uiRowPos = ((uiCGPosY << MLS_CG_LOG2_HEIGHT) + y) * uiWidth + (uiCGPosX << MLS_CG_LOG2_WIDTH);
+
+        for ( UInt x = 0; x < (1 << MLS_CG_LOG2_WIDTH); x++ )
+        {
+          const UInt             uiBlkPos                = uiRowPos + x;
+          const Int              quantisationCoefficient = (enableScalingLists) ? piQCoef[uiBlkPos] : defaultQuantisationCoefficient;
+          const Intermediate_Int lLevelDouble            = (Intermediate_Int)std::min<Int64>(Int64(abs(plSrcCoeff[ uiBlkPos ])) * quantisationCoefficient, levelLimit);
+
+          plLevelDouble[ uiBlkPos ] = lLevelDouble;
+          lCGMaxLevel               = std::max(lCGMaxLevel, lLevelDouble);
+#if ADAPTIVE_QP_SELECTION
+          piArlDstCoeff[ uiBlkPos ] = m_bUseAdaptQpSelect ? (TCoeff)(( lLevelDouble + iAddC) >> iQBitsC ) : 0;
+#endif
+        }
+      }
+
+      uiCGCandidate[ uiCGPosY * codingParameters.widthInGroups + uiCGPosX ] = (lCGMaxLevel >= insignificantLevel) ? 1 : 0;
+      lMaxLevelDouble = std::max(lMaxLevelDouble, lCGMaxLevel);
+    }
+  }
+
+  if ( ((lMaxLevelDouble + (Intermediate_Int(1) << (iQBits - 1))) >> iQBits) > RDOQ_FP_MAX_LEVEL )
+  {
+    return false;
+  }
+
+  //===== level decision =====
+  Int64 piCostCoeff [ MAX_TU_SIZE * MAX_TU_SIZE ];
+  Int64 piCostSig   [ MAX_TU_SIZE * MAX_TU_SIZE ];
+  Int64 piCostCoeff0[ MAX_TU_SIZE * MAX_TU_SIZE ];
+  Int rateIncUp   [ MAX_TU_SIZE * MAX_TU_SIZE ];
+  Int rateIncDown [ MAX_TU_SIZE * MAX_TU_SIZE ];
+  Int sigRateDelta[ MAX_TU_SIZE * MAX_TU_SIZE ];
+  TCoeff deltaU   [ MAX_TU_SIZE * MAX_TU_SIZE ];
+  memset( piDstCoeff,   0, sizeof(TCoeff) *  uiMaxNumCoeff );
+  memset( rateIncUp,    0, sizeof(Int   ) *  uiMaxNumCoeff );
+  memset( rateIncDown,  0, sizeof(Int   ) *  uiMaxNumCoeff );
+  memset( sigRateDelta, 0, sizeof(Int   ) *  uiMaxNumCoeff );
+  memset( deltaU,       0, sizeof(TCoeff) *  uiMaxNumCoeff );
+
+  Int64 piCostCoeffGroupSig[ MLS_GRP_NUM ];
+  UInt uiSigCoeffGroupFlag[ MLS_GRP_NUM ];
+  Int iCGLastScanPos = -1;
+
+  UInt    uiCtxSet            = 0;
+  Int     c1                  = 1;
+  Int     c2                  = 0;
+  Int64   i64BaseCost         = 0;
+  Int64   i64BlockUncodedCost = 0;
+  Int     iLastScanPos        = -1;
+
+  UInt    c1Idx     = 0;
+  UInt    c2Idx     = 0;
+  Int     baseLevel;
+
+  memset( piCostCoeffGroupSig,   0, sizeof(Int64) * MLS_GRP_NUM );
+  memset( uiSigCoeffGroupFlag,   0, sizeof(UInt) * MLS_GRP_NUM );
+
+  UInt uiCGNum = uiWidth * uiHeight >> MLS_CG_SIZE;
+  Int iScanPos;
+  coeffGroupRDStatsFixedPoint rdStats;
+
+  const UInt significanceMapContextOffset = getSignificanceMapContextOffset(compID);
+
+  for (Int iCGScanPos = uiCGNum-1; iCGScanPos >= 0; iCGScanPos--)
+  {
+    UInt uiCGBlkPos = codingParameters.scanCG[ iCGScanPos ];
+    UInt uiCGPosY   = uiCGBlkPos / codingParameters.widthInGroups;
+    UInt uiCGPosX   = uiCGBlkPos - (uiCGPosY * codingParameters.widthInGroups);
+
+    if ( !uiCGCandidate[ uiCGBlkPos ] && (iLastScanPos < 0 || iCGScanPos > 0) )
+    {
+      // every level of the group is zero: only its distortion and, once the last position has been found,
+      // the cost of the zero coded_sub_block_flag remain
+      Int64 i64CGUncodedCost = 0;
+      for (Int iScanPosinCG = uiCGSize-1; iScanPosinCG >= 0; iScanPosinCG--)
+      {
+        const UInt   uiBlkPos     = codingParameters.scan[ iCGScanPos*uiCGSize + iScanPosinCG ];
+        const Int64  errorWeight  = (enableScalingLists) ? piErrWeight[uiBlkPos] : defaultWeight;
+        i64CGUncodedCost         += fixedPointDistortion( plLevelDouble[ uiBlkPos ], errorShift, errorWeight, weightShift );
+      }
+      i64BlockUncodedCost += i64CGUncodedCost;
+      i64BaseCost         += i64CGUncodedCost;
+
+      if ( iLastScanPos >= 0 )
+      {
+        UInt  uiCtxSig = getSigCoeffGroupCtxInc( uiSigCoeffGroupFlag, uiCGPosX, uiCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups );
+        piCostCoeffGroupSig[ iCGScanPos ] = m_pcEstBitsSbac->significantCoeffGroupBits[ uiCtxSig ][ 0 ];
+        i64BaseCost += piCostCoeffGroupSig[ iCGScanPos ];
+
+        //===== context set update =====
+        uiCtxSet          = getContextSetIndex(compID, (iCGScanPos - 1), (c1 == 0));
+        c1                = 1;
+        c2                = 0;
+        c1Idx             = 0;
+        c2Idx             = 0;
+        uiGoRiceParam     = initialGolombRiceParameter;
+      }
+      continue;
+    }
+
+    memset( &rdStats, 0, sizeof (coeffGroupRDStatsFixedPoint));
+
+    const Int patternSigCtx = TComTrQuant::calcPatternSigCtx(uiSigCoeffGroupFlag, uiCGPosX, uiCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups);
+
+    for (Int iScanPosinCG = uiCGSize-1; iScanPosinCG >= 0; iScanPosinCG--)
+    {
+      iScanPos = iCGScanPos*uiCGSize + iScanPosinCG;
+      //===== quantization =====
+      UInt    uiBlkPos          = codingParameters.scan[iScanPos];
+
+      const Int64            errorWeight  = (enableScalingLists) ? piErrWeight[uiBlkPos] : defaultWeight;
+      const Intermediate_Int lLevelDouble = plLevelDouble[ uiBlkPos ];
+      const UInt uiMaxAbsLevel  = (lLevelDouble < insignificantLevel) ? 0 : std::min<UInt>(UInt(entropyCodingMaximum), UInt((lLevelDouble + (Intermediate_Int(1) << (iQBits - 1))) >> iQBits));
+
+      piCostCoeff0[ iScanPos ]  = fixedPointDistortion( lLevelDouble, errorShift, errorWeight, weightShift );
+      piCostSig   [ iScanPos ]  = 0;
+      i64BlockUncodedCost      += piCostCoeff0[ iScanPos ];
+
+      if ( uiMaxAbsLevel > 0 && iLastScanPos < 0 )
+      {
+        iLastScanPos            = iScanPos;
+        uiCtxSet                = getContextSetIndex(compID, (iScanPos >> MLS_CG_SIZE), 0);
+        iCGLastScanPos          = iCGScanPos;
+      }
+
+      if ( iLastScanPos >= 0 )
+      {
+        //===== coefficient level estimation =====
+        UInt  uiLevel;
+        UInt  uiOneCtx         = (NUM_ONE_FLAG_CTX_PER_SET * uiCtxSet) + c1;
+        UInt  uiAbsCtx         = (NUM_ABS_FLAG_CTX_PER_SET * uiCtxSet) + c2;
+
+        if( iScanPos == iLastScanPos )
+        {
+          uiLevel              = xGetCodedLevelFixedPoint( piCostCoeff[ iScanPos ], piCostCoeff0[ iScanPos ], piCostSig[ iScanPos ],
+                                                           lLevelDouble, uiMaxAbsLevel, significanceMapContextOffset, uiOneCtx, uiAbsCtx, uiGoRiceParam,
+                                                           c1Idx, c2Idx, iQBits, errorShift, errorWeight, weightShift, 1, extendedPrecision, maxLog2TrDynamicRange
+                                                           );
+        }
+        else
+        {
+          UShort uiCtxSig      = significanceMapContextOffset + getSigCtxInc( patternSigCtx, codingParameters, iScanPos, uiLog2BlockWidth, uiLog2BlockHeight, channelType );
+
+          uiLevel              = xGetCodedLevelFixedPoint( piCostCoeff[ iScanPos ], piCostCoeff0[ iScanPos ], piCostSig[ iScanPos ],
+                                                           lLevelDouble, uiMaxAbsLevel, uiCtxSig, uiOneCtx, uiAbsCtx, uiGoRiceParam,
+                                                           c1Idx, c2Idx, iQBits, errorShift, errorWeight, weightShift, 0, extendedPrecision, maxLog2TrDynamicRange
+                                                           );
+
+          sigRateDelta[ uiBlkPos ] = m_pcEstBitsSbac->significantBits[ uiCtxSig ][ 1 ] - m_pcEstBitsSbac->significantBits[ uiCtxSig ][ 0 ];
+        }
+
+        deltaU[ uiBlkPos ]        = TCoeff((lLevelDouble - (Intermediate_Int(uiLevel) << iQBits)) >> (iQBits-8));
+
+        if( uiLevel > 0 )
+        {
+          Int rateNow = xGetICRate( uiLevel, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx, extendedPrecision, maxLog2TrDynamicRange );
+          rateIncUp   [ uiBlkPos ] = xGetICRate( uiLevel+1, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx, extendedPrecision, maxLog2TrDynamicRange ) - rateNow;
+          rateIncDown [ uiBlkPos ] = xGetICRate( uiLevel-1, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx, extendedPrecision, maxLog2TrDynamicRange ) - rateNow;
+        }
+        else // uiLevel == 0
+        {
+          rateIncUp   [ uiBlkPos ] = m_pcEstBitsSbac->m_greaterOneBits[ uiOneCtx ][ 0 ];
+        }
+        piDstCoeff[ uiBlkPos ] = uiLevel;
+        i64BaseCost           += piCostCoeff [ iScanPos ];
+
+        baseLevel = (c1Idx < C1FLAG_NUMBER) ? (2 + (c2Idx < C2FLAG_NUMBER)) : 1;
+        if( uiLevel >= baseLevel )
+        {
+          if (uiLevel > 3*(1<<uiGoRiceParam))
+          {
+            uiGoRiceParam = bUseGolombRiceParameterAdaptation ? (uiGoRiceParam + 1) : (std::min<UInt>((uiGoRiceParam + 1), 4));
+          }
+        }
+        if ( uiLevel >= 1)
+        {
+          c1Idx ++;
+        }
+
+        //===== update bin model =====
+        if( uiLevel > 1 )
+        {
+          c1 = 0;
+          c2 += (c2 < 2);
+          c2Idx ++;
+        }
+        else if( (c1 < 3) && (c1 > 0) && uiLevel)
+        {
+          c1++;
+        }
+
+        //===== context set update =====
+        if( ( iScanPos % uiCGSize == 0 ) && ( iScanPos > 0 ) )
+        {
+          uiCtxSet          = getContextSetIndex(compID, ((iScanPos - 1) >> MLS_CG_SIZE), (c1 == 0)); //(iScanPos - 1) because we do this **before** entering the final group
+          c1                = 1;
+          c2                = 0;
+          c1Idx             = 0;
+          c2Idx             = 0;
+          uiGoRiceParam     = initialGolombRiceParameter;
+        }
+      }
+      else
+      {
+        i64BaseCost    += piCostCoeff0[ iScanPos ];
+      }
+      rdStats.i64SigCost += piCostSig[ iScanPos ];
+      if (iScanPosinCG == 0 )
+      {
+        rdStats.i64SigCost_0 = piCostSig[ iScanPos ];
+      }
+      if (piDstCoeff[ uiBlkPos ] )
+      {
+        uiSigCoeffGroupFlag[ uiCGBlkPos ] = 1;
+        rdStats.i64CodedLevelandDist += piCostCoeff[ iScanPos ] - piCostSig[ iScanPos ];
+        rdStats.i64UncodedDist += piCostCoeff0[ iScanPos ];
+        if ( iScanPosinCG != 0 )
+        {
+          rdStats.iNNZbeforePos0++;
+        }
+      }
+    } //end for (iScanPosinCG)
+
+    if (iCGLastScanPos >= 0)
+    {
+      if( iCGScanPos )
+      {
+        UInt  uiCtxSig = getSigCoeffGroupCtxInc( uiSigCoeffGroupFlag, uiCGPosX, uiCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups );
+
+        if (uiSigCoeffGroupFlag[ uiCGBlkPos ] == 0)
+        {
+          i64BaseCost += m_pcEstBitsSbac->significantCoeffGroupBits[ uiCtxSig ][ 0 ] - rdStats.i64SigCost;
+          piCostCoeffGroupSig[ iCGScanPos ] = m_pcEstBitsSbac->significantCoeffGroupBits[ uiCtxSig ][ 0 ];
+        }
+        else if (iCGScanPos < iCGLastScanPos) //skip the last coefficient group, which will be handled together with last position below.
+        {
+          if ( rdStats.iNNZbeforePos0 == 0 )
+          {
+            i64BaseCost -= rdStats.i64SigCost_0;
+            rdStats.i64SigCost -= rdStats.i64SigCost_0;
+          }
+          // rd-cost if SigCoeffGroupFlag = 0, initialization
+          Int64 i64CostZeroCG = i64BaseCost;
+
+          // add SigCoeffGroupFlag cost to total cost
+          i64BaseCost   += m_pcEstBitsSbac->significantCoeffGroupBits[ uiCtxSig ][ 1 ];
+          i64CostZeroCG += m_pcEstBitsSbac->significantCoeffGroupBits[ uiCtxSig ][ 0 ];
+          piCostCoeffGroupSig[ iCGScanPos ] = m_pcEstBitsSbac->significantCoeffGroupBits[ uiCtxSig ][ 1 ];
+
+          // try to convert the current coeff group from non-zero to all-zero
+          i64CostZeroCG += rdStats.i64UncodedDist;  // distortion for resetting non-zero levels to zero levels
+          i64CostZeroCG -= rdStats.i64CodedLevelandDist;   // distortion and level cost for keeping all non-zero levels
+          i64CostZeroCG -= rdStats.i64SigCost;     // sig cost for all coeffs, including zero levels and non-zerl levels
+
+          // if we can save cost, change this block to all-zero block
+          if ( i64CostZeroCG < i64BaseCost )
+          {
+            uiSigCoeffGroupFlag[ uiCGBlkPos ] = 0;
+            i64BaseCost = i64CostZeroCG;
+            piCostCoeffGroupSig[ iCGScanPos ] = m_pcEstBitsSbac->significantCoeffGroupBits[ uiCtxSig ][ 0 ];
+
+            // reset coeffs to 0 in this block
+            for (Int iScanPosinCG = uiCGSize-1; iScanPosinCG >= 0; iScanPosinCG--)
             {
-              curCost = rdFactor * ( - (abs(deltaU[uiBlkPos])) ) + (1<<15) + rateIncUp[uiBlkPos] + sigRateDelta[uiBlkPos] ;
-              curChange = 1 ;
+              iScanPos      = iCGScanPos*uiCGSize + iScanPosinCG;
+              UInt uiBlkPos = codingParameters.scan[ iScanPos ];
 
-              if(n<firstNZPosInCG)
+              if (piDstCoeff[ uiBlkPos ])
               {
-                UInt thissignbit = (plSrcCoeff[uiBlkPos]>=0?0:1);
-                if(thissignbit != signbit )
-                {
-                  curCost = std::numeric_limits<Int64>::max();
-                }
+                piDstCoeff [ uiBlkPos ] = 0;
+                piCostCoeff[ iScanPos ] = piCostCoeff0[ iScanPos ];
+                piCostSig  [ iScanPos ] = 0;
               }
             }
+          } // end if ( i64CostZeroCG < i64BaseCost )
+        }
+      }
+      else
+      {
+        uiSigCoeffGroupFlag[ uiCGBlkPos ] = 1;
+      }
+    }
+  } //end for (iCGScanPos)
 
-            if( curCost<minCostInc)
-            {
-              minCostInc = curCost;
-              finalChange = curChange;
-              minPos = uiBlkPos;
-            }
-          }
+  //===== estimate last position =====
+  if ( iLastScanPos < 0 )
+  {
+    return true;
+  }
 
-          if(piDstCoeff[minPos] == entropyCodingMaximum || piDstCoeff[minPos] == entropyCodingMinimum)
+  Int64   i64BestCost         = 0;
+  Int     ui16CtxCbf          = 0;
+  Int     iBestLastIdxP1      = 0;
+  if( !pcCU->isIntra( uiAbsPartIdx ) && isLuma(compID) && pcCU->getTransformIdx( uiAbsPartIdx ) == 0 )
+  {
+    ui16CtxCbf   = 0;
+    i64BestCost  = i64BlockUncodedCost + m_pcEstBitsSbac->blockRootCbpBits[ ui16CtxCbf ][ 0 ];
+    i64BaseCost += m_pcEstBitsSbac->blockRootCbpBits[ ui16CtxCbf ][ 1 ];
+  }
+  else
+  {
+    ui16CtxCbf   = pcCU->getCtxQtCbf( rTu, channelType );
+    ui16CtxCbf  += getCBFContextOffset(compID);
+    i64BestCost  = i64BlockUncodedCost + m_pcEstBitsSbac->blockCbpBits[ ui16CtxCbf ][ 0 ];
+    i64BaseCost += m_pcEstBitsSbac->blockCbpBits[ ui16CtxCbf ][ 1 ];
+  }
+
+  const Int *const piLastRateH = (codingParameters.scanType == SCAN_VER) ? piLastRateY : piLastRateX;
+  const Int *const piLastRateV = (codingParameters.scanType == SCAN_VER) ? piLastRateX : piLastRateY;
+
+  Bool bFoundLast = false;
+  for (Int iCGScanPos = iCGLastScanPos; iCGScanPos >= 0; iCGScanPos--)
+  {
+    UInt uiCGBlkPos = codingParameters.scanCG[ iCGScanPos ];
+
+    i64BaseCost -= piCostCoeffGroupSig [ iCGScanPos ];
+    if (uiSigCoeffGroupFlag[ uiCGBlkPos ])
+    {
+      for (Int iScanPosinCG = uiCGSize-1; iScanPosinCG >= 0; iScanPosinCG--)
+      {
+        iScanPos = iCGScanPos*uiCGSize + iScanPosinCG;
+
+        if (iScanPos > iLastScanPos)
+        {
+          continue;
+        }
+        UInt   uiBlkPos     = codingParameters.scan[iScanPos];
+
+        if( piDstCoeff[ uiBlkPos ] )
+        {
+          UInt   uiPosY       = uiBlkPos >> uiLog2BlockWidth;
+          UInt   uiPosX       = uiBlkPos - ( uiPosY << uiLog2BlockWidth );
+
+          Int64 i64CostLast = piLastRateH[ g_uiGroupIdx[ uiPosX ] ] + piLastRateV[ g_uiGroupIdx[ uiPosY ] ];
+          Int64 totalCost   = i64BaseCost + i64CostLast - piCostSig[ iScanPos ];
+
+          if( totalCost < i64BestCost )
           {
-            finalChange = -1;
+            iBestLastIdxP1  = iScanPos + 1;
+            i64BestCost     = totalCost;
           }
+          if( piDstCoeff[ uiBlkPos ] > 1 )
+          {
+            bFoundLast = true;
+            break;
+          }
+          i64BaseCost      -= piCostCoeff[ iScanPos ];
+          i64BaseCost      += piCostCoeff0[ iScanPos ];
+        }
+        else
+        {
+          i64BaseCost      -= piCostSig[ iScanPos ];
+        }
+      } //end for
+      if (bFoundLast)
+      {
+        break;
+      }
+    } // end if (uiSigCoeffGroupFlag[ uiCGBlkPos ])
+  } // end for
+
+
+  for ( Int scanPos = 0; scanPos < iBestLastIdxP1; scanPos++ )
+  {
+    Int blkPos = codingParameters.scan[ scanPos ];
+    TCoeff level = piDstCoeff[ blkPos ];
+    uiAbsSum += level;
+    piDstCoeff[ blkPos ] = ( plSrcCoeff[ blkPos ] < 0 ) ? -level : level;
+  }
+
+  //===== clean uncoded coefficients =====
+  for ( Int scanPos = iBestLastIdxP1; scanPos <= iLastScanPos; scanPos++ )
+  {
+    piDstCoeff[ codingParameters.scan[ scanPos ] ] = 0;
+  }
+
+
+  if( pcCU->getSlice()->getPPS()->getSignDataHidingEnabledFlag() && uiAbsSum>=2)
+  {
+    xSignBitHidingRDOQ( piDstCoeff, plSrcCoeff, deltaU, rateIncUp, rateIncDown, sigRateDelta, codingParameters,
+                        uiMaxNumCoeff, cQP, channelBitDepth, entropyCodingMinimum, entropyCodingMaximum );
+  }
+
+  return true;
+}
+
+
+/** Sign data hiding of the levels chosen by the rate distortion optimized quantization
+ * \param piDstCoeff quantized levels, modified in place
+ * \param plSrcCoeff unquantized transform coefficients
+ * \param deltaU quantization error of each level
+ * \param rateIncUp rate increase when incrementing each level
+ * \param rateIncDown rate increase when decrementing each level
+ * \param sigRateDelta rate increase of signalling each coefficient as significant
+ * \param codingParameters entropy coding parameters of the TU
+ * \param uiNumCoeff number of coefficients in the TU
+ * \param cQP reference to quantization parameters
+ * \param channelBitDepth bit depth of the channel
+ * \param entropyCodingMinimum smallest codable level
+ * \param entropyCodingMaximum largest codable level
+ */
+Void TComTrQuant::xSignBitHidingRDOQ(       TCoeff                    * piDstCoeff,
+                                      const TCoeff                    * plSrcCoeff,
+                                      const TCoeff                    * deltaU,
+                                      const Int                       * rateIncUp,
+                                      const Int                       * rateIncDown,
+                                      const Int                       * sigRateDelta,
+                                      const TUEntropyCodingParameters & codingParameters,
+                                      const UInt                        uiNumCoeff,
+                                      const QpParam                   & cQP,
+                                      const Int                         channelBitDepth,
+                                      const TCoeff                      entropyCodingMinimum,
+                                      const TCoeff                      entropyCodingMaximum )
+{
+  const UInt uiCGSize = (1 << MLS_CG_SIZE);
+
+  const Double inverseQuantScale = Double(g_invQuantScales[cQP.rem]);
+  Int64 rdFactor = (Int64)(inverseQuantScale * inverseQuantScale * (1 << (2 * cQP.per))
+                           / m_dLambda / 16 / (1 << (2 * DISTORTION_PRECISION_ADJUSTMENT(channelBitDepth - 8)))
+                           + 0.5);
+
+  Int lastCG = -1;
+  Int absSum = 0 ;
+  Int n ;
+
+  for( Int subSet = (uiNumCoeff-1) >> MLS_CG_SIZE; subSet >= 0; subSet-- )
+  {
+    Int  subPos     = subSet << MLS_CG_SIZE;
+    Int  firstNZPosInCG=uiCGSize , lastNZPosInCG=-1 ;
+    absSum = 0 ;
+
+    for(n = uiCGSize-1; n >= 0; --n )
+    {
+      if( piDstCoeff[ codingParameters.scan[ n + subPos ]] )
+      {
+        lastNZPosInCG = n;
+        break;
+      }
+    }
+
+    for(n = 0; n <uiCGSize; n++ )
+    {
+      if( piDstCoeff[ codingParameters.scan[ n + subPos ]] )
+      {
+        firstNZPosInCG = n;
+        break;
+      }
+    }
+
+    for(n = firstNZPosInCG; n <=lastNZPosInCG; n++ )
+    {
+      absSum += Int(piDstCoeff[ codingParameters.scan[ n + subPos ]]);
+    }
+
+    if(lastNZPosInCG>=0 && lastCG==-1)
+    {
+      lastCG = 1;
+    }
 
-          if(plSrcCoeff[minPos]>=0)
+    if( lastNZPosInCG-firstNZPosInCG>=SBH_THRESHOLD )
+    {
+      UInt signbit = (piDstCoeff[codingParameters.scan[subPos+firstNZPosInCG]]>0?0:1);
+      if( signbit!=(absSum&0x1) )  // hide but need tune
+      {
+        // calculate the cost
+        Int64 minCostInc = std::numeric_limits<Int64>::max(), curCost = std::numeric_limits<Int64>::max();
+        Int minPos = -1, finalChange = 0, curChange = 0;
+
+        for( n = (lastCG==1?lastNZPosInCG:uiCGSize-1) ; n >= 0; --n )
+        {
+          UInt uiBlkPos   = codingParameters.scan[ n + subPos ];
+          if(piDstCoeff[ uiBlkPos ] != 0 )
           {
-            piDstCoeff[minPos] += finalChange ;
+            Int64 costUp   = rdFactor * ( - deltaU[uiBlkPos] ) + rateIncUp[uiBlkPos];
+            Int64 costDown = rdFactor * (   deltaU[uiBlkPos] ) + rateIncDown[uiBlkPos]
+                             -   ((abs(piDstCoeff[uiBlkPos]) == 1) ? sigRateDelta[uiBlkPos] : 0);
+
+            if(lastCG==1 && lastNZPosInCG==n && abs(piDstCoeff[uiBlkPos])==1)
+            {
+              costDown -= (4<<15);
+            }
+
+            if(costUp<costDown)
+            {
+              curCost = costUp;
+              curChange =  1;
+            }
+            else
+            {
+              curChange = -1;
+              if(n==firstNZPosInCG && abs(piDstCoeff[uiBlkPos])==1)
+              {
+                curCost = std::numeric_limits<Int64>::max();
+              }
+              else
+              {
+                curCost = costDown;
+              }
+            }
           }
           else
           {
-            piDstCoeff[minPos] -= finalChange ;
+            curCost = rdFactor * ( - (abs(deltaU[uiBlkPos])) ) + (1<<15) + rateIncUp[uiBlkPos] + sigRateDelta[uiBlkPos] ;
+            curChange = 1 ;
+
+            if(n<firstNZPosInCG)
+            {
+              UInt thissignbit = (plSrcCoeff[uiBlkPos]>=0?0:1);
+              if(thissignbit != signbit )
+              {
+                curCost = std::numeric_limits<Int64>::max();
+              }
+            }
+          }
+
+          if( curCost<minCostInc)
+          {
+            minCostInc = curCost;
+            finalChange = curChange;
+            minPos = uiBlkPos;
           }
         }
-      }
 
-      if(lastCG==1)
-      {
-        lastCG=0 ;
+        if(piDstCoeff[minPos] == entropyCodingMaximum || piDstCoeff[minPos] == entropyCodingMinimum)
+        {
+          finalChange = -1;
+        }
+
+        if(plSrcCoeff[minPos]>=0)
+        {
+          piDstCoeff[minPos] += finalChange ;
+        }
+        else
+        {
+          piDstCoeff[minPos] -= finalChange ;
+        }
       }
     }
+
+    if(lastCG==1)
+    {
+      lastCG=0 ;
+    }
   }
 }
 
@@ -2867,6 +3853,72 @@ __inline UInt TComTrQuant::xGetCodedLevel ( Double&          rd64CodedCost,
   return uiBestAbsLevel;
 }
 
+/** Get the best level in RD sense, with the costs in fixed-point units of the estimated rate
+ *
+ * \returns best quantized transform level for given scan position
+ *
+ * Fixed-point counterpart of xGetCodedLevel, used by xRateDistOptQuantFixedPoint.
+ */
+__inline UInt TComTrQuant::xGetCodedLevelFixedPoint ( Int64&           rCodedCost,             //< reference to coded cost
+                                                      const Int64      codedCost0,             //< cost when coefficient is 0
+                                                      Int64&           rCodedCostSig,          //< reference to cost of significant coefficient
+                                                      Intermediate_Int lLevelDouble,           //< unscaled quantized level
+                                                      UInt             uiMaxAbsLevel,          //< scaled quantized level
+                                                      UShort           ui16CtxNumSig,          //< current ctxInc for coeff_abs_significant_flag
+                                                      UShort           ui16CtxNumOne,          //< current ctxInc for coeff_abs_level_greater1
+                                                      UShort           ui16CtxNumAbs,          //< current ctxInc for coeff_abs_level_greater2
+                                                      UShort           ui16AbsGoRice,          //< current Rice parameter for coeff_abs_level_remaining
+                                                      UInt             c1Idx,                  //<
+                                                      UInt             c2Idx,                  //<
+                                                      Int              iQBits,                 //< quantization step size
+                                                      Int              errorShift,             //< bits dropped from the quantization error
+                                                      Int64            errorWeight,            //< fixed-point distortion weight
+                                                      Int              weightShift,            //< scale of errorWeight
+                                                      Bool             bLast,                  //< indicates if the coefficient is the last significant
+                                                      Bool             useLimitedPrefixLength, //<
+                                                      const Int        maxLog2TrDynamicRange   //<
+                                                      ) const
+{
+  Int64 currCostSig    = 0;
+  UInt  uiBestAbsLevel = 0;
+
+  if( !bLast && uiMaxAbsLevel < 3 )
+  {
+    rCodedCostSig       = m_pcEstBitsSbac->significantBits[ ui16CtxNumSig ][ 0 ];
+    rCodedCost          = codedCost0 + rCodedCostSig;
+    if( uiMaxAbsLevel == 0 )
+    {
+      return uiBestAbsLevel;
+    }
+  }
+  else
+  {
+    rCodedCost          = std::numeric_limits<Int64>::max();
+  }
+
+  if( !bLast )
+  {
+    currCostSig         = m_pcEstBitsSbac->significantBits[ ui16CtxNumSig ][ 1 ];
+  }
+
+  UInt uiMinAbsLevel    = ( uiMaxAbsLevel > 1 ? uiMaxAbsLevel - 1 : 1 );
+  for( Int uiAbsLevel  = uiMaxAbsLevel; uiAbsLevel >= uiMinAbsLevel ; uiAbsLevel-- )
+  {
+    Int64 currCost      = fixedPointDistortion( lLevelDouble - ( Intermediate_Int(uiAbsLevel) << iQBits ), errorShift, errorWeight, weightShift )
+                        + xGetICRate( uiAbsLevel, ui16CtxNumOne, ui16CtxNumAbs, ui16AbsGoRice, c1Idx, c2Idx, useLimitedPrefixLength, maxLog2TrDynamicRange );
+    currCost           += currCostSig;
+
+    if( currCost < rCodedCost )
+    {
+      uiBestAbsLevel    = uiAbsLevel;
+      rCodedCost        = currCost;
+      rCodedCostSig     = currCostSig;
+    }
+  }
+
+  return uiBestAbsLevel;
+}
+
 /** Calculates the cost for specific absolute transform level
  * \param uiAbsLevel scaled quantized level
  * \param ui16CtxNumOne current ctxInc for coeff_abs_level_greater1 (1st bin of coeff_abs_level_minus1 in AVC)
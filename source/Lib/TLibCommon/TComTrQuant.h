@@ -106,6 +106,7 @@ public:
                               Bool useRDOQ                = false,
                               Bool useRDOQTS              = false,
                               Bool useSelectiveRDOQ       = false,
+                              Bool useRDOQFixedPoint      = false,
                               Bool bEnc                   = false,
                               Bool useTransformSkipFast   = false
 #if ADAPTIVE_QP_SELECTION
@@ -217,6 +218,7 @@ protected:
   Bool     m_useRDOQ;
   Bool     m_useRDOQTS;
   Bool     m_useSelectiveRDOQ;
+  Bool     m_useRDOQFixedPoint;
 #if ADAPTIVE_QP_SELECTION
   Bool     m_bUseAdaptQpSelect;
 #endif
@@ -238,6 +240,19 @@ private:
 
   Void signBitHidingHDQ( TCoeff* pQCoef, TCoeff* pCoef, TCoeff* deltaU, const TUEntropyCodingParameters &codingParameters, const Int maxLog2TrDynamicRange );
 
+  Void xSignBitHidingRDOQ(       TCoeff                    * piDstCoeff,
+                           const TCoeff                    * plSrcCoeff,
+                           const TCoeff                    * deltaU,
+                           const Int                       * rateIncUp,
+                           const Int                       * rateIncDown,
+                           const Int                       * sigRateDelta,
+                           const TUEntropyCodingParameters & codingParameters,
+                           const UInt                        uiNumCoeff,
+                           const QpParam                   & cQP,
+                           const Int                         channelBitDepth,
+                           const TCoeff                      entropyCodingMinimum,
+                           const TCoeff                      entropyCodingMaximum );
+
   // quantization
   Void xQuant(       TComTU       &rTu,
                      TCoeff      * pSrc,
@@ -266,6 +281,16 @@ private:
                                      const ComponentID   compID,
                                      const QpParam      &cQP );
 
+  Bool           xRateDistOptQuantFixedPoint (       TComTU       &rTu,
+                                                     TCoeff      * plSrcCoeff,
+                                                     TCoeff      * piDstCoeff,
+#if ADAPTIVE_QP_SELECTION
+                                                     TCoeff      *piArlDstCoeff,
+#endif
+                                                     TCoeff       &uiAbsSum,
+                                               const ComponentID   compID,
+                                               const QpParam      &cQP );
+
 __inline UInt              xGetCodedLevel  ( Double&          rd64CodedCost,
                                              Double&          rd64CodedCost0,
                                              Double&          rd64CodedCostSig,
@@ -284,6 +309,26 @@ __inline UInt              xGetCodedLevel  ( Double&          rd64CodedCost,
                                              const Int        maxLog2TrDynamicRange
                                              ) const;
 
+__inline UInt              xGetCodedLevelFixedPoint ( Int64&           rCodedCost,
+                                                      const Int64      codedCost0,
+                                                      Int64&           rCodedCostSig,
+                                                      Intermediate_Int lLevelDouble,
+                                                      UInt             uiMaxAbsLevel,
+                                                      UShort           ui16CtxNumSig,
+                                                      UShort           ui16CtxNumOne,
+                                                      UShort           ui16CtxNumAbs,
+                                                      UShort           ui16AbsGoRice,
+                                                      UInt             c1Idx,
+                                                      UInt             c2Idx,
+                                                      Int              iQBits,
+                                                      Int              errorShift,
+                                                      Int64            errorWeight,
+                                                      Int              weightShift,
+                                                      Bool             bLast,
+                                                      Bool             useLimitedPrefixLength,
+                                                      const Int        maxLog2TrDynamicRange
+                                                      ) const;
+
 
   __inline Int xGetICRate  ( const UInt   uiAbsLevel,
                              const UShort ui16CtxNumOne,
@@ -330,6 +375,15 @@ public:
 
 };// END CLASS DEFINITION TComTrQuant
 
+// ====================================================================================================================
+// Function declarations
+// ====================================================================================================================
+
+/// MxN forward and inverse transforms (2D) of TComTrQuant. With VECTOR_CODING__TRANSFORM, they use the SIMD versions of
+/// the 1D transforms for the extension returned by getSimdExtension()
+Void xTrMxN ( Int bitDepth, TCoeff *block, TCoeff *coeff, Int iWidth, Int iHeight, Bool useDST, const Int maxLog2TrDynamicRange );
+Void xITrMxN( Int bitDepth, TCoeff *coeff, TCoeff *block, Int iWidth, Int iHeight, Bool useDST, const Int maxLog2TrDynamicRange );
+
 //! \}
 
 #endif // __TCOMTRQUANT__
@@ -147,9 +147,15 @@
 #if defined __SSE2__ || defined __AVX2__ || defined __AVX__ || defined _M_AMD64 || defined _M_X64
 #define VECTOR_CODING__INTERPOLATION_FILTER               1 ///< enable vector coding for the interpolation filter. 1 (default if SSE possible) disable SSE vector coding. Should not affect RD costs/decisions. Code back-ported from JEM2.0.
 #define VECTOR_CODING__DISTORTION_CALCULATIONS            1 ///< enable vector coding for distortion calculations   1 (default if SSE possible) disable SSE vector coding. Should not affect RD costs/decisions. Code back-ported from JEM2.0.
+#define VECTOR_CODING__TRANSFORM                          1 ///< enable vector coding for the partial butterfly transforms. 1 (default if SSE possible) uses SSE4.1/AVX2 when the CPU supports them. Should not affect RD costs/decisions.
+#define VECTOR_CODING__VIDEO_IO                           1 ///< enable vector coding for the sample conversions of the YUV file reader/writer. 1 (default if SSE possible) uses SSE4.1 when the CPU supports it. Does not change the samples.
+#define VECTOR_CODING__EMULATION_PREVENTION               1 ///< enable vector coding for the zero byte pair search of the emulation prevention handling. 1 (default if SSE possible) uses SSE4.1/AVX2 when the CPU supports them. Does not change the bitstream.
 #else
 #define VECTOR_CODING__INTERPOLATION_FILTER               0 ///< enable vector coding for the interpolation filter. 0 (default if SSE not possible) disable SSE vector coding. Should not affect RD costs/decisions. Code back-ported from JEM2.0.
 #define VECTOR_CODING__DISTORTION_CALCULATIONS            0 ///< enable vector coding for distortion calculations   0 (default if SSE not possible) disable SSE vector coding. Should not affect RD costs/decisions. Code back-ported from JEM2.0.
+#define VECTOR_CODING__TRANSFORM                          0 ///< enable vector coding for the partial butterfly transforms. 0 (default if SSE not possible) disable SSE vector coding. Should not affect RD costs/decisions.
+#define VECTOR_CODING__VIDEO_IO                           0 ///< enable vector coding for the sample conversions of the YUV file reader/writer. 0 (default if SSE not possible) disable SSE vector coding. Does not change the samples.
+#define VECTOR_CODING__EMULATION_PREVENTION               0 ///< enable vector coding for the zero byte pair search of the emulation prevention handling. 0 (default if SSE not possible) disable SSE vector coding. Does not change the bitstream.
 #endif
 
 // ====================================================================================================================
@@ -39,6 +39,9 @@
 
 #include <stdint.h>
 #include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <vector>
 #include "AnnexBread.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
@@ -196,4 +199,181 @@ byteStreamNALUnit(
   stats.m_numBytesInNALUnit = UInt(nalUnit.size());
   return eof;
 }
+
+MappedInputByteStream::MappedInputByteStream()
+: m_data(NULL)
+, m_size(0)
+, m_pos(0)
+, m_eof(false)
+{
+}
+
+MappedInputByteStream::~MappedInputByteStream()
+{
+  close();
+}
+
+Bool MappedInputByteStream::open(const std::string& fileName)
+{
+  close();
+
+  if (m_mapping.open(fileName))
+  {
+    m_data = m_mapping.getData();
+    m_size = m_mapping.getSize();
+    return true;
+  }
+
+  // fall back to reading the whole file, e.g. for pipes or empty files
+  std::ifstream file(fileName.c_str(), std::ifstream::in | std::ifstream::binary);
+  if (!file)
+  {
+    return false;
+  }
+  m_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  m_data = m_buffer.empty() ? NULL : &m_buffer[0];
+  m_size = m_buffer.size();
+  return true;
+}
+
+Void MappedInputByteStream::close()
+{
+  m_mapping.close();
+  std::vector<uint8_t>().swap(m_buffer);
+  m_data = NULL;
+  m_size = 0;
+  m_pos  = 0;
+  m_eof  = false;
+}
+
+/**
+ * Returns the first byte-aligned three-byte sequence 0x000000, 0x000001 or
+ * 0x000002 in [p, end), or end if there is none.  Such a sequence can only
+ * start at a pair of zero bytes, so the search skips from one zero byte to
+ * the next with memchr, which the C library implements with vector
+ * instructions.
+ */
+static const uint8_t* findZeroWord(const uint8_t* p, const uint8_t* end)
+{
+  while (end - p >= 3)
+  {
+    const uint8_t* zero = static_cast<const uint8_t*>(memchr(p, 0x00, std::size_t(end - p - 2)));
+    if (zero == NULL)
+    {
+      break;
+    }
+    if (zero[1] != 0x00)
+    {
+      p = zero + 2;
+    }
+    else if (zero[2] > 2)
+    {
+      p = zero + 3;
+    }
+    else
+    {
+      return zero;
+    }
+  }
+  return end;
+}
+
+static inline Bool isStartCode(const uint8_t* p, const uint8_t* end)
+{
+  return (end - p >= 3 && p[0] == 0x00 && p[1] == 0x00 && p[2] == 0x01)
+      || (end - p >= 4 && p[0] == 0x00 && p[1] == 0x00 && p[2] == 0x00 && p[3] == 0x01);
+}
+
+/**
+ * Parse the Annex B byte stream held by bs to extract a single NAL unit,
+ * following the same steps as the istream based parser above.  On return
+ * nalUnit points at the NAL unit inside the byte stream, which stays valid
+ * until bs is closed.
+ *
+ * Returns true if EOF was reached (NB, nalunit data may be valid),
+ *         otherwise false.
+ */
+Bool
+byteStreamNALUnit(
+  MappedInputByteStream& bs,
+  const uint8_t*& nalUnit,
+  std::size_t& nalUnitSize,
+  AnnexBStats& stats)
+{
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  TComCodingStatistics::SStat &statBits=TComCodingStatistics::GetStatisticEP(STATS__NAL_UNIT_PACKING);
+  TComCodingStatistics::SStat &bodyStats=TComCodingStatistics::GetStatisticEP(STATS__NAL_UNIT_TOTAL_BODY);
+#endif
+  const uint8_t* const start = bs.getData() + bs.getPosition();
+  const uint8_t* const end   = bs.getData() + bs.getSize();
+  const uint8_t*       p     = start;
+
+  nalUnit     = NULL;
+  nalUnitSize = 0;
+  stats.m_numBytesInNALUnit = 0;
+
+  // leading_zero_8bits
+  while (!isStartCode(p, end))
+  {
+    if (p == end)
+    {
+      bs.advance(p - start);
+      bs.setEof();
+      return true;
+    }
+    assert(*p == 0x00);
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    statBits.bits+=8; statBits.count++;
+#endif
+    stats.m_numLeadingZero8BitsBytes++;
+    p++;
+  }
+
+  // zero_byte
+  if (p[2] != 0x01)
+  {
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    statBits.bits+=8; statBits.count++;
+#endif
+    stats.m_numZeroByteBytes++;
+    p++;
+  }
+
+  // start_code_prefix_one_3bytes
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  statBits.bits+=24; statBits.count+=3;
+#endif
+  stats.m_numStartCodePrefixBytes += 3;
+  p += 3;
+
+  // nal_unit: up to the next 0x000000, 0x000001 or 0x000002, or the end of the stream
+  const uint8_t* nalEnd = findZeroWord(p, end);
+  nalUnit     = p;
+  nalUnitSize = std::size_t(nalEnd - p);
+  stats.m_numBytesInNALUnit = UInt(nalUnitSize);
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  bodyStats.bits+=8*nalUnitSize; bodyStats.count+=nalUnitSize;
+#endif
+  p = nalEnd;
+
+  // trailing_zero_8bits
+  while (!isStartCode(p, end))
+  {
+    if (p == end)
+    {
+      bs.advance(p - start);
+      bs.setEof();
+      return true;
+    }
+    assert(*p == 0x00);
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    statBits.bits+=8; statBits.count++;
+#endif
+    stats.m_numTrailingZero8BitsBytes++;
+    p++;
+  }
+
+  bs.advance(p - start);
+  return false;
+}
 //! \}
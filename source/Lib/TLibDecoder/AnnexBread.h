@@ -42,10 +42,13 @@
 #define __ANNEXBREAD__
 
 #include <stdint.h>
+#include <cstddef>
 #include <istream>
+#include <string>
 #include <vector>
 
 #include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComMappedFile.h"
 
 //! \ingroup TLibDecoder
 //! \{
@@ -192,7 +195,58 @@ struct AnnexBStats
   }
 };
 
+/**
+ * Byte stream that is held in memory as a whole, normally by mapping the
+ * bitstream file read-only into the address space.  NAL units are returned
+ * as views into the mapping, and re-reading a NAL unit only requires the
+ * current position to be moved back.
+ */
+class MappedInputByteStream
+{
+public:
+  MappedInputByteStream();
+  ~MappedInputByteStream();
+
+  /**
+   * Map the file fileName.  Where the platform does not support mapping
+   * files, the file is read into an internal buffer instead.
+   * Returns false if the file could not be opened.
+   */
+  Bool open(const std::string& fileName);
+  Void close();
+
+  const uint8_t* getData() const           { return m_data; }
+  std::size_t    getSize() const           { return m_size; }
+  std::size_t    getPosition() const       { return m_pos; }
+
+  /**
+   * Move the current position, e.g. back to the start of a NAL unit that
+   * has to be decoded again.  This clears the end-of-stream state.
+   */
+  Void           setPosition(std::size_t pos) { assert(pos <= m_size); m_pos = pos; m_eof = false; }
+  Void           advance(std::size_t n)    { assert(m_pos + n <= m_size); m_pos += n; }
+  Void           setEof()                  { m_eof = true; }
+
+  /**
+   * returns true once an extraction has run into the end of the stream,
+   * matching the state of an istream after a read beyond its end.
+   */
+  Bool           eof() const               { return m_eof; }
+
+private:
+  MappedInputByteStream(const MappedInputByteStream&);
+  MappedInputByteStream& operator=(const MappedInputByteStream&);
+
+  const uint8_t*       m_data;    ///< start of the byte stream
+  std::size_t          m_size;    ///< number of bytes in the byte stream
+  std::size_t          m_pos;     ///< current position in the byte stream
+  Bool                 m_eof;     ///< set when an extraction reached the end of the byte stream
+  TComMappedFile       m_mapping; ///< mapping of the file
+  std::vector<uint8_t> m_buffer;  ///< file contents when the file is not mapped
+};
+
 Bool byteStreamNALUnit(InputByteStream& bs, std::vector<uint8_t>& nalUnit, AnnexBStats& stats);
+Bool byteStreamNALUnit(MappedInputByteStream& bs, const uint8_t*& nalUnit, std::size_t& nalUnitSize, AnnexBStats& stats);
 
 //! \}
 
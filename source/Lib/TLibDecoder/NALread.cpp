@@ -40,6 +40,7 @@
 #include <vector>
 #include <algorithm>
 #include <ostream>
+#include <string.h>
 
 #include "NALread.h"
 #include "TLibCommon/NAL.h"
@@ -55,35 +56,48 @@ using namespace std;
 
 //! \ingroup TLibDecoder
 //! \{
-static Void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, TComInputBitstream *bitstream, Bool isVclNalUnit)
+/**
+ * Remove the emulation prevention bytes from the payloadSize bytes at payload
+ * and store the result in nalUnitBuf.  payload may point into nalUnitBuf
+ * itself, as the RBSP is never longer than the payload.
+ */
+static Void convertPayloadToRBSP(const uint8_t* payload, std::size_t payloadSize, vector<uint8_t>& nalUnitBuf, TComInputBitstream *bitstream, Bool isVclNalUnit)
 {
-  UInt zeroCount = 0;
-  vector<uint8_t>::iterator it_read, it_write;
+  const uint8_t* const it_end = payload + payloadSize;
+
+  if (nalUnitBuf.size() < payloadSize)
+  {
+    nalUnitBuf.resize(payloadSize);
+  }
+  uint8_t* const it_begin = &nalUnitBuf[0];
+  uint8_t* it_write = it_begin;
 
-  UInt pos = 0;
   bitstream->clearEmulationPreventionByteLocation();
-  for (it_read = it_write = nalUnitBuf.begin(); it_read != nalUnitBuf.end(); it_read++, it_write++, pos++)
+
+  // an emulation_prevention_three_byte can only follow two zero bytes, so the
+  // bytes up to each zero byte pair are copied unchanged
+  const uint8_t* it_copy = payload;
+  const uint8_t* it_read = payload;
+  while (it_end - (it_read = findZeroBytePair(it_read, it_end)) > 2)
   {
-    assert(zeroCount < 2 || *it_read >= 0x03);
-    if (zeroCount == 2 && *it_read == 0x03)
+    const uint8_t* it_next = it_read + 2;
+    assert(*it_next >= 0x03);
+    if (*it_next == 0x03)
     {
-      bitstream->pushEmulationPreventionByteLocation( pos );
-      pos++;
-      it_read++;
-      zeroCount = 0;
+      bitstream->pushEmulationPreventionByteLocation( UInt(it_next - payload) );
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
       TComCodingStatistics::IncrementStatisticEP(STATS__EMULATION_PREVENTION_3_BYTES, 8, 0);
 #endif
-      if (it_read == nalUnitBuf.end())
-      {
-        break;
-      }
-      assert(*it_read <= 0x03);
+      memmove(it_write, it_copy, it_next - it_copy);
+      it_write += it_next - it_copy;
+      it_copy = it_next + 1;
+      assert(it_copy == it_end || *it_copy <= 0x03);
     }
-    zeroCount = (*it_read == 0x00) ? zeroCount+1 : 0;
-    *it_write = *it_read;
+    it_read = it_next + 1;
   }
-  assert(zeroCount == 0);
+  memmove(it_write, it_copy, it_end - it_copy);
+  it_write += it_end - it_copy;
+  assert(it_end[-1] != 0x00);
 
   if (isVclNalUnit)
   {
@@ -102,7 +116,7 @@ static Void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, TComInputBitstream
     }
   }
 
-  nalUnitBuf.resize(it_write - nalUnitBuf.begin());
+  nalUnitBuf.resize(it_write - it_begin);
 }
 
 #if ENC_DEC_TRACE && DEC_NUH_TRACE
@@ -177,7 +191,21 @@ Void read(InputNALUnit& nalu)
   TComInputBitstream &bitstream = nalu.getBitstream();
   vector<uint8_t>& nalUnitBuf=bitstream.getFifo();
   // perform anti-emulation prevention
-  convertPayloadToRBSP(nalUnitBuf, &bitstream, (nalUnitBuf[0] & 64) == 0);
+  convertPayloadToRBSP(&nalUnitBuf[0], nalUnitBuf.size(), nalUnitBuf, &bitstream, (nalUnitBuf[0] & 64) == 0);
+  bitstream.resetToStart();
+  readNalUnitHeader(nalu);
+}
+
+/**
+ * read the NAL unit of nalUnitSize bytes at nalUnitData, which is left
+ * untouched.  The bitstream of nalu receives the RBSP, so the only copy of
+ * the payload is the one made while removing the emulation prevention bytes.
+ */
+Void read(InputNALUnit& nalu, const uint8_t* nalUnitData, std::size_t nalUnitSize)
+{
+  assert(nalUnitSize > 0);
+  TComInputBitstream &bitstream = nalu.getBitstream();
+  convertPayloadToRBSP(nalUnitData, nalUnitSize, bitstream.getFifo(), &bitstream, (nalUnitData[0] & 64) == 0);
   bitstream.resetToStart();
   readNalUnitHeader(nalu);
 }
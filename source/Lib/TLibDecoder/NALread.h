@@ -41,6 +41,9 @@
 #ifndef __NALREAD__
 #define __NALREAD__
 
+#include <cstddef>
+#include <stdint.h>
+
 #include "TLibCommon/CommonDef.h"
 #include "TLibCommon/TComBitStream.h"
 #include "TLibCommon/NAL.h"
@@ -66,6 +69,7 @@ class InputNALUnit : public NALUnit
 };
 
 Void read(InputNALUnit& nalu);
+Void read(InputNALUnit& nalu, const uint8_t* nalUnitData, std::size_t nalUnitSize);
 Void readNalUnitHeader(InputNALUnit& nalu);
 
 //! \}
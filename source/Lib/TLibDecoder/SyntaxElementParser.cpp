@@ -166,34 +166,13 @@ Void SyntaxElementParser::xReadUvlc( UInt& rValue, const TChar *pSymbolName)
 Void SyntaxElementParser::xReadUvlc( UInt& rValue)
 #endif
 {
-  UInt uiVal = 0;
-  UInt uiCode = 0;
-  UInt uiLength;
-  m_pcBitstream->read( 1, uiCode );
+  rValue = m_pcBitstream->readUvlc();
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   UInt totalLen=1;
-#endif
-
-  if( 0 == uiCode )
+  for (UInt uiCode = rValue + 1; uiCode > 1; uiCode >>= 1)
   {
-    uiLength = 0;
-
-    while( ! ( uiCode & 1 ))
-    {
-      m_pcBitstream->read( 1, uiCode );
-      uiLength++;
-    }
-
-    m_pcBitstream->read( uiLength, uiVal );
-
-    uiVal += (1 << uiLength)-1;
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    totalLen+=uiLength+uiLength;
-#endif
+    totalLen+=2;
   }
-
-  rValue = uiVal;
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
   TComCodingStatistics::IncrementStatisticEP(pSymbolName, Int(totalLen), rValue);
 #endif
 
@@ -210,34 +189,14 @@ Void SyntaxElementParser::xReadSvlc( Int& rValue, const TChar *pSymbolName)
 Void SyntaxElementParser::xReadSvlc( Int& rValue)
 #endif
 {
-  UInt uiBits = 0;
-  m_pcBitstream->read( 1, uiBits );
+  const UInt uiBits = m_pcBitstream->readUvlc() + 1;
+  rValue = ( uiBits & 1) ? -(Int)(uiBits>>1) : (Int)(uiBits>>1);
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   UInt totalLen=1;
-#endif
-  if( 0 == uiBits )
+  for (UInt uiCode = uiBits; uiCode > 1; uiCode >>= 1)
   {
-    UInt uiLength = 0;
-
-    while( ! ( uiBits & 1 ))
-    {
-      m_pcBitstream->read( 1, uiBits );
-      uiLength++;
-    }
-
-    m_pcBitstream->read( uiLength, uiBits );
-
-    uiBits += (1 << uiLength);
-    rValue = ( uiBits & 1) ? -(Int)(uiBits>>1) : (Int)(uiBits>>1);
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    totalLen+=uiLength+uiLength;
-#endif
+    totalLen+=2;
   }
-  else
-  {
-    rValue = 0;
-  }
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
   TComCodingStatistics::IncrementStatisticEP(pSymbolName, Int(totalLen), rValue);
 #endif
 
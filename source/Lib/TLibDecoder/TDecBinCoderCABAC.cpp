@@ -44,6 +44,18 @@
 //! \ingroup TLibDecoder
 //! \{
 
+/* m_uiValue holds the arithmetic decoder offset, compared with m_uiRange << CABAC_VALUE_SHIFT,
+ * followed by the bits read ahead from the bitstream:
+ *
+ *   bit 47       39
+ *       |R|...|R|B|B|...|B|0|...|0|    (R = bits aligned with the range, B = 7 - m_bitsNeeded buffered bits)
+ *
+ * The next byte goes at bit m_bitsNeeded + 24, so a 32-bit word is loaded once m_bitsNeeded >= 0.
+ * Apart from the scale, this is the byte-wise engine of the specification with a wider refill.
+ */
+static const UInt CABAC_VALUE_SHIFT  = 39;
+static const Int  MAX_NUM_BYPASS_BINS = 16; ///< bypass bins decoded per step; the value register then uses all 64 bits
+
 TDecBinCABAC::TDecBinCABAC()
 : m_pcTComBitstream( 0 )
 {
@@ -73,9 +85,10 @@ TDecBinCABAC::start()
   TComCodingStatistics::UpdateCABACStat(STATS__CABAC_INITIALISATION, 512, 510, 0);
 #endif
   m_uiRange    = 510;
-  m_bitsNeeded = -8;
-  m_uiValue    = (m_pcTComBitstream->readByte() << 8);
-  m_uiValue   |= m_pcTComBitstream->readByte();
+  m_bitsNeeded = 0;
+  m_uiValue    = UInt64(m_pcTComBitstream->readByte()) << (CABAC_VALUE_SHIFT + 1);
+  m_uiValue   |= UInt64(m_pcTComBitstream->readByte()) << (CABAC_VALUE_SHIFT - 7);
+  xRefill();
 }
 
 Void
@@ -84,8 +97,9 @@ TDecBinCABAC::finish()
   UInt lastByte;
 
   m_pcTComBitstream->peekPreviousByte( lastByte );
-  // Check for proper stop/alignment pattern
-  assert( ((lastByte << (8 + m_bitsNeeded)) & 0xff) == 0x80 );
+  // Check for proper stop/alignment pattern. The bytes read ahead have been returned by decodeBinTrm,
+  // so m_bitsNeeded is the number of bits of the last byte used.
+  assert( ((lastByte << m_bitsNeeded) & 0xff) == 0x80 );
 }
 
 /**
@@ -116,7 +130,7 @@ Void TDecBinCABAC::decodeBin( UInt& ruiBin, ContextModel &rcCtxModel )
 
   UInt uiLPS = TComCABACTables::sm_aucLPSTable[ rcCtxModel.getState() ][ ( m_uiRange >> 6 ) - 4 ];
   m_uiRange -= uiLPS;
-  UInt scaledRange = m_uiRange << 7;
+  const UInt64 scaledRange = UInt64(m_uiRange) << CABAC_VALUE_SHIFT;
 
   if( m_uiValue < scaledRange )
   {
@@ -127,21 +141,20 @@ Void TDecBinCABAC::decodeBin( UInt& ruiBin, ContextModel &rcCtxModel )
 #endif
     rcCtxModel.updateMPS();
 
-    if ( scaledRange < ( 256 << 7 ) )
+    if ( m_uiRange < 256 )
     {
-      m_uiRange = scaledRange >> 6;
+      m_uiRange += m_uiRange;
       m_uiValue += m_uiValue;
 
       if ( ++m_bitsNeeded == 0 )
       {
-        m_bitsNeeded = -8;
-        m_uiValue += m_pcTComBitstream->readByte();
+        xRefill();
       }
     }
   }
   else
   {
-    // LPS path
+    // LPS path: the renormalisation shift is the number of leading zeros of the 8-bit LPS range
     ruiBin      = 1 - rcCtxModel.getMps();
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     TComCodingStatistics::UpdateCABACStat(whichStat, m_uiRange+uiLPS, uiLPS, Int(ruiBin));
@@ -155,8 +168,7 @@ Void TDecBinCABAC::decodeBin( UInt& ruiBin, ContextModel &rcCtxModel )
 
     if ( m_bitsNeeded >= 0 )
     {
-      m_uiValue += m_pcTComBitstream->readByte() << m_bitsNeeded;
-      m_bitsNeeded -= 8;
+      xRefill();
     }
   }
 
@@ -200,12 +212,11 @@ Void TDecBinCABAC::decodeBinEP( UInt& ruiBin )
 
   if ( ++m_bitsNeeded >= 0 )
   {
-    m_bitsNeeded = -8;
-    m_uiValue += m_pcTComBitstream->readByte();
+    xRefill();
   }
 
   ruiBin = 0;
-  UInt scaledRange = m_uiRange << 7;
+  const UInt64 scaledRange = UInt64(m_uiRange) << CABAC_VALUE_SHIFT;
   if ( m_uiValue >= scaledRange )
   {
     ruiBin = 1;
@@ -216,6 +227,11 @@ Void TDecBinCABAC::decodeBinEP( UInt& ruiBin )
 #endif
 }
 
+/** Decode bypass bins, up to MAX_NUM_BYPASS_BINS at a time.
+ * Decoding n bypass bins one by one is a binary long division of the value, shifted left by n,
+ * by the scaled range, with the bins as the quotient bits. With all n bits loaded, the bins are
+ * therefore found with a single division by the range.
+ */
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 Void TDecBinCABAC::decodeBinsEP( UInt& ruiBin, Int numBins, const TComCodingStatisticsClassType &whichStat )
 #else
@@ -236,43 +252,24 @@ Void TDecBinCABAC::decodeBinsEP( UInt& ruiBin, Int numBins )
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   Int origNumBins=numBins;
 #endif
-  while ( numBins > 8 )
+  while ( numBins > 0 )
   {
-    m_uiValue = ( m_uiValue << 8 ) + ( m_pcTComBitstream->readByte() << ( 8 + m_bitsNeeded ) );
+    const Int binsToRead = std::min(numBins, MAX_NUM_BYPASS_BINS);
 
-    UInt scaledRange = m_uiRange << 15;
-    for ( Int i = 0; i < 8; i++ )
+    m_bitsNeeded += binsToRead;
+    m_uiValue   <<= binsToRead;
+
+    if ( m_bitsNeeded >= 0 )
     {
-      bins += bins;
-      scaledRange >>= 1;
-      if ( m_uiValue >= scaledRange )
-      {
-        bins++;
-        m_uiValue -= scaledRange;
-      }
+      xRefill();
     }
-    numBins -= 8;
-  }
 
-  m_bitsNeeded += numBins;
-  m_uiValue <<= numBins;
+    // m_uiValue < m_uiRange << (CABAC_VALUE_SHIFT + binsToRead), so the quotient has binsToRead bits
+    const UInt newBins = UInt( m_uiValue >> CABAC_VALUE_SHIFT ) / m_uiRange;
 
-  if ( m_bitsNeeded >= 0 )
-  {
-    m_uiValue += m_pcTComBitstream->readByte() << m_bitsNeeded;
-    m_bitsNeeded -= 8;
-  }
-
-  UInt scaledRange = m_uiRange << ( numBins + 7 );
-  for ( Int i = 0; i < numBins; i++ )
-  {
-    bins += bins;
-    scaledRange >>= 1;
-    if ( m_uiValue >= scaledRange )
-    {
-      bins++;
-      m_uiValue -= scaledRange;
-    }
+    bins       = ( bins << binsToRead ) | newBins;
+    m_uiValue -= UInt64( newBins * m_uiRange ) << CABAC_VALUE_SHIFT;
+    numBins   -= binsToRead;
   }
 
   ruiBin = bins;
@@ -302,31 +299,24 @@ Void TDecBinCABAC::decodeAlignedBinsEP( UInt& ruiBins, Int numBins )
 
   while (binsRemaining > 0)
   {
-    const UInt binsToRead = std::min<UInt>(binsRemaining, 8); //read bytes if able to take advantage of the system's byte-read function
-    const UInt binMask    = (1 << binsToRead) - 1;
-
-    //The MSB of m_uiValue is known to be 0 because range is 256. Therefore:
-    // > The comparison against the symbol range of 128 is simply a test on the next-most-significant bit
-    // > "Subtracting" the symbol range if the decoded bin is 1 simply involves clearing that bit.
-    //
-    //As a result, the required bins are simply the <binsToRead> next-most-significant bits of m_uiValue
-    //(m_uiValue is stored MSB-aligned in a 16-bit buffer - hence the shift of 15)
-    //
-    //   m_uiValue = |0|V|V|V|V|V|V|V|V|B|B|B|B|B|B|B|        (V = usable bit, B = potential buffered bit (buffer refills when m_bitsNeeded >= 0))
-    //
-    const UInt newBins = (m_uiValue >> (15 - binsToRead)) & binMask;
-
-    ruiBins   = (ruiBins   << binsToRead) | newBins;
-    m_uiValue = (m_uiValue << binsToRead) & 0x7FFF;
+    const Int binsToRead = std::min(binsRemaining, MAX_NUM_BYPASS_BINS);
 
-    binsRemaining -= binsToRead;
-    m_bitsNeeded  += binsToRead;
+    //Because range is 256, the division by the scaled range in decodeBinsEP is a shift:
+    //the required bins are simply the <binsToRead> bits of m_uiValue above the range-aligned bits.
+    m_bitsNeeded += binsToRead;
+    m_uiValue   <<= binsToRead;
 
     if (m_bitsNeeded >= 0)
     {
-      m_uiValue    |= m_pcTComBitstream->readByte() << m_bitsNeeded;
-      m_bitsNeeded -= 8;
+      xRefill();
     }
+
+    const UInt newBins = UInt(m_uiValue >> (CABAC_VALUE_SHIFT + 8));
+
+    ruiBins   = (ruiBins << binsToRead) | newBins;
+    m_uiValue = m_uiValue & ((UInt64(1) << (CABAC_VALUE_SHIFT + 8)) - 1);
+
+    binsRemaining -= binsToRead;
   }
 
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
@@ -338,13 +328,16 @@ Void
 TDecBinCABAC::decodeBinTrm( UInt& ruiBin )
 {
   m_uiRange -= 2;
-  UInt scaledRange = m_uiRange << 7;
+  const UInt64 scaledRange = UInt64(m_uiRange) << CABAC_VALUE_SHIFT;
   if( m_uiValue >= scaledRange )
   {
     ruiBin = 1;
+    // decoding stops here (end of slice segment or sub-stream, or PCM samples follow), so the
+    // bitstream has to be left where the byte-wise engine would have left it
+    xReturnUnusedBytes();
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     TComCodingStatistics::UpdateCABACStat(STATS__CABAC_TRM_BITS, m_uiRange+2, 2, ruiBin);
-    TComCodingStatistics::IncrementStatisticEP(STATS__BYTE_ALIGNMENT_BITS, -m_bitsNeeded, 0);
+    TComCodingStatistics::IncrementStatisticEP(STATS__BYTE_ALIGNMENT_BITS, 8 - m_bitsNeeded, 0);
 #endif
   }
   else
@@ -353,15 +346,14 @@ TDecBinCABAC::decodeBinTrm( UInt& ruiBin )
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     TComCodingStatistics::UpdateCABACStat(STATS__CABAC_TRM_BITS, m_uiRange+2, m_uiRange, ruiBin);
 #endif
-    if ( scaledRange < ( 256 << 7 ) )
+    if ( m_uiRange < 256 )
     {
-      m_uiRange = scaledRange >> 6;
+      m_uiRange += m_uiRange;
       m_uiValue += m_uiValue;
 
       if ( ++m_bitsNeeded == 0 )
       {
-        m_bitsNeeded = -8;
-        m_uiValue += m_pcTComBitstream->readByte();
+        xRefill();
       }
     }
   }
@@ -380,4 +372,37 @@ Void  TDecBinCABAC::xReadPCMCode(UInt uiLength, UInt& ruiCode)
   TComCodingStatistics::IncrementStatisticEP(STATS__CABAC_PCM_CODE_BITS, uiLength, ruiCode);
 #endif
 }
+
+/** Load the next four bytes into m_uiValue (m_bitsNeeded >= 0).
+ * Near the end of the bitstream, the remaining bytes are loaded where the first bytes of the word would go.
+ */
+Void TDecBinCABAC::xRefill()
+{
+  const UInt numBitsLeft = m_pcTComBitstream->getNumBitsLeft();
+
+  if ( numBitsLeft >= 32 )
+  {
+    m_uiValue    += UInt64( m_pcTComBitstream->read( 32 ) ) << m_bitsNeeded;
+    m_bitsNeeded -= 32;
+  }
+  else if ( numBitsLeft > 0 )
+  {
+    m_uiValue    += UInt64( m_pcTComBitstream->read( numBitsLeft ) ) << ( m_bitsNeeded + 32 - numBitsLeft );
+    m_bitsNeeded -= Int(numBitsLeft);
+  }
+}
+
+/** Return the whole bytes that are still buffered in m_uiValue to the bitstream.
+ * Afterwards, the bitstream is positioned after the last byte that contributes to the value,
+ * and m_bitsNeeded (0..7) is the number of bits of that byte that have been used.
+ */
+Void TDecBinCABAC::xReturnUnusedBytes()
+{
+  assert( m_bitsNeeded < 8 );
+  const UInt numUnusedBytes = UInt( 7 - m_bitsNeeded ) >> 3;
+
+  m_pcTComBitstream->rewindBytes( numUnusedBytes );
+  m_bitsNeeded += Int(numUnusedBytes << 3);
+  m_uiValue    &= ~UInt64(0) << ( m_bitsNeeded + 32 );
+}
 //! \}
@@ -79,10 +79,13 @@ public:
   const TDecBinCABAC* getTDecBinCABAC() const { return this; }
 
 private:
+  Void  xRefill           ();
+  Void  xReturnUnusedBytes();
+
   TComInputBitstream* m_pcTComBitstream;
   UInt                m_uiRange;
-  UInt                m_uiValue;
-  Int                 m_bitsNeeded;
+  UInt64              m_uiValue;    ///< offset aligned with m_uiRange, followed by up to 39 bits read ahead
+  Int                 m_bitsNeeded; ///< minus the number of bits the value can be shifted by before the next word is loaded
 };
 
 //! \}
@@ -51,6 +51,7 @@ TDecCu::TDecCu()
   m_ppcYuvResi = NULL;
   m_ppcYuvReco = NULL;
   m_ppcCU      = NULL;
+  m_mainBitDepth = 0;
 }
 
 TDecCu::~TDecCu()
@@ -164,6 +165,28 @@ Void TDecCu::decompressCtu( TComDataCU* pCtu )
   xDecompressCU( pCtu, 0,  0 );
 }
 
+/**
+ Select the reconstruction used for CUs of the given SPS.
+ 4:2:0 streams with equal luma and chroma bit depths of 8 or 10 and no range extension tools are reconstructed
+ through instantiations specialised on the bit depth; all other streams use the generic reconstruction.
+ \param    sps                       [in]     active SPS
+ */
+Void TDecCu::selectReconstruction( const TComSPS &sps )
+{
+  m_mainBitDepth = 0;
+#if !DEBUG_STRING && !O0043_BEST_EFFORT_DECODING
+  const Int bitDepth = sps.getBitDepth(CHANNEL_TYPE_LUMA);
+
+  if (   sps.getChromaFormatIdc() == CHROMA_420
+      && sps.getBitDepth(CHANNEL_TYPE_CHROMA) == bitDepth
+      && (bitDepth == 8 || bitDepth == 10)
+      && !sps.getSpsRangeExtension().settingsDifferFromDefaults() )
+  {
+    m_mainBitDepth = bitDepth;
+  }
+#endif
+}
+
 // ====================================================================================================================
 // Protected member functions
 // ====================================================================================================================
@@ -393,8 +416,11 @@ Void TDecCu::xDecompressCU( TComDataCU* pCtu, UInt uiAbsPartIdx,  UInt uiDepth )
     return;
   }
 
-  // Residual reconstruction
-  m_ppcYuvResi[uiDepth]->clear();
+  // Residual reconstruction (the specialised reconstruction only clears the residual of coded inter CUs)
+  if (m_mainBitDepth == 0)
+  {
+    m_ppcYuvResi[uiDepth]->clear();
+  }
 
   m_ppcCU[uiDepth]->copySubCU( pCtu, uiAbsPartIdx );
 
@@ -442,6 +468,18 @@ Void TDecCu::xReconInter( TComDataCU* pcCU, UInt uiDepth )
 #endif
   m_pcPrediction->motionCompensation( pcCU, m_ppcYuvReco[uiDepth] );
 
+  switch (m_mainBitDepth)
+  {
+    case 8:
+      xReconInterResiMain<8>( pcCU, uiDepth );
+      return;
+    case 10:
+      xReconInterResiMain<10>( pcCU, uiDepth );
+      return;
+    default:
+      break;
+  }
+
 #if DEBUG_STRING
   const Int debugPredModeMask=DebugStringGetPredModeMask(MODE_INTER);
   if (DebugOptionList::DebugString_Pred.getInt()&debugPredModeMask)
@@ -486,6 +524,18 @@ TDecCu::xIntraRecBlk(       TComYuv*    pcRecoYuv,
                       const ComponentID compID,
                             TComTU     &rTu)
 {
+  switch (m_mainBitDepth)
+  {
+    case 8:
+      xIntraRecBlkMain<8>( pcRecoYuv, pcResiYuv, compID, rTu );
+      return;
+    case 10:
+      xIntraRecBlkMain<10>( pcRecoYuv, pcResiYuv, compID, rTu );
+      return;
+    default:
+      break;
+  }
+
   if (!rTu.ProcessComponentSection(compID))
   {
     return;
@@ -674,6 +724,121 @@ TDecCu::xIntraRecBlk(       TComYuv*    pcRecoYuv,
   }
 }
 
+/** Residual reconstruction of an inter CU of a 4:2:0 stream with a bit depth known at compile time.
+ * CUs without residual keep the motion compensated prediction.
+ */
+template <Int bitDepth>
+Void TDecCu::xReconInterResiMain( TComDataCU* pcCU, UInt uiDepth )
+{
+  if (!pcCU->getQtRootCbf(0))
+  {
+    return;
+  }
+
+  TComYuv *pcRecoYuv = m_ppcYuvReco[uiDepth];
+  TComYuv *pcResiYuv = m_ppcYuvResi[uiDepth];
+
+  pcResiYuv->clear();
+  xDecodeInterTexture( pcCU, uiDepth );
+
+  const Int maxVal = (1 << bitDepth) - 1;
+
+  for (UInt comp = 0; comp < MAX_NUM_COMPONENT; comp++)
+  {
+    const ComponentID compID  = ComponentID(comp);
+    const UInt        uiSize  = isLuma(compID) ? pcCU->getWidth(0) : (pcCU->getWidth(0) >> 1);
+    const UInt        uiStrideReco = pcRecoYuv->getStride(compID);
+    const UInt        uiStrideResi = pcResiYuv->getStride(compID);
+          Pel*        pReco   = pcRecoYuv->getAddr(compID);
+    const Pel*        pResi   = pcResiYuv->getAddr(compID);
+
+    for (UInt y = 0; y < uiSize; y++)
+    {
+      for (UInt x = 0; x < uiSize; x++)
+      {
+        pReco[x] = Pel(Clip3<Int>(0, maxVal, pReco[x] + pResi[x]));
+      }
+      pReco += uiStrideReco;
+      pResi += uiStrideResi;
+    }
+  }
+}
+
+/** Intra reconstruction of a TU of a 4:2:0 stream with a bit depth known at compile time.
+ * TUs are always square, there is no chroma mode mapping, intra smoothing or cross-component prediction,
+ * and the prediction is formed in the reconstruction buffer so that uncoded TUs only need to be copied to the picture.
+ */
+template <Int bitDepth>
+Void TDecCu::xIntraRecBlkMain( TComYuv* pcRecoYuv, TComYuv* pcResiYuv, const ComponentID compID, TComTU &rTu )
+{
+  if (!rTu.ProcessComponentSection(compID))
+  {
+    return;
+  }
+
+  TComDataCU *pcCU = rTu.getCU();
+  const TComSPS &sps=*(pcCU->getSlice()->getSPS());
+  const UInt uiAbsPartIdx=rTu.GetAbsPartIdxTU();
+
+  const TComRectangle &tuRect  =rTu.getRect(compID);
+  const UInt uiWidth           = tuRect.width;
+  const UInt uiHeight          = tuRect.height;
+  const UInt uiStride          = pcRecoYuv->getStride (compID);
+        Pel* piReco            = pcRecoYuv->getAddr( compID, uiAbsPartIdx );
+
+  const UInt uiChPredMode  = pcCU->getIntraDir( toChannelType(compID), uiAbsPartIdx );
+  const UInt partsPerMinCU = 1<<(2*(sps.getMaxTotalCUDepth() - sps.getLog2DiffMaxMinCodingBlockSize()));
+  const UInt uiChFinalMode = (uiChPredMode==DM_CHROMA_IDX && isChroma(compID)) ? pcCU->getIntraDir(CHANNEL_TYPE_LUMA, getChromasCorrespondingPULumaIdx(uiAbsPartIdx, CHROMA_420, partsPerMinCU)) : uiChPredMode;
+
+  //===== init availability pattern =====
+  const Bool bUseFilteredPredictions=TComPrediction::filteringIntraReferenceSamples(compID, uiChFinalMode, uiWidth, uiHeight, CHROMA_420, false);
+
+  DEBUG_STRING_NEW(sTemp)
+  m_pcPrediction->initIntraPatternChType( rTu, compID, bUseFilteredPredictions  DEBUG_STRING_PASS_INTO(sTemp) );
+
+  //===== get prediction signal =====
+  m_pcPrediction->predIntraAng( compID,   uiChFinalMode, 0 /* Decoder does not have an original image */, 0, piReco, uiStride, rTu, bUseFilteredPredictions );
+
+  //===== reconstruction =====
+  const UInt uiRecIPredStride  = pcCU->getPic()->getPicYuvRec()->getStride(compID);
+        Pel* pRecIPred         = pcCU->getPic()->getPicYuvRec()->getAddr( compID, pcCU->getCtuRsAddr(), pcCU->getZorderIdxInCtu() + uiAbsPartIdx );
+
+  if (pcCU->getCbf(uiAbsPartIdx, compID, rTu.GetTransformDepthRel()) != 0)
+  {
+    Pel*      piResi  = pcResiYuv->getAddr( compID, uiAbsPartIdx );
+    TCoeff*   pcCoeff = pcCU->getCoeff(compID) + rTu.getCoefficientOffset(compID);
+    const QpParam cQP(*pcCU, compID);
+#if DEBUG_STRING
+    std::string *psDebug = 0;
+#endif
+
+    m_pcTrQuant->invTransformNxN( rTu, compID, piResi, uiStride, pcCoeff, cQP DEBUG_STRING_PASS_INTO(psDebug) );
+
+    const Int maxVal = (1 << bitDepth) - 1;
+
+    for( UInt uiY = 0; uiY < uiHeight; uiY++ )
+    {
+      for( UInt uiX = 0; uiX < uiWidth; uiX++ )
+      {
+        piReco   [ uiX ] = Pel(Clip3<Int>(0, maxVal, piReco[ uiX ] + piResi[ uiX ]));
+        pRecIPred[ uiX ] = piReco[ uiX ];
+      }
+      piResi    += uiStride;
+      piReco    += uiStride;
+      pRecIPred += uiRecIPredStride;
+    }
+  }
+  else
+  {
+    for( UInt uiY = 0; uiY < uiHeight; uiY++ )
+    {
+      ::memcpy( pRecIPred, piReco, uiWidth * sizeof(Pel) );
+      piReco    += uiStride;
+      pRecIPred += uiRecIPredStride;
+    }
+  }
+}
+
 
 Void
 TDecCu::xReconIntraQT( TComDataCU* pcCU, UInt uiDepth )
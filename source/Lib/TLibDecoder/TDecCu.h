@@ -73,6 +73,8 @@ private:
   Bool                m_bDecodeDQP;
   Bool                m_IsChromaQpAdjCoded;
 
+  Int                 m_mainBitDepth;     ///< bit depth of the specialised 4:2:0 Main/Main10 reconstruction, 0 for the generic reconstruction
+
 public:
   TDecCu();
   virtual ~TDecCu();
@@ -96,6 +98,9 @@ public:
   /// reconstruct Ctu information
   Void  decompressCtu           ( TComDataCU* pCtu );
 
+  /// select the reconstruction path used for the given SPS
+  Void  selectReconstruction    ( const TComSPS &sps );
+
 protected:
 
   Void xDecodeCU                ( TComDataCU* const pcCU, const UInt uiAbsPartIdx, const UInt uiDepth, Bool &isLastCtuOfSliceSegment);
@@ -109,6 +114,11 @@ protected:
   Void xIntraRecBlk             ( TComYuv* pcRecoYuv, TComYuv* pcPredYuv, TComYuv* pcResiYuv, const ComponentID component, TComTU &rTu );
   Void xIntraRecQT              ( TComYuv* pcRecoYuv, TComYuv* pcPredYuv, TComYuv* pcResiYuv, const ChannelType chType, TComTU &rTu );
 
+  template <Int bitDepth>
+  Void xReconInterResiMain      ( TComDataCU* pcCU, UInt uiDepth );
+  template <Int bitDepth>
+  Void xIntraRecBlkMain         ( TComYuv* pcRecoYuv, TComYuv* pcResiYuv, const ComponentID compID, TComTU &rTu );
+
   Void xReconPCM                ( TComDataCU* pcCU, UInt uiDepth );
 
   Void xDecodeInterTexture      ( TComDataCU* pcCU, UInt uiDepth );
@@ -139,16 +139,24 @@ Void TDecGop::filterPicture(TComPic* pcPic)
   //-- For time output for each slice
   clock_t iBeforeTime = clock();
 
-  // deblocking filter
-  Bool bLFCrossTileBoundary = pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag();
-  m_pcLoopFilter->setCfg(bLFCrossTileBoundary);
-  m_pcLoopFilter->loopFilterPic( pcPic );
-
-  if( pcSlice->getSPS()->getUseSAO() )
+  if ( m_pcSliceDecoder->getLoopFilterCtuRows() )
+  {
+    // the CTU rows have been filtered while the slices were decoded, except the last ones
+    m_pcSliceDecoder->finishLoopFilterCtuRows( pcPic );
+  }
+  else
   {
-    m_pcSAO->reconstructBlkSAOParams(pcPic, pcPic->getPicSym()->getSAOBlkParam());
-    m_pcSAO->SAOProcess(pcPic);
-    m_pcSAO->PCMLFDisableProcess(pcPic);
+    // deblocking filter
+    Bool bLFCrossTileBoundary = pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag();
+    m_pcLoopFilter->setCfg(bLFCrossTileBoundary);
+    m_pcLoopFilter->loopFilterPic( pcPic );
+
+    if( pcSlice->getSPS()->getUseSAO() )
+    {
+      m_pcSAO->reconstructBlkSAOParams(pcPic, pcPic->getPicSym()->getSAOBlkParam());
+      m_pcSAO->SAOProcess(pcPic);
+      m_pcSAO->PCMLFDisableProcess(pcPic);
+    }
   }
 
   pcPic->compressMotion();
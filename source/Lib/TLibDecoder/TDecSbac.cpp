@@ -55,6 +55,59 @@
 #endif
 
 
+//////////////////////////////////////////////////////////////////////
+// Tables for xParseCoeffNxNFast
+//////////////////////////////////////////////////////////////////////
+
+// raster position (x + 4y) within a 4x4 coefficient group of each scan position
+static const UChar coeffGroupScan[SCAN_NUMBER_OF_TYPES][1 << MLS_CG_SIZE] =
+{
+  {  0,  4,  1,  8,  5,  2, 12,  9,  6,  3, 13, 10,  7, 14, 11, 15 }, //SCAN_DIAG
+  {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 }, //SCAN_HOR
+  {  0,  4,  8, 12,  1,  5,  9, 13,  2,  6, 10, 14,  3,  7, 11, 15 }  //SCAN_VER
+};
+
+// scan position of each raster position within a 4x4 coefficient group
+static const UChar coeffGroupScanPosition[SCAN_NUMBER_OF_TYPES][1 << MLS_CG_SIZE] =
+{
+  {  0,  2,  5,  9,  1,  4,  8, 12,  3,  7, 11, 14,  6, 10, 13, 15 }, //SCAN_DIAG
+  {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 }, //SCAN_HOR
+  {  0,  4,  8, 12,  1,  5,  9, 13,  2,  6, 10, 14,  3,  7, 11, 15 }  //SCAN_VER
+};
+
+// significant_coeff_flag context of each scan position of a 4x4 TU (ctxIndMap4x4 in scan order)
+static const UChar sigCtx4x4[SCAN_NUMBER_OF_TYPES][1 << MLS_CG_SIZE] =
+{
+  { 0, 2, 1, 6, 3, 4, 7, 6, 4, 5, 7, 8, 5, 8, 8, 8 }, //SCAN_DIAG
+  { 0, 1, 4, 5, 2, 3, 4, 5, 6, 6, 8, 8, 7, 7, 8, 8 }, //SCAN_HOR
+  { 0, 2, 6, 7, 1, 3, 6, 7, 4, 4, 8, 8, 5, 5, 8, 8 }  //SCAN_VER
+};
+
+// significant_coeff_flag context increment of each scan position of a coefficient group in a larger TU,
+// for each pattern of significant right (1) and below (2) groups (see TComTrQuant::getSigCtxInc)
+static const UChar sigCtxCoeffGroup[SCAN_NUMBER_OF_TYPES][4][1 << MLS_CG_SIZE] =
+{
+  { //SCAN_DIAG
+    { 2, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+    { 2, 1, 2, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 0, 0, 0 },
+    { 2, 2, 1, 2, 1, 0, 2, 1, 0, 0, 1, 0, 0, 0, 0, 0 },
+    { 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2 }
+  },
+  { //SCAN_HOR
+    { 2, 1, 1, 0, 1, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0 },
+    { 2, 2, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0 },
+    { 2, 1, 0, 0, 2, 1, 0, 0, 2, 1, 0, 0, 2, 1, 0, 0 },
+    { 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2 }
+  },
+  { //SCAN_VER
+    { 2, 1, 1, 0, 1, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0 },
+    { 2, 1, 0, 0, 2, 1, 0, 0, 2, 1, 0, 0, 2, 1, 0, 0 },
+    { 2, 2, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0 },
+    { 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2 }
+  }
+};
+
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -1356,6 +1409,18 @@ Void TDecSbac::parseCoeffNxN(  TComTU &rTu, ComponentID compID )
   //===== decode last significant =====
   UInt uiPosLastX, uiPosLastY;
   parseLastSignificantXY( uiPosLastX, uiPosLastY, uiWidth, uiHeight, compID, codingParameters.scanType );
+
+  if (   !extendedPrecision && !alignCABACBeforeBypass && !bUseGolombRiceParameterAdaptation && (uiWidth == uiHeight)
+      && (codingParameters.firstSignificanceMapContext != significanceMapContextSetStart[chType][CONTEXT_TYPE_SINGLE]) )
+  {
+    xParseCoeffNxNFast( pcCoef, uiLog2BlockWidth, compID, codingParameters, uiPosLastX, uiPosLastY, beValid, maxLog2TrDynamicRange );
+
+#if ENVIRONMENT_VARIABLE_DEBUG_AND_TEST
+    printSBACCoeffData(uiPosLastX, uiPosLastY, uiWidth, uiHeight, compID, uiAbsPartIdx, codingParameters.scanType, pcCoef);
+#endif
+    return;
+  }
+
   UInt uiBlkPosLast      = uiPosLastX + (uiPosLastY<<uiLog2BlockWidth);
   pcCoef[ uiBlkPosLast ] = 1;
 
@@ -1614,6 +1679,279 @@ Void TDecSbac::parseCoeffNxN(  TComTU &rTu, ComponentID compID )
   return;
 }
 
+/** Parse the coefficients of a square TU when none of the range extension tools that change residual
+ *  coding are used, that is without extended precision, bypass alignment, persistent Rice adaptation
+ *  or the single significance map context of transform skip.
+ *  Coefficient groups are visited in scan order without searching the coefficient scan, the
+ *  significant_coeff_flag contexts come from per-TU-size tables, and the coefficients are written
+ *  straight into the TU buffer.
+ * \param pcCoef            coefficients of the TU
+ * \param uiLog2BlockSize   log2 of the TU width and height
+ * \param compID            component of the TU
+ * \param codingParameters  scans and first significance map context of the TU
+ * \param uiPosLastX        column of the last significant coefficient
+ * \param uiPosLastY        row of the last significant coefficient
+ * \param beValid           whether sign data hiding may be used in the TU
+ * \param maxLog2TrDynamicRange dynamic range of the coefficients
+ */
+Void TDecSbac::xParseCoeffNxNFast( TCoeff* pcCoef, const UInt uiLog2BlockSize, const ComponentID compID, const TUEntropyCodingParameters &codingParameters,
+                                   const UInt uiPosLastX, const UInt uiPosLastY, const Bool beValid, const Int maxLog2TrDynamicRange )
+{
+  const ChannelType     chType             = toChannelType(compID);
+  const COEFF_SCAN_TYPE scanType           = codingParameters.scanType;
+  const UInt            log2WidthInGroups  = uiLog2BlockSize - MLS_CG_LOG2_WIDTH;
+  const UInt            widthInGroups      = 1 << log2WidthInGroups;
+
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  TComCodingStatisticsClassType ctype_group(STATS__CABAC_BITS__SIG_COEFF_GROUP_FLAG, uiLog2BlockSize, compID);
+  TComCodingStatisticsClassType ctype_map  (STATS__CABAC_BITS__SIG_COEFF_MAP_FLAG,   uiLog2BlockSize, compID);
+  TComCodingStatisticsClassType ctype_gt1  (STATS__CABAC_BITS__GT1_FLAG,             uiLog2BlockSize, compID);
+  TComCodingStatisticsClassType ctype_gt2  (STATS__CABAC_BITS__GT2_FLAG,             uiLog2BlockSize, compID);
+  TComCodingStatisticsClassType ctype_signs(STATS__CABAC_BITS__SIGN_BIT,             uiLog2BlockSize, compID);
+  TComCodingStatisticsClassType ctype_escs (STATS__CABAC_BITS__ESCAPE_BITS,          uiLog2BlockSize, compID);
+#endif
+
+  // offset in the TU of each scan position of a coefficient group
+  Int coeffGroupOffset[1 << MLS_CG_SIZE];
+  for (Int n = 0; n < (1 << MLS_CG_SIZE); n++)
+  {
+    const UInt rasterPos = coeffGroupScan[scanType][n];
+    coeffGroupOffset[n]  = (rasterPos & 3) + ((rasterPos >> 2) << uiLog2BlockSize);
+  }
+
+  // locate the last significant coefficient in the scan
+  const UInt uiCGBlkPosLast = ((uiPosLastY >> MLS_CG_LOG2_HEIGHT) << log2WidthInGroups) + (uiPosLastX >> MLS_CG_LOG2_WIDTH);
+  Int iLastScanSet = 0;
+  while (codingParameters.scanCG[iLastScanSet] != uiCGBlkPosLast)
+  {
+    iLastScanSet++;
+  }
+  const Int iLastPosInCG = coeffGroupScanPosition[scanType][(uiPosLastX & 3) + ((uiPosLastY & 3) << 2)];
+
+  ContextModel * const baseCoeffGroupCtx = m_cCUSigCoeffGroupSCModel.get( 0, isChroma(chType) );
+  ContextModel * const baseCtx           = m_cCUSigSCModel.get( 0, 0 ) + getSignificanceMapContextOffset(compID);
+
+  UInt uiSigCoeffGroupFlag[ MLS_GRP_NUM ];
+  memset( uiSigCoeffGroupFlag, 0, sizeof(UInt) << (2 * log2WidthInGroups) );
+
+  UInt c1 = 1;
+
+  for( Int iSubSet = iLastScanSet; iSubSet >= 0; iSubSet-- )
+  {
+    const UInt iCGBlkPos = codingParameters.scanCG[ iSubSet ];
+    const UInt iCGPosY   = iCGBlkPos >> log2WidthInGroups;
+    const UInt iCGPosX   = iCGBlkPos & (widthInGroups - 1);
+    TCoeff * const pcCGCoef = pcCoef + (iCGPosY << (uiLog2BlockSize + MLS_CG_LOG2_HEIGHT)) + (iCGPosX << MLS_CG_LOG2_WIDTH);
+
+    for (Int y = 0; y < (1 << MLS_CG_LOG2_HEIGHT); y++)
+    {
+      memset( pcCGCoef + (y << uiLog2BlockSize), 0, sizeof(TCoeff) << MLS_CG_LOG2_WIDTH );
+    }
+
+    const UInt sigRight = (iCGPosX < widthInGroups - 1) ? uiSigCoeffGroupFlag[ iCGBlkPos + 1             ] : 0;
+    const UInt sigLower = (iCGPosY < widthInGroups - 1) ? uiSigCoeffGroupFlag[ iCGBlkPos + widthInGroups ] : 0;
+
+    Int  numNonZero = 0;
+    Int  pos[1 << MLS_CG_SIZE];
+    Int  iScanPosSig = (1 << MLS_CG_SIZE) - 1;
+    Int  lastNZPosInCG = -1;
+    Int  firstNZPosInCG = 1 << MLS_CG_SIZE;
+
+    if( iSubSet == iLastScanSet )
+    {
+      lastNZPosInCG  = iLastPosInCG;
+      firstNZPosInCG = iLastPosInCG;
+      iScanPosSig    = iLastPosInCG - 1;
+      pos[ numNonZero++ ] = coeffGroupOffset[ iLastPosInCG ];
+    }
+
+    // decode significant_coeffgroup_flag
+    if( iSubSet == iLastScanSet || iSubSet == 0 )
+    {
+      uiSigCoeffGroupFlag[ iCGBlkPos ] = 1;
+    }
+    else
+    {
+      UInt uiSigCoeffGroup;
+      m_pcTDecBinIf->decodeBin( uiSigCoeffGroup, baseCoeffGroupCtx[ sigRight | sigLower ] RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(ctype_group) );
+      uiSigCoeffGroupFlag[ iCGBlkPos ] = uiSigCoeffGroup;
+    }
+
+    // decode significant_coeff_flag
+    if( uiSigCoeffGroupFlag[ iCGBlkPos ] )
+    {
+      const UChar  *sigCtx;
+      ContextModel *groupCtx = baseCtx + codingParameters.firstSignificanceMapContext;
+      if (uiLog2BlockSize == 2)
+      {
+        sigCtx = sigCtx4x4[ scanType ];
+      }
+      else
+      {
+        sigCtx = sigCtxCoeffGroup[ scanType ][ sigRight + (sigLower << 1) ];
+        if (iSubSet > 0)
+        {
+          groupCtx += notFirstGroupNeighbourhoodContextOffset[ chType ];
+        }
+      }
+
+      UInt uiSig;
+      for( ; iScanPosSig > 0; iScanPosSig-- )
+      {
+        m_pcTDecBinIf->decodeBin( uiSig, groupCtx[ sigCtx[ iScanPosSig ] ] RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(ctype_map) );
+        if( uiSig )
+        {
+          pos[ numNonZero++ ] = coeffGroupOffset[ iScanPosSig ];
+          if( lastNZPosInCG == -1 )
+          {
+            lastNZPosInCG = iScanPosSig;
+          }
+          firstNZPosInCG = iScanPosSig;
+        }
+      }
+
+      if( iScanPosSig == 0 )
+      {
+        if( iSubSet == 0 )
+        {
+          // the DC coefficient has its own context
+          m_pcTDecBinIf->decodeBin( uiSig, baseCtx[ 0 ] RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(ctype_map) );
+        }
+        else if( numNonZero )
+        {
+          m_pcTDecBinIf->decodeBin( uiSig, groupCtx[ sigCtx[ 0 ] ] RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(ctype_map) );
+        }
+        else
+        {
+          uiSig = 1;
+        }
+
+        if( uiSig )
+        {
+          pos[ numNonZero++ ] = coeffGroupOffset[ 0 ];
+          if( lastNZPosInCG == -1 )
+          {
+            lastNZPosInCG = 0;
+          }
+          firstNZPosInCG = 0;
+        }
+      }
+    }
+
+    if( numNonZero == 0 )
+    {
+      continue;
+    }
+
+    const Bool signHidden = beValid && ( lastNZPosInCG - firstNZPosInCG >= SBH_THRESHOLD );
+
+    const UInt uiCtxSet = getContextSetIndex(compID, iSubSet, (c1 == 0));
+    c1 = 1;
+    UInt uiBin;
+
+    ContextModel *baseCtxMod = m_cCUOneSCModel.get( 0, 0 ) + (NUM_ONE_FLAG_CTX_PER_SET * uiCtxSet);
+
+    Int absCoeff[1 << MLS_CG_SIZE];
+    for ( Int i = 0; i < numNonZero; i++)
+    {
+      absCoeff[i] = 1;
+    }
+    const Int numC1Flag = min(numNonZero, C1FLAG_NUMBER);
+    Int firstC2FlagIdx = -1;
+    Bool escapeDataPresentInGroup = (numNonZero > C1FLAG_NUMBER);
+
+    for( Int idx = 0; idx < numC1Flag; idx++ )
+    {
+      m_pcTDecBinIf->decodeBin( uiBin, baseCtxMod[c1] RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(ctype_gt1) );
+      if( uiBin == 1 )
+      {
+        c1 = 0;
+        if (firstC2FlagIdx == -1)
+        {
+          firstC2FlagIdx = idx;
+        }
+        else //if a greater-than-one has been encountered already this group
+        {
+          escapeDataPresentInGroup = true;
+        }
+      }
+      else if( (c1 < 3) && (c1 > 0) )
+      {
+        c1++;
+      }
+      absCoeff[ idx ] = uiBin + 1;
+    }
+
+    if (firstC2FlagIdx != -1)
+    {
+      baseCtxMod = m_cCUAbsSCModel.get( 0, 0 ) + (NUM_ABS_FLAG_CTX_PER_SET * uiCtxSet);
+      m_pcTDecBinIf->decodeBin( uiBin, baseCtxMod[0] RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(ctype_gt2) );
+      absCoeff[ firstC2FlagIdx ] = uiBin + 2;
+      if (uiBin != 0)
+      {
+        escapeDataPresentInGroup = true;
+      }
+    }
+
+    // all the signs of the group in one call
+    const Int numSigns = signHidden ? (numNonZero - 1) : numNonZero;
+    UInt coeffSigns;
+    m_pcTDecBinIf->decodeBinsEP( coeffSigns, numSigns RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(ctype_signs) );
+    coeffSigns <<= 32 - numSigns;
+
+    if (escapeDataPresentInGroup)
+    {
+      UInt uiGoRiceParam = 0;
+      Int  iFirstCoeff2  = 1;
+      for( Int idx = 0; idx < numNonZero; idx++ )
+      {
+        const Int baseLevel = (idx < C1FLAG_NUMBER) ? (2 + iFirstCoeff2) : 1;
+
+        if( absCoeff[ idx ] == baseLevel )
+        {
+          UInt uiLevel;
+          xReadCoefRemainExGolomb( uiLevel, uiGoRiceParam, false, maxLog2TrDynamicRange RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(ctype_escs) );
+
+          absCoeff[ idx ] = uiLevel + baseLevel;
+
+          if (absCoeff[ idx ] > (3 << uiGoRiceParam))
+          {
+            uiGoRiceParam = std::min<UInt>(uiGoRiceParam + 1, 4);
+          }
+        }
+
+        if( absCoeff[ idx ] >= 2 )
+        {
+          iFirstCoeff2 = 0;
+        }
+      }
+    }
+
+    Int absSum = 0;
+    for( Int idx = 0; idx < numNonZero; idx++ )
+    {
+      TCoeff coeff = absCoeff[ idx ];
+      absSum += absCoeff[ idx ];
+
+      if ( idx == numNonZero-1 && signHidden )
+      {
+        // Infer sign of 1st element.
+        if (absSum&0x1)
+        {
+          coeff = -coeff;
+        }
+      }
+      else
+      {
+        const Int sign = static_cast<Int>( coeffSigns ) >> 31;
+        coeff = ( coeff ^ sign ) - sign;
+        coeffSigns <<= 1;
+      }
+      pcCGCoef[ pos[ idx ] ] = coeff;
+    }
+  }
+}
+
 Void TDecSbac::parseSaoMaxUvlc ( UInt& val, UInt maxSymbol )
 {
   if (maxSymbol == 0)
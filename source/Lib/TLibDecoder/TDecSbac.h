@@ -103,6 +103,8 @@ private:
   Void  xReadEpExGolomb     ( UInt& ruiSymbol, UInt uiCount );
   Void  xReadCoefRemainExGolomb ( UInt &rSymbol, UInt &rParam, const Bool useLimitedPrefixLength, const Int maxLog2TrDynamicRange );
 #endif
+  Void  xParseCoeffNxNFast  ( TCoeff* pcCoef, const UInt uiLog2BlockSize, const ComponentID compID, const TUEntropyCodingParameters &codingParameters,
+                              const UInt uiPosLastX, const UInt uiPosLastY, const Bool beValid, const Int maxLog2TrDynamicRange );
 private:
   TComInputBitstream* m_pcBitstream;
   TDecBinIf*        m_pcTDecBinIf;
@@ -46,6 +46,13 @@
 //////////////////////////////////////////////////////////////////////
 
 TDecSlice::TDecSlice()
+ : m_pcThreadPool(NULL)
+ , m_pcLoopFilter(NULL)
+ , m_pcSAO(NULL)
+ , m_loopFilterCtuRows(false)
+ , m_pcLoopFilterPic(NULL)
+ , m_numDeblockedCtuRows(0)
+ , m_numSAOCtuRows(0)
 {
 }
 
@@ -59,13 +66,24 @@ Void TDecSlice::create()
 
 Void TDecSlice::destroy()
 {
+  for ( UInt substreamIdx = 0; substreamIdx < m_apcWavefrontSyncContextStates.size(); substreamIdx++ )
+  {
+    delete m_apcWavefrontSyncContextStates[substreamIdx];
+  }
+  m_apcWavefrontSyncContextStates.clear();
 }
 
-Void TDecSlice::init(TDecEntropy* pcEntropyDecoder, TDecCu* pcCuDecoder, TDecConformanceCheck *pDecConformanceCheck)
+Void TDecSlice::init(TDecEntropy* pcEntropyDecoder, TDecCu* pcCuDecoder, TDecConformanceCheck *pDecConformanceCheck,
+                     TComThreadPool* pcThreadPool, const std::vector<TDecCtuWorker*>& apcCtuWorkers,
+                     TComLoopFilter* pcLoopFilter, TComSampleAdaptiveOffset* pcSAO)
 {
   m_pcEntropyDecoder     = pcEntropyDecoder;
   m_pcCuDecoder          = pcCuDecoder;
   m_pDecConformanceCheck = pDecConformanceCheck;
+  m_pcThreadPool         = pcThreadPool;
+  m_apcCtuWorkers        = apcCtuWorkers;
+  m_pcLoopFilter         = pcLoopFilter;
+  m_pcSAO                = pcSAO;
 }
 
 Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcPic, TDecSbac* pcSbacDecoder)
@@ -80,14 +98,26 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
   const Bool depSliceSegmentsEnabled = pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag();
   const Bool wavefrontsEnabled       = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag();
 
-  m_pcEntropyDecoder->setEntropyDecoder ( pcSbacDecoder  );
-  m_pcEntropyDecoder->setBitstream      ( ppcSubstreams[0] );
-  m_pcEntropyDecoder->resetEntropy      (pcSlice);
-
   // decoder doesn't need prediction & residual frame buffer
   pcPic->setPicYuvPred( 0 );
   pcPic->setPicYuvResi( 0 );
 
+  const Bool bUseWorkerThreads = xUseWorkerThreads();
+  std::vector<UInt> substreamStartCtuTsAddr;
+  if ( bUseWorkerThreads && pcSlice->getNumberOfSubstreamSizes() > 0 && xDetermineSubstreamStartCtuTsAddrs( pcPic, pcSlice, substreamStartCtuTsAddr ) )
+  {
+    xDecompressSliceParallel( ppcSubstreams, pcPic, substreamStartCtuTsAddr );
+    if ( m_loopFilterCtuRows )
+    {
+      xFilterCtuRows( pcPic, pcSlice->getSliceSegmentCurEndCtuTsAddr() );
+    }
+    return;
+  }
+
+  m_pcEntropyDecoder->setEntropyDecoder ( pcSbacDecoder  );
+  m_pcEntropyDecoder->setBitstream      ( ppcSubstreams[0] );
+  m_pcEntropyDecoder->resetEntropy      (pcSlice);
+
 #if ENC_DEC_TRACE
   g_bJustDoIt = g_bEncDecTraceEnable;
 #endif
@@ -121,6 +151,12 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
     }
   }
 
+  // otherwise, the CTUs are parsed on this thread and reconstructed behind it on a worker thread
+  if ( bUseWorkerThreads )
+  {
+    xStartPipelinedReconstruction( pcPic, startCtuTsAddr );
+  }
+
   // for every CTU in the slice segment...
 
   Bool isLastCtuOfSliceSegment = false;
@@ -221,7 +257,22 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
     }
 #endif
 
-    m_pcCuDecoder->decompressCtu ( pCtu );
+    if ( bUseWorkerThreads )
+    {
+      if ( isLastCtuOfSliceSegment || ctuTsAddr+1 == numCtusInFrame )
+      {
+        m_reconstructionSync.setProgress( 1, Int(ctuTsAddr) );
+      }
+      m_reconstructionSync.setProgress( 0, Int(ctuTsAddr) );
+    }
+    else
+    {
+      m_pcCuDecoder->decompressCtu ( pCtu );
+      if ( m_loopFilterCtuRows )
+      {
+        xFilterCtuRows( pcPic, ctuTsAddr+1 );
+      }
+    }
 
 #if ENC_DEC_TRACE
     g_bJustDoIt = g_bEncDecTraceDisable;
@@ -260,6 +311,11 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
 
   }
 
+  if ( bUseWorkerThreads )
+  {
+    m_pcThreadPool->waitForAll();
+  }
+
   assert(isLastCtuOfSliceSegment == true);
 
 
@@ -270,4 +326,348 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
 
 }
 
+/** Check whether the worker threads can be used to decode a slice segment.
+ * The trace, the bit statistics and the conformance checks are collected in decoding order, so the serial loop is
+ * used for them.
+ */
+Bool TDecSlice::xUseWorkerThreads() const
+{
+#if ENC_DEC_TRACE || RExt__DECODER_DEBUG_BIT_STATISTICS
+  return false;
+#else
+  if ( m_apcCtuWorkers.empty() )
+  {
+    return false;
+  }
+  if ( TDecConformanceCheck::doChecking() )
+  {
+    return false;
+  }
+#if MCTS_ENC_CHECK
+  if ( m_pDecConformanceCheck && m_pDecConformanceCheck->getTMctsCheck() )
+  {
+    return false;
+  }
+#endif
+  return true;
+#endif
+}
+
+/** Find the first CTU of each substream of a slice segment.
+ * Only the first CTU of the slice segment is known before parsing, so the last substream is bounded by the end of its
+ * tile, or of its CTU row of the tile when wavefronts are enabled.
+ * \param pcPic                   picture class
+ * \param pcSlice                 slice segment
+ * \param substreamStartCtuTsAddr returns the first CTU of each substream, followed by the bound of the last one
+ * \returns false if the picture has fewer substreams than signalled by the entry points
+ */
+Bool TDecSlice::xDetermineSubstreamStartCtuTsAddrs( TComPic* pcPic, TComSlice* pcSlice, std::vector<UInt>& substreamStartCtuTsAddr )
+{
+  const TComPicSym* const pcPicSym = pcPic->getPicSym();
+  const UInt startCtuTsAddr        = pcSlice->getSliceSegmentCurStartCtuTsAddr();
+  const UInt numCtusInFrame        = pcPic->getNumberOfCtusInFrame();
+  const UInt numSubstreams         = pcSlice->getNumberOfSubstreamSizes()+1;
+  const UInt subStreamOffset       = pcPic->getSubstreamForCtuAddr(pcPicSym->getCtuTsToRsAddrMap(startCtuTsAddr), true, pcSlice);
+
+  substreamStartCtuTsAddr.clear();
+  UInt ctuTsAddr = startCtuTsAddr;
+  for( ; ctuTsAddr < numCtusInFrame; ctuTsAddr++ )
+  {
+    const UInt substreamIdx = pcPic->getSubstreamForCtuAddr(pcPicSym->getCtuTsToRsAddrMap(ctuTsAddr), true, pcSlice) - subStreamOffset;
+    if ( substreamIdx >= numSubstreams )
+    {
+      break;
+    }
+    if ( substreamIdx == substreamStartCtuTsAddr.size() )
+    {
+      substreamStartCtuTsAddr.push_back( ctuTsAddr );
+    }
+  }
+  if ( substreamStartCtuTsAddr.size() != numSubstreams )
+  {
+    return false;
+  }
+  substreamStartCtuTsAddr.push_back( ctuTsAddr );
+
+  while ( m_apcWavefrontSyncContextStates.size() < numSubstreams )
+  {
+    m_apcWavefrontSyncContextStates.push_back( new TDecSbac );
+  }
+  return true;
+}
+
+/** Decode the substreams of a slice segment on the worker threads, each with its own SBAC and CU decoder.
+ * With wavefronts, a CTU is only parsed and reconstructed once the row above has finished its top-right neighbour,
+ * which also makes the synchronisation contexts of the row above available.
+ * \param ppcSubstreams           substreams of the slice segment
+ * \param pcPic                   picture class
+ * \param substreamStartCtuTsAddr first CTU of each substream, followed by the bound of the last one
+ */
+Void TDecSlice::xDecompressSliceParallel( TComInputBitstream** ppcSubstreams, TComPic* pcPic, const std::vector<UInt>& substreamStartCtuTsAddr )
+{
+  TComSlice* const pcSlice           = pcPic->getSlice(pcPic->getCurrSliceIdx());
+  TComPicSym* const pcPicSym         = pcPic->getPicSym();
+  const UInt startCtuTsAddr          = substreamStartCtuTsAddr.front();
+  const UInt boundingCtuTsAddr       = substreamStartCtuTsAddr.back();
+  const Int  numSubstreams           = Int(substreamStartCtuTsAddr.size()) - 1;
+
+  const UInt frameWidthInCtus        = pcPicSym->getFrameWidthInCtus();
+  const Bool depSliceSegmentsEnabled = pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag();
+  const Bool wavefrontsEnabled       = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag();
+
+  // a row has completed all CTUs left of its first one: those belong to previous slice segments
+  m_wavefrontSync.create( numSubstreams, -1 );
+  std::vector<Int>  hasSyncState( numSubstreams, 0 ); // not std::vector<Bool>: its elements are written concurrently
+  for( Int substreamIdx = 0; substreamIdx < numSubstreams; substreamIdx++ )
+  {
+    const UInt ctuRsAddr = pcPicSym->getCtuTsToRsAddrMap( substreamStartCtuTsAddr[substreamIdx] );
+    m_wavefrontSync.setProgress( substreamIdx, Int(ctuRsAddr % frameWidthInCtus) - 1 );
+  }
+
+  // initialise the CTUs first: the availability checks of a CTU read the slice of its neighbours in other substreams.
+  // CTUs beyond the end of the slice segment are initialised again by the slice segment that contains them.
+  for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ctuTsAddr++ )
+  {
+    const UInt ctuRsAddr = pcPicSym->getCtuTsToRsAddrMap(ctuTsAddr);
+    pcPic->getCtu( ctuRsAddr )->initCtu( pcPic, ctuRsAddr );
+  }
+
+  UInt sliceSegmentEndCtuTsAddr = 0;
+
+  for( Int substreamIdx = 0; substreamIdx < numSubstreams; substreamIdx++ )
+  {
+    m_pcThreadPool->addJob( [=, &substreamStartCtuTsAddr, &hasSyncState, &sliceSegmentEndCtuTsAddr]( Int threadIdx )
+    {
+      TDecCtuWorker* const pcWorker         = m_apcCtuWorkers[threadIdx];
+      TDecEntropy*   const pcEntropyDecoder = pcWorker->getEntropyDecoder();
+      TDecSbac*      const pcSbacDecoder    = pcWorker->getSbacDecoder();
+      TDecCu*        const pcCuDecoder      = pcWorker->getCuDecoder();
+      const UInt           firstCtuTsAddr   = substreamStartCtuTsAddr[substreamIdx];
+
+      pcEntropyDecoder->setBitstream( ppcSubstreams[substreamIdx] );
+      pcEntropyDecoder->resetEntropy( pcSlice );
+
+      if (depSliceSegmentsEnabled && substreamIdx == 0)
+      {
+        // modify initial contexts with previous slice segment if this is a dependent slice.
+        const UInt startCtuRsAddr = pcPicSym->getCtuTsToRsAddrMap(firstCtuTsAddr);
+        const TComTile *pCurrentTile=pcPicSym->getTComTile(pcPicSym->getTileIdxMap(startCtuRsAddr));
+
+        if( pcSlice->getDependentSliceSegmentFlag() && startCtuRsAddr != pCurrentTile->getFirstCtuRsAddr())
+        {
+          if ( pCurrentTile->getTileWidthInCtus() >= 2 || !wavefrontsEnabled)
+          {
+            pcSbacDecoder->loadContexts(&m_lastSliceSegmentEndContextState);
+          }
+        }
+      }
+
+      Bool isLastCtuOfSliceSegment = false;
+      for( UInt ctuTsAddr = firstCtuTsAddr; !isLastCtuOfSliceSegment && ctuTsAddr < substreamStartCtuTsAddr[substreamIdx+1]; ctuTsAddr++ )
+      {
+        const UInt ctuRsAddr = pcPicSym->getCtuTsToRsAddrMap(ctuTsAddr);
+        const TComTile &currentTile = *(pcPicSym->getTComTile(pcPicSym->getTileIdxMap(ctuRsAddr)));
+        const UInt firstCtuRsAddrOfTile = currentTile.getFirstCtuRsAddr();
+        const UInt tileXPosInCtus = firstCtuRsAddrOfTile % frameWidthInCtus;
+        const UInt tileYPosInCtus = firstCtuRsAddrOfTile / frameWidthInCtus;
+        const UInt ctuXPosInCtus  = ctuRsAddr % frameWidthInCtus;
+        const UInt ctuYPosInCtus  = ctuRsAddr / frameWidthInCtus;
+
+        // wait for the top-right CTU (the previous substream is the row above, unless this row starts the tile)
+        if ( wavefrontsEnabled && substreamIdx > 0 && ctuRsAddr >= firstCtuRsAddrOfTile + frameWidthInCtus )
+        {
+          m_wavefrontSync.waitForProgress( substreamIdx-1, Int(std::min( ctuXPosInCtus+1, tileXPosInCtus+currentTile.getTileWidthInCtus()-1 )) );
+        }
+
+        TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
+
+        // Synchronize cabac probabilities with upper-right CTU if it's available and at the start of a line.
+        if (ctuTsAddr == firstCtuTsAddr && ctuRsAddr != firstCtuRsAddrOfTile && ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled)
+        {
+          TComDataCU *pCtuUp = pCtu->getCtuAbove();
+          if ( pCtuUp && ((ctuRsAddr%frameWidthInCtus+1) < frameWidthInCtus)  )
+          {
+            TComDataCU *pCtuTR = pcPic->getCtu( ctuRsAddr - frameWidthInCtus + 1 );
+            if ( pCtu->CUIsFromSameSliceAndTile(pCtuTR) )
+            {
+              // the top-right CTU was decoded either by the row above, or during a previous slice segment
+              pcSbacDecoder->loadContexts( substreamIdx > 0 && hasSyncState[substreamIdx-1] ? m_apcWavefrontSyncContextStates[substreamIdx-1] : &m_entropyCodingSyncContextState );
+            }
+          }
+        }
+
+        if ( pcSlice->getSPS()->getUseSAO() )
+        {
+          SAOBlkParam& saoblkParam = (pcPicSym->getSAOBlkParam())[ctuRsAddr];
+          Bool bIsSAOSliceEnabled = false;
+          Bool sliceEnabled[MAX_NUM_COMPONENT];
+          for(Int comp=0; comp < MAX_NUM_COMPONENT; comp++)
+          {
+            ComponentID compId=ComponentID(comp);
+            sliceEnabled[compId] = pcSlice->getSaoEnabledFlag(toChannelType(compId)) && (comp < pcPic->getNumberValidComponents());
+            if (sliceEnabled[compId])
+            {
+              bIsSAOSliceEnabled=true;
+            }
+            saoblkParam[compId].modeIdc = SAO_MODE_OFF;
+          }
+          if (bIsSAOSliceEnabled)
+          {
+            const Bool leftMergeAvail  = ctuXPosInCtus > 0 && pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-1);
+            const Bool aboveMergeAvail = ctuYPosInCtus > 0 && pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-frameWidthInCtus);
+
+            pcSbacDecoder->parseSAOBlkParam( saoblkParam, sliceEnabled, leftMergeAvail, aboveMergeAvail, pcSlice->getSPS()->getBitDepths());
+          }
+        }
+
+        pcCuDecoder->decodeCtu     ( pCtu, isLastCtuOfSliceSegment );
+        pcCuDecoder->decompressCtu ( pCtu );
+
+        //Store probabilities of second CTU in line into buffer
+        if ( ctuXPosInCtus == tileXPosInCtus+1 && wavefrontsEnabled)
+        {
+          m_apcWavefrontSyncContextStates[substreamIdx]->loadContexts( pcSbacDecoder );
+          hasSyncState[substreamIdx] = 1;
+        }
+
+        if (isLastCtuOfSliceSegment)
+        {
+          assert( substreamIdx+1 == numSubstreams );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+          pcSbacDecoder->parseRemainingBytes(false);
+#endif
+          sliceSegmentEndCtuTsAddr = ctuTsAddr+1;
+          if( depSliceSegmentsEnabled )
+          {
+            m_lastSliceSegmentEndContextState.loadContexts( pcSbacDecoder );//ctx end of dep.slice
+          }
+        }
+        else if (  ctuXPosInCtus + 1 == tileXPosInCtus + currentTile.getTileWidthInCtus() &&
+                 ( ctuYPosInCtus + 1 == tileYPosInCtus + currentTile.getTileHeightInCtus() || wavefrontsEnabled)
+                )
+        {
+          // The sub-stream should be terminated after this CTU.
+          // (end of tile, end of wavefront-CTU-row)
+          UInt binVal;
+          pcSbacDecoder->parseTerminatingBit( binVal );
+          assert( binVal );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+          pcSbacDecoder->parseRemainingBytes(true);
+#endif
+        }
+
+        m_wavefrontSync.setProgress( substreamIdx, Int(ctuXPosInCtus) );
+      }
+    } );
+  }
+
+  m_pcThreadPool->waitForAll();
+
+  assert( sliceSegmentEndCtuTsAddr != 0 );
+  if(!pcSlice->getDependentSliceSegmentFlag())
+  {
+    pcSlice->setSliceCurEndCtuTsAddr( sliceSegmentEndCtuTsAddr );
+  }
+  pcSlice->setSliceSegmentCurEndCtuTsAddr( sliceSegmentEndCtuTsAddr );
+
+  // hand the context states over to the next slice segment
+  for( Int substreamIdx = numSubstreams-1; substreamIdx >= 0; substreamIdx-- )
+  {
+    if ( hasSyncState[substreamIdx] )
+    {
+      m_entropyCodingSyncContextState.loadContexts( m_apcWavefrontSyncContextStates[substreamIdx] );
+      break;
+    }
+  }
+}
+
+/** Reconstruct the CTUs of a slice segment on a worker thread, in decoding order, as soon as they have been parsed.
+ * Parsing only reads syntax elements and motion data of CTUs that were parsed before, and the reconstruction of a
+ * CTU only reads the samples of CTUs reconstructed before it, so the two can run one behind the other.
+ * The parsing loop stores the index of each parsed CTU in row 0 of m_reconstructionSync, and the last CTU of the slice
+ * segment in row 1 before its index in row 0.
+ * \param pcPic          picture class
+ * \param startCtuTsAddr first CTU of the slice segment
+ */
+Void TDecSlice::xStartPipelinedReconstruction( TComPic* pcPic, const UInt startCtuTsAddr )
+{
+  m_reconstructionSync.create( 2, -1 );
+
+  m_pcThreadPool->addJob( [=]( Int threadIdx )
+  {
+    TDecCu* const pcCuDecoder = m_apcCtuWorkers[threadIdx]->getCuDecoder();
+
+    for( UInt ctuTsAddr = startCtuTsAddr; ; ctuTsAddr++ )
+    {
+      m_reconstructionSync.waitForProgress( 0, Int(ctuTsAddr) );
+      pcCuDecoder->decompressCtu( pcPic->getCtu( pcPic->getPicSym()->getCtuTsToRsAddrMap(ctuTsAddr) ) );
+      if ( m_loopFilterCtuRows )
+      {
+        xFilterCtuRows( pcPic, ctuTsAddr+1 );
+      }
+      if ( m_reconstructionSync.getProgress( 1 ) == Int(ctuTsAddr) )
+      {
+        break;
+      }
+    }
+  } );
+}
+
+/** Deblock, SAO-filter and restore the PCM samples of the CTU rows that can be filtered once the first CTUs of the
+ * picture, in decoding order, have been reconstructed.
+ * A CTU row is deblocked once the row below has been reconstructed, as the intra prediction of the row below reads the
+ * unfiltered samples at its bottom. SAO is applied to a CTU row once the row below has been deblocked, as it reads the
+ * deblocked samples around each CTU. Filtering the rows in order gives the same picture as filtering the whole picture.
+ * \param pcPic                picture class
+ * \param numReconstructedCtus number of CTUs of the picture that have been reconstructed, in decoding order
+ */
+Void TDecSlice::xFilterCtuRows( TComPic* pcPic, const UInt numReconstructedCtus )
+{
+  const UInt numCtuRows = pcPic->getFrameHeightInCtus();
+
+  if ( m_pcLoopFilterPic != pcPic )
+  {
+    const UInt frameWidthInCtus = pcPic->getFrameWidthInCtus();
+    m_pcLoopFilterPic     = pcPic;
+    m_numDeblockedCtuRows = 0;
+    m_numSAOCtuRows       = 0;
+    m_ctuRowEndCtuTsAddr.assign( numCtuRows, 0 );
+    for ( UInt ctuRsAddr = 0; ctuRsAddr < pcPic->getNumberOfCtusInFrame(); ctuRsAddr++ )
+    {
+      UInt& rowEndCtuTsAddr = m_ctuRowEndCtuTsAddr[ctuRsAddr / frameWidthInCtus];
+      rowEndCtuTsAddr = std::max( rowEndCtuTsAddr, pcPic->getPicSym()->getCtuRsToTsAddrMap(ctuRsAddr) + 1 );
+    }
+  }
+
+  const TComSlice* pcSlice = pcPic->getSlice(0);
+
+  while ( m_numDeblockedCtuRows < numCtuRows &&
+          numReconstructedCtus >= m_ctuRowEndCtuTsAddr[std::min( m_numDeblockedCtuRows + 1, numCtuRows - 1 )] )
+  {
+    m_pcLoopFilter->setCfg( pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag() );
+    m_pcLoopFilter->loopFilterCtuRow( pcPic, m_numDeblockedCtuRows );
+    m_numDeblockedCtuRows++;
+  }
+
+  while ( m_numSAOCtuRows + 1 < m_numDeblockedCtuRows || ( m_numSAOCtuRows < numCtuRows && m_numDeblockedCtuRows == numCtuRows ) )
+  {
+    if ( pcSlice->getSPS()->getUseSAO() )
+    {
+      m_pcSAO->reconstructBlkSAOParamsCtuRow( pcPic, pcPic->getPicSym()->getSAOBlkParam(), m_numSAOCtuRows );
+      m_pcSAO->SAOProcessCtuRow( pcPic, m_numSAOCtuRows );
+      m_pcSAO->PCMLFDisableProcessCtuRow( pcPic, m_numSAOCtuRows );
+    }
+    m_numSAOCtuRows++;
+  }
+}
+
+/** Filter the CTU rows of a picture that have not been filtered while its slices were decoded.
+ * \param pcPic picture class
+ */
+Void TDecSlice::finishLoopFilterCtuRows( TComPic* pcPic )
+{
+  xFilterCtuRows( pcPic, pcPic->getNumberOfCtusInFrame() );
+  m_pcLoopFilterPic = NULL;
+}
+
 //! \}
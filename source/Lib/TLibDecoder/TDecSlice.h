@@ -45,10 +45,16 @@
 #include "TLibCommon/CommonDef.h"
 #include "TLibCommon/TComBitStream.h"
 #include "TLibCommon/TComPic.h"
+#include "TLibCommon/TComThreadPool.h"
+#include "TLibCommon/TComLoopFilter.h"
+#include "TLibCommon/TComSampleAdaptiveOffset.h"
 #include "TDecEntropy.h"
 #include "TDecCu.h"
 #include "TDecSbac.h"
 #include "TDecBinCoderCABAC.h"
+#include "TDecCtuWorker.h"
+
+#include <vector>
 
 //! \ingroup TLibDecoder
 //! \{
@@ -70,15 +76,42 @@ private:
 
   TDecSbac        m_lastSliceSegmentEndContextState;    ///< context storage for state at the end of the previous slice-segment (used for dependent slices only).
   TDecSbac        m_entropyCodingSyncContextState;      ///< context storate for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
+
+  TComThreadPool*             m_pcThreadPool;                   ///< worker threads (owned by TDecTop)
+  std::vector<TDecCtuWorker*> m_apcCtuWorkers;                  ///< per-thread CTU processing units (owned by TDecTop)
+  TComWavefrontSync           m_wavefrontSync;                  ///< progress of each substream of the slice segment
+  TComWavefrontSync           m_reconstructionSync;             ///< last parsed CTU of the slice segment, and its last CTU once parsed
+  std::vector<TDecSbac*>      m_apcWavefrontSyncContextStates;  ///< per-substream state of contexts after the second CTU of the tile-row
+
+  TComLoopFilter*             m_pcLoopFilter;
+  TComSampleAdaptiveOffset*   m_pcSAO;
+  Bool                        m_loopFilterCtuRows;              ///< deblock and SAO-filter each CTU row while the picture is decoded
+  TComPic*                    m_pcLoopFilterPic;                ///< picture whose CTU rows are being filtered
+  std::vector<UInt>           m_ctuRowEndCtuTsAddr;             ///< for each CTU row, the CTU following its last CTU in decoding order
+  UInt                        m_numDeblockedCtuRows;
+  UInt                        m_numSAOCtuRows;                  ///< number of CTU rows with SAO and PCM restoration applied
+
+  Bool  xUseWorkerThreads       () const;
+  Bool  xDetermineSubstreamStartCtuTsAddrs( TComPic* pcPic, TComSlice* pcSlice, std::vector<UInt>& substreamStartCtuTsAddr );
+  Void  xDecompressSliceParallel( TComInputBitstream** ppcSubstreams, TComPic* pcPic, const std::vector<UInt>& substreamStartCtuTsAddr );
+  Void  xStartPipelinedReconstruction( TComPic* pcPic, const UInt startCtuTsAddr );
+  Void  xFilterCtuRows          ( TComPic* pcPic, const UInt numReconstructedCtus );
+
 public:
   TDecSlice();
   virtual ~TDecSlice();
 
-  Void  init              ( TDecEntropy* pcEntropyDecoder, TDecCu* pcMbDecoder, TDecConformanceCheck *pDecConformanceCheck );
+  Void  init              ( TDecEntropy* pcEntropyDecoder, TDecCu* pcMbDecoder, TDecConformanceCheck *pDecConformanceCheck,
+                            TComThreadPool* pcThreadPool, const std::vector<TDecCtuWorker*>& apcCtuWorkers,
+                            TComLoopFilter* pcLoopFilter, TComSampleAdaptiveOffset* pcSAO );
   Void  create            ();
   Void  destroy           ();
 
   Void  decompressSlice   ( TComInputBitstream** ppcSubstreams,   TComPic* pcPic, TDecSbac* pcSbacDecoder );
+
+  Void  setLoopFilterCtuRows( Bool enabled ) { m_loopFilterCtuRows = enabled; }
+  Bool  getLoopFilterCtuRows() const         { return m_loopFilterCtuRows; }
+  Void  finishLoopFilterCtuRows( TComPic* pcPic );
 };
 
 //! \}
@@ -63,6 +63,7 @@ TDecTop::TDecTop()
   , m_seiReader()
   , m_cLoopFilter()
   , m_cSAO()
+  , m_numWorkerThreads(0)
   , m_pcPic(NULL)
   , m_prevPOC(MAX_INT)
   , m_prevTid0POC(0)
@@ -114,6 +115,15 @@ Void TDecTop::create()
   m_cGopDecoder.create();
   m_apcSlicePilot = new TComSlice;
   m_uiSliceIdx = 0;
+
+  if ( m_numWorkerThreads > 1 )
+  {
+    m_cThreadPool.create( m_numWorkerThreads );
+    for ( Int workerIdx = 0; workerIdx < m_numWorkerThreads; workerIdx++ )
+    {
+      m_apcCtuWorkers.push_back( new TDecCtuWorker );
+    }
+  }
 }
 
 Void TDecTop::destroy()
@@ -124,6 +134,14 @@ Void TDecTop::destroy()
   m_apcSlicePilot = NULL;
 
   m_cSliceDecoder.destroy();
+
+  // stop the worker threads before their processing units are released
+  m_cThreadPool.destroy();
+  for ( UInt workerIdx = 0; workerIdx < m_apcCtuWorkers.size(); workerIdx++ )
+  {
+    delete m_apcCtuWorkers[workerIdx];
+  }
+  m_apcCtuWorkers.clear();
 }
 
 Void TDecTop::init()
@@ -131,12 +149,16 @@ Void TDecTop::init()
   // initialize ROM
   initROM();
   m_cGopDecoder.init( &m_cEntropyDecoder, &m_cSbacDecoder, &m_cBinCABAC, &m_cCavlcDecoder, &m_cSliceDecoder, &m_cLoopFilter, &m_cSAO);
-  m_cSliceDecoder.init( &m_cEntropyDecoder, &m_cCuDecoder, &m_conformanceCheck );
+  m_cSliceDecoder.init( &m_cEntropyDecoder, &m_cCuDecoder, &m_conformanceCheck, &m_cThreadPool, m_apcCtuWorkers, &m_cLoopFilter, &m_cSAO );
 #if MCTS_ENC_CHECK
   m_cEntropyDecoder.init(&m_cPrediction, &m_conformanceCheck );
 #else
   m_cEntropyDecoder.init(&m_cPrediction);
 #endif
+  for ( UInt workerIdx = 0; workerIdx < m_apcCtuWorkers.size(); workerIdx++ )
+  {
+    m_apcCtuWorkers[workerIdx]->init( &m_conformanceCheck );
+  }
 }
 
 Void TDecTop::deletePicBuffer ( )
@@ -234,6 +256,10 @@ Void TDecTop::executeLoopFilters(Int& poc, TComList<TComPic*>*& rpcListPic)
   poc                 = pcPic->getSlice(m_uiSliceIdx-1)->getPOC();
   rpcListPic          = &m_cListPic;
   m_cCuDecoder.destroy();
+  for ( UInt workerIdx = 0; workerIdx < m_apcCtuWorkers.size(); workerIdx++ )
+  {
+    m_apcCtuWorkers[workerIdx]->destroy();
+  }
   m_bFirstSliceInPicture  = true;
 
   return;
@@ -360,7 +386,7 @@ Void TDecTop::xActivateParameterSets()
 
     // Initialise the various objects for the new set of settings
     m_cSAO.create( sps->getPicWidthInLumaSamples(), sps->getPicHeightInLumaSamples(), sps->getChromaFormatIdc(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), sps->getMaxTotalCUDepth(), pps->getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_LUMA), pps->getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_CHROMA) );
-    m_cLoopFilter.create( sps->getMaxTotalCUDepth() );
+    m_cLoopFilter.create( sps->getMaxTotalCUDepth(), &m_cThreadPool );
     m_cPrediction.initTempBuff(sps->getChromaFormatIdc());
 
 
@@ -397,7 +423,13 @@ Void TDecTop::xActivateParameterSets()
   #else
       m_cCuDecoder.init(&m_cEntropyDecoder, &m_cTrQuant, &m_cPrediction);
   #endif
+      m_cCuDecoder.selectReconstruction( *sps );
       m_cTrQuant.init     ( sps->getMaxTrSize() );
+      for ( UInt workerIdx = 0; workerIdx < m_apcCtuWorkers.size(); workerIdx++ )
+      {
+        m_apcCtuWorkers[workerIdx]->create( sps->getMaxTotalCUDepth(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), sps->getChromaFormatIdc(), sps->getMaxTrSize() );
+        m_apcCtuWorkers[workerIdx]->getCuDecoder()->selectReconstruction( *sps );
+      }
 
       m_cSliceDecoder.create();
     }
@@ -754,6 +786,11 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
     }
     m_cTrQuant.setScalingListDec(scalingList);
     m_cTrQuant.setUseScalingList(true);
+    for ( UInt workerIdx = 0; workerIdx < m_apcCtuWorkers.size(); workerIdx++ )
+    {
+      m_apcCtuWorkers[workerIdx]->getTrQuant()->setScalingListDec(scalingList);
+      m_apcCtuWorkers[workerIdx]->getTrQuant()->setUseScalingList(true);
+    }
   }
   else
   {
@@ -764,6 +801,11 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
     };
     m_cTrQuant.setFlatScalingList(maxLog2TrDynamicRange, pcSlice->getSPS()->getBitDepths());
     m_cTrQuant.setUseScalingList(false);
+    for ( UInt workerIdx = 0; workerIdx < m_apcCtuWorkers.size(); workerIdx++ )
+    {
+      m_apcCtuWorkers[workerIdx]->getTrQuant()->setFlatScalingList(maxLog2TrDynamicRange, pcSlice->getSPS()->getBitDepths());
+      m_apcCtuWorkers[workerIdx]->getTrQuant()->setUseScalingList(false);
+    }
   }
 
   //  Decode a picture
@@ -45,6 +45,7 @@
 #include "TLibCommon/TComTrQuant.h"
 #include "TLibCommon/TComPrediction.h"
 #include "TLibCommon/SEI.h"
+#include "TLibCommon/TComThreadPool.h"
 
 #include "TDecGop.h"
 #include "TDecEntropy.h"
@@ -52,6 +53,7 @@
 #include "TDecCAVLC.h"
 #include "SEIread.h"
 #include "TDecConformance.h"
+#include "TDecCtuWorker.h"
 
 class InputNALUnit;
 
@@ -92,6 +94,9 @@ private:
   TComLoopFilter          m_cLoopFilter;
   TComSampleAdaptiveOffset m_cSAO;
   TDecConformanceCheck    m_conformanceCheck;
+  Int                     m_numWorkerThreads;       ///< number of threads used to decode substreams in parallel (0 or 1: single-threaded)
+  TComThreadPool          m_cThreadPool;            ///< worker threads for parallel substream decoding
+  std::vector<TDecCtuWorker*> m_apcCtuWorkers;      ///< per-thread CTU processing units, indexed by worker thread
 
   Bool isSkipPictureForBLA(Int& iPOCLastDisplay);
   Bool isRandomAccessSkipPicture(Int& iSkipFrame,  Int& iPOCLastDisplay);
@@ -127,6 +132,9 @@ public:
   Void  destroy ();
 
   Void setDecodedPictureHashSEIEnabled(Int enabled) { m_cGopDecoder.setDecodedPictureHashSEIEnabled(enabled); }
+  /// must be called before create()
+  Void setNumWorkerThreads(Int numWorkerThreads) { m_numWorkerThreads = numWorkerThreads; }
+  Void setLoopFilterCtuRows(Bool enabled) { m_cSliceDecoder.setLoopFilterCtuRows(enabled); }
 #if MCTS_ENC_CHECK
   Void setTMctsCheckEnabled(Bool enabled) { m_tmctsCheckEnabled = enabled; }
 
@@ -85,41 +85,43 @@ Void write(ostream& out, OutputNALUnit& nalu)
    *  - 0x00000303
    */
   vector<uint8_t>& rbsp   = nalu.m_Bitstream.getFIFO();
-
-  vector<uint8_t> outputBuffer;
-  outputBuffer.resize(rbsp.size()*2+1); //there can never be enough emulation_prevention_three_bytes to require this much space
-  std::size_t outputAmount = 0;
-  Int         zeroCount    = 0;
-  for (vector<uint8_t>::iterator it = rbsp.begin(); it != rbsp.end(); it++)
+  if (rbsp.empty())
   {
-    const uint8_t v=(*it);
-    if (zeroCount==2 && v<=3)
-    {
-      outputBuffer[outputAmount++]=emulation_prevention_three_byte[0];
-      zeroCount=0;
-    }
+    return;
+  }
 
-    if (v==0)
+  /* an emulation_prevention_three_byte is only needed after two zero bytes,
+   * so the rbsp is written in runs that end at such byte pairs, directly
+   * into out */
+  const uint8_t* const end     = &rbsp[0] + rbsp.size();
+  const uint8_t*       runStart = &rbsp[0];
+  const uint8_t*       it       = runStart;
+  while (end - (it = findZeroBytePair(it, end)) > 2)
+  {
+    const uint8_t* next = it + 2;
+    if (*next <= 3)
     {
-      zeroCount++;
+      out.write(reinterpret_cast<const TChar*>(runStart), next - runStart);
+      out.write(reinterpret_cast<const TChar*>(emulation_prevention_three_byte), 1);
+      runStart = next;
+      it = next;
     }
     else
     {
-      zeroCount=0;
+      it = next + 1;
     }
-    outputBuffer[outputAmount++]=v;
   }
+  out.write(reinterpret_cast<const TChar*>(runStart), end - runStart);
 
   /* 7.4.1.1
    * ... when the last byte of the RBSP data is equal to 0x00 (which can
    * only occur when the RBSP ends in a cabac_zero_word), a final byte equal
    * to 0x03 is appended to the end of the data.
    */
-  if (zeroCount>0)
+  if (end[-1] == 0x00)
   {
-    outputBuffer[outputAmount++]=emulation_prevention_three_byte[0];
+    out.write(reinterpret_cast<const TChar*>(emulation_prevention_three_byte), 1);
   }
-  out.write(reinterpret_cast<const TChar*>(&(*outputBuffer.begin())), outputAmount);
 }
 
 //! \}
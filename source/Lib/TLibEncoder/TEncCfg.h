@@ -234,6 +234,11 @@ protected:
   Bool      m_bFastMEAssumingSmootherMVEnabled;
   Int       m_minSearchWindow;
   Bool      m_bRestrictMESampling;
+  Bool      m_subPelPlaneCache;                 ///< interpolate the sub-sample planes of reference pictures once for the fractional motion search
+  Bool      m_hierarchicalME;                   ///< seed the integer motion search with a search on downscaled pictures
+  Bool      m_lookahead;                        ///< run the lookahead pre-analysis of the source pictures
+  Int       m_lookaheadThreads;                 ///< number of threads of the lookahead pre-analysis
+  Bool      m_lookaheadModeHints;               ///< skip intra modes in inter slices where the pre-analysis finds inter prediction much cheaper
 
   //====== Quality control ========
   Int       m_iMaxDeltaQP;                      //  Max. absolute delta QP (1:default)
@@ -263,6 +268,7 @@ protected:
   Bool      m_useRDOQ;
   Bool      m_useRDOQTS;
   Bool      m_useSelectiveRDOQ;
+  Bool      m_useRDOQFixedPoint;                ///< evaluate the RDOQ costs in fixed-point arithmetic
   UInt      m_rdPenalty;
   FastInterSearchMode m_fastInterSearchMode;
   Bool      m_bUseEarlyCU;
@@ -312,6 +318,8 @@ protected:
   std::vector<Int> m_tileRowHeight;
 
   Bool      m_entropyCodingSyncEnabledFlag;
+  Int       m_numWorkerThreads;                               ///< number of threads used to compress the CTUs of a slice in parallel (0 or 1: single-threaded)
+  Int       m_numParallelPictures;                            ///< number of pictures of a GOP encoded concurrently (0 or 1: one after another)
 
   HashType  m_decodedPictureHashSEIType;
   Bool      m_bufferingPeriodSEIEnabled;
@@ -632,6 +640,11 @@ public:
   Void      setFastMEAssumingSmootherMVEnabled ( Bool b )    { m_bFastMEAssumingSmootherMVEnabled = b; }
   Void      setMinSearchWindow              ( Int   i )      { m_minSearchWindow = i; }
   Void      setRestrictMESampling           ( Bool  b )      { m_bRestrictMESampling = b; }
+  Void      setSubPelPlaneCache             ( Bool  b )      { m_subPelPlaneCache = b; }
+  Void      setHierarchicalME               ( Bool  b )      { m_hierarchicalME = b; }
+  Void      setLookahead                    ( Bool  b )      { m_lookahead = b; }
+  Void      setLookaheadThreads             ( Int   i )      { m_lookaheadThreads = i; }
+  Void      setLookaheadModeHints           ( Bool  b )      { m_lookaheadModeHints = b; }
 
   //====== Quality control ========
   Void      setMaxDeltaQP                   ( Int   i )      { m_iMaxDeltaQP = i; }
@@ -729,6 +742,11 @@ public:
   Bool      getFastMEAssumingSmootherMVEnabled () const { return m_bFastMEAssumingSmootherMVEnabled; }
   Int       getMinSearchWindow                 () const { return m_minSearchWindow; }
   Bool      getRestrictMESampling              () const { return m_bRestrictMESampling; }
+  Bool      getSubPelPlaneCache                () const { return m_subPelPlaneCache; }
+  Bool      getHierarchicalME                  () const { return m_hierarchicalME; }
+  Bool      getLookahead                       () const { return m_lookahead; }
+  Int       getLookaheadThreads                () const { return m_lookaheadThreads; }
+  Bool      getLookaheadModeHints              () const { return m_lookaheadModeHints; }
 
   //==== Quality control ========
   Int       getMaxDeltaQP                   () const { return  m_iMaxDeltaQP; }
@@ -743,6 +761,7 @@ public:
   Void      setUseRDOQ                      ( Bool  b )     { m_useRDOQ    = b; }
   Void      setUseRDOQTS                    ( Bool  b )     { m_useRDOQTS  = b; }
   Void      setUseSelectiveRDOQ             ( Bool b )      { m_useSelectiveRDOQ = b; }
+  Void      setUseRDOQFixedPoint            ( Bool b )      { m_useRDOQFixedPoint = b; }
   Void      setRDpenalty                    ( UInt  u )     { m_rdPenalty  = u; }
   Void      setFastInterSearchMode          ( FastInterSearchMode m ) { m_fastInterSearchMode = m; }
   Void      setUseEarlyCU                   ( Bool  b )     { m_bUseEarlyCU = b; }
@@ -768,6 +787,7 @@ public:
   Bool      getUseRDOQ                      ()      { return m_useRDOQ;    }
   Bool      getUseRDOQTS                    ()      { return m_useRDOQTS;  }
   Bool      getUseSelectiveRDOQ             ()      { return m_useSelectiveRDOQ; }
+  Bool      getUseRDOQFixedPoint            ()      { return m_useRDOQFixedPoint; }
   Int       getRDpenalty                    ()      { return m_rdPenalty;  }
   FastInterSearchMode getFastInterSearchMode() const{ return m_fastInterSearchMode;  }
   Bool      getUseEarlyCU                   ()      { return m_bUseEarlyCU; }
@@ -861,6 +881,10 @@ public:
   Void  xCheckGSParameters();
   Void  setEntropyCodingSyncEnabledFlag(Bool b)                      { m_entropyCodingSyncEnabledFlag = b; }
   Bool  getEntropyCodingSyncEnabledFlag() const                      { return m_entropyCodingSyncEnabledFlag; }
+  Void  setNumWorkerThreads(Int i)                                   { m_numWorkerThreads = i; }
+  Int   getNumWorkerThreads() const                                  { return m_numWorkerThreads; }
+  Void  setNumParallelPictures(Int i)                                { m_numParallelPictures = i; }
+  Int   getNumParallelPictures() const                               { return m_numParallelPictures; }
   Void  setDecodedPictureHashSEIType(HashType m)                     { m_decodedPictureHashSEIType = m; }
   HashType getDecodedPictureHashSEIType() const                      { return m_decodedPictureHashSEIType; }
   Void  setBufferingPeriodSEIEnabled(Bool b)                         { m_bufferingPeriodSEIEnabled = b; }
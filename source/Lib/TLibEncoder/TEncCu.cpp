@@ -205,18 +205,34 @@ Void TEncCu::destroy()
  */
 Void TEncCu::init( TEncTop* pcEncTop )
 {
-  m_pcEncCfg           = pcEncTop;
-  m_pcPredSearch       = pcEncTop->getPredSearch();
-  m_pcTrQuant          = pcEncTop->getTrQuant();
-  m_pcRdCost           = pcEncTop->getRdCost();
+  init( pcEncTop, pcEncTop->getPredSearch(), pcEncTop->getTrQuant(), pcEncTop->getRdCost(), pcEncTop->getEntropyCoder(),
+        pcEncTop->getBinCABAC(), pcEncTop->getRDSbacCoder(), pcEncTop->getRDGoOnSbacCoder(), pcEncTop->getRateCtrl() );
+}
+
+/** Initialise with an explicit set of processing units, e.g. those of a worker thread context.
+ */
+Void TEncCu::init( TEncCfg*      pcEncCfg,
+                   TEncSearch*   pcPredSearch,
+                   TComTrQuant*  pcTrQuant,
+                   TComRdCost*   pcRdCost,
+                   TEncEntropy*  pcEntropyCoder,
+                   TEncBinCABAC* pcBinCABAC,
+                   TEncSbac***   pppcRDSbacCoder,
+                   TEncSbac*     pcRDGoOnSbacCoder,
+                   TEncRateCtrl* pcRateCtrl )
+{
+  m_pcEncCfg           = pcEncCfg;
+  m_pcPredSearch       = pcPredSearch;
+  m_pcTrQuant          = pcTrQuant;
+  m_pcRdCost           = pcRdCost;
 
-  m_pcEntropyCoder     = pcEncTop->getEntropyCoder();
-  m_pcBinCABAC         = pcEncTop->getBinCABAC();
+  m_pcEntropyCoder     = pcEntropyCoder;
+  m_pcBinCABAC         = pcBinCABAC;
 
-  m_pppcRDSbacCoder    = pcEncTop->getRDSbacCoder();
-  m_pcRDGoOnSbacCoder  = pcEncTop->getRDGoOnSbacCoder();
+  m_pppcRDSbacCoder    = pppcRDSbacCoder;
+  m_pcRDGoOnSbacCoder  = pcRDGoOnSbacCoder;
 
-  m_pcRateCtrl         = pcEncTop->getRateCtrl();
+  m_pcRateCtrl         = pcRateCtrl;
   m_lumaQPOffset       = 0;
   initLumaDeltaQpLUT();
 }
@@ -234,6 +250,11 @@ Void TEncCu::compressCtu( TComDataCU* pCtu )
   m_ppcBestCU[0]->initCtu( pCtu->getPic(), pCtu->getCtuRsAddr() );
   m_ppcTempCU[0]->initCtu( pCtu->getPic(), pCtu->getCtuRsAddr() );
 
+  if( m_pcEncCfg->getHierarchicalME() && !pCtu->getSlice()->isIntra() )
+  {
+    m_pcPredSearch->hierarchicalMotionSearch( pCtu );
+  }
+
   // analysis of CU
   DEBUG_STRING_NEW(sDebug)
 
@@ -575,6 +596,19 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
 
     if(!earlyDetectionSkipMode)
     {
+      // the lookahead pre-analysis skips the intra modes of CUs that are predicted much better from the previous picture
+      Bool bLookaheadSkipIntra = false;
+      if ( m_pcEncCfg->getLookaheadModeHints() && rpcBestCU->getSlice()->getSliceType() != I_SLICE )
+      {
+        const TEncPic* pcEPic = dynamic_cast<const TEncPic*>( rpcBestCU->getPic() );
+        if ( pcEPic != NULL && pcEPic->getLookaheadValid() && pcEPic->getLookaheadHasInter() )
+        {
+          Distortion uiIntraCost, uiInterCost;
+          pcEPic->getLookaheadCosts( uiLPelX, uiTPelY, rpcBestCU->getWidth(0), rpcBestCU->getHeight(0), uiIntraCost, uiInterCost );
+          bLookaheadSkipIntra = 4 * uiInterCost < 3 * uiIntraCost;
+        }
+      }
+
       for (Int iQP=iMinQP; iQP<=iMaxQP; iQP++)
       {
         const Bool bIsLosslessMode = isAddLowestQP && (iQP == iMinQP); // If lossless, then iQP is irrelevant for subsequent modules.
@@ -736,7 +770,7 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
         // speedup for inter frames
 #if MCTS_ENC_CHECK
         if ( m_pcEncCfg->getTMCTSSEITileConstraint() || (rpcBestCU->getSlice()->getSliceType() == I_SLICE) ||
-             ((!m_pcEncCfg->getDisableIntraPUsInInterSlices()) && (
+             ((!m_pcEncCfg->getDisableIntraPUsInInterSlices()) && (!bLookaheadSkipIntra) && (
              (rpcBestCU->getCbf(0, COMPONENT_Y) != 0) ||
              ((rpcBestCU->getCbf(0, COMPONENT_Cb) != 0) && (numberValidComponents > COMPONENT_Cb)) ||
              ((rpcBestCU->getCbf(0, COMPONENT_Cr) != 0) && (numberValidComponents > COMPONENT_Cr))  // avoid very complex intra if it is unlikely
@@ -744,7 +778,7 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
         {
 #else
         if((rpcBestCU->getSlice()->getSliceType() == I_SLICE)                                        ||
-            ((!m_pcEncCfg->getDisableIntraPUsInInterSlices()) && (
+            ((!m_pcEncCfg->getDisableIntraPUsInInterSlices()) && (!bLookaheadSkipIntra) && (
               (rpcBestCU->getCbf( 0, COMPONENT_Y  ) != 0)                                            ||
              ((rpcBestCU->getCbf( 0, COMPONENT_Cb ) != 0) && (numberValidComponents > COMPONENT_Cb)) ||
              ((rpcBestCU->getCbf( 0, COMPONENT_Cr ) != 0) && (numberValidComponents > COMPONENT_Cr))  // avoid very complex intra if it is unlikely
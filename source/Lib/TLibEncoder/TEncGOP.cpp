@@ -576,7 +576,7 @@ Void TEncGOP::xCreatePerPictureSEIMessages (Int picInGOP, SEIMessages& seiMessag
   if (picInGOP ==0 && m_pcCfg->getSOPDescriptionSEIEnabled() ) // write SOP description SEI (if enabled) at the beginning of GOP
   {
     SEISOPDescription* sopDescriptionSEI = new SEISOPDescription();
-    m_seiEncoder.initSEISOPDescription(sopDescriptionSEI, slice, picInGOP, m_iLastIDR, m_iGopSize);
+    m_seiEncoder.initSEISOPDescription(sopDescriptionSEI, slice, picInGOP, slice->getLastIDR(), m_iGopSize);
     seiMessages.push_back(sopDescriptionSEI);
   }
 
@@ -1216,6 +1216,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
   {
     effFieldIRAPMap.initialize(isField, m_iGopSize, iPOCLast, iNumPicRcvd, m_iLastIDR, this, m_pcCfg);
   }
+  const Int IRAPGOPid = m_pcCfg->getEfficientFieldIRAPEnabled() ? effFieldIRAPMap.GetIRAPGOPid() : 0;
 
   // reset flag indicating whether pictures have been encoded
   for ( Int iGOPid=0; iGOPid < m_iGopSize; iGOPid++ )
@@ -1223,6 +1224,36 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     m_pcCfg->setEncodedFlag(iGOPid, false);
   }
 
+  // Each picture is set up (slice type, RPS, reference lists, QP) in coding order, then compressed and filtered
+  // (xCompressPicture), and its access unit is written in coding order (xWritePicture). Normally a picture is written
+  // as soon as it has been compressed. With several picture workers, the compression runs on a worker thread once
+  // the pictures of the GOP that it references have been compressed, and the next pictures are set up meanwhile; a
+  // picture is written when its worker is needed for a later picture, or at the end of the GOP.
+  const Bool bParallelPictures = xUseParallelPictures();
+  std::vector<PicEncodingState> picStates( m_iGopSize );
+  std::deque<Int>               picsToWrite;     // GOP entries that have been set up but not written, in coding order
+  std::vector<TEncPicWorker*>   freePicWorkers;
+  if ( bParallelPictures )
+  {
+    m_pictureProgress.create( m_iGopSize, 0 );
+    for ( Int workerIdx = m_pcEncTop->getNumPicWorkers()-1; workerIdx >= 0; workerIdx-- )
+    {
+      freePicWorkers.push_back( m_pcEncTop->getPicWorker( workerIdx ) );
+    }
+  }
+  // write the oldest picture that has been set up, and make its picture worker available again
+  auto writeOldestPicture = [&]()
+  {
+    PicEncodingState& rWriteState = picStates[picsToWrite.front()];
+    picsToWrite.pop_front();
+    xWritePicture( rWriteState, rcListPic, duData, leadingSeiMessages, nestedSeiMessages, duInfoSeiMessages, trailingSeiMessages,
+                   pcBitstreamRedirect, IRAPGOPid, isField, isTff, snr_conversion, outputLogCtrl );
+    if ( rWriteState.pcPicWorker != NULL )
+    {
+      freePicWorkers.push_back( rWriteState.pcPicWorker );
+    }
+  };
+
   for ( Int iGOPid=0; iGOPid < m_iGopSize; iGOPid++ )
   {
     if (m_pcCfg->getEfficientFieldIRAPEnabled())
@@ -1275,17 +1306,56 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     AccessUnit& accessUnit = accessUnitsInGOP.back();
     xGetBuffer( rcListPic, rcListPicYuvRecOut, iNumPicRcvd, iTimeOffset, pcPic, pcPicYuvRecOut, pocCurr, isField );
 
+    PicEncodingState& rPicState = picStates[iGOPid];
+    rPicState.iGOPid         = iGOPid;
+    rPicState.pcPic          = pcPic;
+    rPicState.pcPicYuvRecOut = pcPicYuvRecOut;
+    rPicState.pcAccessUnit   = &accessUnit;
+    rPicState.iBeforeTime    = iBeforeTime;
+    if ( bParallelPictures )
+    {
+      TEncPicWorker* pcPicWorker = freePicWorkers.back();
+      freePicWorkers.pop_back();
+      rPicState.pcPicWorker       = pcPicWorker;
+      rPicState.pcSliceEncoder    = pcPicWorker->getSliceEncoder();
+      rPicState.pcLoopFilter      = pcPicWorker->getLoopFilter();
+      rPicState.pcSAO             = pcPicWorker->getSAO();
+      rPicState.pcRDGoOnSbacCoder = pcPicWorker->getCtuWorker()->getRDGoOnSbacCoder();
+    }
+    else
+    {
+      rPicState.pcSliceEncoder    = m_pcSliceEncoder;
+      rPicState.pcLoopFilter      = m_pcLoopFilter;
+      rPicState.pcSAO             = m_pcSAO;
+      rPicState.pcRDGoOnSbacCoder = m_pcEncTop->getRDGoOnSbacCoder();
+    }
+    TEncSlice* pcSliceEncoder = rPicState.pcSliceEncoder;
+
+    // the reconstruction is about to be overwritten
+    pcPic->invalidateSubPelPlanes();
+
 #if REDUCED_ENCODER_MEMORY
     pcPic->prepareForReconstruction();
 
 #endif
+    if ( bParallelPictures )
+    {
+      // the border is extended when the compression of the picture has finished, not when a later picture of the GOP
+      // sets up its reference picture lists (see TComSlice::setRefPicList)
+      pcPic->getPicYuvRec()->setBorderExtension(true);
+    }
+    if (m_pcCfg->getHierarchicalME())
+    {
+      pcPic->buildLowResPlanes(TComPic::PIC_YUV_ORG);
+    }
+
     //  Slice data initialization
     pcPic->clearSliceBuffer();
     pcPic->allocateNewSlice();
-    m_pcSliceEncoder->setSliceIdx(0);
+    pcSliceEncoder->setSliceIdx(0);
     pcPic->setCurrSliceIdx(0);
 
-    m_pcSliceEncoder->initEncSlice ( pcPic, iPOCLast, pocCurr, iGOPid, pcSlice, isField );
+    pcSliceEncoder->initEncSlice ( pcPic, iPOCLast, pocCurr, iGOPid, pcSlice, isField );
 
     pcSlice->setLastIDR(m_iLastIDR);
     pcSlice->setSliceIdx(0);
@@ -1362,7 +1432,10 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       pcSlice->createExplicitReferencePictureSetFromReference(rcListPic, pcSlice->getRPS(), pcSlice->isIRAP(), m_iLastRecoveryPicPOC, m_pcCfg->getDecodingRefreshType() == 3, m_pcCfg->getEfficientFieldIRAPEnabled());
     }
 
-    pcSlice->applyReferencePictureSet(rcListPic, pcSlice->getRPS());
+    {
+      std::unique_lock<std::mutex> lock( m_referenceMarkingMutex );
+      pcSlice->applyReferencePictureSet(rcListPic, pcSlice->getRPS());
+    }
 
     if(pcSlice->getTLayer() > 0 
       &&  !( pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RADL_N     // Check if not a leading picture
@@ -1448,11 +1521,30 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     if (pcSlice->getPOC() > m_RASPOCforResetEncoder && m_pcCfg->getResetEncoderStateAfterIRAP())
     {
       // need to reset encoder decisions.
-      m_pcSliceEncoder->resetEncoderDecisions();
-
-      if (pcSlice->getSPS()->getUseSAO())
+      if ( bParallelPictures )
       {
-        m_pcSAO->resetEncoderDecisions();
+        // each picture worker keeps its own decisions: reset all of them once the pictures in flight have been written
+        while ( !picsToWrite.empty() )
+        {
+          writeOldestPicture();
+        }
+        for ( Int workerIdx = 0; workerIdx < m_pcEncTop->getNumPicWorkers(); workerIdx++ )
+        {
+          m_pcEncTop->getPicWorker( workerIdx )->getSliceEncoder()->resetEncoderDecisions();
+          if (pcSlice->getSPS()->getUseSAO())
+          {
+            m_pcEncTop->getPicWorker( workerIdx )->getSAO()->resetEncoderDecisions();
+          }
+        }
+      }
+      else
+      {
+        pcSliceEncoder->resetEncoderDecisions();
+
+        if (pcSlice->getSPS()->getUseSAO())
+        {
+          rPicState.pcSAO->resetEncoderDecisions();
+        }
       }
       m_RASPOCforResetEncoder=MAX_INT;
     }
@@ -1462,7 +1554,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     }
 #endif
 
-    pcSlice->setEncCABACTableIdx(m_pcSliceEncoder->getEncCABACTableIdx());
+    pcSlice->setEncCABACTableIdx(pcSliceEncoder->getEncCABACTableIdx());
 #if MCTS_EXTRACTION
     SliceType  encCABACTableIdx = pcSlice->getEncCABACTableIdx();
     Bool encCabacInitFlag = (pcSlice->getSliceType() != encCABACTableIdx && encCABACTableIdx != I_SLICE) ? true : false;
@@ -1536,7 +1628,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     // set adaptive search range for non-intra-slices
     if (m_pcCfg->getUseASR() && pcSlice->getSliceType()!=I_SLICE)
     {
-      m_pcSliceEncoder->setSearchRange(pcSlice);
+      pcSliceEncoder->setSearchRange(pcSlice);
     }
 
     Bool bGPBcheck=false;
@@ -1567,10 +1659,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
 
 
     Double lambda            = 0.0;
-    Int actualHeadBits       = 0;
-    Int actualTotalBits      = 0;
     Int estimatedBits        = 0;
-    Int tmpBitsBeforeWriting = 0;
     if ( m_pcCfg->getUseRateCtrl() ) // TODO: does this work with multiple slices and slice-segments?
     {
       Int frameLevel = m_pcRateCtrl->getRCSeq()->getGOPID2Level( iGOPid );
@@ -1614,7 +1703,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       }
       else if ( frameLevel == 0 )   // intra case, but use the model
       {
-        m_pcSliceEncoder->calCostSliceI(pcPic); // TODO: This only analyses the first slice segment - what about the others?
+        pcSliceEncoder->calCostSliceI(pcPic); // TODO: This only analyses the first slice segment - what about the others?
 
         if ( m_pcCfg->getIntraPeriod() != 1 )   // do not refine allocated bits for all intra case
         {
@@ -1653,6 +1742,23 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       }
       else    // normal case
       {
+        // complexity of the CTUs estimated by the lookahead pre-analysis
+        const TEncPic* pcEPic = dynamic_cast<const TEncPic*>( pcPic );
+        if ( m_pcCfg->getLookahead() && pcEPic != NULL && pcEPic->getLookaheadValid() )
+        {
+          Double totalCost = 0.0;
+          for ( UInt ctuRsAddr = 0; ctuRsAddr < pcPic->getNumberOfCtusInFrame(); ctuRsAddr++ )
+          {
+            const Int ctuPosX = ( ctuRsAddr % pcPic->getFrameWidthInCtus() ) * pcSlice->getSPS()->getMaxCUWidth();
+            const Int ctuPosY = ( ctuRsAddr / pcPic->getFrameWidthInCtus() ) * pcSlice->getSPS()->getMaxCUHeight();
+            Distortion uiIntraCost, uiInterCost;
+            pcEPic->getLookaheadCosts( ctuPosX, ctuPosY, pcSlice->getSPS()->getMaxCUWidth(), pcSlice->getSPS()->getMaxCUHeight(), uiIntraCost, uiInterCost );
+            const Double cost = Double( std::min( uiIntraCost, uiInterCost ) );
+            m_pcRateCtrl->getRCPic()->getLCU( ctuRsAddr ).m_lookaheadCost = cost;
+            totalCost += cost;
+          }
+          m_pcRateCtrl->getRCPic()->setTotalLookaheadCost( totalCost );
+        }
         list<TEncRCPic*> listPreviousPicture = m_pcRateCtrl->getPicList();
         lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture, pcSlice->getSliceType());
         sliceQP = m_pcRateCtrl->getRCPic()->estimatePicQP( lambda, listPreviousPicture );
@@ -1661,375 +1767,507 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       sliceQP = Clip3( -pcSlice->getSPS()->getQpBDOffset(CHANNEL_TYPE_LUMA), MAX_QP, sliceQP );
       m_pcRateCtrl->getRCPic()->setPicEstQP( sliceQP );
 
-      m_pcSliceEncoder->resetQP( pcPic, sliceQP, lambda );
+      pcSliceEncoder->resetQP( pcPic, sliceQP, lambda );
     }
+    rPicState.lambda        = lambda;
+    rPicState.estimatedBits = estimatedBits;
 
-    UInt uiNumSliceSegments = 1;
-
-    // Allocate some coders, now the number of tiles are known.
-    const Int numSubstreamsColumns = (pcSlice->getPPS()->getNumTileColumnsMinus1() + 1);
-    const Int numSubstreamRows     = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag() ? pcPic->getFrameHeightInCtus() : (pcSlice->getPPS()->getNumTileRowsMinus1() + 1);
-    const Int numSubstreams        = numSubstreamRows * numSubstreamsColumns;
-    std::vector<TComOutputBitstream> substreamsOut(numSubstreams);
 
-    // now compress (trial encode) the various slice segments (slices, and dependent slices)
+    if ( bParallelPictures )
     {
-      const UInt numberOfCtusInFrame=pcPic->getPicSym()->getNumberOfCtusInFrame();
-      pcSlice->setSliceCurStartCtuTsAddr( 0 );
-      pcSlice->setSliceSegmentCurStartCtuTsAddr( 0 );
-
-      for(UInt nextCtuTsAddr = 0; nextCtuTsAddr < numberOfCtusInFrame; )
+      // the pictures of this GOP that are referenced have to be compressed before this one
+      for ( Int list = 0; list < NUM_REF_PIC_LIST_01; list++ )
       {
-        m_pcSliceEncoder->precompressSlice( pcPic );
-        m_pcSliceEncoder->compressSlice   ( pcPic, false, false );
-
-        const UInt curSliceSegmentEnd = pcSlice->getSliceSegmentCurEndCtuTsAddr();
-        if (curSliceSegmentEnd < numberOfCtusInFrame)
+        for ( Int refIdx = 0; refIdx < pcSlice->getNumRefIdx( RefPicList( list ) ); refIdx++ )
         {
-          const Bool bNextSegmentIsDependentSlice=curSliceSegmentEnd<pcSlice->getSliceCurEndCtuTsAddr();
-          const UInt sliceBits=pcSlice->getSliceBits();
-          pcPic->allocateNewSlice();
-          // prepare for next slice
-          pcPic->setCurrSliceIdx                    ( uiNumSliceSegments );
-          m_pcSliceEncoder->setSliceIdx             ( uiNumSliceSegments   );
-          pcSlice = pcPic->getSlice                 ( uiNumSliceSegments   );
-          assert(pcSlice->getPPS()!=0);
-          pcSlice->copySliceInfo                    ( pcPic->getSlice(uiNumSliceSegments-1)  );
-          pcSlice->setSliceIdx                      ( uiNumSliceSegments   );
-          if (bNextSegmentIsDependentSlice)
+          const TComPic* pcRefPic = pcSlice->getRefPic( RefPicList( list ), refIdx );
+          for ( Int refGOPid = 0; refGOPid < m_iGopSize; refGOPid++ )
           {
-            pcSlice->setSliceBits(sliceBits);
-          }
-          else
-          {
-            pcSlice->setSliceCurStartCtuTsAddr      ( curSliceSegmentEnd );
-            pcSlice->setSliceBits(0);
+            if ( refGOPid != iGOPid && picStates[refGOPid].pcPic == pcRefPic &&
+                 std::find( rPicState.refGOPids.begin(), rPicState.refGOPids.end(), refGOPid ) == rPicState.refGOPids.end() )
+            {
+              rPicState.refGOPids.push_back( refGOPid );
+            }
           }
-          pcSlice->setDependentSliceSegmentFlag(bNextSegmentIsDependentSlice);
-          pcSlice->setSliceSegmentCurStartCtuTsAddr ( curSliceSegmentEnd );
-          // TODO: optimise cabac_init during compress slice to improve multi-slice operation
-          // pcSlice->setEncCABACTableIdx(m_pcSliceEncoder->getEncCABACTableIdx());
-          uiNumSliceSegments ++;
         }
-        nextCtuTsAddr = curSliceSegmentEnd;
       }
-    }
 
-    duData.clear();
-    pcSlice = pcPic->getSlice(0);
-
-    // SAO parameter estimation using non-deblocked pixels for CTU bottom and right boundary areas
-    if( pcSlice->getSPS()->getUseSAO() && m_pcCfg->getSaoCtuBoundary() )
+      PicEncodingState* pcPicState = &rPicState;
+      m_pcEncTop->getPicThreadPool()->addJob( [this, pcPicState]( Int )
+      {
+        for ( UInt i = 0; i < pcPicState->refGOPids.size(); i++ )
+        {
+          m_pictureProgress.waitForProgress( pcPicState->refGOPids[i], 1 );
+        }
+        xCompressPicture( *pcPicState );
+        pcPicState->pcPic->getPicYuvRec()->extendPicBorder( true );
+        m_pictureProgress.setProgress( pcPicState->iGOPid, 1 );
+      } );
+    }
+    else
     {
-      m_pcSAO->getPreDBFStatistics(pcPic);
+      xCompressPicture( rPicState );
     }
+    picsToWrite.push_back( iGOPid );
 
-    //-- Loop filter
-    Bool bLFCrossTileBoundary = pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag();
-    m_pcLoopFilter->setCfg(bLFCrossTileBoundary);
-    if ( m_pcCfg->getDeblockingFilterMetric() )
+    // write the oldest pictures until a picture worker is free for the next picture
+    while ( !picsToWrite.empty() && ( !bParallelPictures || freePicWorkers.empty() ) )
     {
-      if ( m_pcCfg->getDeblockingFilterMetric()==2 )
-      {
-        applyDeblockingFilterParameterSelection(pcPic, uiNumSliceSegments, iGOPid);
-      }
-      else
-      {
-        applyDeblockingFilterMetric(pcPic, uiNumSliceSegments);
-      }
+      writeOldestPicture();
     }
-    m_pcLoopFilter->loopFilterPic( pcPic );
-
-    /////////////////////////////////////////////////////////////////////////////////////////////////// File writing
-    // Set entropy coder
-    m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder );
 
-    // write various parameter sets
-#if JCTVC_Y0038_PARAMS
-    //bool writePS = m_bSeqFirst || (m_pcCfg->getReWriteParamSetsFlag() && (pcPic->getSlice(0)->getSliceType() == I_SLICE));
-    bool writePS = m_bSeqFirst || (m_pcCfg->getReWriteParamSetsFlag() && (pcSlice->isIRAP()));
-    if (writePS)
+    if (m_pcCfg->getEfficientFieldIRAPEnabled())
     {
-      m_pcEncTop->setParamSetChanged(pcSlice->getSPS()->getSPSId(), pcSlice->getPPS()->getPPSId());
+      iGOPid=effFieldIRAPMap.restoreGOPid(iGOPid);
     }
-    actualTotalBits += xWriteParameterSets(accessUnit, pcSlice, writePS);
+  } // iGOPid-loop
 
-    if (writePS)
-#else
-    actualTotalBits += xWriteParameterSets(accessUnit, pcSlice, m_bSeqFirst);
+  // write the pictures that are still being encoded
+  while ( !picsToWrite.empty() )
+  {
+    writeOldestPicture();
+  }
+  if ( bParallelPictures )
+  {
+    m_pcEncTop->getPicThreadPool()->waitForAll();
+  }
+
+  delete pcBitstreamRedirect;
+
+  assert ( (m_iNumPicCoded == iNumPicRcvd) );
+}
 
-    if ( m_bSeqFirst )
+/** Concurrent picture encoding is used when picture workers have been created, unless an option carries encoder state
+ * from one picture to the next (rate control, deblocking parameter selection, adaptive QP selection), the slice QP is
+ * chosen during compression (DeltaQpRD) while later pictures read it to select their collocated picture, or the
+ * symbols are traced.
+ */
+Bool TEncGOP::xUseParallelPictures() const
+{
+  if ( m_pcEncTop->getNumPicWorkers() < 2 )
+  {
+    return false;
+  }
+  if ( m_pcCfg->getUseRateCtrl() || m_pcCfg->getDeblockingFilterMetric() || m_pcCfg->getDeltaQpRD() > 0 )
+  {
+    return false;
+  }
+#if ADAPTIVE_QP_SELECTION
+  if ( m_pcCfg->getUseAdaptQpSelect() )
+  {
+    return false;
+  }
 #endif
-    {
-      // create prefix SEI messages at the beginning of the sequence
-      assert(leadingSeiMessages.empty());
-#if MCTS_EXTRACTION
-      xCreateIRAPLeadingSEIMessages(leadingSeiMessages, m_pcEncTop->getVPS(),  pcSlice->getSPS(), pcSlice->getPPS());
+#if ENC_DEC_TRACE
+  return false;
 #else
-      xCreateIRAPLeadingSEIMessages(leadingSeiMessages, pcSlice->getSPS(), pcSlice->getPPS());
+  return true;
 #endif
+}
 
-      m_bSeqFirst = false;
-    }
-    if (m_pcCfg->getAccessUnitDelimiter())
+/** Compress, filter and entropy code the slice segments of a picture that has been set up by compressGOP.
+ * The entropy coded substreams are kept in the state until the access unit is written by xWritePicture.
+ */
+Void TEncGOP::xCompressPicture( PicEncodingState& rPicState )
+{
+  TComPic*   pcPic              = rPicState.pcPic;
+  TEncSlice* pcSliceEncoder     = rPicState.pcSliceEncoder;
+  TComSlice* pcSlice            = pcPic->getSlice(0);
+  UInt&      uiNumSliceSegments = rPicState.uiNumSliceSegments;
+
+  // Allocate some coders, now the number of tiles are known.
+  const Int numSubstreamsColumns = (pcSlice->getPPS()->getNumTileColumnsMinus1() + 1);
+  const Int numSubstreamRows     = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag() ? pcPic->getFrameHeightInCtus() : (pcSlice->getPPS()->getNumTileRowsMinus1() + 1);
+  const Int numSubstreams        = numSubstreamRows * numSubstreamsColumns;
+
+  // now compress (trial encode) the various slice segments (slices, and dependent slices)
+  {
+    const UInt numberOfCtusInFrame=pcPic->getPicSym()->getNumberOfCtusInFrame();
+    pcSlice->setSliceCurStartCtuTsAddr( 0 );
+    pcSlice->setSliceSegmentCurStartCtuTsAddr( 0 );
+
+    for(UInt nextCtuTsAddr = 0; nextCtuTsAddr < numberOfCtusInFrame; )
     {
-      xWriteAccessUnitDelimiter(accessUnit, pcSlice);
-    }
+      pcSliceEncoder->precompressSlice( pcPic );
+      pcSliceEncoder->compressSlice   ( pcPic, false, false );
 
-    // reset presence of BP SEI indication
-    m_bufferingPeriodSEIPresentInAU = false;
-    // create prefix SEI associated with a picture
-    xCreatePerPictureSEIMessages(iGOPid, leadingSeiMessages, nestedSeiMessages, pcSlice);
+      const UInt curSliceSegmentEnd = pcSlice->getSliceSegmentCurEndCtuTsAddr();
+      if (curSliceSegmentEnd < numberOfCtusInFrame)
+      {
+        const Bool bNextSegmentIsDependentSlice=curSliceSegmentEnd<pcSlice->getSliceCurEndCtuTsAddr();
+        const UInt sliceBits=pcSlice->getSliceBits();
+        {
+          // a later picture of the GOP may be marking this picture as unused for reference meanwhile
+          std::unique_lock<std::mutex> lock( m_referenceMarkingMutex );
+          pcPic->allocateNewSlice();
+          // prepare for next slice
+          pcPic->setCurrSliceIdx                    ( uiNumSliceSegments );
+          pcSliceEncoder->setSliceIdx               ( uiNumSliceSegments   );
+          pcSlice = pcPic->getSlice                 ( uiNumSliceSegments   );
+          assert(pcSlice->getPPS()!=0);
+          pcSlice->copySliceInfo                    ( pcPic->getSlice(uiNumSliceSegments-1)  );
+        }
+        pcSlice->setSliceIdx                      ( uiNumSliceSegments   );
+        if (bNextSegmentIsDependentSlice)
+        {
+          pcSlice->setSliceBits(sliceBits);
+        }
+        else
+        {
+          pcSlice->setSliceCurStartCtuTsAddr      ( curSliceSegmentEnd );
+          pcSlice->setSliceBits(0);
+        }
+        pcSlice->setDependentSliceSegmentFlag(bNextSegmentIsDependentSlice);
+        pcSlice->setSliceSegmentCurStartCtuTsAddr ( curSliceSegmentEnd );
+        // TODO: optimise cabac_init during compress slice to improve multi-slice operation
+        // pcSlice->setEncCABACTableIdx(pcSliceEncoder->getEncCABACTableIdx());
+        uiNumSliceSegments ++;
+      }
+      nextCtuTsAddr = curSliceSegmentEnd;
+    }
+  }
 
-    /* use the main bitstream buffer for storing the marshalled picture */
-    m_pcEntropyCoder->setBitstream(NULL);
+  pcSlice = pcPic->getSlice(0);
 
-    pcSlice = pcPic->getSlice(0);
+  // SAO parameter estimation using non-deblocked pixels for CTU bottom and right boundary areas
+  if( pcSlice->getSPS()->getUseSAO() && m_pcCfg->getSaoCtuBoundary() )
+  {
+    rPicState.pcSAO->getPreDBFStatistics(pcPic);
+  }
 
-    if (pcSlice->getSPS()->getUseSAO())
+  //-- Loop filter
+  Bool bLFCrossTileBoundary = pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag();
+  rPicState.pcLoopFilter->setCfg(bLFCrossTileBoundary);
+  if ( m_pcCfg->getDeblockingFilterMetric() )
+  {
+    if ( m_pcCfg->getDeblockingFilterMetric()==2 )
     {
-      Bool sliceEnabled[MAX_NUM_COMPONENT];
-      TComBitCounter tempBitCounter;
-      tempBitCounter.resetBits();
-      m_pcEncTop->getRDGoOnSbacCoder()->setBitstream(&tempBitCounter);
-      m_pcSAO->initRDOCabacCoder(m_pcEncTop->getRDGoOnSbacCoder(), pcSlice);
-      m_pcSAO->SAOProcess(pcPic, sliceEnabled, pcPic->getSlice(0)->getLambdas(),
-                          m_pcCfg->getTestSAODisableAtPictureLevel(),
-                          m_pcCfg->getSaoEncodingRate(),
-                          m_pcCfg->getSaoEncodingRateChroma(),
+      applyDeblockingFilterParameterSelection(pcPic, uiNumSliceSegments, rPicState.iGOPid);
+    }
+    else
+    {
+      applyDeblockingFilterMetric(pcPic, uiNumSliceSegments);
+    }
+  }
+  rPicState.pcLoopFilter->loopFilterPic( pcPic );
+
+  if (pcSlice->getSPS()->getUseSAO())
+  {
+    Bool sliceEnabled[MAX_NUM_COMPONENT];
+    TComBitCounter tempBitCounter;
+    tempBitCounter.resetBits();
+    rPicState.pcRDGoOnSbacCoder->setBitstream(&tempBitCounter);
+    rPicState.pcSAO->initRDOCabacCoder(rPicState.pcRDGoOnSbacCoder, pcSlice);
+    rPicState.pcSAO->SAOProcess(pcPic, sliceEnabled, pcPic->getSlice(0)->getLambdas(),
+                                m_pcCfg->getTestSAODisableAtPictureLevel(),
+                                m_pcCfg->getSaoEncodingRate(),
+                                m_pcCfg->getSaoEncodingRateChroma(),
 #if ADD_RESET_ENCODER_DECISIONS_AFTER_IRAP
-                          m_pcCfg->getSaoCtuBoundary());
+                                m_pcCfg->getSaoCtuBoundary());
 #else
-                          m_pcCfg->getSaoCtuBoundary(),
-                          m_pcCfg->getSaoResetEncoderStateAfterIRAP());
+                                m_pcCfg->getSaoCtuBoundary(),
+                                m_pcCfg->getSaoResetEncoderStateAfterIRAP());
 #endif
-      m_pcSAO->PCMLFDisableProcess(pcPic);
-      m_pcEncTop->getRDGoOnSbacCoder()->setBitstream(NULL);
+    rPicState.pcSAO->PCMLFDisableProcess(pcPic);
+    rPicState.pcRDGoOnSbacCoder->setBitstream(NULL);
 
-      //assign SAO slice header
-      for(Int s=0; s< uiNumSliceSegments; s++)
-      {
-        pcPic->getSlice(s)->setSaoEnabledFlag(CHANNEL_TYPE_LUMA, sliceEnabled[COMPONENT_Y]);
-        assert(sliceEnabled[COMPONENT_Cb] == sliceEnabled[COMPONENT_Cr]);
-        pcPic->getSlice(s)->setSaoEnabledFlag(CHANNEL_TYPE_CHROMA, sliceEnabled[COMPONENT_Cb]);
-      }
+    //assign SAO slice header
+    for(Int s=0; s< uiNumSliceSegments; s++)
+    {
+      pcPic->getSlice(s)->setSaoEnabledFlag(CHANNEL_TYPE_LUMA, sliceEnabled[COMPONENT_Y]);
+      assert(sliceEnabled[COMPONENT_Cb] == sliceEnabled[COMPONENT_Cr]);
+      pcPic->getSlice(s)->setSaoEnabledFlag(CHANNEL_TYPE_CHROMA, sliceEnabled[COMPONENT_Cb]);
     }
+  }
 
-    // pcSlice is currently slice 0.
-    std::size_t binCountsInNalUnits   = 0; // For implementation of cabac_zero_word stuffing (section 7.4.3.10)
-    std::size_t numBytesInVclNalUnits = 0; // For implementation of cabac_zero_word stuffing (section 7.4.3.10)
-
-    for( UInt sliceSegmentStartCtuTsAddr = 0, sliceIdxCount=0; sliceSegmentStartCtuTsAddr < pcPic->getPicSym()->getNumberOfCtusInFrame(); sliceIdxCount++, sliceSegmentStartCtuTsAddr=pcSlice->getSliceSegmentCurEndCtuTsAddr() )
+  // entropy code the slice segments
+  rPicState.substreamsOut.resize( uiNumSliceSegments );
+  rPicState.binCountsInNalUnits = 0;
+  for( UInt sliceIdx = 0; sliceIdx < uiNumSliceSegments; sliceIdx++ )
+  {
+    pcSlice = pcPic->getSlice(sliceIdx);
+    if(sliceIdx > 0 && pcSlice->getSliceType()!= I_SLICE)
     {
-      pcSlice = pcPic->getSlice(sliceIdxCount);
-      if(sliceIdxCount > 0 && pcSlice->getSliceType()!= I_SLICE)
-      {
-        pcSlice->checkColRefIdx(sliceIdxCount, pcPic);
-      }
-      pcPic->setCurrSliceIdx(sliceIdxCount);
-      m_pcSliceEncoder->setSliceIdx(sliceIdxCount);
+      pcSlice->checkColRefIdx(sliceIdx, pcPic);
+    }
+    pcPic->setCurrSliceIdx(sliceIdx);
+    pcSliceEncoder->setSliceIdx(sliceIdx);
 
-      pcSlice->setRPS(pcPic->getSlice(0)->getRPS());
-      pcSlice->setRPSidx(pcPic->getSlice(0)->getRPSidx());
+    pcSlice->setEncCABACTableIdx(pcSliceEncoder->getEncCABACTableIdx());
+#if MCTS_EXTRACTION
+    SliceType  encCABACTableIdx = pcSlice->getEncCABACTableIdx();
+    Bool encCabacInitFlag = (pcSlice->getSliceType() != encCABACTableIdx && encCABACTableIdx != I_SLICE) ? true : false;
+    pcSlice->setCabacInitFlag(encCabacInitFlag);
+#endif
+    pcSlice->setFinalized(true);
 
-      for ( UInt ui = 0 ; ui < numSubstreams; ui++ )
-      {
-        substreamsOut[ui].clear();
-      }
+    pcSlice->clearSubstreamSizes(  );
+    rPicState.substreamsOut[sliceIdx].resize(numSubstreams);
+    UInt numBinsCoded = 0;
+    pcSliceEncoder->encodeSlice(pcPic, &(rPicState.substreamsOut[sliceIdx][0]), numBinsCoded);
+    rPicState.binCountsInNalUnits+=numBinsCoded;
+  }
 
-      m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder );
-      m_pcEntropyCoder->resetEntropy      ( pcSlice );
-      /* start slice NALunit */
-      OutputNALUnit nalu( pcSlice->getNalUnitType(), pcSlice->getTLayer() );
-      m_pcEntropyCoder->setBitstream(&nalu.m_Bitstream);
+  pcPic->compressMotion();
+  if (m_pcCfg->getHierarchicalME())
+  {
+    pcPic->buildLowResPlanes(TComPic::PIC_YUV_REC);
+  }
+}
 
-      pcSlice->setNoRaslOutputFlag(false);
-      if (pcSlice->isIRAP())
-      {
-        if (pcSlice->getNalUnitType() >= NAL_UNIT_CODED_SLICE_BLA_W_LP && pcSlice->getNalUnitType() <= NAL_UNIT_CODED_SLICE_IDR_N_LP)
-        {
-          pcSlice->setNoRaslOutputFlag(true);
-        }
-        //the inference for NoOutputPriorPicsFlag
-        // KJS: This cannot happen at the encoder
-        if (!m_bFirst && pcSlice->isIRAP() && pcSlice->getNoRaslOutputFlag())
-        {
-          if (pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_CRA)
-          {
-            pcSlice->setNoOutputPriorPicsFlag(true);
-          }
-        }
-      }
+/** Write the access unit of a picture that has been compressed by xCompressPicture, and update the statistics.
+ * Pictures are written in coding order; when the picture is compressed by a worker thread, wait for it first.
+ */
+Void TEncGOP::xWritePicture( PicEncodingState& rPicState, TComList<TComPic*>& rcListPic, std::deque<DUData>& duData,
+                             SEIMessages& leadingSeiMessages, SEIMessages& nestedSeiMessages, SEIMessages& duInfoSeiMessages, SEIMessages& trailingSeiMessages,
+                             TComOutputBitstream* pcBitstreamRedirect, Int IRAPGOPid, Bool isField, Bool isTff,
+                             const InputColourSpaceConversion snr_conversion, const TEncAnalyze::OutputLogControl &outputLogCtrl )
+{
+  if ( rPicState.pcPicWorker != NULL )
+  {
+    m_pictureProgress.waitForProgress( rPicState.iGOPid, 1 );
+  }
+
+  const Int   iGOPid     = rPicState.iGOPid;
+  TComPic*    pcPic      = rPicState.pcPic;
+  AccessUnit& accessUnit = *rPicState.pcAccessUnit;
+  TComSlice*  pcSlice    = pcPic->getSlice(0);
+  Int actualHeadBits       = 0;
+  Int actualTotalBits      = 0;
+  Int tmpBitsBeforeWriting = 0;
+
+  duData.clear();
+
+  /////////////////////////////////////////////////////////////////////////////////////////////////// File writing
+  // Set entropy coder
+  m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder );
 
-      pcSlice->setEncCABACTableIdx(m_pcSliceEncoder->getEncCABACTableIdx());
+  // write various parameter sets
+#if JCTVC_Y0038_PARAMS
+  //bool writePS = m_bSeqFirst || (m_pcCfg->getReWriteParamSetsFlag() && (pcPic->getSlice(0)->getSliceType() == I_SLICE));
+  bool writePS = m_bSeqFirst || (m_pcCfg->getReWriteParamSetsFlag() && (pcSlice->isIRAP()));
+  if (writePS)
+  {
+    m_pcEncTop->setParamSetChanged(pcSlice->getSPS()->getSPSId(), pcSlice->getPPS()->getPPSId());
+  }
+  actualTotalBits += xWriteParameterSets(accessUnit, pcSlice, writePS);
+
+  if (writePS)
+#else
+  actualTotalBits += xWriteParameterSets(accessUnit, pcSlice, m_bSeqFirst);
+
+  if ( m_bSeqFirst )
+#endif
+  {
+    // create prefix SEI messages at the beginning of the sequence
+    assert(leadingSeiMessages.empty());
 #if MCTS_EXTRACTION
-      encCABACTableIdx = pcSlice->getEncCABACTableIdx();
-      encCabacInitFlag = (pcSlice->getSliceType() != encCABACTableIdx && encCABACTableIdx != I_SLICE) ? true : false;
-      pcSlice->setCabacInitFlag(encCabacInitFlag);
+    xCreateIRAPLeadingSEIMessages(leadingSeiMessages, m_pcEncTop->getVPS(),  pcSlice->getSPS(), pcSlice->getPPS());
+#else
+    xCreateIRAPLeadingSEIMessages(leadingSeiMessages, pcSlice->getSPS(), pcSlice->getPPS());
 #endif
-      tmpBitsBeforeWriting = m_pcEntropyCoder->getNumberOfWrittenBits();
-      m_pcEntropyCoder->encodeSliceHeader(pcSlice);
-      actualHeadBits += ( m_pcEntropyCoder->getNumberOfWrittenBits() - tmpBitsBeforeWriting );
 
-      pcSlice->setFinalized(true);
+    m_bSeqFirst = false;
+  }
+  if (m_pcCfg->getAccessUnitDelimiter())
+  {
+    xWriteAccessUnitDelimiter(accessUnit, pcSlice);
+  }
 
-      pcSlice->clearSubstreamSizes(  );
-      {
-        UInt numBinsCoded = 0;
-        m_pcSliceEncoder->encodeSlice(pcPic, &(substreamsOut[0]), numBinsCoded);
-        binCountsInNalUnits+=numBinsCoded;
-      }
+  // reset presence of BP SEI indication
+  m_bufferingPeriodSEIPresentInAU = false;
+  // create prefix SEI associated with a picture
+  xCreatePerPictureSEIMessages(iGOPid, leadingSeiMessages, nestedSeiMessages, pcSlice);
 
-      {
-        // Construct the final bitstream by concatenating substreams.
-        // The final bitstream is either nalu.m_Bitstream or pcBitstreamRedirect;
-        // Complete the slice header info.
-        m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder );
-        m_pcEntropyCoder->setBitstream(&nalu.m_Bitstream);
-        m_pcEntropyCoder->encodeTilesWPPEntryPoint( pcSlice );
+  /* use the main bitstream buffer for storing the marshalled picture */
+  m_pcEntropyCoder->setBitstream(NULL);
 
-        // Append substreams...
-        TComOutputBitstream *pcOut = pcBitstreamRedirect;
-        const Int numZeroSubstreamsAtStartOfSlice  = pcPic->getSubstreamForCtuAddr(pcSlice->getSliceSegmentCurStartCtuTsAddr(), false, pcSlice);
-        const Int numSubstreamsToCode  = pcSlice->getNumberOfSubstreamSizes()+1;
-        for ( UInt ui = 0 ; ui < numSubstreamsToCode; ui++ )
-        {
-          pcOut->addSubstream(&(substreamsOut[ui+numZeroSubstreamsAtStartOfSlice]));
-        }
-      }
+  pcSlice = pcPic->getSlice(0);
 
-      // If current NALU is the first NALU of slice (containing slice header) and more NALUs exist (due to multiple dependent slices) then buffer it.
-      // If current NALU is the last NALU of slice and a NALU was buffered, then (a) Write current NALU (b) Update an write buffered NALU at approproate location in NALU list.
-      Bool bNALUAlignedWrittenToList    = false; // used to ensure current NALU is not written more than once to the NALU list.
-      xAttachSliceDataToNalUnit(nalu, pcBitstreamRedirect);
-      accessUnit.push_back(new NALUnitEBSP(nalu));
-      actualTotalBits += UInt(accessUnit.back()->m_nalUnitData.str().size()) * 8;
-      numBytesInVclNalUnits += (std::size_t)(accessUnit.back()->m_nalUnitData.str().size());
-      bNALUAlignedWrittenToList = true;
+  // pcSlice is currently slice 0.
+  std::size_t numBytesInVclNalUnits = 0; // For implementation of cabac_zero_word stuffing (section 7.4.3.10)
+
+  for( UInt sliceSegmentStartCtuTsAddr = 0, sliceIdxCount=0; sliceSegmentStartCtuTsAddr < pcPic->getPicSym()->getNumberOfCtusInFrame(); sliceIdxCount++, sliceSegmentStartCtuTsAddr=pcSlice->getSliceSegmentCurEndCtuTsAddr() )
+  {
+    pcSlice = pcPic->getSlice(sliceIdxCount);
+    pcPic->setCurrSliceIdx(sliceIdxCount);
+
+    pcSlice->setRPS(pcPic->getSlice(0)->getRPS());
+    pcSlice->setRPSidx(pcPic->getSlice(0)->getRPSidx());
 
-      if (!bNALUAlignedWrittenToList)
+    std::vector<TComOutputBitstream>& substreamsOut = rPicState.substreamsOut[sliceIdxCount];
+
+    m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder );
+    m_pcEntropyCoder->resetEntropy      ( pcSlice );
+    /* start slice NALunit */
+    OutputNALUnit nalu( pcSlice->getNalUnitType(), pcSlice->getTLayer() );
+    m_pcEntropyCoder->setBitstream(&nalu.m_Bitstream);
+
+    pcSlice->setNoRaslOutputFlag(false);
+    if (pcSlice->isIRAP())
+    {
+      if (pcSlice->getNalUnitType() >= NAL_UNIT_CODED_SLICE_BLA_W_LP && pcSlice->getNalUnitType() <= NAL_UNIT_CODED_SLICE_IDR_N_LP)
       {
-        nalu.m_Bitstream.writeAlignZero();
-        accessUnit.push_back(new NALUnitEBSP(nalu));
+        pcSlice->setNoRaslOutputFlag(true);
       }
-
-      if( ( m_pcCfg->getPictureTimingSEIEnabled() || m_pcCfg->getDecodingUnitInfoSEIEnabled() ) &&
-          ( pcSlice->getSPS()->getVuiParametersPresentFlag() ) &&
-          ( ( pcSlice->getSPS()->getVuiParameters()->getHrdParameters()->getNalHrdParametersPresentFlag() )
-         || ( pcSlice->getSPS()->getVuiParameters()->getHrdParameters()->getVclHrdParametersPresentFlag() ) ) &&
-          ( pcSlice->getSPS()->getVuiParameters()->getHrdParameters()->getSubPicCpbParamsPresentFlag() ) )
+      //the inference for NoOutputPriorPicsFlag
+      // KJS: This cannot happen at the encoder
+      if (!m_bFirst && pcSlice->isIRAP() && pcSlice->getNoRaslOutputFlag())
       {
-          UInt numNalus = 0;
-        UInt numRBSPBytes = 0;
-        for (AccessUnit::const_iterator it = accessUnit.begin(); it != accessUnit.end(); it++)
+        if (pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_CRA)
         {
-          numRBSPBytes += UInt((*it)->m_nalUnitData.str().size());
-          numNalus ++;
+          pcSlice->setNoOutputPriorPicsFlag(true);
         }
-        duData.push_back(DUData());
-        duData.back().accumBitsDU = ( numRBSPBytes << 3 );
-        duData.back().accumNalsDU = numNalus;
       }
-    } // end iteration over slices
-
-    // cabac_zero_words processing
-    cabac_zero_word_padding(pcSlice, pcPic, binCountsInNalUnits, numBytesInVclNalUnits, accessUnit.back()->m_nalUnitData, m_pcCfg->getCabacZeroWordPaddingEnabled());
-
-    pcPic->compressMotion();
+    }
 
-    //-- For time output for each slice
-    Double dEncTime = (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
+    tmpBitsBeforeWriting = m_pcEntropyCoder->getNumberOfWrittenBits();
+    m_pcEntropyCoder->encodeSliceHeader(pcSlice);
+    actualHeadBits += ( m_pcEntropyCoder->getNumberOfWrittenBits() - tmpBitsBeforeWriting );
 
-    std::string digestStr;
-    if (m_pcCfg->getDecodedPictureHashSEIType()!=HASHTYPE_NONE)
     {
-      SEIDecodedPictureHash *decodedPictureHashSei = new SEIDecodedPictureHash();
-      m_seiEncoder.initDecodedPictureHashSEI(decodedPictureHashSei, pcPic, digestStr, pcSlice->getSPS()->getBitDepths());
-      trailingSeiMessages.push_back(decodedPictureHashSei);
-    }
+      // Construct the final bitstream by concatenating substreams.
+      // The final bitstream is either nalu.m_Bitstream or pcBitstreamRedirect;
+      // Complete the slice header info.
+      m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder );
+      m_pcEntropyCoder->setBitstream(&nalu.m_Bitstream);
+      m_pcEntropyCoder->encodeTilesWPPEntryPoint( pcSlice );
 
-    m_pcCfg->setEncodedFlag(iGOPid, true);
+      // Append substreams...
+      TComOutputBitstream *pcOut = pcBitstreamRedirect;
+      const Int numZeroSubstreamsAtStartOfSlice  = pcPic->getSubstreamForCtuAddr(pcSlice->getSliceSegmentCurStartCtuTsAddr(), false, pcSlice);
+      const Int numSubstreamsToCode  = pcSlice->getNumberOfSubstreamSizes()+1;
+      UInt numBytesToCode = pcOut->getByteStreamLength();
+      for ( UInt ui = 0 ; ui < numSubstreamsToCode; ui++ )
+      {
+        numBytesToCode += (substreamsOut[ui+numZeroSubstreamsAtStartOfSlice].getNumberOfWrittenBits() + 7) >> 3;
+      }
+      pcOut->reserve(numBytesToCode);
+      for ( UInt ui = 0 ; ui < numSubstreamsToCode; ui++ )
+      {
+        pcOut->addSubstream(&(substreamsOut[ui+numZeroSubstreamsAtStartOfSlice]));
+      }
+    }
 
-    Double PSNR_Y;
+    // If current NALU is the first NALU of slice (containing slice header) and more NALUs exist (due to multiple dependent slices) then buffer it.
+    // If current NALU is the last NALU of slice and a NALU was buffered, then (a) Write current NALU (b) Update an write buffered NALU at approproate location in NALU list.
+    Bool bNALUAlignedWrittenToList    = false; // used to ensure current NALU is not written more than once to the NALU list.
+    xAttachSliceDataToNalUnit(nalu, pcBitstreamRedirect);
+    accessUnit.push_back(new NALUnitEBSP(nalu));
+    actualTotalBits += UInt(accessUnit.back()->m_nalUnitData.str().size()) * 8;
+    numBytesInVclNalUnits += (std::size_t)(accessUnit.back()->m_nalUnitData.str().size());
+    bNALUAlignedWrittenToList = true;
 
-    xCalculateAddPSNRs( isField, isTff, iGOPid, pcPic, accessUnit, rcListPic, dEncTime, snr_conversion, outputLogCtrl, &PSNR_Y );
-    
-    // Only produce the Green Metadata SEI message with the last picture.
-    if( m_pcCfg->getSEIGreenMetadataInfoSEIEnable() && pcSlice->getPOC() == ( m_pcCfg->getFramesToBeEncoded() - 1 )  )
+    if (!bNALUAlignedWrittenToList)
     {
-      SEIGreenMetadataInfo *seiGreenMetadataInfo = new SEIGreenMetadataInfo;
-      m_seiEncoder.initSEIGreenMetadataInfo(seiGreenMetadataInfo, (UInt)(PSNR_Y * 100 + 0.5));
-      trailingSeiMessages.push_back(seiGreenMetadataInfo);
+      nalu.m_Bitstream.writeAlignZero();
+      accessUnit.push_back(new NALUnitEBSP(nalu));
     }
-    
-    xWriteTrailingSEIMessages(trailingSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS());
-    
-    printHash(m_pcCfg->getDecodedPictureHashSEIType(), digestStr);
 
-    if ( m_pcCfg->getUseRateCtrl() )
+    if( ( m_pcCfg->getPictureTimingSEIEnabled() || m_pcCfg->getDecodingUnitInfoSEIEnabled() ) &&
+        ( pcSlice->getSPS()->getVuiParametersPresentFlag() ) &&
+        ( ( pcSlice->getSPS()->getVuiParameters()->getHrdParameters()->getNalHrdParametersPresentFlag() )
+       || ( pcSlice->getSPS()->getVuiParameters()->getHrdParameters()->getVclHrdParametersPresentFlag() ) ) &&
+        ( pcSlice->getSPS()->getVuiParameters()->getHrdParameters()->getSubPicCpbParamsPresentFlag() ) )
     {
-      Double avgQP     = m_pcRateCtrl->getRCPic()->calAverageQP();
-      Double avgLambda = m_pcRateCtrl->getRCPic()->calAverageLambda();
-      if ( avgLambda < 0.0 )
+        UInt numNalus = 0;
+      UInt numRBSPBytes = 0;
+      for (AccessUnit::const_iterator it = accessUnit.begin(); it != accessUnit.end(); it++)
       {
-        avgLambda = lambda;
+        numRBSPBytes += UInt((*it)->m_nalUnitData.str().size());
+        numNalus ++;
       }
+      duData.push_back(DUData());
+      duData.back().accumBitsDU = ( numRBSPBytes << 3 );
+      duData.back().accumNalsDU = numNalus;
+    }
+  } // end iteration over slices
 
-      m_pcRateCtrl->getRCPic()->updateAfterPicture( actualHeadBits, actualTotalBits, avgQP, avgLambda, pcSlice->getSliceType());
-      m_pcRateCtrl->getRCPic()->addToPictureLsit( m_pcRateCtrl->getPicList() );
+  // cabac_zero_words processing
+  cabac_zero_word_padding(pcSlice, pcPic, rPicState.binCountsInNalUnits, numBytesInVclNalUnits, accessUnit.back()->m_nalUnitData, m_pcCfg->getCabacZeroWordPaddingEnabled());
 
-      m_pcRateCtrl->getRCSeq()->updateAfterPic( actualTotalBits );
-      if ( pcSlice->getSliceType() != I_SLICE )
-      {
-        m_pcRateCtrl->getRCGOP()->updateAfterPicture( actualTotalBits );
-      }
-      else    // for intra picture, the estimated bits are used to update the current status in the GOP
-      {
-        m_pcRateCtrl->getRCGOP()->updateAfterPicture( estimatedBits );
-      }
-      if (m_pcRateCtrl->getCpbSaturationEnabled())
-      {
-        m_pcRateCtrl->updateCpbState(actualTotalBits);
-        printf(" [CPB %6d bits]", m_pcRateCtrl->getCpbState());
-      }
-    }
+  //-- For time output for each slice
+  Double dEncTime = (Double)(clock()-rPicState.iBeforeTime) / CLOCKS_PER_SEC;
 
-    xCreatePictureTimingSEI(m_pcCfg->getEfficientFieldIRAPEnabled()?effFieldIRAPMap.GetIRAPGOPid():0, leadingSeiMessages, nestedSeiMessages, duInfoSeiMessages, pcSlice, isField, duData);
-    if (m_pcCfg->getScalableNestingSEIEnabled())
-    {
-      xCreateScalableNestingSEI (leadingSeiMessages, nestedSeiMessages);
-    }
-    xWriteLeadingSEIMessages(leadingSeiMessages, duInfoSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS(), duData);
-    xWriteDuSEIMessages(duInfoSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS(), duData);
+  std::string digestStr;
+  if (m_pcCfg->getDecodedPictureHashSEIType()!=HASHTYPE_NONE)
+  {
+    SEIDecodedPictureHash *decodedPictureHashSei = new SEIDecodedPictureHash();
+    m_seiEncoder.initDecodedPictureHashSEI(decodedPictureHashSei, pcPic, digestStr, pcSlice->getSPS()->getBitDepths());
+    trailingSeiMessages.push_back(decodedPictureHashSei);
+  }
 
-    pcPic->getPicYuvRec()->copyToPic(pcPicYuvRecOut);
+  m_pcCfg->setEncodedFlag(iGOPid, true);
 
-    pcPic->setReconMark   ( true );
-    m_bFirst = false;
-    m_iNumPicCoded++;
-    m_totalCoded ++;
-    /* logging: insert a newline at end of picture period */
-    printf("\n");
-    fflush(stdout);
+  Double PSNR_Y;
 
-    if (m_pcCfg->getEfficientFieldIRAPEnabled())
+  xCalculateAddPSNRs( isField, isTff, iGOPid, pcPic, accessUnit, rcListPic, dEncTime, snr_conversion, outputLogCtrl, &PSNR_Y );
+  
+  // Only produce the Green Metadata SEI message with the last picture.
+  if( m_pcCfg->getSEIGreenMetadataInfoSEIEnable() && pcSlice->getPOC() == ( m_pcCfg->getFramesToBeEncoded() - 1 )  )
+  {
+    SEIGreenMetadataInfo *seiGreenMetadataInfo = new SEIGreenMetadataInfo;
+    m_seiEncoder.initSEIGreenMetadataInfo(seiGreenMetadataInfo, (UInt)(PSNR_Y * 100 + 0.5));
+    trailingSeiMessages.push_back(seiGreenMetadataInfo);
+  }
+  
+  xWriteTrailingSEIMessages(trailingSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS());
+  
+  printHash(m_pcCfg->getDecodedPictureHashSEIType(), digestStr);
+
+  if ( m_pcCfg->getUseRateCtrl() )
+  {
+    Double avgQP     = m_pcRateCtrl->getRCPic()->calAverageQP();
+    Double avgLambda = m_pcRateCtrl->getRCPic()->calAverageLambda();
+    if ( avgLambda < 0.0 )
     {
-      iGOPid=effFieldIRAPMap.restoreGOPid(iGOPid);
+      avgLambda = rPicState.lambda;
     }
-#if REDUCED_ENCODER_MEMORY
 
-    pcPic->releaseReconstructionIntermediateData();
-    if (!isField) // don't release the source data for field-coding because the fields are dealt with in pairs. // TODO: release source data for interlace simulations.
+    m_pcRateCtrl->getRCPic()->updateAfterPicture( actualHeadBits, actualTotalBits, avgQP, avgLambda, pcSlice->getSliceType());
+    m_pcRateCtrl->getRCPic()->addToPictureLsit( m_pcRateCtrl->getPicList() );
+
+    m_pcRateCtrl->getRCSeq()->updateAfterPic( actualTotalBits );
+    if ( pcSlice->getSliceType() != I_SLICE )
     {
-      pcPic->releaseEncoderSourceImageData();
+      m_pcRateCtrl->getRCGOP()->updateAfterPicture( actualTotalBits );
     }
+    else    // for intra picture, the estimated bits are used to update the current status in the GOP
+    {
+      m_pcRateCtrl->getRCGOP()->updateAfterPicture( rPicState.estimatedBits );
+    }
+    if (m_pcRateCtrl->getCpbSaturationEnabled())
+    {
+      m_pcRateCtrl->updateCpbState(actualTotalBits);
+      printf(" [CPB %6d bits]", m_pcRateCtrl->getCpbState());
+    }
+  }
 
-#endif
-  } // iGOPid-loop
+  xCreatePictureTimingSEI(IRAPGOPid, leadingSeiMessages, nestedSeiMessages, duInfoSeiMessages, pcSlice, isField, duData);
+  if (m_pcCfg->getScalableNestingSEIEnabled())
+  {
+    xCreateScalableNestingSEI (leadingSeiMessages, nestedSeiMessages);
+  }
+  xWriteLeadingSEIMessages(leadingSeiMessages, duInfoSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS(), duData);
+  xWriteDuSEIMessages(duInfoSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS(), duData);
 
-  delete pcBitstreamRedirect;
+  pcPic->getPicYuvRec()->copyToPic(rPicState.pcPicYuvRecOut);
 
-  assert ( (m_iNumPicCoded == iNumPicRcvd) );
+  pcPic->setReconMark   ( true );
+  m_bFirst = false;
+  m_iNumPicCoded++;
+  m_totalCoded ++;
+  /* logging: insert a newline at end of picture period */
+  printf("\n");
+  fflush(stdout);
+#if REDUCED_ENCODER_MEMORY
+
+  pcPic->releaseReconstructionIntermediateData();
+  if (!isField) // don't release the source data for field-coding because the fields are dealt with in pairs. // TODO: release source data for interlace simulations.
+  {
+    pcPic->releaseEncoderSourceImageData();
+  }
+#endif
 }
 
 Void TEncGOP::printOutSummary(UInt uiNumAllPicCoded, Bool isField, const TEncAnalyze::OutputLogControl &outputLogCtrl, const BitDepths &bitDepths)
@@ -2154,7 +2392,6 @@ Void TEncGOP::xGetBuffer( TComList<TComPic*>&      rcListPic,
   while (iterPic != rcListPic.end())
   {
     rpcPic = *(iterPic);
-    rpcPic->setCurrSliceIdx(0);
     if (rpcPic->getPOC() == pocCurr)
     {
       break;
@@ -3066,6 +3303,7 @@ Void TEncGOP::xAttachSliceDataToNalUnit (OutputNALUnit& rNalu, TComOutputBitstre
   // Perform bitstream concatenation
   if (codedSliceData->getNumberOfWrittenBits() > 0)
   {
+    rNalu.m_Bitstream.reserve(rNalu.m_Bitstream.getByteStreamLength() + ((codedSliceData->getNumberOfWrittenBits() + 7) >> 3));
     rNalu.m_Bitstream.addSubstream(codedSliceData);
   }
 
@@ -39,13 +39,16 @@
 #define __TENCGOP__
 
 #include <list>
+#include <mutex>
 
 #include <stdlib.h>
+#include <time.h>
 
 #include "TLibCommon/TComList.h"
 #include "TLibCommon/TComPic.h"
 #include "TLibCommon/TComBitCounter.h"
 #include "TLibCommon/TComLoopFilter.h"
+#include "TLibCommon/TComThreadPool.h"
 #include "TLibCommon/AccessUnit.h"
 #include "TEncSampleAdaptiveOffset.h"
 #include "TEncSlice.h"
@@ -66,6 +69,7 @@
 //! \{
 
 class TEncTop;
+class TEncPicWorker;
 
 // ====================================================================================================================
 // Class definition
@@ -84,6 +88,44 @@ class TEncGOP
     Int accumNalsDU;
   };
 
+  /// a picture of the GOP between its set-up and the writing of its access unit
+  class PicEncodingState
+  {
+  public:
+    PicEncodingState()
+    :iGOPid(0)
+    ,pcPic(NULL)
+    ,pcPicYuvRecOut(NULL)
+    ,pcAccessUnit(NULL)
+    ,iBeforeTime(0)
+    ,uiNumSliceSegments(1)
+    ,lambda(0.0)
+    ,estimatedBits(0)
+    ,binCountsInNalUnits(0)
+    ,pcSliceEncoder(NULL)
+    ,pcLoopFilter(NULL)
+    ,pcSAO(NULL)
+    ,pcRDGoOnSbacCoder(NULL)
+    ,pcPicWorker(NULL) {};
+
+    Int                       iGOPid;
+    TComPic*                  pcPic;
+    TComPicYuv*               pcPicYuvRecOut;
+    AccessUnit*               pcAccessUnit;
+    clock_t                   iBeforeTime;
+    UInt                      uiNumSliceSegments;
+    Double                    lambda;                 ///< rate control picture lambda
+    Int                       estimatedBits;          ///< rate control target bits
+    std::vector< std::vector<TComOutputBitstream> > substreamsOut; ///< entropy coded substreams, per slice segment
+    std::size_t               binCountsInNalUnits;    ///< for cabac_zero_word stuffing (section 7.4.3.10)
+    std::vector<Int>          refGOPids;              ///< pictures of the GOP that the picture references
+    TEncSlice*                pcSliceEncoder;
+    TComLoopFilter*           pcLoopFilter;
+    TEncSampleAdaptiveOffset* pcSAO;
+    TEncSbac*                 pcRDGoOnSbacCoder;
+    TEncPicWorker*            pcPicWorker;            ///< NULL when the processing units of TEncTop are used
+  };
+
 private:
 
   TEncAnalyze             m_gcAnalyzeAll;
@@ -148,6 +190,8 @@ private:
   SEIEncoder              m_seiEncoder;
   TComPicYuv*             m_pcDeblockingTempPicYuv;
   Int                     m_DBParam[MAX_ENCODER_DEBLOCKING_QUALITY_LAYERS][4];   //[layer_id][0: available; 1: bDBDisabled; 2: Beta Offset Div2; 3: Tc Offset Div2;]
+  TComWavefrontSync       m_pictureProgress;              ///< per GOP entry: 1 once the picture has been compressed and filtered
+  std::mutex              m_referenceMarkingMutex;        ///< held while the reference marking is applied, and while a picture being compressed copies its first slice
 
 public:
   TEncGOP();
@@ -193,6 +237,13 @@ protected:
   Void  xInitGOP          ( Int iPOCLast, Int iNumPicRcvd, Bool isField );
   Void  xGetBuffer        ( TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut, Int iNumPicRcvd, Int iTimeOffset, TComPic*& rpcPic, TComPicYuv*& rpcPicYuvRecOut, Int pocCurr, Bool isField );
 
+  Bool  xUseParallelPictures () const;
+  Void  xCompressPicture  ( PicEncodingState& rPicState );
+  Void  xWritePicture     ( PicEncodingState& rPicState, TComList<TComPic*>& rcListPic, std::deque<DUData>& duData,
+                            SEIMessages& leadingSeiMessages, SEIMessages& nestedSeiMessages, SEIMessages& duInfoSeiMessages, SEIMessages& trailingSeiMessages,
+                            TComOutputBitstream* pcBitstreamRedirect, Int IRAPGOPid, Bool isField, Bool isTff,
+                            const InputColourSpaceConversion snr_conversion, const TEncAnalyze::OutputLogControl &outputLogCtrl );
+
   Void  xCalculateAddPSNRs         ( const Bool isField, const Bool isFieldTopFieldFirst, const Int iGOPid, TComPic* pcPic, const AccessUnit&accessUnit, TComList<TComPic*> &rcListPic, Double dEncTime, const InputColourSpaceConversion snr_conversion, const TEncAnalyze::OutputLogControl &outputLogCtrl, Double* PSNR_Y );
   Void  xCalculateAddPSNR          ( TComPic* pcPic, TComPicYuv* pcPicD, const AccessUnit&, Double dEncTime, const InputColourSpaceConversion snr_conversion, const TEncAnalyze::OutputLogControl &outputLogCtrl, Double* PSNR_Y );
   Void  xCalculateInterlacedAddPSNR( TComPic* pcPicOrgFirstField, TComPic* pcPicOrgSecondField,
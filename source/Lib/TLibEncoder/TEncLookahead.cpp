@@ -0,0 +1,406 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncLookahead.cpp
+    \brief    lookahead pre-analysis of the source pictures
+*/
+
+#include "TEncLookahead.h"
+
+#include <limits>
+
+//! \ingroup TLibEncoder
+//! \{
+
+/// range in half-resolution samples of the motion search around the best candidate vector
+static const Int LOOKAHEAD_SEARCH_RANGE = 8;
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TEncLookahead::TEncLookahead()
+: m_pcReference    (NULL)
+, m_iNumAttached   (0)
+, m_iSourceWidth   (0)
+, m_iSourceHeight  (0)
+, m_iMaxCUWidth    (0)
+, m_iMaxCUHeight   (0)
+, m_iBitDepth      (8)
+, m_iWidthInBlocks (0)
+, m_iHeightInBlocks(0)
+{
+}
+
+TEncLookahead::~TEncLookahead()
+{
+  destroy();
+}
+
+/** Start the analysis threads
+ * \param iNumThreads   number of analysis threads
+ * \param iSourceWidth  picture width in luma samples
+ * \param iSourceHeight picture height in luma samples
+ * \param iMaxCUWidth   CTU width, used for the margins of the half-resolution pictures
+ * \param iMaxCUHeight  CTU height, used for the margins of the half-resolution pictures
+ * \param iBitDepth     internal luma bit depth
+ */
+Void TEncLookahead::create( Int iNumThreads, Int iSourceWidth, Int iSourceHeight, Int iMaxCUWidth, Int iMaxCUHeight, Int iBitDepth )
+{
+  m_iSourceWidth    = iSourceWidth;
+  m_iSourceHeight   = iSourceHeight;
+  m_iMaxCUWidth     = iMaxCUWidth;
+  m_iMaxCUHeight    = iMaxCUHeight;
+  m_iBitDepth       = iBitDepth;
+  m_iWidthInBlocks  = (iSourceWidth  + LOOKAHEAD_BLOCK_SIZE - 1) / LOOKAHEAD_BLOCK_SIZE;
+  m_iHeightInBlocks = (iSourceHeight + LOOKAHEAD_BLOCK_SIZE - 1) / LOOKAHEAD_BLOCK_SIZE;
+  m_cThreadPool.create( std::max(iNumThreads, 1) );
+}
+
+Void TEncLookahead::destroy()
+{
+  m_cThreadPool.destroy();
+
+  for (UInt i = 0; i < m_apcPictures.size(); i++)
+  {
+    m_apcFreePictures.push_back( m_apcPictures[i] );
+  }
+  m_apcPictures.clear();
+  m_iNumAttached = 0;
+  if (m_pcReference != NULL)
+  {
+    m_apcFreePictures.push_back( m_pcReference );
+    m_pcReference = NULL;
+  }
+  for (UInt i = 0; i < m_apcFreePictures.size(); i++)
+  {
+    m_apcFreePictures[i]->pcLowRes->destroy();
+    delete m_apcFreePictures[i]->pcLowRes;
+    delete m_apcFreePictures[i];
+  }
+  m_apcFreePictures.clear();
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** Downscale the original of the next source picture in input order and queue its analysis against the previous
+ * source picture. The application may add the pictures ahead of passing them to the encoder, in which case their
+ * analysis runs while the preceding GOPs are compressed.
+ * \param pcPicYuvOrg original picture, which is no longer accessed when the function returns
+ */
+Void TEncLookahead::addPicture( const TComPicYuv* pcPicYuvOrg )
+{
+  Picture *pcCur;
+  if (m_apcFreePictures.empty())
+  {
+    pcCur           = new Picture;
+    pcCur->pcLowRes = new TComPicYuv;
+    pcCur->pcLowRes->createWithoutCUInfo( (m_iSourceWidth + 1) >> 1, (m_iSourceHeight + 1) >> 1, CHROMA_400, true, m_iMaxCUWidth >> 1, m_iMaxCUHeight >> 1 );
+    pcCur->blocks.resize( m_iWidthInBlocks * m_iHeightInBlocks );
+  }
+  else
+  {
+    pcCur = m_apcFreePictures.back();
+    m_apcFreePictures.pop_back();
+  }
+  pcPicYuvOrg->downscaleLumaTo( pcCur->pcLowRes );
+  pcCur->bHasInter = false;
+  pcCur->bDone     = false;
+  pcCur->pcPic     = NULL;
+
+  const Picture *pcPrev = m_apcPictures.empty() ? m_pcReference : m_apcPictures.back();
+  const TComPicYuv *pcPrevLowRes = (pcPrev == NULL) ? NULL : pcPrev->pcLowRes;
+  m_apcPictures.push_back( pcCur );
+
+  m_cThreadPool.addJob( [=]( Int threadIdx )
+  {
+    xAnalysePicture( pcCur, pcPrevLowRes );
+  } );
+}
+
+/** Associate a picture received by the encoder with the analysis of its original. The results are valid in the
+ * picture once waitForAnalysis() has returned.
+ * \param pcPic received picture, whose original has been set
+ */
+Void TEncLookahead::attachPicture( TEncPic* pcPic )
+{
+  if (m_iNumAttached == Int(m_apcPictures.size()))
+  {
+    addPicture( pcPic->getPicYuvOrg() );
+  }
+  assert( pcPic->getLookaheadWidthInBlocks() == m_iWidthInBlocks && pcPic->getLookaheadHeightInBlocks() == m_iHeightInBlocks );
+
+  m_apcPictures[m_iNumAttached++]->pcPic = pcPic;
+  pcPic->setLookaheadState( false, false );
+}
+
+/** Wait for the analyses of the received pictures and copy their results. The pictures added ahead of the encoder
+ * are not waited for. Only the half-resolution picture of the last received picture is kept, as the reference of
+ * the next one.
+ */
+Void TEncLookahead::waitForAnalysis()
+{
+  if (m_iNumAttached == 0)
+  {
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    for (Int i = 0; i < m_iNumAttached; i++)
+    {
+      const Picture *pcPicture = m_apcPictures[i];
+      m_analysisDone.wait( lock, [pcPicture]() { return pcPicture->bDone; } );
+    }
+  }
+
+  for (Int i = 0; i < m_iNumAttached; i++)
+  {
+    Picture *pcPicture = m_apcPictures[i];
+    TEncPic *pcPic     = pcPicture->pcPic;
+    for (Int iBlkY = 0; iBlkY < m_iHeightInBlocks; iBlkY++)
+    {
+      for (Int iBlkX = 0; iBlkX < m_iWidthInBlocks; iBlkX++)
+      {
+        pcPic->getLookaheadBlock( iBlkX, iBlkY ) = pcPicture->blocks[iBlkY * m_iWidthInBlocks + iBlkX];
+      }
+    }
+    pcPic->setLookaheadState( true, pcPicture->bHasInter );
+    pcPicture->pcPic = NULL;
+  }
+
+  // the previous reference is no longer needed, as the analysis of the picture following it has finished
+  if (m_pcReference != NULL)
+  {
+    m_apcFreePictures.push_back( m_pcReference );
+  }
+  for (Int i = 0; i < m_iNumAttached - 1; i++)
+  {
+    m_apcFreePictures.push_back( m_apcPictures.front() );
+    m_apcPictures.pop_front();
+  }
+  m_pcReference = m_apcPictures.front();
+  m_apcPictures.pop_front();
+  m_iNumAttached = 0;
+}
+
+// ====================================================================================================================
+// Protected member functions
+// ====================================================================================================================
+
+/** Estimate the costs and motion of all blocks of a picture.
+ * \param pcCur  picture receiving the results, holding its half-resolution original
+ * \param pcPrev half-resolution original of the previous picture in input order, or NULL
+ */
+Void TEncLookahead::xAnalysePicture( Picture* pcCur, const TComPicYuv* pcPrev )
+{
+  const Int iBlkSize = LOOKAHEAD_BLOCK_SIZE >> 1;
+
+  for (Int iBlkY = 0; iBlkY < m_iHeightInBlocks; iBlkY++)
+  {
+    for (Int iBlkX = 0; iBlkX < m_iWidthInBlocks; iBlkX++)
+    {
+      TEncLookaheadBlock &rcBlock = pcCur->blocks[iBlkY * m_iWidthInBlocks + iBlkX];
+      rcBlock.m_intraCost = xEstimateIntraCost( pcCur->pcLowRes, iBlkX * iBlkSize, iBlkY * iBlkSize );
+
+      if (pcPrev == NULL)
+      {
+        rcBlock.m_interCost = rcBlock.m_intraCost;
+        rcBlock.m_mv.setZero();
+        continue;
+      }
+
+      // the vectors of the left, above and above-right blocks are the start candidates besides the zero vector
+      TComMv acCandidates[4];
+      Int    iNumCandidates = 0;
+      acCandidates[iNumCandidates++].setZero();
+      if (iBlkX > 0)
+      {
+        acCandidates[iNumCandidates++] = pcCur->blocks[iBlkY * m_iWidthInBlocks + iBlkX - 1].m_mv;
+      }
+      if (iBlkY > 0)
+      {
+        acCandidates[iNumCandidates++] = pcCur->blocks[(iBlkY - 1) * m_iWidthInBlocks + iBlkX].m_mv;
+        if (iBlkX + 1 < m_iWidthInBlocks)
+        {
+          acCandidates[iNumCandidates++] = pcCur->blocks[(iBlkY - 1) * m_iWidthInBlocks + iBlkX + 1].m_mv;
+        }
+      }
+      // the stored vectors are in full-resolution units and therefore even
+      for (Int i = 1; i < iNumCandidates; i++)
+      {
+        acCandidates[i].set( acCandidates[i].getHor() / 2, acCandidates[i].getVer() / 2 );
+      }
+
+      TComMv cMv;
+      rcBlock.m_interCost = xEstimateInterCost( pcCur->pcLowRes, pcPrev, iBlkX * iBlkSize, iBlkY * iBlkSize, acCandidates, iNumCandidates, cMv );
+      rcBlock.m_mv        = cMv <<= 1;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    pcCur->bHasInter = pcPrev != NULL;
+    pcCur->bDone     = true;
+  }
+  m_analysisDone.notify_all();
+}
+
+/** Estimate the intra cost of a half-resolution block as the lowest SATD of the DC, planar, horizontal and vertical
+ * predictions from the neighbouring original samples.
+ */
+Distortion TEncLookahead::xEstimateIntraCost( const TComPicYuv* pcCur, Int iPosX, Int iPosY )
+{
+  const Int  iBlkSize  = LOOKAHEAD_BLOCK_SIZE >> 1;
+  const Int  iLog2Size = g_aucConvertToBit[iBlkSize] + 2;
+  const Int  iStride   = pcCur->getStride(COMPONENT_Y);
+  const Pel *piOrg     = pcCur->getAddr(COMPONENT_Y) + iPosY * iStride + iPosX;
+  const Pel  iMidValue = Pel(1 << (m_iBitDepth - 1));
+
+  // the samples up to the above-right and below-left corners are used, those outside the picture are read from the extended border
+  Pel aiAbove[iBlkSize + 1];
+  Pel aiLeft [iBlkSize + 1];
+  for (Int i = 0; i <= iBlkSize; i++)
+  {
+    aiAbove[i] = (iPosY > 0) ? piOrg[i - iStride]      : iMidValue;
+    aiLeft [i] = (iPosX > 0) ? piOrg[i * iStride - 1]  : iMidValue;
+  }
+
+  Int iDCSum = iBlkSize;
+  for (Int i = 0; i < iBlkSize; i++)
+  {
+    iDCSum += aiAbove[i] + aiLeft[i];
+  }
+  const Pel iDCValue = Pel(iDCSum >> (iLog2Size + 1));
+
+  Pel aiPred[4][iBlkSize * iBlkSize];
+  for (Int y = 0; y < iBlkSize; y++)
+  {
+    for (Int x = 0; x < iBlkSize; x++)
+    {
+      aiPred[0][y * iBlkSize + x] = iDCValue;
+      aiPred[1][y * iBlkSize + x] = Pel(((iBlkSize - 1 - x) * aiLeft[y] + (x + 1) * aiAbove[iBlkSize] +
+                                         (iBlkSize - 1 - y) * aiAbove[x] + (y + 1) * aiLeft[iBlkSize] + iBlkSize) >> (iLog2Size + 1));
+      aiPred[2][y * iBlkSize + x] = aiLeft[y];
+      aiPred[3][y * iBlkSize + x] = aiAbove[x];
+    }
+  }
+
+  Distortion uiBestCost = std::numeric_limits<Distortion>::max();
+  for (Int iMode = 0; iMode < 4; iMode++)
+  {
+    DistParam cDistParam;
+    m_cRdCost.setDistParam( cDistParam, m_iBitDepth, piOrg, iStride, aiPred[iMode], iBlkSize, iBlkSize, iBlkSize, true );
+    uiBestCost = std::min( uiBestCost, cDistParam.DistFunc( &cDistParam ) );
+  }
+  return uiBestCost;
+}
+
+/** Estimate the inter cost of a half-resolution block. The best of the candidate vectors by SAD is refined by an
+ * exhaustive SAD search, and the SATD at the resulting vector is returned.
+ * \param pcCur          half-resolution original of the picture
+ * \param pcPrev         half-resolution original of the previous picture
+ * \param iPosX          horizontal position of the block
+ * \param iPosY          vertical position of the block
+ * \param pcCandidates   candidate vectors in half-resolution samples, the first one is tested first
+ * \param iNumCandidates number of candidate vectors
+ * \param rcMv           returns the vector in half-resolution samples
+ */
+Distortion TEncLookahead::xEstimateInterCost( const TComPicYuv* pcCur, const TComPicYuv* pcPrev, Int iPosX, Int iPosY,
+                                              const TComMv* pcCandidates, Int iNumCandidates, TComMv& rcMv )
+{
+  const Int  iBlkSize     = LOOKAHEAD_BLOCK_SIZE >> 1;
+  const Int  iOrgStride   = pcCur->getStride(COMPONENT_Y);
+  const Pel *piOrg        = pcCur->getAddr(COMPONENT_Y) + iPosY * iOrgStride + iPosX;
+  const Int  iRefStride   = pcPrev->getStride(COMPONENT_Y);
+  const Pel *piRef        = pcPrev->getAddr(COMPONENT_Y) + iPosY * iRefStride + iPosX;
+  const Int  iLimitLeft   = -pcPrev->getMarginX(COMPONENT_Y) - iPosX;
+  const Int  iLimitRight  = pcPrev->getWidth(COMPONENT_Y)  + pcPrev->getMarginX(COMPONENT_Y) - iBlkSize - iPosX;
+  const Int  iLimitTop    = -pcPrev->getMarginY(COMPONENT_Y) - iPosY;
+  const Int  iLimitBottom = pcPrev->getHeight(COMPONENT_Y) + pcPrev->getMarginY(COMPONENT_Y) - iBlkSize - iPosY;
+
+  DistParam cDistParam;
+  m_cRdCost.setDistParam( cDistParam, m_iBitDepth, piOrg, iOrgStride, piRef, iRefStride, iBlkSize, iBlkSize );
+
+  Distortion uiBestSad = std::numeric_limits<Distortion>::max();
+  Int        iBestX    = 0;
+  Int        iBestY    = 0;
+  for (Int i = 0; i < iNumCandidates; i++)
+  {
+    const Int iCandX = Clip3( iLimitLeft, iLimitRight,  pcCandidates[i].getHor() );
+    const Int iCandY = Clip3( iLimitTop,  iLimitBottom, pcCandidates[i].getVer() );
+    cDistParam.pCur  = piRef + iCandY * iRefStride + iCandX;
+    const Distortion uiSad = cDistParam.DistFunc( &cDistParam );
+    if (uiSad < uiBestSad)
+    {
+      uiBestSad = uiSad;
+      iBestX    = iCandX;
+      iBestY    = iCandY;
+    }
+  }
+
+  const Int iMinX = std::max( iBestX - LOOKAHEAD_SEARCH_RANGE, iLimitLeft   );
+  const Int iMaxX = std::min( iBestX + LOOKAHEAD_SEARCH_RANGE, iLimitRight  );
+  const Int iMinY = std::max( iBestY - LOOKAHEAD_SEARCH_RANGE, iLimitTop    );
+  const Int iMaxY = std::min( iBestY + LOOKAHEAD_SEARCH_RANGE, iLimitBottom );
+  const Int iCentreX = iBestX;
+  const Int iCentreY = iBestY;
+  for (Int y = iMinY; y <= iMaxY; y++)
+  {
+    for (Int x = iMinX; x <= iMaxX; x++)
+    {
+      if (x == iCentreX && y == iCentreY)
+      {
+        continue;
+      }
+      cDistParam.pCur = piRef + y * iRefStride + x;
+      cDistParam.m_maximumDistortionForEarlyExit = uiBestSad;
+      const Distortion uiSad = cDistParam.DistFunc( &cDistParam );
+      if (uiSad < uiBestSad)
+      {
+        uiBestSad = uiSad;
+        iBestX    = x;
+        iBestY    = y;
+      }
+    }
+  }
+  rcMv.set( iBestX, iBestY );
+
+  m_cRdCost.setDistParam( cDistParam, m_iBitDepth, piOrg, iOrgStride, piRef + iBestY * iRefStride + iBestX, iRefStride, iBlkSize, iBlkSize, true );
+  return cDistParam.DistFunc( &cDistParam );
+}
+
+//! \}
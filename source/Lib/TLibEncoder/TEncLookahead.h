@@ -0,0 +1,116 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncLookahead.h
+    \brief    lookahead pre-analysis of the source pictures (header)
+*/
+
+#ifndef __TENCLOOKAHEAD__
+#define __TENCLOOKAHEAD__
+
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComPicYuv.h"
+#include "TLibCommon/TComRdCost.h"
+#include "TLibCommon/TComThreadPool.h"
+#include "TEncPic.h"
+
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// Lookahead pre-analysis: estimates intra and inter costs and motion of the source pictures on their own threads,
+/// while the pictures of a GOP are being received or, when the application passes them ahead, while earlier GOPs
+/// are compressed, so that they are available when the GOP is compressed
+class TEncLookahead
+{
+private:
+  /// analysis of one source picture
+  struct Picture
+  {
+    TComPicYuv*                     pcLowRes;         ///< half-resolution original
+    std::vector<TEncLookaheadBlock> blocks;
+    Bool                            bHasInter;        ///< a previous picture was available
+    Bool                            bDone;            ///< the analysis has finished, protected by m_mutex
+    TEncPic*                        pcPic;            ///< picture of the encoder receiving the results, or NULL
+  };
+
+  TComThreadPool            m_cThreadPool;
+  TComRdCost                m_cRdCost;                ///< only used for its distortion functions, which are thread safe
+  std::deque<Picture*>      m_apcPictures;            ///< pictures added and not yet released, in input order
+  Picture*                  m_pcReference;            ///< last released picture, kept as the reference of the analysis of the next one
+  std::vector<Picture*>     m_apcFreePictures;
+  Int                       m_iNumAttached;           ///< number of pictures at the front of m_apcPictures that were received by the encoder
+  std::mutex                m_mutex;
+  std::condition_variable   m_analysisDone;
+  Int                       m_iSourceWidth;
+  Int                       m_iSourceHeight;
+  Int                       m_iMaxCUWidth;
+  Int                       m_iMaxCUHeight;
+  Int                       m_iBitDepth;
+  Int                       m_iWidthInBlocks;
+  Int                       m_iHeightInBlocks;
+
+  Void       xAnalysePicture     ( Picture* pcCur, const TComPicYuv* pcPrev );
+  Distortion xEstimateIntraCost  ( const TComPicYuv* pcCur, Int iPosX, Int iPosY );
+  Distortion xEstimateInterCost  ( const TComPicYuv* pcCur, const TComPicYuv* pcPrev, Int iPosX, Int iPosY,
+                                   const TComMv* pcCandidates, Int iNumCandidates, TComMv& rcMv );
+
+public:
+  TEncLookahead();
+  virtual ~TEncLookahead();
+
+  Void create                    ( Int iNumThreads, Int iSourceWidth, Int iSourceHeight, Int iMaxCUWidth, Int iMaxCUHeight, Int iBitDepth );
+  Void destroy                   ();
+
+  /// downscale the original of the next source picture in input order and queue its analysis
+  Void addPicture                ( const TComPicYuv* pcPicYuvOrg );
+
+  /// associate the next received picture with its analysis, adding it first if it was not passed ahead
+  Void attachPicture             ( TEncPic* pcPic );
+
+  /// block until the analysis of all received pictures has finished and store the results in them
+  Void waitForAnalysis           ();
+};
+
+//! \}
+
+#endif // __TENCLOOKAHEAD__
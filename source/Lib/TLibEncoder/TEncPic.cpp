@@ -105,6 +105,10 @@ Void TEncPicQPAdaptationLayer::destroy()
 TEncPic::TEncPic()
 : m_acAQLayer(NULL)
 , m_uiMaxAQDepth(0)
+, m_lookaheadWidthInBlocks(0)
+, m_lookaheadHeightInBlocks(0)
+, m_bLookaheadValid(false)
+, m_bLookaheadHasInter(false)
 {
 }
 
@@ -143,6 +147,12 @@ Void TEncPic::create( const TComSPS &sps, const TComPPS &pps, UInt uiMaxAdaptive
       m_acAQLayer[d].create( iWidth, iHeight, uiMaxWidth>>d, uiMaxHeight>>d );
     }
   }
+
+  m_lookaheadWidthInBlocks  = (iWidth  + LOOKAHEAD_BLOCK_SIZE - 1) / LOOKAHEAD_BLOCK_SIZE;
+  m_lookaheadHeightInBlocks = (iHeight + LOOKAHEAD_BLOCK_SIZE - 1) / LOOKAHEAD_BLOCK_SIZE;
+  m_lookaheadBlocks.resize( m_lookaheadWidthInBlocks * m_lookaheadHeightInBlocks );
+  m_bLookaheadValid         = false;
+  m_bLookaheadHasInter      = false;
 }
 
 //! Clean up
@@ -153,7 +163,38 @@ Void TEncPic::destroy()
     delete[] m_acAQLayer;
     m_acAQLayer = NULL;
   }
+  m_lookaheadBlocks.clear();
+  m_bLookaheadValid = false;
   TComPic::destroy();
 }
+
+/** Sum the lookahead cost estimates of the blocks covering an area of the picture
+ * \param iPosX        horizontal luma position of the area
+ * \param iPosY        vertical luma position of the area
+ * \param iWidth       width of the area
+ * \param iHeight      height of the area
+ * \param ruiIntraCost returns the sum of the intra costs
+ * \param ruiInterCost returns the sum of the inter costs
+ */
+Void TEncPic::getLookaheadCosts( Int iPosX, Int iPosY, Int iWidth, Int iHeight, Distortion& ruiIntraCost, Distortion& ruiInterCost ) const
+{
+  const Int iBlkLeft   = iPosX / LOOKAHEAD_BLOCK_SIZE;
+  const Int iBlkTop    = iPosY / LOOKAHEAD_BLOCK_SIZE;
+  const Int iBlkRight  = std::min( (iPosX + iWidth  - 1) / LOOKAHEAD_BLOCK_SIZE, m_lookaheadWidthInBlocks  - 1 );
+  const Int iBlkBottom = std::min( (iPosY + iHeight - 1) / LOOKAHEAD_BLOCK_SIZE, m_lookaheadHeightInBlocks - 1 );
+
+  ruiIntraCost = 0;
+  ruiInterCost = 0;
+  for (Int iBlkY = iBlkTop; iBlkY <= iBlkBottom; iBlkY++)
+  {
+    for (Int iBlkX = iBlkLeft; iBlkX <= iBlkRight; iBlkX++)
+    {
+      const TEncLookaheadBlock &rcBlock = getLookaheadBlock( iBlkX, iBlkY );
+      ruiIntraCost += rcBlock.m_intraCost;
+      ruiInterCost += rcBlock.m_interCost;
+    }
+  }
+}
+
 //! \}
 
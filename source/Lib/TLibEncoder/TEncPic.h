@@ -40,6 +40,9 @@
 
 #include "TLibCommon/CommonDef.h"
 #include "TLibCommon/TComPic.h"
+#include "TLibCommon/TComMv.h"
+
+#include <vector>
 
 //! \ingroup TLibEncoder
 //! \{
@@ -91,13 +94,30 @@ public:
   Void                   setAvgActivity( Double d )  { m_dAvgActivity = d; }
 };
 
-/// Picture class including local image characteristics information for QP adaptation
+/// width and height in luma samples of the blocks of the lookahead pre-analysis
+static const Int LOOKAHEAD_BLOCK_SIZE = 16;
+
+/// Cost estimates of the lookahead pre-analysis for one block, computed on the half-resolution original
+struct TEncLookaheadBlock
+{
+  Distortion m_intraCost;   ///< SATD of the best of the DC, planar, horizontal and vertical predictions
+  Distortion m_interCost;   ///< SATD of the motion-compensated prediction from the previous picture in input order
+  TComMv     m_mv;          ///< integer-sample luma vector to the previous picture in input order
+};
+
+/// Picture class including local image characteristics information for QP adaptation and the lookahead pre-analysis
 class TEncPic : public TComPic
 {
 private:
   TEncPicQPAdaptationLayer* m_acAQLayer;
   UInt                      m_uiMaxAQDepth;
 
+  std::vector<TEncLookaheadBlock> m_lookaheadBlocks;
+  Int                       m_lookaheadWidthInBlocks;
+  Int                       m_lookaheadHeightInBlocks;
+  Bool                      m_bLookaheadValid;      ///< the blocks hold the pre-analysis of the current original picture
+  Bool                      m_bLookaheadHasInter;   ///< a previous picture was available, so the inter costs and vectors are valid
+
 public:
   TEncPic();
   virtual ~TEncPic();
@@ -111,6 +131,15 @@ public:
 
   TEncPicQPAdaptationLayer* getAQLayer( UInt uiDepth )  { return &m_acAQLayer[uiDepth]; }
   UInt                      getMaxAQDepth()             { return m_uiMaxAQDepth;        }
+
+  Void                      setLookaheadState( Bool bValid, Bool bHasInter )   { m_bLookaheadValid = bValid; m_bLookaheadHasInter = bHasInter; }
+  Bool                      getLookaheadValid() const                         { return m_bLookaheadValid;         }
+  Bool                      getLookaheadHasInter() const                      { return m_bLookaheadHasInter;      }
+  Int                       getLookaheadWidthInBlocks() const                 { return m_lookaheadWidthInBlocks;  }
+  Int                       getLookaheadHeightInBlocks() const                { return m_lookaheadHeightInBlocks; }
+  TEncLookaheadBlock&       getLookaheadBlock( Int iBlkX, Int iBlkY )         { return m_lookaheadBlocks[iBlkY * m_lookaheadWidthInBlocks + iBlkX]; }
+  const TEncLookaheadBlock& getLookaheadBlock( Int iBlkX, Int iBlkY ) const   { return m_lookaheadBlocks[iBlkY * m_lookaheadWidthInBlocks + iBlkX]; }
+  Void                      getLookaheadCosts( Int iPosX, Int iPosY, Int iWidth, Int iHeight, Distortion& ruiIntraCost, Distortion& ruiInterCost ) const;
 };
 
 //! \}
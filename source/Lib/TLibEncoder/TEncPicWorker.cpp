@@ -0,0 +1,91 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncPicWorker.cpp
+    \brief    per-thread picture processing context
+*/
+
+#include "TEncPicWorker.h"
+#include "TEncTop.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TEncPicWorker::TEncPicWorker()
+{
+}
+
+TEncPicWorker::~TEncPicWorker()
+{
+  destroy();
+}
+
+Void TEncPicWorker::create( Int iWidth, Int iHeight, ChromaFormat chromaFormat, UInt maxCUWidth, UInt maxCUHeight, UInt maxTotalCUDepth,
+                            Bool bUseSAO, UInt log2SaoOffsetScaleLuma, UInt log2SaoOffsetScaleChroma, Bool bSaoCtuBoundary )
+{
+  m_cCtuWorker.create( maxTotalCUDepth, maxCUWidth, maxCUHeight, chromaFormat );
+  m_cSliceEncoder.create( iWidth, iHeight, chromaFormat, maxCUWidth, maxCUHeight, maxTotalCUDepth );
+  m_cLoopFilter.create( maxTotalCUDepth );
+  if ( bUseSAO )
+  {
+    m_cEncSAO.create( iWidth, iHeight, chromaFormat, maxCUWidth, maxCUHeight, maxTotalCUDepth, log2SaoOffsetScaleLuma, log2SaoOffsetScaleChroma );
+    m_cEncSAO.createEncData( bSaoCtuBoundary );
+  }
+}
+
+Void TEncPicWorker::destroy()
+{
+  m_cEncSAO.destroyEncData();
+  m_cEncSAO.destroy();
+  m_cLoopFilter.destroy();
+  m_cSliceEncoder.destroy();
+  m_cCtuWorker.destroy();
+}
+
+/** Initialise the processing units in the same way as TEncTop::init does for the main ones.
+ * Scaling lists are set up separately, by TEncTop::xInitScalingLists.
+ */
+Void TEncPicWorker::init( TEncTop* pcEncTop, UInt maxTrSize, Int searchRange, Int bipredSearchRange,
+                          UInt maxCUWidth, UInt maxCUHeight, UInt maxTotalCUDepth )
+{
+  m_cCtuWorker.init( pcEncTop, maxTrSize, searchRange, bipredSearchRange, maxCUWidth, maxCUHeight, maxTotalCUDepth );
+  m_cSliceEncoder.init( pcEncTop, &m_cCtuWorker );
+  m_cCtuWorker.getCuEncoder()->setSliceEncoder( &m_cSliceEncoder );
+}
+
+//! \}
@@ -0,0 +1,86 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncPicWorker.h
+    \brief    per-thread picture processing context (header)
+*/
+
+#ifndef __TENCPICWORKER__
+#define __TENCPICWORKER__
+
+// Include files
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComLoopFilter.h"
+
+#include "TEncCtuWorker.h"
+#include "TEncSlice.h"
+#include "TEncSampleAdaptiveOffset.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+class TEncTop;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// set of picture-level processing units, so that a picture can be compressed, filtered and entropy coded while other pictures of the GOP are processed concurrently
+class TEncPicWorker
+{
+private:
+  TEncCtuWorker            m_cCtuWorker;                  ///< CU encoder, search, transform, RD cost and entropy coders
+  TEncSlice                m_cSliceEncoder;               ///< slice encoder
+  TComLoopFilter           m_cLoopFilter;                 ///< deblocking filter class
+  TEncSampleAdaptiveOffset m_cEncSAO;                     ///< sample adaptive offset class
+
+public:
+  TEncPicWorker();
+  virtual ~TEncPicWorker();
+
+  Void  create              ( Int iWidth, Int iHeight, ChromaFormat chromaFormat, UInt maxCUWidth, UInt maxCUHeight, UInt maxTotalCUDepth,
+                              Bool bUseSAO, UInt log2SaoOffsetScaleLuma, UInt log2SaoOffsetScaleChroma, Bool bSaoCtuBoundary );
+  Void  destroy             ();
+  Void  init                ( TEncTop* pcEncTop, UInt maxTrSize, Int searchRange, Int bipredSearchRange,
+                              UInt maxCUWidth, UInt maxCUHeight, UInt maxTotalCUDepth );
+
+  TEncCtuWorker*            getCtuWorker       () { return &m_cCtuWorker;    }
+  TEncSlice*                getSliceEncoder    () { return &m_cSliceEncoder; }
+  TComLoopFilter*           getLoopFilter      () { return &m_cLoopFilter;   }
+  TEncSampleAdaptiveOffset* getSAO             () { return &m_cEncSAO;       }
+};
+
+//! \}
+
+#endif // __TENCPICWORKER__
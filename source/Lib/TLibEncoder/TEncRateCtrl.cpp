@@ -485,6 +485,7 @@ TEncRCPic::TEncRCPic()
   m_picActualBits       = 0;
   m_picQP               = 0;
   m_picLambda           = 0.0;
+  m_totalLookaheadCost  = 0.0;
 }
 
 TEncRCPic::~TEncRCPic()
@@ -642,6 +643,7 @@ Void TEncRCPic::create( TEncRCSeq* encRCSeq, TEncRCGOP* encRCGOP, Int frameLevel
       m_LCUs[LCUIdx].m_lambda     = 0.0;
       m_LCUs[LCUIdx].m_targetBits = 0;
       m_LCUs[LCUIdx].m_bitWeight  = 1.0;
+      m_LCUs[LCUIdx].m_lookaheadCost = 0.0;
       Int currWidth  = ( (i == picWidthInLCU -1) ? picWidth  - LCUWidth *(picWidthInLCU -1) : LCUWidth  );
       Int currHeight = ( (j == picHeightInLCU-1) ? picHeight - LCUHeight*(picHeightInLCU-1) : LCUHeight );
       m_LCUs[LCUIdx].m_numberOfPixel = currWidth * currHeight;
@@ -651,6 +653,7 @@ Void TEncRCPic::create( TEncRCSeq* encRCSeq, TEncRCGOP* encRCGOP, Int frameLevel
   m_picActualBits       = 0;
   m_picQP               = 0;
   m_picLambda           = 0.0;
+  m_totalLookaheadCost  = 0.0;
 }
 
 Void TEncRCPic::destroy()
@@ -744,6 +747,12 @@ Double TEncRCPic::estimatePicLambda( list<TEncRCPic*>& listPreviousPictures, Sli
 
     m_LCUs[i].m_bitWeight =  m_LCUs[i].m_numberOfPixel * pow( estLambda/alphaLCU, 1.0/betaLCU );
 
+    // without separate LCU models all LCUs share one R-lambda model, so the complexity from the lookahead distributes the bits
+    if ( !m_encRCSeq->getUseLCUSeparateModel() && eSliceType != I_SLICE && m_totalLookaheadCost > 0.0 )
+    {
+      m_LCUs[i].m_bitWeight *= ( m_LCUs[i].m_lookaheadCost / m_LCUs[i].m_numberOfPixel ) / ( m_totalLookaheadCost / m_numberOfPixel );
+    }
+
     if ( m_LCUs[i].m_bitWeight < 0.01 )
     {
       m_LCUs[i].m_bitWeight = 0.01;
@@ -86,6 +86,7 @@ struct TRCLCU
   Int m_numberOfPixel;
   Double m_costIntra;
   Int m_targetBitsLeft;
+  Double m_lookaheadCost;   // inter or intra cost estimate of the lookahead pre-analysis
 };
 
 struct TRCParameter
@@ -269,6 +270,7 @@ public:
   Void setBitLeft(Int bits)                               { m_bitsLeft = bits; }
   Void setTargetBits( Int bits )                          { m_targetBits = bits; m_bitsLeft = bits;}
   Void setTotalIntraCost(Double cost)                     { m_totalCostIntra = cost; }
+  Void setTotalLookaheadCost(Double cost)                 { m_totalLookaheadCost = cost; }
   Void getLCUInitTargetBits();
 
   Int  getPicActualBits()                                 { return m_picActualBits; }
@@ -300,6 +302,7 @@ private:
   Int m_picActualHeaderBits;    // only SH and potential APS
   Double m_totalCostIntra;
   Double m_remainingCostIntra;
+  Double m_totalLookaheadCost;  // zero when the lookahead pre-analysis is not available
   Int m_picActualBits;          // the whole picture, including header
   Int m_picQP;                  // in integer form
   Double m_picLambda;
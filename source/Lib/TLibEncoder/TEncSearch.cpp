@@ -39,6 +39,7 @@
 #include "TLibCommon/TComRom.h"
 #include "TLibCommon/TComMotionInfo.h"
 #include "TEncSearch.h"
+#include "TEncPic.h"
 #include "TLibCommon/TComTU.h"
 #include "TLibCommon/Debug.h"
 #include <math.h>
@@ -48,6 +49,9 @@
 //! \ingroup TLibEncoder
 //! \{
 
+// window of the integer search around the predictor and the hierarchical ME and lookahead start vectors
+static const Int START_MV_REFINE_RANGE = 16;
+
 static const TComMv s_acMvRefineH[9] =
 {
   TComMv(  0,  0 ), // 0
@@ -820,10 +824,16 @@ __inline Void TEncSearch::xTZ8PointDiamondSearch( const TComPattern*const  pcPat
   } // iDist == 1
 }
 
+/** Test the 8 fractional positions around baseRefMv.
+ * The samples are read from the interpolated blocks of xExtDIFUpSamplingH/Q, or from the sub-sample planes of the
+ * reference picture when apiSubPelRef is given; apiSubPelRef[4*fracY+fracX] then points at the integer position of the search.
+ */
 Distortion TEncSearch::xPatternRefinement( TComPattern* pcPatternKey,
                                            TComMv baseRefMv,
                                            Int iFrac, TComMv& rcMvFrac,
-                                           Bool bAllowUseOfHadamard
+                                           Bool bAllowUseOfHadamard,
+                                           Pel* const* apiSubPelRef,
+                                           Int iSubPelStride
                                          )
 {
   Distortion  uiDist;
@@ -831,9 +841,9 @@ Distortion TEncSearch::xPatternRefinement( TComPattern* pcPatternKey,
   UInt        uiDirecBest = 0;
 
   Pel*  piRefPos;
-  Int iRefStride = m_filteredBlock[0][0].getStride(COMPONENT_Y);
+  Int iRefStride = apiSubPelRef ? iSubPelStride : m_filteredBlock[0][0].getStride(COMPONENT_Y);
 
-  m_pcRdCost->setDistParam( pcPatternKey, m_filteredBlock[0][0].getAddr(COMPONENT_Y), iRefStride, 1, m_cDistParam, m_pcEncCfg->getUseHADME() && bAllowUseOfHadamard );
+  m_pcRdCost->setDistParam( pcPatternKey, apiSubPelRef ? apiSubPelRef[0] : m_filteredBlock[0][0].getAddr(COMPONENT_Y), iRefStride, 1, m_cDistParam, m_pcEncCfg->getUseHADME() && bAllowUseOfHadamard );
 
   const TComMv* pcMvRefine = (iFrac == 2 ? s_acMvRefineH : s_acMvRefineQ);
 
@@ -869,14 +879,21 @@ Distortion TEncSearch::xPatternRefinement( TComPattern* pcPatternKey,
 
     Int horVal = cMvTest.getHor() * iFrac;
     Int verVal = cMvTest.getVer() * iFrac;
-    piRefPos = m_filteredBlock[ verVal & 3 ][ horVal & 3 ].getAddr(COMPONENT_Y);
-    if ( horVal == 2 && ( verVal & 1 ) == 0 )
+    if (apiSubPelRef)
     {
-      piRefPos += 1;
+      piRefPos = apiSubPelRef[ ((verVal & 3) << 2) + (horVal & 3) ] + (verVal >> 2) * iRefStride + (horVal >> 2);
     }
-    if ( ( horVal & 1 ) == 0 && verVal == 2 )
+    else
     {
-      piRefPos += iRefStride;
+      piRefPos = m_filteredBlock[ verVal & 3 ][ horVal & 3 ].getAddr(COMPONENT_Y);
+      if ( horVal == 2 && ( verVal & 1 ) == 0 )
+      {
+        piRefPos += 1;
+      }
+      if ( ( horVal & 1 ) == 0 && verVal == 2 )
+      {
+        piRefPos += iRefStride;
+      }
     }
     cMvTest = pcMvRefine[i];
     cMvTest += rcMvFrac;
@@ -2199,6 +2216,198 @@ TEncSearch::xSetIntraResultChromaQT(TComYuv*    pcRecoYuv, TComTU &rTu)
 
 
 
+/** Hadamard distortion of a square intra prediction, generated and measured tile by tile.
+ * Each tile is built in a small local buffer and measured straight away, so the prediction block is never stored.
+ * \param iSize      block size
+ * \param iTileSize  size of the Hadamard tiles, as used by the distortion function for the whole block
+ * \param piOrg      original block in the orientation of the prediction
+ * \param iOrgStride stride of the original
+ * \param rcTileDist distortion parameters of a tile, measuring against the local tile buffer
+ * \param predRow    writes iTileSize prediction samples of a row, starting at a column
+ */
+template<typename PredRowFunc>
+static Distortion intraPredTileDist( const Int iSize, const Int iTileSize, const Pel* piOrg, const Int iOrgStride, DistParam& rcTileDist, PredRowFunc predRow )
+{
+  Pel        aiTile[8 * 8];
+  Distortion uiDist = 0;
+
+  rcTileDist.pCur       = aiTile;
+  rcTileDist.iStrideOrg = iOrgStride;
+  for (Int y0 = 0; y0 < iSize; y0 += iTileSize)
+  {
+    for (Int x0 = 0; x0 < iSize; x0 += iTileSize)
+    {
+      for (Int y = 0; y < iTileSize; y++)
+      {
+        predRow( x0, y0 + y, aiTile + y * iTileSize );
+      }
+      rcTileDist.pOrg = piOrg + y0 * iOrgStride + x0;
+      uiDist += rcTileDist.DistFunc( &rcTileDist );
+    }
+  }
+  return uiDist;
+}
+
+/** Hadamard distortion of the 35 luma intra predictions of a PU, for the first pass of the mode decision.
+ * The reference arrays are read once per PU. Horizontal modes are predicted in the orientation of the vertical ones and
+ * measured against the transposed original, which gives the same Hadamard distortion. The results are identical to
+ * predicting each mode with predIntraAng() and measuring it with the Hadamard distortion function.
+ * The intra pattern must have been initialised with filtered reference samples, and the CU must not be lossless.
+ * \param rTu         TU of the PU
+ * \param piOrg       original luma block
+ * \param iOrgStride  stride of the original
+ * \param auiDist     returns the distortion of each luma mode
+ */
+Void TEncSearch::xEstimateIntraModeDistLuma( TComTU &rTu, const Pel* piOrg, const Int iOrgStride, Distortion auiDist[NUM_INTRA_MODE] )
+{
+  const TComDataCU    *pcCU         = rTu.getCU();
+  const TComSPS       &sps          = *(pcCU->getSlice()->getSPS());
+  const TComRectangle &rect         = rTu.getRect( COMPONENT_Y );
+  const Int            iSize        = rect.width;
+  const Int            iLog2Size    = g_aucConvertToBit[ iSize ] + 2;
+  const Int            iTileSize    = ( iSize & 7 ) == 0 ? 8 : 4;
+  const Bool           bEdgeFilters = iSize <= MAXIMUM_INTRA_FILTERED_WIDTH;
+#if O0043_BEST_EFFORT_DECODING
+  const Int            bitDepth     = sps.getStreamBitDepth( CHANNEL_TYPE_LUMA );
+#else
+  const Int            bitDepth     = sps.getBitDepth( CHANNEL_TYPE_LUMA );
+#endif
+  const Int            iMaxVal      = ( 1 << bitDepth ) - 1;
+
+  assert( rect.width == rect.height );
+  assert( !pcCU->getCUTransquantBypass( rTu.GetAbsPartIdxTU() ) );
+
+  // the distortion of the whole block is the sum of the tiles, reduced by the precision adjustment at the end. The
+  // tiles are measured with a bit depth that has no adjustment; up to 10 bits this selects the same kernels.
+  const Int iTileBitDepth = DISTORTION_PRECISION_ADJUSTMENT( bitDepth - 8 ) == 0 ? bitDepth : 8;
+  assert( iTileBitDepth == bitDepth || bitDepth <= 10 );
+
+  // transposed original for the horizontal modes
+  Pel aiOrgT[MAX_CU_SIZE * MAX_CU_SIZE];
+  for (Int y = 0; y < iSize; y++)
+  {
+    for (Int x = 0; x < iSize; x++)
+    {
+      aiOrgT[x * iSize + y] = piOrg[y * iOrgStride + x];
+    }
+  }
+
+  // the corner followed by the above and the left reference samples, unfiltered and filtered
+  Pel aaiRefAbove[NUM_PRED_BUF][2 * MAX_CU_SIZE + 2];
+  Pel aaiRefLeft [NUM_PRED_BUF][2 * MAX_CU_SIZE + 2];
+  const Int sw = 2 * iSize + 1;
+  for (Int iBuf = 0; iBuf < NUM_PRED_BUF; iBuf++)
+  {
+    const Pel *ptrSrc = getPredictorPtr( COMPONENT_Y, iBuf == PRED_BUF_FILTERED );
+    // the last sample is repeated, as it is only read with a zero weight by the interpolation of the steepest angles
+    for (Int k = 0; k < 2 * iSize + 2; k++)
+    {
+      const Int kSrc = std::min( k, 2 * iSize );
+      aaiRefAbove[iBuf][k] = ptrSrc[kSrc];
+      aaiRefLeft [iBuf][k] = ptrSrc[kSrc * sw];
+    }
+  }
+
+  DistParam cTileDist;
+  m_pcRdCost->setDistParam( cTileDist, iTileBitDepth, piOrg, iOrgStride, NULL, iTileSize, iTileSize, iTileSize, true );
+  cTileDist.bApplyWeight = false;
+
+  static const Int angTable[9]    = {0,    2,    5,   9,  13,  17,  21,  26,  32};
+  static const Int invAngTable[9] = {0, 4096, 1638, 910, 630, 482, 390, 315, 256}; // (256 * 32) / Angle
+
+  for (UInt uiMode = 0; uiMode < NUM_INTRA_MODE - 1; uiMode++)
+  {
+    const Bool bUseFilter = TComPrediction::filteringIntraReferenceSamples( COMPONENT_Y, uiMode, iSize, iSize, pcCU->getPic()->getChromaFormat(), sps.getSpsRangeExtension().getIntraSmoothingDisabledFlag() );
+    const Pel *piRefAbove = aaiRefAbove[bUseFilter ? PRED_BUF_FILTERED : PRED_BUF_UNFILTERED];
+    const Pel *piRefLeft  = aaiRefLeft [bUseFilter ? PRED_BUF_FILTERED : PRED_BUF_UNFILTERED];
+
+    if (uiMode == PLANAR_IDX)
+    {
+      const Int iTopRight   = piRefAbove[iSize + 1];
+      const Int iBottomLeft = piRefLeft [iSize + 1];
+      auiDist[uiMode] = intraPredTileDist( iSize, iTileSize, piOrg, iOrgStride, cTileDist, [&]( Int x0, Int y, Pel* piDst )
+      {
+        const Int iLeft = piRefLeft[y + 1];
+        for (Int x = 0; x < iTileSize; x++)
+        {
+          const Int iX = x0 + x;
+          piDst[x] = Pel( ( ( iSize - 1 - iX ) * iLeft + ( iX + 1 ) * iTopRight + ( iSize - 1 - y ) * piRefAbove[iX + 1] + ( y + 1 ) * iBottomLeft + iSize ) >> ( iLog2Size + 1 ) );
+        }
+      } );
+    }
+    else if (uiMode == DC_IDX)
+    {
+      Int iSum = iSize;
+      for (Int k = 1; k <= iSize; k++)
+      {
+        iSum += piRefAbove[k] + piRefLeft[k];
+      }
+      const Int iDCVal = iSum / ( 2 * iSize );
+      auiDist[uiMode] = intraPredTileDist( iSize, iTileSize, piOrg, iOrgStride, cTileDist, [&]( Int x0, Int y, Pel* piDst )
+      {
+        for (Int x = 0; x < iTileSize; x++)
+        {
+          piDst[x] = Pel( iDCVal );
+        }
+        if (bEdgeFilters && y == 0)
+        {
+          for (Int x = 0; x < iTileSize; x++)
+          {
+            piDst[x] = Pel( ( piRefAbove[x0 + x + 1] + 3 * iDCVal + 2 ) >> 2 );
+          }
+          if (x0 == 0)
+          {
+            piDst[0] = Pel( ( piRefAbove[1] + piRefLeft[1] + 2 * iDCVal + 2 ) >> 2 );
+          }
+        }
+        else if (bEdgeFilters && x0 == 0)
+        {
+          piDst[0] = Pel( ( piRefLeft[y + 1] + 3 * iDCVal + 2 ) >> 2 );
+        }
+      } );
+    }
+    else
+    {
+      const Bool bIsModeVer         = uiMode >= 18;
+      const Int  intraPredAngleMode = bIsModeVer ? Int(uiMode) - VER_IDX : -( Int(uiMode) - HOR_IDX );
+      const Int  absAngMode         = abs( intraPredAngleMode );
+      const Int  intraPredAngle     = ( intraPredAngleMode < 0 ? -1 : 1 ) * angTable[absAngMode];
+      const Pel *piRefSide          = bIsModeVer ? piRefLeft : piRefAbove;
+
+      // main reference, extended to the left by the projection of the side reference for negative angles
+      Pel  aiRefMain[3 * MAX_CU_SIZE + 2];
+      Pel *piRefMain = aiRefMain + MAX_CU_SIZE;
+      ::memcpy( piRefMain, bIsModeVer ? piRefAbove : piRefLeft, sizeof(Pel) * ( 2 * iSize + 2 ) );
+      if (intraPredAngle < 0)
+      {
+        Int invAngleSum = 128;
+        for (Int k = -1; k > ( iSize * intraPredAngle ) >> 5; k--)
+        {
+          invAngleSum += invAngTable[absAngMode];
+          piRefMain[k] = piRefSide[invAngleSum >> 8];
+        }
+      }
+
+      const Bool bEdgeFilter = bEdgeFilters && intraPredAngle == 0;
+      auiDist[uiMode] = intraPredTileDist( iSize, iTileSize, bIsModeVer ? piOrg : aiOrgT, bIsModeVer ? iOrgStride : iSize, cTileDist, [&]( Int x0, Int y, Pel* piDst )
+      {
+        const Int  deltaPos   = ( y + 1 ) * intraPredAngle;
+        const Int  deltaFract = deltaPos & ( 32 - 1 );
+        const Pel *piRef      = piRefMain + ( deltaPos >> 5 ) + 1 + x0;
+        for (Int x = 0; x < iTileSize; x++)
+        {
+          piDst[x] = Pel( ( ( 32 - deltaFract ) * piRef[x] + deltaFract * piRef[x + 1] + 16 ) >> 5 );
+        }
+        if (bEdgeFilter && x0 == 0)
+        {
+          piDst[0] = Pel( Clip3( 0, iMaxVal, piDst[0] + ( ( piRefSide[y + 1] - piRefSide[0] ) >> 1 ) ) );
+        }
+      } );
+    }
+    auiDist[uiMode] >>= DISTORTION_PRECISION_ADJUSTMENT( bitDepth - 8 );
+  }
+}
+
 Void
 TEncSearch::estIntraPredLumaQT(TComDataCU* pcCU,
                                TComYuv*    pcOrgYuv,
@@ -2293,17 +2502,35 @@ TEncSearch::estIntraPredLumaQT(TComDataCU* pcCU,
       const Bool bUseHadamard=pcCU->getCUTransquantBypass(0) == 0;
       m_pcRdCost->setDistParam(distParam, sps.getBitDepth(CHANNEL_TYPE_LUMA), piOrg, uiStride, piPred, uiStride, puRect.width, puRect.height, bUseHadamard);
       distParam.bApplyWeight = false;
+
+      // the Hadamard distortion of all modes is estimated in one pass over the PU, unless the tiles cannot be
+      // measured without the precision adjustment of the distortion
+      const Int  bitDepthLuma  = sps.getBitDepth(CHANNEL_TYPE_LUMA);
+      const Bool bBatchedModes = bUseHadamard && (DISTORTION_PRECISION_ADJUSTMENT(bitDepthLuma - 8) == 0 || bitDepthLuma <= 10);
+      Distortion auiModeDist[NUM_INTRA_MODE];
+      if (bBatchedModes)
+      {
+        xEstimateIntraModeDistLuma( tuRecurseWithPU, piOrg, uiStride, auiModeDist );
+      }
+
       for( Int modeIdx = 0; modeIdx < numModesAvailable; modeIdx++ )
       {
         UInt       uiMode = modeIdx;
         Distortion uiSad  = 0;
 
-        const Bool bUseFilter=TComPrediction::filteringIntraReferenceSamples(COMPONENT_Y, uiMode, puRect.width, puRect.height, chFmt, sps.getSpsRangeExtension().getIntraSmoothingDisabledFlag());
+        if (bBatchedModes)
+        {
+          uiSad = auiModeDist[uiMode];
+        }
+        else
+        {
+          const Bool bUseFilter=TComPrediction::filteringIntraReferenceSamples(COMPONENT_Y, uiMode, puRect.width, puRect.height, chFmt, sps.getSpsRangeExtension().getIntraSmoothingDisabledFlag());
 
-        predIntraAng( COMPONENT_Y, uiMode, piOrg, uiStride, piPred, uiStride, tuRecurseWithPU, bUseFilter, TComPrediction::UseDPCMForFirstPassIntraEstimation(tuRecurseWithPU, uiMode) );
+          predIntraAng( COMPONENT_Y, uiMode, piOrg, uiStride, piPred, uiStride, tuRecurseWithPU, bUseFilter, TComPrediction::UseDPCMForFirstPassIntraEstimation(tuRecurseWithPU, uiMode) );
 
-        // use hadamard transform here
-        uiSad+=distParam.DistFunc(&distParam);
+          // use hadamard transform here
+          uiSad+=distParam.DistFunc(&distParam);
+        }
 
         UInt   iModeBits = 0;
 
@@ -3803,6 +4030,24 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
 
   TComMv      cMvPred = *pcMvPred;
 
+  // start vectors of the fast integer search besides the predictors
+  TComMv acExtraStartMvs[2];
+  Int    iNumExtraStartMvs = 0;
+  if ( !bBi && m_motionEstimationSearchMethod != MESEARCH_FULL )
+  {
+    // the hierarchical ME start vector lets the fast integer search use a small window
+    if ( m_pcEncCfg->getHierarchicalME() )
+    {
+      acExtraStartMvs[iNumExtraStartMvs++] = m_hierarchicalMv[eRefPicList][iRefIdxPred];
+      m_iSearchRange = std::min(m_iSearchRange, START_MV_REFINE_RANGE);
+      iSrchRng       = m_iSearchRange;
+    }
+    if ( m_pcEncCfg->getLookahead() && xGetLookaheadStartMv( pcCU, iPartIdx, eRefPicList, iRefIdxPred, acExtraStartMvs[iNumExtraStartMvs] ) )
+    {
+      iNumExtraStartMvs++;
+    }
+  }
+
   if ( bBi )
   {
 #if MCTS_ENC_CHECK
@@ -3818,6 +4063,22 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
 #else
     xSetSearchRange(pcCU, cMvPred, iSrchRng, cMvSrchRngLT, cMvSrchRngRB);
 #endif
+    for ( Int i = 0; i < iNumExtraStartMvs; i++ )
+    {
+      // extend the window to cover the start vector and its neighbourhood
+      const Int iSeedSrchRng = std::min(iSrchRng, START_MV_REFINE_RANGE);
+      TComMv cMvSeedRngLT;
+      TComMv cMvSeedRngRB;
+      TComMv cMvSeed = acExtraStartMvs[i];
+      cMvSeed <<= 2;
+#if MCTS_ENC_CHECK
+      xSetSearchRange(pcCU, cMvSeed, iSeedSrchRng, cMvSeedRngLT, cMvSeedRngRB, &cPattern);
+#else
+      xSetSearchRange(pcCU, cMvSeed, iSeedSrchRng, cMvSeedRngLT, cMvSeedRngRB);
+#endif
+      cMvSrchRngLT.set( std::min(cMvSrchRngLT.getHor(), cMvSeedRngLT.getHor()), std::min(cMvSrchRngLT.getVer(), cMvSeedRngLT.getVer()) );
+      cMvSrchRngRB.set( std::max(cMvSrchRngRB.getHor(), cMvSeedRngRB.getHor()), std::max(cMvSrchRngRB.getVer(), cMvSeedRngRB.getVer()) );
+    }
   }
 
   m_pcRdCost->selectMotionLambda( true, 0, pcCU->getCUTransquantBypass(uiPartAddr) );
@@ -3839,7 +4100,7 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
     {
       pIntegerMv2Nx2NPred = &(m_integerMv2Nx2N[eRefPicList][iRefIdxPred]);
     }
-    xPatternSearchFast  ( pcCU, &cPattern, piRefY, iRefStride, &cMvSrchRngLT, &cMvSrchRngRB, rcMv, ruiCost, pIntegerMv2Nx2NPred );
+    xPatternSearchFast  ( pcCU, &cPattern, piRefY, iRefStride, &cMvSrchRngLT, &cMvSrchRngRB, rcMv, ruiCost, pIntegerMv2Nx2NPred, acExtraStartMvs, iNumExtraStartMvs );
     if (pcCU->getPartitionSize(0) == SIZE_2Nx2N)
     {
       m_integerMv2Nx2N[eRefPicList][iRefIdxPred] = rcMv;
@@ -3850,7 +4111,8 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
   m_pcRdCost->setCostScale ( 1 );
 
   const Bool bIsLosslessCoded = pcCU->getCUTransquantBypass(uiPartAddr) != 0;
-  xPatternSearchFracDIF( bIsLosslessCoded, &cPattern, piRefY, iRefStride, &rcMv, cMvHalf, cMvQter, ruiCost );
+  TComPic *pcRefPicSubPel = m_pcEncCfg->getSubPelPlaneCache() ? pcCU->getSlice()->getRefPic( eRefPicList, iRefIdxPred ) : NULL;
+  xPatternSearchFracDIF( bIsLosslessCoded, &cPattern, piRefY, iRefStride, &rcMv, cMvHalf, cMvQter, ruiCost, pcRefPicSubPel );
 
   m_pcRdCost->setCostScale( 0 );
   rcMv <<= 2;
@@ -4015,7 +4277,9 @@ Void TEncSearch::xPatternSearchFast( const TComDataCU* const  pcCU,
                                      const TComMv* const      pcMvSrchRngRB,
                                      TComMv&                  rcMv,
                                      Distortion&              ruiSAD,
-                                     const TComMv* const      pIntegerMv2Nx2NPred )
+                                     const TComMv* const      pIntegerMv2Nx2NPred,
+                                     const TComMv* const      pcExtraStartMvs,
+                                     const Int                iNumExtraStartMvs )
 {
   assert (MD_LEFT < NUM_MV_PREDICTORS);
   pcCU->getMvPredLeft       ( m_acMvPredictors[MD_LEFT] );
@@ -4027,15 +4291,15 @@ Void TEncSearch::xPatternSearchFast( const TComDataCU* const  pcCU,
   switch ( m_motionEstimationSearchMethod )
   {
     case MESEARCH_DIAMOND:
-      xTZSearch( pcCU, pcPatternKey, piRefY, iRefStride, pcMvSrchRngLT, pcMvSrchRngRB, rcMv, ruiSAD, pIntegerMv2Nx2NPred, false );
+      xTZSearch( pcCU, pcPatternKey, piRefY, iRefStride, pcMvSrchRngLT, pcMvSrchRngRB, rcMv, ruiSAD, pIntegerMv2Nx2NPred, pcExtraStartMvs, iNumExtraStartMvs, false );
       break;
 
     case MESEARCH_SELECTIVE:
-      xTZSearchSelective( pcCU, pcPatternKey, piRefY, iRefStride, pcMvSrchRngLT, pcMvSrchRngRB, rcMv, ruiSAD, pIntegerMv2Nx2NPred );
+      xTZSearchSelective( pcCU, pcPatternKey, piRefY, iRefStride, pcMvSrchRngLT, pcMvSrchRngRB, rcMv, ruiSAD, pIntegerMv2Nx2NPred, pcExtraStartMvs, iNumExtraStartMvs );
       break;
 
     case MESEARCH_DIAMOND_ENHANCED:
-      xTZSearch( pcCU, pcPatternKey, piRefY, iRefStride, pcMvSrchRngLT, pcMvSrchRngRB, rcMv, ruiSAD, pIntegerMv2Nx2NPred, true );
+      xTZSearch( pcCU, pcPatternKey, piRefY, iRefStride, pcMvSrchRngLT, pcMvSrchRngRB, rcMv, ruiSAD, pIntegerMv2Nx2NPred, pcExtraStartMvs, iNumExtraStartMvs, true );
       break;
 
     case MESEARCH_FULL: // shouldn't get here.
@@ -4054,6 +4318,8 @@ Void TEncSearch::xTZSearch( const TComDataCU* const pcCU,
                             TComMv&                  rcMv,
                             Distortion&              ruiSAD,
                             const TComMv* const      pIntegerMv2Nx2NPred,
+                            const TComMv* const      pcExtraStartMvs,
+                            const Int                iNumExtraStartMvs,
                             const Bool               bExtendedSettings)
 {
   const Bool bUseAdaptiveRaster                      = bExtendedSettings;
@@ -4125,6 +4391,20 @@ Void TEncSearch::xTZSearch( const TComDataCU* const pcCU,
     }
   }
 
+  // test whether the hierarchical ME or lookahead vectors are a better start point
+  for ( Int i = 0; i < iNumExtraStartMvs; i++ )
+  {
+    const Int iHorMv = pcExtraStartMvs[i].getHor();
+    const Int iVerMv = pcExtraStartMvs[i].getVer();
+    // the window keeps the vector inside the picture margins and the tile of a motion-constrained tile set
+    if ( iHorMv >= pcMvSrchRngLT->getHor() && iHorMv <= pcMvSrchRngRB->getHor() &&
+         iVerMv >= pcMvSrchRngLT->getVer() && iVerMv <= pcMvSrchRngRB->getVer() &&
+         (iHorMv != cStruct.iBestX || iVerMv != cStruct.iBestY) )
+    {
+      xTZSearchHelp( pcPatternKey, cStruct, iHorMv, iVerMv, 0, 0 );
+    }
+  }
+
   Int   iSrchRngHorLeft   = pcMvSrchRngLT->getHor();
   Int   iSrchRngHorRight  = pcMvSrchRngRB->getHor();
   Int   iSrchRngVerTop    = pcMvSrchRngLT->getVer();
@@ -4361,7 +4641,9 @@ Void TEncSearch::xTZSearchSelective( const TComDataCU* const   pcCU,
                                      const TComMv* const       pcMvSrchRngRB,
                                      TComMv                   &rcMv,
                                      Distortion               &ruiSAD,
-                                     const TComMv* const       pIntegerMv2Nx2NPred )
+                                     const TComMv* const       pIntegerMv2Nx2NPred,
+                                     const TComMv* const       pcExtraStartMvs,
+                                     const Int                 iNumExtraStartMvs )
 {
   const Bool bTestOtherPredictedMV    = true;
   const Bool bTestZeroVector          = true;
@@ -4430,6 +4712,20 @@ Void TEncSearch::xTZSearchSelective( const TComDataCU* const   pcCU,
     xTZSearchHelp( pcPatternKey, cStruct, 0, 0, 0, 0 );
   }
 
+  // test whether the hierarchical ME or lookahead vectors are a better start point
+  for ( Int i = 0; i < iNumExtraStartMvs; i++ )
+  {
+    const Int iHorMv = pcExtraStartMvs[i].getHor();
+    const Int iVerMv = pcExtraStartMvs[i].getVer();
+    // the window keeps the vector inside the picture margins and the tile of a motion-constrained tile set
+    if ( iHorMv >= pcMvSrchRngLT->getHor() && iHorMv <= pcMvSrchRngRB->getHor() &&
+         iVerMv >= pcMvSrchRngLT->getVer() && iVerMv <= pcMvSrchRngRB->getVer() &&
+         (iHorMv != cStruct.iBestX || iVerMv != cStruct.iBestY) )
+    {
+      xTZSearchHelp( pcPatternKey, cStruct, iHorMv, iVerMv, 0, 0 );
+    }
+  }
+
   if ( pIntegerMv2Nx2NPred != 0 )
   {
     TComMv integerMv2Nx2NPred = *pIntegerMv2Nx2NPred;
@@ -4543,12 +4839,19 @@ Void TEncSearch::xPatternSearchFracDIF(
                                        TComMv*      pcMvInt,
                                        TComMv&      rcMvHalf,
                                        TComMv&      rcMvQter,
-                                       Distortion&  ruiCost
+                                       Distortion&  ruiCost,
+                                       TComPic*     pcRefPic
                                       )
 {
   //  Reference pattern initialization (integer scale)
   TComPattern cPatternRoi;
   Int         iOffset    = pcMvInt->getHor() + pcMvInt->getVer() * iRefStride;
+
+  //  Use the cached sub-sample planes of the reference picture when they cover the search
+  Pel*        apiSubPelRef[16];
+  const Bool  bUseSubPelPlanes = pcRefPic != NULL && xGetSubPelRef( pcRefPic, piRefY + iOffset, pcPatternKey->getROIYWidth(), pcPatternKey->getROIYHeight(), apiSubPelRef );
+  Pel* const* apiSubPel        = bUseSubPelPlanes ? apiSubPelRef : NULL;
+
   cPatternRoi.initPattern(piRefY + iOffset,
                           pcPatternKey->getROIYWidth(),
                           pcPatternKey->getROIYHeight(),
@@ -4565,21 +4868,286 @@ Void TEncSearch::xPatternSearchFracDIF(
 #endif
 
   //  Half-pel refinement
-  xExtDIFUpSamplingH ( &cPatternRoi );
+  if (!bUseSubPelPlanes)
+  {
+    xExtDIFUpSamplingH ( &cPatternRoi );
+  }
 
   rcMvHalf = *pcMvInt;   rcMvHalf <<= 1;    // for mv-cost
   TComMv baseRefMv(0, 0);
-  ruiCost = xPatternRefinement( pcPatternKey, baseRefMv, 2, rcMvHalf, !bIsLosslessCoded );
+  ruiCost = xPatternRefinement( pcPatternKey, baseRefMv, 2, rcMvHalf, !bIsLosslessCoded, apiSubPel, iRefStride );
 
   m_pcRdCost->setCostScale( 0 );
 
-  xExtDIFUpSamplingQ ( &cPatternRoi, rcMvHalf );
+  if (!bUseSubPelPlanes)
+  {
+    xExtDIFUpSamplingQ ( &cPatternRoi, rcMvHalf );
+  }
   baseRefMv = rcMvHalf;
   baseRefMv <<= 1;
 
   rcMvQter = *pcMvInt;   rcMvQter <<= 1;    // for mv-cost
   rcMvQter += rcMvHalf;  rcMvQter <<= 1;
-  ruiCost = xPatternRefinement( pcPatternKey, baseRefMv, 1, rcMvQter, !bIsLosslessCoded );
+  ruiCost = xPatternRefinement( pcPatternKey, baseRefMv, 1, rcMvQter, !bIsLosslessCoded, apiSubPel, iRefStride );
+}
+
+/** Get the sub-sample positions of a block of the reference picture for the fractional search around its integer position.
+ * The sub-sample planes are created and interpolated on first use.
+ * \param pcRefPic     reference picture
+ * \param piRefY       integer position of the block in the reconstruction of the reference picture
+ * \param iWidth       block width
+ * \param iHeight      block height
+ * \param apiSubPelRef returns the position of the block in the plane of each quarter-sample phase, indexed by 4*fracY+fracX
+ * \returns false when the planes do not cover the samples around the block, which then have to be interpolated separately
+ */
+Bool TEncSearch::xGetSubPelRef( TComPic* pcRefPic, const Pel* piRefY, Int iWidth, Int iHeight, Pel* apiSubPelRef[16] )
+{
+  TComPicYuv *pcPicYuvRec    = pcRefPic->getPicYuvRec();
+  const Int   iStride        = pcPicYuvRec->getStride(COMPONENT_Y);
+  const Int   halfFilterSize = NTAPS_LUMA >> 1;
+  const Int   iOffset        = Int(piRefY - pcPicYuvRec->getAddr(COMPONENT_Y));
+        Int   iPosY          = (iOffset >= 0) ? iOffset / iStride : -((iStride - 1 - iOffset) / iStride);
+        Int   iPosX          = iOffset - iPosY * iStride;
+
+  if (iPosX >= pcPicYuvRec->getWidth(COMPONENT_Y) + pcPicYuvRec->getMarginX(COMPONENT_Y))
+  {
+    // the block starts in the left margin of the next row
+    iPosX -= iStride;
+    iPosY++;
+  }
+
+  // the planes hold the positions whose filter taps lie inside the picture buffer, and the
+  // refinement reads up to one integer position above and to the left of the block
+  if (   iPosX - 1 < halfFilterSize - 1 - pcPicYuvRec->getMarginX(COMPONENT_Y)
+      || iPosY - 1 < halfFilterSize - 1 - pcPicYuvRec->getMarginY(COMPONENT_Y)
+      || iPosX + iWidth  > pcPicYuvRec->getWidth (COMPONENT_Y) + pcPicYuvRec->getMarginX(COMPONENT_Y) - halfFilterSize
+      || iPosY + iHeight > pcPicYuvRec->getHeight(COMPONENT_Y) + pcPicYuvRec->getMarginY(COMPONENT_Y) - halfFilterSize )
+  {
+    return false;
+  }
+
+  xFillSubPelPlanes( pcRefPic, iPosY - 1, iPosY + iHeight - 1 );
+
+  for (Int fracY = 0; fracY < 4; fracY++)
+  {
+    for (Int fracX = 0; fracX < 4; fracX++)
+    {
+      TComPicYuv *pcPlane = (fracY|fracX) ? pcRefPic->getPicYuvSubPel(fracY, fracX) : pcPicYuvRec;
+      apiSubPelRef[(fracY << 2) + fracX] = pcPlane->getAddr(COMPONENT_Y) + iOffset;
+    }
+  }
+  return true;
+}
+
+/** Interpolate the CTU rows of the sub-sample planes of a reference picture that cover the luma rows iTop to iBottom.
+ * Rows are interpolated once; the first and last CTU rows also cover the picture margin.
+ * The CTU workers of a slice may search the same reference picture concurrently. Rows that are already interpolated
+ * are detected without a lock; the lock is only taken to create the planes or interpolate a missing row.
+ */
+Void TEncSearch::xFillSubPelPlanes( TComPic* pcRefPic, Int iTop, Int iBottom )
+{
+  const TComSPS     &sps            = pcRefPic->getPicSym()->getSPS();
+  const Int          ctuHeight      = sps.getMaxCUHeight();
+  const Int          numCtuRows     = pcRefPic->getFrameHeightInCtus();
+  const Int          firstRow       = Clip3(0, numCtuRows - 1, iTop / ctuHeight);
+  const Int          lastRow        = Clip3(0, numCtuRows - 1, iBottom / ctuHeight);
+
+  Bool bAllRowsValid = pcRefPic->getSubPelPlanesCreated();
+  for (Int ctuRow = firstRow; bAllRowsValid && ctuRow <= lastRow; ctuRow++)
+  {
+    bAllRowsValid = pcRefPic->getSubPelRowValid(ctuRow);
+  }
+  if (bAllRowsValid)
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock( pcRefPic->getSubPelMutex() );
+
+  if (!pcRefPic->getSubPelPlanesCreated())
+  {
+    pcRefPic->createSubPelPlanes();
+  }
+
+  TComPicYuv        *pcPicYuvRec    = pcRefPic->getPicYuvRec();
+  const ChromaFormat chFmt          = pcRefPic->getChromaFormat();
+  const Int          bitDepth       = sps.getBitDepth(CHANNEL_TYPE_LUMA);
+  const Int          filterSize     = NTAPS_LUMA;
+  const Int          halfFilterSize = filterSize >> 1;
+  const Int          iStride        = pcPicYuvRec->getStride(COMPONENT_Y);
+  const Int          iLeft          = halfFilterSize - 1 - pcPicYuvRec->getMarginX(COMPONENT_Y);
+  const Int          iWidth         = pcPicYuvRec->getWidth(COMPONENT_Y) + 2 * pcPicYuvRec->getMarginX(COMPONENT_Y) - filterSize + 1;
+
+  for (Int ctuRow = firstRow; ctuRow <= lastRow; ctuRow++)
+  {
+    // another worker may have interpolated the row before the lock was taken
+    if (pcRefPic->getSubPelRowValid(ctuRow))
+    {
+      continue;
+    }
+
+    const Int iRowTop    = (ctuRow == 0)              ? halfFilterSize - 1 - pcPicYuvRec->getMarginY(COMPONENT_Y) : ctuRow * ctuHeight;
+    const Int iRowBottom = (ctuRow == numCtuRows - 1) ? pcPicYuvRec->getHeight(COMPONENT_Y) + pcPicYuvRec->getMarginY(COMPONENT_Y) - halfFilterSize : (ctuRow + 1) * ctuHeight;
+    const Int iHeight    = iRowBottom - iRowTop;
+
+    std::vector<Pel> tmp(iWidth * (iHeight + filterSize - 1));
+    Pel *srcPtr = pcPicYuvRec->getAddr(COMPONENT_Y) + (iRowTop - (halfFilterSize - 1)) * iStride + iLeft;
+
+    for (Int fracX = 0; fracX < 4; fracX++)
+    {
+      m_if.filterHor(COMPONENT_Y, srcPtr, iStride, &tmp[0], iWidth, iWidth, iHeight + filterSize - 1, fracX, false, chFmt, bitDepth);
+
+      for (Int fracY = 0; fracY < 4; fracY++)
+      {
+        if ((fracY|fracX) == 0)
+        {
+          continue;
+        }
+        Pel *dstPtr = pcRefPic->getPicYuvSubPel(fracY, fracX)->getAddr(COMPONENT_Y) + iRowTop * iStride + iLeft;
+        m_if.filterVer(COMPONENT_Y, &tmp[(halfFilterSize - 1) * iWidth], iWidth, dstPtr, iStride, iWidth, iHeight, fracY, false, true, chFmt, bitDepth);
+      }
+    }
+    pcRefPic->setSubPelRowValid(ctuRow);
+  }
+}
+
+
+/** Hierarchical motion search of a CTU.
+ * For each reference picture, the CTU is searched exhaustively in the quarter-resolution pictures around the zero
+ * vector and the result is refined in the half-resolution pictures. The integer-sample vector found is then tested
+ * as a start point of the TZ search of every prediction unit of the CTU.
+ * \param pCtu CTU to be searched, whose original and reference pictures hold the downscaled planes
+ */
+Void TEncSearch::hierarchicalMotionSearch( TComDataCU* pCtu )
+{
+  TComPic          *pcPic     = pCtu->getPic();
+  const TComSlice  *pcSlice   = pCtu->getSlice();
+  const TComSPS    &sps       = *(pcSlice->getSPS());
+  const Int         iBitDepth = sps.getBitDepth(CHANNEL_TYPE_LUMA);
+  const Int         iPosX     = pCtu->getCUPelX();
+  const Int         iPosY     = pCtu->getCUPelY();
+  const Int         iWidth    = std::min<Int>(sps.getMaxCUWidth(),  sps.getPicWidthInLumaSamples()  - iPosX);
+  const Int         iHeight   = std::min<Int>(sps.getMaxCUHeight(), sps.getPicHeightInLumaSamples() - iPosY);
+  const Int         coarsest  = TComPic::NUM_LOW_RES_LEVELS - 1;
+
+  for (Int iRefList = 0; iRefList < (pcSlice->isInterB() ? 2 : 1); iRefList++)
+  {
+    const RefPicList eRefPicList = RefPicList(iRefList);
+
+    for (Int iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx(eRefPicList); iRefIdx++)
+    {
+      const Int iList0Idx = (eRefPicList == REF_PIC_LIST_1) ? pcSlice->getList1IdxToList0Idx( iRefIdx ) : -1;
+      if ( iList0Idx >= 0 && m_aaiAdaptSR[REF_PIC_LIST_1][iRefIdx] == m_aaiAdaptSR[REF_PIC_LIST_0][iList0Idx] )
+      {
+        // the picture has already been searched as a list 0 reference
+        m_hierarchicalMv[REF_PIC_LIST_1][iRefIdx] = m_hierarchicalMv[REF_PIC_LIST_0][iList0Idx];
+        continue;
+      }
+
+      const TComPic *pcRefPic = pcSlice->getRefPic(eRefPicList, iRefIdx);
+      TComMv         cMv( 0, 0 );
+
+      for (Int level = coarsest; level >= 0; level--)
+      {
+        const Int iShift = level + 1;
+        // the quarter-resolution search covers the search range, the finer levels correct the rounding of the coarser one
+        const Int iRange = (level == coarsest) ? (m_aaiAdaptSR[iRefList][iRefIdx] + (1 << iShift) - 1) >> iShift : 2;
+
+        xLowResBlockSearch( pcPic->getPicYuvLowRes(TComPic::PIC_YUV_ORG, level), pcRefPic->getPicYuvLowRes(TComPic::PIC_YUV_REC, level),
+                            iPosX >> iShift, iPosY >> iShift, (iWidth + (1 << iShift) - 1) >> iShift, (iHeight + (1 << iShift) - 1) >> iShift,
+                            iRange, iRange, iBitDepth, cMv );
+        cMv <<= 1;
+      }
+      m_hierarchicalMv[iRefList][iRefIdx] = cMv;
+    }
+  }
+}
+
+/** Exhaustive SAD search of a block of a downscaled picture.
+ * The search is limited to the positions whose samples lie inside the picture buffer of the reference.
+ * \param pcOrg    downscaled original picture
+ * \param pcRef    downscaled reference picture at the same resolution
+ * \param iPosX    horizontal position of the block
+ * \param iPosY    vertical position of the block
+ * \param iWidth   block width
+ * \param iHeight  block height
+ * \param iRangeX  horizontal search range around rcMv
+ * \param iRangeY  vertical search range around rcMv
+ * \param iBitDepth luma bit depth
+ * \param rcMv     centre of the search on input, best vector on output
+ */
+Void TEncSearch::xLowResBlockSearch( TComPicYuv* pcOrg, TComPicYuv* pcRef, Int iPosX, Int iPosY, Int iWidth, Int iHeight,
+                                     Int iRangeX, Int iRangeY, Int iBitDepth, TComMv& rcMv )
+{
+  const Int  iLimitLeft   = -pcRef->getMarginX(COMPONENT_Y) - iPosX;
+  const Int  iLimitRight  = pcRef->getWidth(COMPONENT_Y)  + pcRef->getMarginX(COMPONENT_Y) - iWidth  - iPosX;
+  const Int  iLimitTop    = -pcRef->getMarginY(COMPONENT_Y) - iPosY;
+  const Int  iLimitBottom = pcRef->getHeight(COMPONENT_Y) + pcRef->getMarginY(COMPONENT_Y) - iHeight - iPosY;
+  // a vector scaled up from a coarser level may point further into the margin than this level provides
+  const Int  iCentreX     = Clip3(iLimitLeft, iLimitRight,  rcMv.getHor());
+  const Int  iCentreY     = Clip3(iLimitTop,  iLimitBottom, rcMv.getVer());
+  const Int  iMinX        = std::max(iCentreX - iRangeX, iLimitLeft);
+  const Int  iMaxX        = std::min(iCentreX + iRangeX, iLimitRight);
+  const Int  iMinY        = std::max(iCentreY - iRangeY, iLimitTop);
+  const Int  iMaxY        = std::min(iCentreY + iRangeY, iLimitBottom);
+  const Int  iRefStride   = pcRef->getStride(COMPONENT_Y);
+  const Pel *piRef        = pcRef->getAddr(COMPONENT_Y) + iPosY * iRefStride + iPosX;
+
+  DistParam cDistParam;
+  m_pcRdCost->setDistParam( cDistParam, iBitDepth, pcOrg->getAddr(COMPONENT_Y) + iPosY * pcOrg->getStride(COMPONENT_Y) + iPosX, pcOrg->getStride(COMPONENT_Y),
+                            piRef, iRefStride, iWidth, iHeight );
+
+  // the centre is tested first so that it is kept on ties
+  Int        iBestX    = iCentreX;
+  Int        iBestY    = iCentreY;
+  cDistParam.pCur      = piRef + iBestY * iRefStride + iBestX;
+  Distortion uiSadBest = cDistParam.DistFunc( &cDistParam );
+
+  for (Int y = iMinY; y <= iMaxY; y++)
+  {
+    for (Int x = iMinX; x <= iMaxX; x++)
+    {
+      cDistParam.pCur = piRef + y * iRefStride + x;
+      cDistParam.m_maximumDistortionForEarlyExit = uiSadBest;
+      const Distortion uiSad = cDistParam.DistFunc( &cDistParam );
+      if (uiSad < uiSadBest)
+      {
+        uiSadBest = uiSad;
+        iBestX    = x;
+        iBestY    = y;
+      }
+    }
+  }
+  rcMv.set( iBestX, iBestY );
+}
+
+/** Start vector of the integer search derived from the lookahead pre-analysis.
+ * The vector of the block covering the centre of the prediction unit points to the previous picture in input order
+ * and is scaled by the POC distance to the reference picture.
+ * \param pcCU         current CU
+ * \param iPartIdx     index of the prediction unit
+ * \param eRefPicList  reference picture list
+ * \param iRefIdx      reference index
+ * \param rcMv         integer-sample start vector on output
+ * \returns true if the pre-analysis of the current picture provides a vector
+ */
+Bool TEncSearch::xGetLookaheadStartMv( const TComDataCU* const pcCU, Int iPartIdx, RefPicList eRefPicList, Int iRefIdx, TComMv& rcMv ) const
+{
+  const TEncPic* pcEPic = dynamic_cast<const TEncPic*>( pcCU->getPic() );
+  if ( pcEPic == NULL || !pcEPic->getLookaheadValid() || !pcEPic->getLookaheadHasInter() )
+  {
+    return false;
+  }
+
+  Int iPosX, iPosY, iWidth, iHeight;
+  pcCU->getPartPosition( iPartIdx, iPosX, iPosY, iWidth, iHeight );
+  const Int iBlkX = std::min( ( iPosX + ( iWidth  >> 1 ) ) / LOOKAHEAD_BLOCK_SIZE, pcEPic->getLookaheadWidthInBlocks()  - 1 );
+  const Int iBlkY = std::min( ( iPosY + ( iHeight >> 1 ) ) / LOOKAHEAD_BLOCK_SIZE, pcEPic->getLookaheadHeightInBlocks() - 1 );
+
+  const Int iPocDist = pcCU->getSlice()->getPOC() - pcCU->getSlice()->getRefPOC( eRefPicList, iRefIdx );
+  const TComMv& cMv  = pcEPic->getLookaheadBlock( iBlkX, iBlkY ).m_mv;
+  rcMv.set( cMv.getHor() * iPocDist, cMv.getVer() * iPocDist );
+  return true;
 }
 
 
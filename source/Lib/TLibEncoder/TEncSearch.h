@@ -116,6 +116,7 @@ protected:
   UInt            m_auiMVPIdxCost[AMVP_MAX_NUM_CANDS+1][AMVP_MAX_NUM_CANDS+1]; //th array bounds
 
   TComMv          m_integerMv2Nx2N[NUM_REF_PIC_LIST_01][MAX_NUM_REF];
+  TComMv          m_hierarchicalMv[NUM_REF_PIC_LIST_01][MAX_NUM_REF]; ///< integer-sample vector of the current CTU found on the downscaled pictures
 
   Bool            m_isInitialized;
 public:
@@ -142,7 +143,8 @@ protected:
   /// sub-function for motion vector refinement used in fractional-pel accuracy
   Distortion  xPatternRefinement( TComPattern* pcPatternKey,
                                   TComMv baseRefMv,
-                                  Int iFrac, TComMv& rcMvFrac, Bool bAllowUseOfHadamard
+                                  Int iFrac, TComMv& rcMvFrac, Bool bAllowUseOfHadamard,
+                                  Pel* const* apiSubPelRef = NULL, Int iSubPelStride = 0
                                  );
 
   typedef struct
@@ -205,6 +207,9 @@ public:
                                   Bool        bSkipResidual
                                   DEBUG_STRING_FN_DECLARE(sDebug) );
 
+  /// hierarchical ME - search the downscaled pictures for a start vector of each reference picture of the CTU
+  Void hierarchicalMotionSearch ( TComDataCU* pCtu );
+
   /// set ME search range
   Void setAdaptiveSearchRange   ( Int iDir, Int iRefIdx, Int iSearchRange) { assert(iDir < MAX_NUM_REF_LIST_ADAPT_SR && iRefIdx<Int(MAX_IDX_ADAPT_SR)); m_aaiAdaptSR[iDir][iRefIdx] = iSearchRange; }
 
@@ -294,6 +299,11 @@ protected:
   Void  xStoreIntraResultQT       ( const ComponentID compID, TComTU &rTu);
   Void  xLoadIntraResultQT        ( const ComponentID compID, TComTU &rTu);
 
+  Void  xEstimateIntraModeDistLuma( TComTU      &rTu,
+                                    const Pel*   piOrg,
+                                    const Int    iOrgStride,
+                                    Distortion   auiDist[NUM_INTRA_MODE] );
+
 
   // -------------------------------------------------------------------------------------------------------------------
   // Inter search (AMP)
@@ -378,6 +388,8 @@ protected:
                                     TComMv&                  rcMv,
                                     Distortion&              ruiSAD,
                                     const TComMv* const      pIntegerMv2Nx2NPred,
+                                    const TComMv* const      pcExtraStartMvs,
+                                    const Int                iNumExtraStartMvs,
                                     const Bool               bExtendedSettings
                                     );
 
@@ -389,7 +401,9 @@ protected:
                                     const TComMv* const      pcMvSrchRngRB,
                                     TComMv&                  rcMv,
                                     Distortion&              ruiSAD,
-                                    const TComMv* const      pIntegerMv2Nx2NPred
+                                    const TComMv* const      pIntegerMv2Nx2NPred,
+                                    const TComMv* const      pcExtraStartMvs,
+                                    const Int                iNumExtraStartMvs
                                     );
 
   Void xSetSearchRange            ( const TComDataCU* const pcCU,
@@ -415,7 +429,9 @@ protected:
                                     const TComMv* const      pcMvSrchRngRB,
                                     TComMv&                  rcMv,
                                     Distortion&              ruiSAD,
-                                    const TComMv* const      pIntegerMv2Nx2NPred
+                                    const TComMv* const      pIntegerMv2Nx2NPred,
+                                    const TComMv* const      pcExtraStartMvs,
+                                    const Int                iNumExtraStartMvs
                                   );
 
   Void xPatternSearch             ( const TComPattern* const pcPatternKey,
@@ -434,12 +450,20 @@ protected:
                                     TComMv*      pcMvInt,
                                     TComMv&      rcMvHalf,
                                     TComMv&      rcMvQter,
-                                    Distortion&  ruiCost
+                                    Distortion&  ruiCost,
+                                    TComPic*     pcRefPic
                                    );
 
   Void xExtDIFUpSamplingH( TComPattern* pcPattern );
   Void xExtDIFUpSamplingQ( TComPattern* pcPatternKey, TComMv halfPelRef );
 
+  Bool xGetSubPelRef              ( TComPic* pcRefPic, const Pel* piRefY, Int iWidth, Int iHeight, Pel* apiSubPelRef[16] );
+  Void xFillSubPelPlanes          ( TComPic* pcRefPic, Int iTop, Int iBottom );
+
+  Void xLowResBlockSearch         ( TComPicYuv* pcOrg, TComPicYuv* pcRef, Int iPosX, Int iPosY, Int iWidth, Int iHeight,
+                                    Int iRangeX, Int iRangeY, Int iBitDepth, TComMv& rcMv );
+  Bool xGetLookaheadStartMv       ( const TComDataCU* const pcCU, Int iPartIdx, RefPicList eRefPicList, Int iRefIdx, TComMv& rcMv ) const;
+
   // -------------------------------------------------------------------------------------------------------------------
   // T & Q & Q-1 & T-1
   // -------------------------------------------------------------------------------------------------------------------
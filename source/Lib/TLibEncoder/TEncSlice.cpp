@@ -38,6 +38,7 @@
 #include "TEncTop.h"
 #include "TEncSlice.h"
 #include <math.h>
+#include <algorithm>
 
 //! \ingroup TLibEncoder
 //! \{
@@ -48,6 +49,7 @@
 
 TEncSlice::TEncSlice()
  : m_encCABACTableIdx(I_SLICE)
+ , m_pcThreadPool    (NULL)
 {
 }
 
@@ -74,6 +76,12 @@ Void TEncSlice::destroy()
   m_vdRdPicLambda.clear();
   m_vdRdPicQp.clear();
   m_viRdPicQp.clear();
+
+  for ( UInt rowIdx = 0; rowIdx < m_apcWavefrontSyncContextStates.size(); rowIdx++ )
+  {
+    delete m_apcWavefrontSyncContextStates[rowIdx];
+  }
+  m_apcWavefrontSyncContextStates.clear();
 }
 
 Void TEncSlice::init( TEncTop* pcEncTop )
@@ -99,6 +107,36 @@ Void TEncSlice::init( TEncTop* pcEncTop )
   m_vdRdPicQp.resize(    m_pcCfg->getDeltaQpRD() * 2 + 1 );
   m_viRdPicQp.resize(    m_pcCfg->getDeltaQpRD() * 2 + 1 );
   m_pcRateCtrl        = pcEncTop->getRateCtrl();
+
+  m_pcThreadPool      = pcEncTop->getThreadPool();
+  m_apcCtuWorkers.clear();
+  for ( Int workerIdx = 0; workerIdx < pcEncTop->getNumCtuWorkers(); workerIdx++ )
+  {
+    m_apcCtuWorkers.push_back( pcEncTop->getCtuWorker( workerIdx ) );
+  }
+}
+
+/** Initialise with the processing units of a worker context instead of those of TEncTop, so that several pictures can
+ * be compressed and entropy coded concurrently. The CTUs are then processed by the calling thread only.
+ */
+Void TEncSlice::init( TEncTop* pcEncTop, TEncCtuWorker* pcCtuWorker )
+{
+  init( pcEncTop );
+
+  m_pcCuEncoder       = pcCtuWorker->getCuEncoder();
+  m_pcPredSearch      = pcCtuWorker->getPredSearch();
+
+  m_pcEntropyCoder    = pcCtuWorker->getEntropyCoder();
+  m_pcSbacCoder       = pcCtuWorker->getSbacCoder();
+  m_pcBinCABAC        = pcCtuWorker->getBinCABAC();
+  m_pcTrQuant         = pcCtuWorker->getTrQuant();
+
+  m_pcRdCost          = pcCtuWorker->getRdCost();
+  m_pppcRDSbacCoder   = pcCtuWorker->getRDSbacCoder();
+  m_pcRDGoOnSbacCoder = pcCtuWorker->getRDGoOnSbacCoder();
+
+  m_pcThreadPool      = NULL;
+  m_apcCtuWorkers.clear();
 }
 
 Void TEncSlice::updateLambda(TComSlice* pSlice, Double dQP)
@@ -560,6 +598,10 @@ Void TEncSlice::setSearchRange( TComSlice* pcSlice )
       iRefPOC = pcSlice->getRefPic(e, iRefIdx)->getPOC();
       Int newSearchRange = Clip3(m_pcCfg->getMinSearchWindow(), iMaxSR, (iMaxSR*ADAPT_SR_SCALE*abs(iCurrPOC - iRefPOC)+iOffset)/iGOPSize);
       m_pcPredSearch->setAdaptiveSearchRange(iDir, iRefIdx, newSearchRange);
+      for ( UInt workerIdx = 0; workerIdx < m_apcCtuWorkers.size(); workerIdx++ )
+      {
+        m_apcCtuWorkers[workerIdx]->getPredSearch()->setAdaptiveSearchRange(iDir, iRefIdx, newSearchRange);
+      }
     }
   }
 }
@@ -787,6 +829,12 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
     }
   }
 
+  if ( xUseParallelCompression( pcPic, pcSlice, bCompressEntireSlice ) )
+  {
+    xCompressSliceParallel( pcPic, startCtuTsAddr, boundingCtuTsAddr, bFastDeltaQP );
+    startCtuTsAddr = boundingCtuTsAddr; // all CTUs have been compressed by the worker threads: skip the loop below
+  }
+
   // for every CTU in the slice segment (may terminate sooner if there is a byte limit on the slice-segment)
 
   for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
@@ -982,6 +1030,394 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
   //}
 }
 
+/** Check whether the CTUs of a slice segment can be compressed by the worker threads.
+ * Rate control, byte-limited slices, adaptive QP selection and the luma-level-dependent QP update the state of
+ * the main processing units from one CTU to the next, so the serial loop is used for them.
+ */
+Bool TEncSlice::xUseParallelCompression( const TComPic* pcPic, const TComSlice* pcSlice, const Bool bCompressEntireSlice ) const
+{
+  if ( m_apcCtuWorkers.empty() )
+  {
+    return false;
+  }
+  if ( !m_pcCfg->getEntropyCodingSyncEnabledFlag() && pcPic->getPicSym()->getNumTiles() < 2 )
+  {
+    return false;
+  }
+  if ( m_pcCfg->getUseRateCtrl() || m_pcCfg->getLumaLevelToDeltaQPMapping().isEnabled() )
+  {
+    return false;
+  }
+#if ADAPTIVE_QP_SELECTION
+  if ( m_pcCfg->getUseAdaptQpSelect() )
+  {
+    return false;
+  }
+#endif
+  if ( pcSlice->getSliceMode()==FIXED_NUMBER_OF_BYTES || ( !bCompressEntireSlice && pcSlice->getSliceSegmentMode()==FIXED_NUMBER_OF_BYTES ) )
+  {
+    return false;
+  }
+  return true;
+}
+
+/** Check whether the substreams of a slice segment can be entropy coded by the worker threads.
+ */
+Bool TEncSlice::xUseParallelEncoding( const TComPic* pcPic ) const
+{
+#if ENC_DEC_TRACE
+  return false;
+#else
+  return !m_apcCtuWorkers.empty() && ( m_pcCfg->getEntropyCodingSyncEnabledFlag() || pcPic->getPicSym()->getNumTiles() > 1 );
+#endif
+}
+
+/** Split a slice segment into the parts of its substreams: a new part starts with each tile, and with each CTU row
+ * of a tile when wavefronts are enabled. The CTUs of a part continue the same CABAC state.
+ * \param pcPic                 picture class
+ * \param startCtuTsAddr        first CTU of the slice segment
+ * \param boundingCtuTsAddr     end of the slice segment (exclusive)
+ * \param substreamStartCtuTsAddr returns the first CTU of each part, followed by boundingCtuTsAddr
+ */
+Void TEncSlice::xDetermineSubstreamStartCtuTsAddrs( const TComPic* pcPic, const UInt startCtuTsAddr, const UInt boundingCtuTsAddr, std::vector<UInt>& substreamStartCtuTsAddr )
+{
+  const TComPicSym* const pcPicSym   = pcPic->getPicSym();
+  const UInt       frameWidthInCtus  = pcPicSym->getFrameWidthInCtus();
+  const Bool       wavefrontsEnabled = m_pcCfg->getEntropyCodingSyncEnabledFlag();
+
+  substreamStartCtuTsAddr.clear();
+  for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ctuTsAddr++ )
+  {
+    const UInt ctuRsAddr            = pcPicSym->getCtuTsToRsAddrMap(ctuTsAddr);
+    const UInt firstCtuRsAddrOfTile = pcPicSym->getTComTile(pcPicSym->getTileIdxMap(ctuRsAddr))->getFirstCtuRsAddr();
+    if ( ctuTsAddr == startCtuTsAddr || ctuRsAddr == firstCtuRsAddrOfTile ||
+         ( wavefrontsEnabled && ctuRsAddr % frameWidthInCtus == firstCtuRsAddrOfTile % frameWidthInCtus ) )
+    {
+      substreamStartCtuTsAddr.push_back( ctuTsAddr );
+    }
+  }
+  substreamStartCtuTsAddr.push_back( boundingCtuTsAddr );
+
+  const UInt numSubstreams = UInt(substreamStartCtuTsAddr.size() - 1);
+  while ( m_apcWavefrontSyncContextStates.size() < numSubstreams )
+  {
+    m_apcWavefrontSyncContextStates.push_back( new TEncSbac );
+  }
+}
+
+/** Compress the CTUs of a slice segment on the worker threads.
+ * Each tile, or each CTU row of a tile when wavefronts are enabled, is compressed by one job. With wavefronts, a
+ * CTU is only started once the row above has finished its top-right neighbour, and the context synchronisation of
+ * the serial loop is reproduced per row, so that the decisions (and therefore the bitstream) are identical to those
+ * of the serial loop.
+ * \param pcPic             picture class
+ * \param startCtuTsAddr    first CTU of the slice segment
+ * \param boundingCtuTsAddr end of the slice segment (exclusive)
+ * \param bFastDeltaQP      fast delta-QP mode of the CU encoder
+ */
+Void TEncSlice::xCompressSliceParallel( TComPic* pcPic, const UInt startCtuTsAddr, const UInt boundingCtuTsAddr, const Bool bFastDeltaQP )
+{
+  TComSlice* const pcSlice           = pcPic->getSlice(getSliceIdx());
+  TComPicSym* const pcPicSym         = pcPic->getPicSym();
+  const UInt       frameWidthInCtus  = pcPicSym->getFrameWidthInCtus();
+  const Bool       wavefrontsEnabled = m_pcCfg->getEntropyCodingSyncEnabledFlag();
+
+  std::vector<UInt> substreamStartCtuTsAddr;
+  xDetermineSubstreamStartCtuTsAddrs( pcPic, startCtuTsAddr, boundingCtuTsAddr, substreamStartCtuTsAddr );
+  const Int numSubstreams = Int(substreamStartCtuTsAddr.size()) - 1;
+
+  // a row has completed all CTUs left of its first one: those belong to previous slice segments
+  m_wavefrontSync.create( numSubstreams, -1 );
+  std::vector<Int>  hasSyncState( numSubstreams, 0 ); // not std::vector<Bool>: its elements are written concurrently
+  for( Int substreamIdx = 0; substreamIdx < numSubstreams; substreamIdx++ )
+  {
+    const UInt ctuRsAddr = pcPicSym->getCtuTsToRsAddrMap( substreamStartCtuTsAddr[substreamIdx] );
+    m_wavefrontSync.setProgress( substreamIdx, Int(ctuRsAddr % frameWidthInCtus) - 1 );
+  }
+
+  for( UInt workerIdx = 0; workerIdx < m_apcCtuWorkers.size(); workerIdx++ )
+  {
+    m_apcCtuWorkers[workerIdx]->initSlice( pcSlice, *m_pcRdCost, bFastDeltaQP );
+  }
+
+  // initialise all CTUs first: the availability checks of a CTU read the slice of its neighbours in other substreams
+  for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ctuTsAddr++ )
+  {
+    const UInt ctuRsAddr = pcPicSym->getCtuTsToRsAddrMap(ctuTsAddr);
+    pcPic->getCtu( ctuRsAddr )->initCtu( pcPic, ctuRsAddr );
+  }
+
+  std::vector<Int> ctuWrittenBits( boundingCtuTsAddr - startCtuTsAddr, 0 );
+
+  for( Int substreamIdx = 0; substreamIdx < numSubstreams; substreamIdx++ )
+  {
+    m_pcThreadPool->addJob( [=, &substreamStartCtuTsAddr, &hasSyncState, &ctuWrittenBits]( Int threadIdx )
+    {
+      TEncCtuWorker* const pcWorker       = m_apcCtuWorkers[threadIdx];
+      TEncEntropy*   const pcEntropyCoder = pcWorker->getEntropyCoder();
+      TEncSbac*      const pcCurrBest     = pcWorker->getRDSbacCoder()[0][CI_CURR_BEST];
+      TEncSbac*      const pcRDGoOn       = pcWorker->getRDGoOnSbacCoder();
+      TEncBinCABAC*  const pRDSbacCoder   = (TEncBinCABAC *) pcCurrBest->getEncBinIf();
+      TComBitCounter       tempBitCounter;
+
+      for( UInt ctuTsAddr = substreamStartCtuTsAddr[substreamIdx]; ctuTsAddr < substreamStartCtuTsAddr[substreamIdx+1]; ctuTsAddr++ )
+      {
+        const UInt ctuRsAddr = pcPicSym->getCtuTsToRsAddrMap(ctuTsAddr);
+        const TComTile &currentTile = *(pcPicSym->getTComTile(pcPicSym->getTileIdxMap(ctuRsAddr)));
+        const UInt firstCtuRsAddrOfTile = currentTile.getFirstCtuRsAddr();
+        const UInt tileXPosInCtus = firstCtuRsAddrOfTile % frameWidthInCtus;
+        const UInt ctuXPosInCtus  = ctuRsAddr % frameWidthInCtus;
+
+        // wait for the top-right CTU (the previous substream is the row above, unless this row starts the tile)
+        if ( wavefrontsEnabled && substreamIdx > 0 && ctuRsAddr >= firstCtuRsAddrOfTile + frameWidthInCtus )
+        {
+          m_wavefrontSync.waitForProgress( substreamIdx-1, Int(std::min( ctuXPosInCtus+1, tileXPosInCtus+currentTile.getTileWidthInCtus()-1 )) );
+        }
+
+        TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
+
+        // update CABAC state
+        if ( ctuTsAddr == substreamStartCtuTsAddr[substreamIdx] )
+        {
+          if (ctuRsAddr == firstCtuRsAddrOfTile)
+          {
+            pcCurrBest->resetEntropy(pcSlice);
+          }
+          else if ( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
+          {
+            // reset and then update contexts to the state at the end of the top-right CTU (if within current slice and tile).
+            pcCurrBest->resetEntropy(pcSlice);
+            TComDataCU *pCtuUp = pCtu->getCtuAbove();
+            if ( pCtuUp && ((ctuRsAddr%frameWidthInCtus+1) < frameWidthInCtus)  )
+            {
+              TComDataCU *pCtuTR = pcPic->getCtu( ctuRsAddr - frameWidthInCtus + 1 );
+              if ( pCtu->CUIsFromSameSliceAndTile(pCtuTR) )
+              {
+                // the top-right CTU was compressed either by the row above, or during a previous slice segment
+                pcCurrBest->loadContexts( substreamIdx > 0 && hasSyncState[substreamIdx-1] ? m_apcWavefrontSyncContextStates[substreamIdx-1] : &m_entropyCodingSyncContextState );
+              }
+            }
+          }
+          else
+          {
+            // the slice segment starts within a tile (or within a CTU row)
+            pcCurrBest->load( m_pppcRDSbacCoder[0][CI_CURR_BEST] );
+          }
+          pRDSbacCoder->setBinCountingEnableFlag( false );
+          pRDSbacCoder->setBinsCoded( 0 );
+        }
+
+        // set go-on entropy coder (used for all trial encodings)
+        pcEntropyCoder->setEntropyCoder ( pcRDGoOn );
+        pcEntropyCoder->setBitstream( &tempBitCounter );
+        tempBitCounter.resetBits();
+        pcRDGoOn->load( pcCurrBest );
+
+        ((TEncBinCABAC*)pcRDGoOn->getEncBinIf())->setBinCountingEnableFlag(true);
+
+        // run CTU trial encoder
+        pcWorker->getCuEncoder()->compressCtu( pCtu );
+
+        // encode CTU and calculate the true bit counters.
+        pcEntropyCoder->setEntropyCoder ( pcCurrBest );
+        pcEntropyCoder->setBitstream( &tempBitCounter );
+        pRDSbacCoder->setBinCountingEnableFlag( true );
+        pcCurrBest->resetBits();
+        pRDSbacCoder->setBinsCoded( 0 );
+
+        pcWorker->getCuEncoder()->encodeCtu( pCtu );
+
+        pRDSbacCoder->setBinCountingEnableFlag( false );
+
+        ctuWrittenBits[ctuTsAddr - startCtuTsAddr] = pcEntropyCoder->getNumberOfWrittenBits();
+
+        // Store probabilities of second CTU in line into buffer
+        if ( ctuXPosInCtus == tileXPosInCtus+1 && wavefrontsEnabled )
+        {
+          m_apcWavefrontSyncContextStates[substreamIdx]->loadContexts( pcCurrBest );
+          hasSyncState[substreamIdx] = 1;
+        }
+        if ( ctuTsAddr+1 == boundingCtuTsAddr )
+        {
+          m_parallelEndContextState.loadContexts( pcCurrBest );
+        }
+
+        m_wavefrontSync.setProgress( substreamIdx, Int(ctuXPosInCtus) );
+      }
+
+      pcCurrBest->setBitstream(NULL);
+      pcRDGoOn->setBitstream(NULL);
+    } );
+  }
+
+  m_pcThreadPool->waitForAll();
+
+  // accumulate the statistics in coding order, as in the serial loop
+  for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ctuTsAddr++ )
+  {
+    TComDataCU* pCtu = pcPic->getCtu( pcPicSym->getCtuTsToRsAddrMap(ctuTsAddr) );
+    const Int numberOfWrittenBits = ctuWrittenBits[ctuTsAddr - startCtuTsAddr];
+
+    pcSlice->setSliceBits( (UInt)(pcSlice->getSliceBits() + numberOfWrittenBits) );
+    pcSlice->setSliceSegmentBits(pcSlice->getSliceSegmentBits()+numberOfWrittenBits);
+
+    m_uiPicTotalBits += pCtu->getTotalBits();
+    m_dPicRdCost     += pCtu->getTotalCost();
+    m_uiPicDist      += pCtu->getTotalDistortion();
+  }
+
+  // hand the context states over to the next slice segment
+  for( Int substreamIdx = numSubstreams-1; substreamIdx >= 0; substreamIdx-- )
+  {
+    if ( hasSyncState[substreamIdx] )
+    {
+      m_entropyCodingSyncContextState.loadContexts( m_apcWavefrontSyncContextStates[substreamIdx] );
+      break;
+    }
+  }
+  m_pppcRDSbacCoder[0][CI_CURR_BEST]->loadContexts( &m_parallelEndContextState );
+}
+
+/** Entropy code the substreams of a slice segment on the worker threads, each with its own SBAC encoder.
+ * With wavefronts, a row only starts once the row above has stored its synchronisation contexts.
+ * The substream sizes are added to the slice in coding order once all substreams are complete.
+ * \param pcPic         picture class
+ * \param pcSubstreams  substreams of the picture
+ * \param numBinsCoded  returns the number of bins coded in the slice segment
+ */
+Void TEncSlice::xEncodeSliceParallel( TComPic* pcPic, TComOutputBitstream* pcSubstreams, UInt &numBinsCoded )
+{
+  TComSlice *const pcSlice           = pcPic->getSlice(getSliceIdx());
+  TComPicSym* const pcPicSym         = pcPic->getPicSym();
+  const UInt startCtuTsAddr          = pcSlice->getSliceSegmentCurStartCtuTsAddr();
+  const UInt boundingCtuTsAddr       = pcSlice->getSliceSegmentCurEndCtuTsAddr();
+  const UInt frameWidthInCtus        = pcPicSym->getFrameWidthInCtus();
+  const Bool wavefrontsEnabled       = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag();
+
+  std::vector<UInt> substreamStartCtuTsAddr;
+  xDetermineSubstreamStartCtuTsAddrs( pcPic, startCtuTsAddr, boundingCtuTsAddr, substreamStartCtuTsAddr );
+  const Int numSubstreams = Int(substreamStartCtuTsAddr.size()) - 1;
+
+  m_wavefrontSync.create( numSubstreams, -1 );
+  std::vector<Int>  hasSyncState( numSubstreams, 0 ); // not std::vector<Bool>: its elements are written concurrently
+  std::vector<UInt> substreamBinsCoded( numSubstreams, 0 );
+
+  for( Int substreamIdx = 0; substreamIdx < numSubstreams; substreamIdx++ )
+  {
+    m_pcThreadPool->addJob( [=, &substreamStartCtuTsAddr, &hasSyncState, &substreamBinsCoded]( Int threadIdx )
+    {
+      TEncCtuWorker* const pcWorker       = m_apcCtuWorkers[threadIdx];
+      TEncEntropy*   const pcEntropyCoder = pcWorker->getEntropyCoder();
+      TEncSbac*      const pcSbacCoder    = pcWorker->getSbacCoder();
+      TEncBinCABAC*  const pcBinCABAC     = pcWorker->getBinCABAC();
+
+      const UInt firstCtuTsAddr       = substreamStartCtuTsAddr[substreamIdx];
+      const UInt firstCtuRsAddr       = pcPicSym->getCtuTsToRsAddrMap(firstCtuTsAddr);
+      const TComTile &currentTile     = *(pcPicSym->getTComTile(pcPicSym->getTileIdxMap(firstCtuRsAddr)));
+      const UInt firstCtuRsAddrOfTile = currentTile.getFirstCtuRsAddr();
+      const UInt tileXPosInCtus       = firstCtuRsAddrOfTile % frameWidthInCtus;
+      const UInt tileYPosInCtus       = firstCtuRsAddrOfTile / frameWidthInCtus;
+      const UInt uiSubStrm            = pcPic->getSubstreamForCtuAddr(firstCtuRsAddr, true, pcSlice);
+
+      pcEntropyCoder->setEntropyCoder ( pcSbacCoder );
+      pcEntropyCoder->setBitstream( &pcSubstreams[uiSubStrm] );
+      pcEntropyCoder->resetEntropy( pcSlice );
+      if ( substreamIdx == 0 )
+      {
+        // continue from the state prepared by encodeSlice (which covers dependent slice segments)
+        pcSbacCoder->loadContexts( m_pcSbacCoder );
+      }
+      pcBinCABAC->setBinCountingEnableFlag( true );
+      pcBinCABAC->setBinsCoded( 0 );
+
+      // Synchronize cabac probabilities with upper-right CTU if it's available and at the start of a line.
+      if ( wavefrontsEnabled && firstCtuRsAddr != firstCtuRsAddrOfTile && firstCtuRsAddr % frameWidthInCtus == tileXPosInCtus )
+      {
+        TComDataCU *pCtu   = pcPic->getCtu( firstCtuRsAddr );
+        TComDataCU *pCtuUp = pCtu->getCtuAbove();
+        if ( pCtuUp && ((firstCtuRsAddr%frameWidthInCtus+1) < frameWidthInCtus)  )
+        {
+          TComDataCU *pCtuTR = pcPic->getCtu( firstCtuRsAddr - frameWidthInCtus + 1 );
+          if ( pCtu->CUIsFromSameSliceAndTile(pCtuTR) )
+          {
+            if ( substreamIdx > 0 )
+            {
+              m_wavefrontSync.waitForProgress( substreamIdx-1, Int(tileXPosInCtus+1) );
+            }
+            pcSbacCoder->loadContexts( substreamIdx > 0 && hasSyncState[substreamIdx-1] ? m_apcWavefrontSyncContextStates[substreamIdx-1] : &m_entropyCodingSyncContextState );
+          }
+        }
+      }
+
+      for( UInt ctuTsAddr = firstCtuTsAddr; ctuTsAddr < substreamStartCtuTsAddr[substreamIdx+1]; ctuTsAddr++ )
+      {
+        const UInt ctuRsAddr     = pcPicSym->getCtuTsToRsAddrMap(ctuTsAddr);
+        const UInt ctuXPosInCtus = ctuRsAddr % frameWidthInCtus;
+        const UInt ctuYPosInCtus = ctuRsAddr / frameWidthInCtus;
+        TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
+
+        xEncodeSAOBlkParam( pcPic, pcEntropyCoder, ctuRsAddr );
+
+        pcWorker->getCuEncoder()->encodeCtu( pCtu );
+
+        //Store probabilities of second CTU in line into buffer
+        if ( ctuXPosInCtus == tileXPosInCtus+1 && wavefrontsEnabled)
+        {
+          m_apcWavefrontSyncContextStates[substreamIdx]->loadContexts( pcSbacCoder );
+          hasSyncState[substreamIdx] = 1;
+        }
+
+        // terminate the sub-stream, if required (end of slice-segment, end of tile, end of wavefront-CTU-row):
+        if (ctuTsAddr+1 == boundingCtuTsAddr ||
+             (  ctuXPosInCtus + 1 == tileXPosInCtus + currentTile.getTileWidthInCtus() &&
+              ( ctuYPosInCtus + 1 == tileYPosInCtus + currentTile.getTileHeightInCtus() || wavefrontsEnabled)
+             )
+           )
+        {
+          pcEntropyCoder->encodeTerminatingBit(1);
+          pcEntropyCoder->encodeSliceFinish();
+          // Byte-alignment in slice_data() when new tile
+          pcSubstreams[uiSubStrm].writeByteAlignment();
+        }
+        if ( ctuTsAddr+1 == boundingCtuTsAddr )
+        {
+          m_parallelEndContextState.loadContexts( pcSbacCoder );
+        }
+
+        m_wavefrontSync.setProgress( substreamIdx, Int(ctuXPosInCtus) );
+      }
+
+      substreamBinsCoded[substreamIdx] = pcBinCABAC->getBinsCoded();
+      pcEntropyCoder->setBitstream( NULL );
+    } );
+  }
+
+  m_pcThreadPool->waitForAll();
+
+  // write the sub-stream sizes in coding order
+  numBinsCoded = 0;
+  for( Int substreamIdx = 0; substreamIdx < numSubstreams; substreamIdx++ )
+  {
+    if ( substreamIdx+1 < numSubstreams )
+    {
+      const UInt uiSubStrm = pcPic->getSubstreamForCtuAddr( pcPicSym->getCtuTsToRsAddrMap( substreamStartCtuTsAddr[substreamIdx] ), true, pcSlice );
+      pcSlice->addSubstreamSize( (pcSubstreams[uiSubStrm].getNumberOfWrittenBits() >> 3) + pcSubstreams[uiSubStrm].countStartCodeEmulations() );
+    }
+    numBinsCoded += substreamBinsCoded[substreamIdx];
+  }
+
+  // hand the context states over to the next slice segment
+  for( Int substreamIdx = numSubstreams-1; substreamIdx >= 0; substreamIdx-- )
+  {
+    if ( hasSyncState[substreamIdx] )
+    {
+      m_entropyCodingSyncContextState.loadContexts( m_apcWavefrontSyncContextStates[substreamIdx] );
+      break;
+    }
+  }
+  m_pcSbacCoder->loadContexts( &m_parallelEndContextState );
+}
+
 Void TEncSlice::encodeSlice   ( TComPic* pcPic, TComOutputBitstream* pcSubstreams, UInt &numBinsCoded )
 {
   TComSlice *const pcSlice           = pcPic->getSlice(getSliceIdx());
@@ -1031,120 +1467,93 @@ Void TEncSlice::encodeSlice   ( TComPic* pcPic, TComOutputBitstream* pcSubstream
     }
   }
 
-  // for every CTU in the slice segment...
-
-  for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
+  if ( xUseParallelEncoding( pcPic ) )
   {
-    const UInt ctuRsAddr = pcPic->getPicSym()->getCtuTsToRsAddrMap(ctuTsAddr);
-    const TComTile &currentTile = *(pcPic->getPicSym()->getTComTile(pcPic->getPicSym()->getTileIdxMap(ctuRsAddr)));
-    const UInt firstCtuRsAddrOfTile = currentTile.getFirstCtuRsAddr();
-    const UInt tileXPosInCtus       = firstCtuRsAddrOfTile % frameWidthInCtus;
-    const UInt tileYPosInCtus       = firstCtuRsAddrOfTile / frameWidthInCtus;
-    const UInt ctuXPosInCtus        = ctuRsAddr % frameWidthInCtus;
-    const UInt ctuYPosInCtus        = ctuRsAddr / frameWidthInCtus;
-    const UInt uiSubStrm=pcPic->getSubstreamForCtuAddr(ctuRsAddr, true, pcSlice);
-    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
-
-    m_pcEntropyCoder->setBitstream( &pcSubstreams[uiSubStrm] );
+    xEncodeSliceParallel( pcPic, pcSubstreams, numBinsCoded );
+    m_pcBinCABAC->setBinsCoded( numBinsCoded );
+  }
+  else
+  {
+    // for every CTU in the slice segment...
 
-    // set up CABAC contexts' state for this CTU
-    if (ctuRsAddr == firstCtuRsAddrOfTile)
-    {
-      if (ctuTsAddr != startCtuTsAddr) // if it is the first CTU, then the entropy coder has already been reset
-      {
-        m_pcEntropyCoder->resetEntropy(pcSlice);
-      }
-    }
-    else if (ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled)
+    for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
     {
-      // Synchronize cabac probabilities with upper-right CTU if it's available and at the start of a line.
-      if (ctuTsAddr != startCtuTsAddr) // if it is the first CTU, then the entropy coder has already been reset
+      const UInt ctuRsAddr = pcPic->getPicSym()->getCtuTsToRsAddrMap(ctuTsAddr);
+      const TComTile &currentTile = *(pcPic->getPicSym()->getTComTile(pcPic->getPicSym()->getTileIdxMap(ctuRsAddr)));
+      const UInt firstCtuRsAddrOfTile = currentTile.getFirstCtuRsAddr();
+      const UInt tileXPosInCtus       = firstCtuRsAddrOfTile % frameWidthInCtus;
+      const UInt tileYPosInCtus       = firstCtuRsAddrOfTile / frameWidthInCtus;
+      const UInt ctuXPosInCtus        = ctuRsAddr % frameWidthInCtus;
+      const UInt ctuYPosInCtus        = ctuRsAddr / frameWidthInCtus;
+      const UInt uiSubStrm=pcPic->getSubstreamForCtuAddr(ctuRsAddr, true, pcSlice);
+      TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
+
+      m_pcEntropyCoder->setBitstream( &pcSubstreams[uiSubStrm] );
+
+      // set up CABAC contexts' state for this CTU
+      if (ctuRsAddr == firstCtuRsAddrOfTile)
       {
-        m_pcEntropyCoder->resetEntropy(pcSlice);
-      }
-      TComDataCU *pCtuUp = pCtu->getCtuAbove();
-      if ( pCtuUp && ((ctuRsAddr%frameWidthInCtus+1) < frameWidthInCtus)  )
-      {
-        TComDataCU *pCtuTR = pcPic->getCtu( ctuRsAddr - frameWidthInCtus + 1 );
-        if ( pCtu->CUIsFromSameSliceAndTile(pCtuTR) )
+        if (ctuTsAddr != startCtuTsAddr) // if it is the first CTU, then the entropy coder has already been reset
         {
-          // Top-right is available, so use it.
-          m_pcSbacCoder->loadContexts( &m_entropyCodingSyncContextState );
+          m_pcEntropyCoder->resetEntropy(pcSlice);
         }
       }
-    }
-
-
-    if ( pcSlice->getSPS()->getUseSAO() )
-    {
-      Bool bIsSAOSliceEnabled = false;
-      Bool sliceEnabled[MAX_NUM_COMPONENT];
-      for(Int comp=0; comp < MAX_NUM_COMPONENT; comp++)
+      else if (ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled)
       {
-        ComponentID compId=ComponentID(comp);
-        sliceEnabled[compId] = pcSlice->getSaoEnabledFlag(toChannelType(compId)) && (comp < pcPic->getNumberValidComponents());
-        if (sliceEnabled[compId])
+        // Synchronize cabac probabilities with upper-right CTU if it's available and at the start of a line.
+        if (ctuTsAddr != startCtuTsAddr) // if it is the first CTU, then the entropy coder has already been reset
         {
-          bIsSAOSliceEnabled=true;
+          m_pcEntropyCoder->resetEntropy(pcSlice);
         }
-      }
-      if (bIsSAOSliceEnabled)
-      {
-        SAOBlkParam& saoblkParam = (pcPic->getPicSym()->getSAOBlkParam())[ctuRsAddr];
-
-        Bool leftMergeAvail = false;
-        Bool aboveMergeAvail= false;
-        //merge left condition
-        Int rx = (ctuRsAddr % frameWidthInCtus);
-        if(rx > 0)
+        TComDataCU *pCtuUp = pCtu->getCtuAbove();
+        if ( pCtuUp && ((ctuRsAddr%frameWidthInCtus+1) < frameWidthInCtus)  )
         {
-          leftMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-1);
+          TComDataCU *pCtuTR = pcPic->getCtu( ctuRsAddr - frameWidthInCtus + 1 );
+          if ( pCtu->CUIsFromSameSliceAndTile(pCtuTR) )
+          {
+            // Top-right is available, so use it.
+            m_pcSbacCoder->loadContexts( &m_entropyCodingSyncContextState );
+          }
         }
+      }
 
-        //merge up condition
-        Int ry = (ctuRsAddr / frameWidthInCtus);
-        if(ry > 0)
-        {
-          aboveMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-frameWidthInCtus);
-        }
 
-        m_pcEntropyCoder->encodeSAOBlkParam(saoblkParam, pcPic->getPicSym()->getSPS().getBitDepths(), sliceEnabled, leftMergeAvail, aboveMergeAvail);
-      }
-    }
+      xEncodeSAOBlkParam( pcPic, m_pcEntropyCoder, ctuRsAddr );
 
 #if ENC_DEC_TRACE
-    g_bJustDoIt = g_bEncDecTraceEnable;
+      g_bJustDoIt = g_bEncDecTraceEnable;
 #endif
-      m_pcCuEncoder->encodeCtu( pCtu );
+        m_pcCuEncoder->encodeCtu( pCtu );
 #if ENC_DEC_TRACE
-    g_bJustDoIt = g_bEncDecTraceDisable;
+      g_bJustDoIt = g_bEncDecTraceDisable;
 #endif
 
-    //Store probabilities of second CTU in line into buffer
-    if ( ctuXPosInCtus == tileXPosInCtus+1 && wavefrontsEnabled)
-    {
-      m_entropyCodingSyncContextState.loadContexts( m_pcSbacCoder );
-    }
+      //Store probabilities of second CTU in line into buffer
+      if ( ctuXPosInCtus == tileXPosInCtus+1 && wavefrontsEnabled)
+      {
+        m_entropyCodingSyncContextState.loadContexts( m_pcSbacCoder );
+      }
 
-    // terminate the sub-stream, if required (end of slice-segment, end of tile, end of wavefront-CTU-row):
-    if (ctuTsAddr+1 == boundingCtuTsAddr ||
-         (  ctuXPosInCtus + 1 == tileXPosInCtus + currentTile.getTileWidthInCtus() &&
-          ( ctuYPosInCtus + 1 == tileYPosInCtus + currentTile.getTileHeightInCtus() || wavefrontsEnabled)
+      // terminate the sub-stream, if required (end of slice-segment, end of tile, end of wavefront-CTU-row):
+      if (ctuTsAddr+1 == boundingCtuTsAddr ||
+           (  ctuXPosInCtus + 1 == tileXPosInCtus + currentTile.getTileWidthInCtus() &&
+            ( ctuYPosInCtus + 1 == tileYPosInCtus + currentTile.getTileHeightInCtus() || wavefrontsEnabled)
+           )
          )
-       )
-    {
-      m_pcEntropyCoder->encodeTerminatingBit(1);
-      m_pcEntropyCoder->encodeSliceFinish();
-      // Byte-alignment in slice_data() when new tile
-      pcSubstreams[uiSubStrm].writeByteAlignment();
-
-      // write sub-stream size
-      if (ctuTsAddr+1 != boundingCtuTsAddr)
       {
-        pcSlice->addSubstreamSize( (pcSubstreams[uiSubStrm].getNumberOfWrittenBits() >> 3) + pcSubstreams[uiSubStrm].countStartCodeEmulations() );
+        m_pcEntropyCoder->encodeTerminatingBit(1);
+        m_pcEntropyCoder->encodeSliceFinish();
+        // Byte-alignment in slice_data() when new tile
+        pcSubstreams[uiSubStrm].writeByteAlignment();
+
+        // write sub-stream size
+        if (ctuTsAddr+1 != boundingCtuTsAddr)
+        {
+          pcSlice->addSubstreamSize( (pcSubstreams[uiSubStrm].getNumberOfWrittenBits() >> 3) + pcSubstreams[uiSubStrm].countStartCodeEmulations() );
+        }
       }
-    }
-  } // CTU-loop
+    } // CTU-loop
+  }
 
   if( depSliceSegmentsEnabled )
   {
@@ -1170,6 +1579,54 @@ Void TEncSlice::encodeSlice   ( TComPic* pcPic, TComOutputBitstream* pcSubstream
   numBinsCoded = m_pcBinCABAC->getBinsCoded();
 }
 
+/** Encode the SAO parameters of a CTU, if SAO is enabled for the slice.
+ * \param pcPic           picture class
+ * \param pcEntropyCoder  entropy coder used to write the parameters
+ * \param ctuRsAddr       raster-scan address of the CTU
+ */
+Void TEncSlice::xEncodeSAOBlkParam( TComPic* pcPic, TEncEntropy* pcEntropyCoder, const UInt ctuRsAddr )
+{
+  const TComSlice *const pcSlice    = pcPic->getSlice(getSliceIdx());
+  const UInt       frameWidthInCtus = pcPic->getPicSym()->getFrameWidthInCtus();
+
+  if ( pcSlice->getSPS()->getUseSAO() )
+  {
+    Bool bIsSAOSliceEnabled = false;
+    Bool sliceEnabled[MAX_NUM_COMPONENT];
+    for(Int comp=0; comp < MAX_NUM_COMPONENT; comp++)
+    {
+      ComponentID compId=ComponentID(comp);
+      sliceEnabled[compId] = pcSlice->getSaoEnabledFlag(toChannelType(compId)) && (comp < pcPic->getNumberValidComponents());
+      if (sliceEnabled[compId])
+      {
+        bIsSAOSliceEnabled=true;
+      }
+    }
+    if (bIsSAOSliceEnabled)
+    {
+      SAOBlkParam& saoblkParam = (pcPic->getPicSym()->getSAOBlkParam())[ctuRsAddr];
+
+      Bool leftMergeAvail = false;
+      Bool aboveMergeAvail= false;
+      //merge left condition
+      Int rx = (ctuRsAddr % frameWidthInCtus);
+      if(rx > 0)
+      {
+        leftMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-1);
+      }
+
+      //merge up condition
+      Int ry = (ctuRsAddr / frameWidthInCtus);
+      if(ry > 0)
+      {
+        aboveMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-frameWidthInCtus);
+      }
+
+      pcEntropyCoder->encodeSAOBlkParam(saoblkParam, pcPic->getPicSym()->getSPS().getBitDepths(), sliceEnabled, leftMergeAvail, aboveMergeAvail);
+    }
+  }
+}
+
 Void TEncSlice::calculateBoundingCtuTsAddrForSlice(UInt &startCtuTSAddrSlice, UInt &boundingCtuTSAddrSlice, Bool &haveReachedTileBoundary,
                                                    TComPic* pcPic, const Int sliceMode, const Int sliceArgument)
 {
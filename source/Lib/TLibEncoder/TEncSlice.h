@@ -43,7 +43,9 @@
 #include "TLibCommon/TComList.h"
 #include "TLibCommon/TComPic.h"
 #include "TLibCommon/TComPicYuv.h"
+#include "TLibCommon/TComThreadPool.h"
 #include "TEncCu.h"
+#include "TEncCtuWorker.h"
 #include "WeightPredAnalysis.h"
 #include "TEncRateCtrl.h"
 
@@ -100,6 +102,13 @@ private:
   SliceType               m_encCABACTableIdx;
   Int                     m_gopID;
 
+  // parallel processing
+  TComThreadPool*             m_pcThreadPool;                   ///< worker threads (owned by TEncTop)
+  std::vector<TEncCtuWorker*> m_apcCtuWorkers;                  ///< per-thread CTU processing units (owned by TEncTop)
+  TComWavefrontSync           m_wavefrontSync;                  ///< progress of each substream during parallel processing
+  std::vector<TEncSbac*>      m_apcWavefrontSyncContextStates;  ///< WPP context storage of each substream during parallel processing
+  TEncSbac                    m_parallelEndContextState;        ///< context state at the end of the last CTU during parallel processing
+
   Double   calculateLambda( const TComSlice* pSlice, const Int GOPid, const Int depth, const Double refQP, const Double dQP, Int &iQP );
   Void     setUpLambda(TComSlice* slice, const Double dLambda, Int iQP);
   Void     calculateBoundingCtuTsAddrForSlice(UInt &startCtuTSAddrSlice, UInt &boundingCtuTSAddrSlice, Bool &haveReachedTileBoundary, TComPic* pcPic, const Int sliceMode, const Int sliceArgument);
@@ -111,6 +120,7 @@ public:
   Void    create              ( Int iWidth, Int iHeight, ChromaFormat chromaFormat, UInt iMaxCUWidth, UInt iMaxCUHeight, UChar uhTotalDepth );
   Void    destroy             ();
   Void    init                ( TEncTop* pcEncTop );
+  Void    init                ( TEncTop* pcEncTop, TEncCtuWorker* pcCtuWorker );
 #if ADD_RESET_ENCODER_DECISIONS_AFTER_IRAP
   Void    resetEncoderDecisions() { m_encCABACTableIdx = I_SLICE; }
 #endif
@@ -141,6 +151,14 @@ public:
 
 private:
   Double  xGetQPValueAccordingToLambda ( Double lambda );
+  Void    xEncodeSAOBlkParam           ( TComPic* pcPic, TEncEntropy* pcEntropyCoder, const UInt ctuRsAddr );
+
+  // parallel processing of the substreams (tiles / wavefront rows) of a slice segment
+  Bool    xUseParallelCompression      ( const TComPic* pcPic, const TComSlice* pcSlice, const Bool bCompressEntireSlice ) const;
+  Bool    xUseParallelEncoding         ( const TComPic* pcPic ) const;
+  Void    xDetermineSubstreamStartCtuTsAddrs ( const TComPic* pcPic, const UInt startCtuTsAddr, const UInt boundingCtuTsAddr, std::vector<UInt>& substreamStartCtuTsAddr );
+  Void    xCompressSliceParallel       ( TComPic* pcPic, const UInt startCtuTsAddr, const UInt boundingCtuTsAddr, const Bool bFastDeltaQP );
+  Void    xEncodeSliceParallel         ( TComPic* pcPic, TComOutputBitstream* pcSubstreams, UInt &numBinsCoded );
 };
 
 //! \}
@@ -107,8 +107,6 @@ Void TEncTop::create ()
   }
 #endif
 
-  m_cLoopFilter.create( m_maxTotalCUDepth );
-
   if ( m_RCEnableRateControl )
   {
     m_cRateCtrl.init( m_framesToBeEncoded, m_RCTargetBitrate, (Int)( (Double)m_iFrameRate/m_temporalSubsampleRatio + 0.5), m_iGOPSize, m_iSourceWidth, m_iSourceHeight,
@@ -142,10 +140,57 @@ Void TEncTop::create ()
       m_pppcRDSbacCoder   [iDepth][iCIIdx]->init( m_pppcBinCoderCABAC [iDepth][iCIIdx] );
     }
   }
+
+  if ( m_numWorkerThreads > 1 )
+  {
+    m_cThreadPool.create( m_numWorkerThreads );
+    for ( Int workerIdx = 0; workerIdx < m_numWorkerThreads; workerIdx++ )
+    {
+      TEncCtuWorker* pcWorker = new TEncCtuWorker;
+      pcWorker->create( m_maxTotalCUDepth, m_maxCUWidth, m_maxCUHeight, m_chromaFormatIDC );
+      m_apcCtuWorkers.push_back( pcWorker );
+    }
+  }
+
+  if ( m_numParallelPictures > 1 )
+  {
+    m_cPicThreadPool.create( m_numParallelPictures );
+    for ( Int workerIdx = 0; workerIdx < m_numParallelPictures; workerIdx++ )
+    {
+      TEncPicWorker* pcWorker = new TEncPicWorker;
+      pcWorker->create( getSourceWidth(), getSourceHeight(), m_chromaFormatIDC, m_maxCUWidth, m_maxCUHeight, m_maxTotalCUDepth,
+                        m_bUseSAO, m_log2SaoOffsetScale[CHANNEL_TYPE_LUMA], m_log2SaoOffsetScale[CHANNEL_TYPE_CHROMA], getSaoCtuBoundary() );
+      m_apcPicWorkers.push_back( pcWorker );
+    }
+  }
+
+  m_cLoopFilter.create( m_maxTotalCUDepth, &m_cThreadPool );
+
+  if ( m_lookahead )
+  {
+    m_cLookahead.create( m_lookaheadThreads, getSourceWidth(), getSourceHeight(), m_maxCUWidth, m_maxCUHeight, m_bitDepth[CHANNEL_TYPE_LUMA] );
+  }
 }
 
 Void TEncTop::destroy ()
 {
+  // stop the worker threads before their processing units are released
+  m_cThreadPool.        destroy();
+  m_cPicThreadPool.     destroy();
+  m_cLookahead.         destroy();
+  for ( UInt workerIdx = 0; workerIdx < m_apcPicWorkers.size(); workerIdx++ )
+  {
+    m_apcPicWorkers[workerIdx]->destroy();
+    delete m_apcPicWorkers[workerIdx];
+  }
+  m_apcPicWorkers.clear();
+  for ( UInt workerIdx = 0; workerIdx < m_apcCtuWorkers.size(); workerIdx++ )
+  {
+    m_apcCtuWorkers[workerIdx]->destroy();
+    delete m_apcCtuWorkers[workerIdx];
+  }
+  m_apcCtuWorkers.clear();
+
   // destroy processing unit classes
   m_cGOPEncoder.        destroy();
   m_cSliceEncoder.      destroy();
@@ -220,6 +265,7 @@ Void TEncTop::init(Bool isFieldCoding)
                    m_useRDOQ,
                    m_useRDOQTS,
                    m_useSelectiveRDOQ,
+                   m_useRDOQFixedPoint,
                    true
                   ,m_useTransformSkipFast
 #if ADAPTIVE_QP_SELECTION
@@ -230,6 +276,16 @@ Void TEncTop::init(Bool isFieldCoding)
   // initialize encoder search class
   m_cSearch.init( this, &m_cTrQuant, m_iSearchRange, m_bipredSearchRange, m_motionEstimationSearchMethod, m_maxCUWidth, m_maxCUHeight, m_maxTotalCUDepth, &m_cEntropyCoder, &m_cRdCost, getRDSbacCoder(), getRDGoOnSbacCoder() );
 
+  // initialize the processing units of the worker threads
+  for ( UInt workerIdx = 0; workerIdx < m_apcCtuWorkers.size(); workerIdx++ )
+  {
+    m_apcCtuWorkers[workerIdx]->init( this, 1 << m_uiQuadtreeTULog2MaxSize, m_iSearchRange, m_bipredSearchRange, m_maxCUWidth, m_maxCUHeight, m_maxTotalCUDepth );
+  }
+  for ( UInt workerIdx = 0; workerIdx < m_apcPicWorkers.size(); workerIdx++ )
+  {
+    m_apcPicWorkers[workerIdx]->init( this, 1 << m_uiQuadtreeTULog2MaxSize, m_iSearchRange, m_bipredSearchRange, m_maxCUWidth, m_maxCUHeight, m_maxTotalCUDepth );
+  }
+
   m_iMaxRefPicNum = 0;
 }
 
@@ -292,6 +348,31 @@ Void TEncTop::xInitScalingLists(TComSPS &sps, TComPPS &pps)
       }
     }
   }
+
+  // the worker threads quantise with their own TComTrQuant instances
+  std::vector<TComTrQuant*> workerTrQuants;
+  for ( UInt workerIdx = 0; workerIdx < m_apcCtuWorkers.size(); workerIdx++ )
+  {
+    workerTrQuants.push_back( m_apcCtuWorkers[workerIdx]->getTrQuant() );
+  }
+  for ( UInt workerIdx = 0; workerIdx < m_apcPicWorkers.size(); workerIdx++ )
+  {
+    workerTrQuants.push_back( m_apcPicWorkers[workerIdx]->getCtuWorker()->getTrQuant() );
+  }
+  for ( UInt workerIdx = 0; workerIdx < workerTrQuants.size(); workerIdx++ )
+  {
+    TComTrQuant* pcTrQuant = workerTrQuants[workerIdx];
+    if (getUseScalingListId() == SCALING_LIST_OFF)
+    {
+      pcTrQuant->setFlatScalingList(maxLog2TrDynamicRange, sps.getBitDepths());
+      pcTrQuant->setUseScalingList(false);
+    }
+    else
+    {
+      pcTrQuant->setScalingList(&(sps.getScalingList()), maxLog2TrDynamicRange, sps.getBitDepths());
+      pcTrQuant->setUseScalingList(true);
+    }
+  }
 }
 
 // ====================================================================================================================
@@ -347,6 +428,12 @@ Void TEncTop::encode( Bool flush, TComPicYuv* pcPicYuvOrg, TComPicYuv* pcPicYuvT
     {
       m_cPreanalyzer.xPreanalyze( dynamic_cast<TEncPic*>( pcPicCurr ) );
     }
+
+    // analyse the picture while the rest of the GOP is received, unless it was passed to the lookahead earlier
+    if ( m_lookahead )
+    {
+      m_cLookahead.attachPicture( dynamic_cast<TEncPic*>( pcPicCurr ) );
+    }
   }
 
   if ((m_iNumPicRcvd == 0) || (!flush && (m_iPOCLast != 0) && (m_iNumPicRcvd != m_iGOPSize) && (m_iGOPSize != 0)))
@@ -355,6 +442,11 @@ Void TEncTop::encode( Bool flush, TComPicYuv* pcPicYuvOrg, TComPicYuv* pcPicYuvT
     return;
   }
 
+  if ( m_lookahead )
+  {
+    m_cLookahead.waitForAnalysis();
+  }
+
   if ( m_RCEnableRateControl )
   {
     m_cRateCtrl.initRCGOP( m_iNumPicRcvd );
@@ -534,13 +626,14 @@ Void TEncTop::xGetNewPicBuffer ( TComPic*& rpcPic, Int ppsId )
 
   if (rpcPic==0)
   {
-    if ( getUseAdaptiveQP() )
+    if ( getUseAdaptiveQP() || m_lookahead )
     {
+      const UInt uiMaxAQDepth = getUseAdaptiveQP() ? pps.getMaxCuDQPDepth()+1 : 0;
       TEncPic* pcEPic = new TEncPic;
 #if REDUCED_ENCODER_MEMORY
-      pcEPic->create( sps, pps, pps.getMaxCuDQPDepth()+1);
+      pcEPic->create( sps, pps, uiMaxAQDepth );
 #else
-      pcEPic->create( sps, pps, pps.getMaxCuDQPDepth()+1, false);
+      pcEPic->create( sps, pps, uiMaxAQDepth, false );
 #endif
       rpcPic = pcEPic;
     }
@@ -557,6 +650,11 @@ Void TEncTop::xGetNewPicBuffer ( TComPic*& rpcPic, Int ppsId )
     m_cListPic.pushBack( rpcPic );
   }
   rpcPic->setReconMark (false);
+  if ( m_lookahead )
+  {
+    // the pre-analysis of a reused picture buffer belongs to its previous content
+    dynamic_cast<TEncPic*>( rpcPic )->setLookaheadState( false, false );
+  }
 
   m_iPOCLast++;
   m_iNumPicRcvd++;
@@ -44,6 +44,7 @@
 #include "TLibCommon/TComTrQuant.h"
 #include "TLibCommon/TComLoopFilter.h"
 #include "TLibCommon/AccessUnit.h"
+#include "TLibCommon/TComThreadPool.h"
 
 #include "TLibVideoIO/TVideoIOYuv.h"
 
@@ -56,7 +57,10 @@
 #include "TEncSearch.h"
 #include "TEncSampleAdaptiveOffset.h"
 #include "TEncPreanalyzer.h"
+#include "TEncLookahead.h"
 #include "TEncRateCtrl.h"
+#include "TEncCtuWorker.h"
+#include "TEncPicWorker.h"
 //! \ingroup TLibEncoder
 //! \{
 
@@ -108,9 +112,16 @@ private:
 
   // quality control
   TEncPreanalyzer         m_cPreanalyzer;                 ///< image characteristics analyzer for TM5-step3-like adaptive QP
+  TEncLookahead           m_cLookahead;                   ///< cost and motion estimation of the received pictures ahead of encoding
 
   TEncRateCtrl            m_cRateCtrl;                    ///< Rate control class
 
+  // parallel processing
+  TComThreadPool              m_cThreadPool;              ///< worker threads for parallel CTU compression
+  std::vector<TEncCtuWorker*> m_apcCtuWorkers;            ///< per-thread CTU processing units, indexed by worker thread
+  TComThreadPool              m_cPicThreadPool;           ///< worker threads for concurrent picture encoding
+  std::vector<TEncPicWorker*> m_apcPicWorkers;            ///< picture processing units, one per concurrently encoded picture
+
 protected:
   Void  xGetNewPicBuffer  ( TComPic*& rpcPic, Int ppsId ); ///< get picture buffer which will be processed. If ppsId<0, then the ppsMap will be queried for the first match.
   Void  xInitVPS          (TComVPS &vps, const TComSPS &sps); ///< initialize VPS from encoder options
@@ -153,6 +164,12 @@ public:
   TEncSbac***             getRDSbacCoder        () { return  m_pppcRDSbacCoder;       }
   TEncSbac*               getRDGoOnSbacCoder    () { return  &m_cRDGoOnSbacCoder;     }
   TEncRateCtrl*           getRateCtrl           () { return &m_cRateCtrl;             }
+  TComThreadPool*         getThreadPool         () { return &m_cThreadPool;           }
+  Int                     getNumCtuWorkers      () const { return (Int)m_apcCtuWorkers.size(); }
+  TEncCtuWorker*          getCtuWorker          ( Int workerIdx ) { return m_apcCtuWorkers[workerIdx]; }
+  TComThreadPool*         getPicThreadPool      () { return &m_cPicThreadPool;        }
+  Int                     getNumPicWorkers      () const { return (Int)m_apcPicWorkers.size(); }
+  TEncPicWorker*          getPicWorker          ( Int workerIdx ) { return m_apcPicWorkers[workerIdx]; }
   Void selectReferencePictureSet(TComSlice* slice, Int POCCurr, Int GOPid );
   Int getReferencePictureSetIdxForSOP(Int POCCurr, Int GOPid );
 
@@ -179,6 +196,9 @@ public:
                TComList<TComPicYuv*>& rcListPicYuvRecOut,
                std::list<AccessUnit>& accessUnitsOut, Int& iNumEncoded, Bool isTff);
 
+  /// pass the original of a source picture to the lookahead pre-analysis ahead of encode(), in input order (frame coding only)
+  Void addLookaheadPicture( const TComPicYuv* pcPicYuvOrg ) { m_cLookahead.addPicture( pcPicYuvOrg ); }
+
   TEncAnalyze::OutputLogControl getOutputLogControl() const
   {
     TEncAnalyze::OutputLogControl outputLogCtrl;
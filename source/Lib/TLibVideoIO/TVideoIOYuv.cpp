@@ -46,12 +46,255 @@
 #include "TLibCommon/TComRom.h"
 #include "TVideoIOYuv.h"
 
+#if VECTOR_CODING__VIDEO_IO && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include "TLibCommon/TComSimd.h"
+#include <immintrin.h>
+#endif
+
 using namespace std;
 
 // ====================================================================================================================
 // Local Functions
 // ====================================================================================================================
 
+/// horizontal resampling between the lines of a file and of a picture buffer, whose chroma scales differ by at most 1
+enum LineResampling
+{
+  LINE_COPY      = 0,   ///< same sampling: destination sample x is source sample x
+  LINE_DECIMATE  = 1,   ///< destination sample x is source sample 2x, eg file is 444, destination is 422
+  LINE_REPLICATE = 2    ///< destination sample x is source sample x/2, eg file is 422, destination is 444
+};
+
+static inline LineResampling getLineResampling(const UInt csx_src, const UInt csx_dst)
+{
+  assert(csx_src <= csx_dst + 1 && csx_dst <= csx_src + 1);
+  return (csx_src < csx_dst) ? LINE_DECIMATE : ((csx_src > csx_dst) ? LINE_REPLICATE : LINE_COPY);
+}
+
+static inline UInt getSourceIndex(const UInt x, const LineResampling resampling)
+{
+  return (resampling == LINE_DECIMATE) ? (x << 1) : ((resampling == LINE_REPLICATE) ? (x >> 1) : x);
+}
+
+#if VECTOR_CODING__VIDEO_IO && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+// The kernels below convert the leading part of a line and return the number of destination samples converted; the
+// caller finishes the line with the C code. When decimating, the last destination sample is always left to the C
+// code, so that the source line is never read beyond the sample it needs.
+
+/// converts 8-bit file samples to Pel
+SIMD_TARGET_SSE41
+static UInt xReadBytesSse41(Pel* dst, const UChar* src, const UInt width, const LineResampling resampling)
+{
+  UInt x = 0;
+  if (resampling == LINE_COPY)
+  {
+    for (; x + 8 <= width; x += 8)
+    {
+      _mm_storeu_si128((__m128i*)(dst + x), _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*)(src + x))));
+    }
+  }
+  else if (resampling == LINE_DECIMATE)
+  {
+    const __m128i lowByte = _mm_set1_epi16(0x00ff);
+    for (; x + 8 < width; x += 8)
+    {
+      _mm_storeu_si128((__m128i*)(dst + x), _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + 2 * x)), lowByte));
+    }
+  }
+  else
+  {
+    for (; x + 16 <= width; x += 16)
+    {
+      const __m128i samples = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*)(src + x / 2)));
+      _mm_storeu_si128((__m128i*)(dst + x),     _mm_unpacklo_epi16(samples, samples));
+      _mm_storeu_si128((__m128i*)(dst + x + 8), _mm_unpackhi_epi16(samples, samples));
+    }
+  }
+  return x;
+}
+
+/// converts Pel to 8-bit file samples, keeping the low byte of each sample
+SIMD_TARGET_SSE41
+static UInt xWriteBytesSse41(UChar* dst, const Pel* src, const UInt width, const LineResampling resampling)
+{
+  UInt x = 0;
+  if (resampling == LINE_COPY)
+  {
+    const __m128i lowByte = _mm_set1_epi16(0x00ff);
+    for (; x + 16 <= width; x += 16)
+    {
+      const __m128i first  = _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + x)),     lowByte);
+      const __m128i second = _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + x + 8)), lowByte);
+      _mm_storeu_si128((__m128i*)(dst + x), _mm_packus_epi16(first, second));
+    }
+  }
+  else if (resampling == LINE_DECIMATE)
+  {
+    const __m128i lowByte = _mm_set1_epi32(0x000000ff);
+    for (; x + 16 < width; x += 16)
+    {
+      const Pel* line = src + 2 * x;
+      const __m128i first  = _mm_packus_epi32(_mm_and_si128(_mm_loadu_si128((const __m128i*)(line)),      lowByte),
+                                              _mm_and_si128(_mm_loadu_si128((const __m128i*)(line + 8)),  lowByte));
+      const __m128i second = _mm_packus_epi32(_mm_and_si128(_mm_loadu_si128((const __m128i*)(line + 16)), lowByte),
+                                              _mm_and_si128(_mm_loadu_si128((const __m128i*)(line + 24)), lowByte));
+      _mm_storeu_si128((__m128i*)(dst + x), _mm_packus_epi16(first, second));
+    }
+  }
+  else
+  {
+    const __m128i lowByte = _mm_set1_epi16(0x00ff);
+    for (; x + 16 <= width; x += 16)
+    {
+      const __m128i samples = _mm_packus_epi16(_mm_and_si128(_mm_loadu_si128((const __m128i*)(src + x / 2)), lowByte), _mm_setzero_si128());
+      _mm_storeu_si128((__m128i*)(dst + x), _mm_unpacklo_epi8(samples, samples));
+    }
+  }
+  return x;
+}
+
+/// resamples a line of 16-bit words. On the little-endian hosts that have SSE, a 16-bit file sample and a Pel holding
+/// it have the same bytes, so this serves both reading and writing.
+SIMD_TARGET_SSE41
+static UInt xResampleWordsSse41(UChar* dst, const UChar* src, const UInt width, const LineResampling resampling)
+{
+  UInt x = 0;
+  if (resampling == LINE_COPY)
+  {
+    for (; x + 8 <= width; x += 8)
+    {
+      _mm_storeu_si128((__m128i*)(dst + 2 * x), _mm_loadu_si128((const __m128i*)(src + 2 * x)));
+    }
+  }
+  else if (resampling == LINE_DECIMATE)
+  {
+    const __m128i lowWord = _mm_set1_epi32(0x0000ffff);
+    for (; x + 8 < width; x += 8)
+    {
+      const __m128i first  = _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + 4 * x)),      lowWord);
+      const __m128i second = _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + 4 * x + 16)), lowWord);
+      _mm_storeu_si128((__m128i*)(dst + 2 * x), _mm_packus_epi32(first, second));
+    }
+  }
+  else
+  {
+    for (; x + 16 <= width; x += 16)
+    {
+      const __m128i samples = _mm_loadu_si128((const __m128i*)(src + x));
+      _mm_storeu_si128((__m128i*)(dst + 2 * x),      _mm_unpacklo_epi16(samples, samples));
+      _mm_storeu_si128((__m128i*)(dst + 2 * x + 16), _mm_unpackhi_epi16(samples, samples));
+    }
+  }
+  return x;
+}
+
+/// scales a line as described for scalePlane(). The rounded quotient is formed in 32 bits; it always fits in a Pel,
+/// so the saturating pack gives the same result as the C code.
+SIMD_TARGET_SSE41
+static UInt xScaleLineSse41(Pel* img, const UInt width, const Int shiftbits, const Pel minval, const Pel maxval)
+{
+  UInt x = 0;
+  if (shiftbits > 0)
+  {
+    const __m128i shift = _mm_cvtsi32_si128(shiftbits);
+    for (; x + 8 <= width; x += 8)
+    {
+      _mm_storeu_si128((__m128i*)(img + x), _mm_sll_epi16(_mm_loadu_si128((const __m128i*)(img + x)), shift));
+    }
+  }
+  else
+  {
+    const __m128i shift    = _mm_cvtsi32_si128(-shiftbits);
+    const __m128i rounding = _mm_set1_epi32(Pel(1 << (-shiftbits - 1)));
+    const __m128i vmin     = _mm_set1_epi16(minval);
+    const __m128i vmax     = _mm_set1_epi16(maxval);
+    for (; x + 8 <= width; x += 8)
+    {
+      const __m128i samples = _mm_loadu_si128((const __m128i*)(img + x));
+      const __m128i low     = _mm_sra_epi32(_mm_add_epi32(_mm_cvtepi16_epi32(samples),                    rounding), shift);
+      const __m128i high    = _mm_sra_epi32(_mm_add_epi32(_mm_cvtepi16_epi32(_mm_srli_si128(samples, 8)), rounding), shift);
+      _mm_storeu_si128((__m128i*)(img + x), _mm_min_epi16(_mm_max_epi16(_mm_packs_epi32(low, high), vmin), vmax));
+    }
+  }
+  return x;
+}
+#endif
+
+/**
+ * Convert a line of width samples of a file, stored as bytes or as 16-bit little-endian words, to Pel.
+ *
+ * @param dst          destination line
+ * @param src          line data in the file
+ * @param is16bit      true if the file carries > 8bit data, false otherwise.
+ * @param width        number of destination samples
+ * @param resampling   horizontal resampling from the file to the destination
+ */
+static Void readLine(Pel* dst, const UChar* src, const Bool is16bit, const UInt width, const LineResampling resampling)
+{
+  UInt x = 0;
+#if VECTOR_CODING__VIDEO_IO && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  static const SimdExtension simdExtension = getSimdExtension();
+  if (simdExtension >= SIMD_SSE41)
+  {
+    x = is16bit ? xResampleWordsSse41(reinterpret_cast<UChar*>(dst), src, width, resampling) : xReadBytesSse41(dst, src, width, resampling);
+  }
+#endif
+
+  if (!is16bit)
+  {
+    for (; x < width; x++)
+    {
+      dst[x] = src[getSourceIndex(x, resampling)];
+    }
+  }
+  else
+  {
+    for (; x < width; x++)
+    {
+      const UInt i = getSourceIndex(x, resampling);
+      dst[x] = Pel(src[i*2+0]) | (Pel(src[i*2+1])<<8);
+    }
+  }
+}
+
+/**
+ * Convert a line of Pel to width samples of a file, stored as bytes or as 16-bit little-endian words.
+ *
+ * @param dst          line data for the file
+ * @param src          source line
+ * @param is16bit      true if the file carries > 8bit data, false otherwise.
+ * @param width        number of file samples
+ * @param resampling   horizontal resampling from the source to the file
+ */
+static Void writeLine(UChar* dst, const Pel* src, const Bool is16bit, const UInt width, const LineResampling resampling)
+{
+  UInt x = 0;
+#if VECTOR_CODING__VIDEO_IO && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  static const SimdExtension simdExtension = getSimdExtension();
+  if (simdExtension >= SIMD_SSE41)
+  {
+    x = is16bit ? xResampleWordsSse41(dst, reinterpret_cast<const UChar*>(src), width, resampling) : xWriteBytesSse41(dst, src, width, resampling);
+  }
+#endif
+
+  if (!is16bit)
+  {
+    for (; x < width; x++)
+    {
+      dst[x] = (UChar)(src[getSourceIndex(x, resampling)]);
+    }
+  }
+  else
+  {
+    for (; x < width; x++)
+    {
+      const Pel val = src[getSourceIndex(x, resampling)];
+      dst[2*x  ] = (val>>0) & 0xff;
+      dst[2*x+1] = (val>>8) & 0xff;
+    }
+  }
+}
+
 /**
  * Scale all pixels in img depending upon sign of shiftbits by a factor of
  * 2<sup>shiftbits</sup>.
@@ -69,26 +312,39 @@ using namespace std;
  */
 static Void scalePlane(Pel* img, const UInt stride, const UInt width, const UInt height, Int shiftbits, Pel minval, Pel maxval)
 {
-  if (shiftbits > 0)
+  if (shiftbits == 0)
   {
-    for (UInt y = 0; y < height; y++, img+=stride)
+    return;
+  }
+
+#if VECTOR_CODING__VIDEO_IO && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  static const SimdExtension simdExtension = getSimdExtension();
+  const Bool useSimd = simdExtension >= SIMD_SSE41;
+#endif
+
+  for (UInt y = 0; y < height; y++, img+=stride)
+  {
+    UInt x = 0;
+#if VECTOR_CODING__VIDEO_IO && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+    if (useSimd)
     {
-      for (UInt x = 0; x < width; x++)
+      x = xScaleLineSse41(img, width, shiftbits, minval, maxval);
+    }
+#endif
+
+    if (shiftbits > 0)
+    {
+      for (; x < width; x++)
       {
         img[x] <<= shiftbits;
       }
     }
-  }
-  else if (shiftbits < 0)
-  {
-    shiftbits=-shiftbits;
-
-    Pel rounding = 1 << (shiftbits-1);
-    for (UInt y = 0; y < height; y++, img+=stride)
+    else
     {
-      for (UInt x = 0; x < width; x++)
+      const Pel rounding = 1 << (-shiftbits-1);
+      for (; x < width; x++)
       {
-        img[x] = Clip3(minval, maxval, Pel((img[x] + rounding) >> shiftbits));
+        img[x] = Clip3(minval, maxval, Pel((img[x] + rounding) >> (-shiftbits)));
       }
     }
   }
@@ -159,6 +415,9 @@ Void TVideoIOYuv::open( const std::string &fileName, Bool bWriteMode, const Int
       printf("\nfailed to open Input YUV file\n");
       exit(0);
     }
+
+    // frames are taken from the mapping where possible, m_cHandle only keeps track of the position
+    m_cMappedFile.open( fileName );
   }
 
   return;
@@ -167,6 +426,7 @@ Void TVideoIOYuv::open( const std::string &fileName, Bool bWriteMode, const Int
 Void TVideoIOYuv::close()
 {
   m_cHandle.close();
+  m_cMappedFile.close();
 }
 
 Bool TVideoIOYuv::isEof()
@@ -306,6 +566,7 @@ static Bool readPlane(Pel* dst,
   {
     const UInt mask_y_file=(1<<csy_file)-1;
     const UInt mask_y_dest=(1<<csy_dest)-1;
+    const LineResampling resampling=getLineResampling(csx_file, csx_dest);
     for(UInt y444=0; y444<height444; y444++)
     {
       if ((y444&mask_y_file)==0)
@@ -321,44 +582,7 @@ static Bool readPlane(Pel* dst,
       if ((y444&mask_y_dest)==0)
       {
         // process current destination line
-        if (csx_file < csx_dest)
-        {
-          // eg file is 444, dest is 422.
-          const UInt sx=csx_dest-csx_file;
-          if (!is16bit)
-          {
-            for (UInt x = 0; x < width_dest; x++)
-            {
-              dst[x] = buf[x<<sx];
-            }
-          }
-          else
-          {
-            for (UInt x = 0; x < width_dest; x++)
-            {
-              dst[x] = Pel(buf[(x<<sx)*2+0]) | (Pel(buf[(x<<sx)*2+1])<<8);
-            }
-          }
-        }
-        else
-        {
-          // eg file is 422, dest is 444.
-          const UInt sx=csx_file-csx_dest;
-          if (!is16bit)
-          {
-            for (UInt x = 0; x < width_dest; x++)
-            {
-              dst[x] = buf[x>>sx];
-            }
-          }
-          else
-          {
-            for (UInt x = 0; x < width_dest; x++)
-            {
-              dst[x] = Pel(buf[(x>>sx)*2+0]) | (Pel(buf[(x>>sx)*2+1])<<8);
-            }
-          }
-        }
+        readLine(dst, buf, is16bit, width_dest, resampling);
 
         // process right hand side padding
         const Pel val=dst[width_dest-1];
@@ -383,6 +607,68 @@ static Bool readPlane(Pel* dst,
   return true;
 }
 
+/**
+ * Read width*height pixels of a plane stored in memory at src into dst,
+ * optionally padding the left and right edges by edge-extension.  The file
+ * has the chroma format of dst, so each line is converted in one pass.
+ *
+ * @param dst          destination image plane
+ * @param src          plane data in the file
+ * @param is16bit      true if input file carries > 8bit data, false otherwise.
+ * @param stride444    distance between vertically adjacent pixels of dst.
+ * @param width444     width of active area in dst.
+ * @param height444    height of active area in dst.
+ * @param pad_x444     length of horizontal padding.
+ * @param pad_y444     length of vertical padding.
+ * @param compID       chroma component
+ * @param format       chroma format of image and file
+ * @return pointer to the data following the plane
+ */
+static const UChar* readPlane(Pel* dst,
+                              const UChar* src,
+                              Bool is16bit,
+                              UInt stride444,
+                              UInt width444,
+                              UInt height444,
+                              UInt pad_x444,
+                              UInt pad_y444,
+                              const ComponentID compID,
+                              const ChromaFormat format)
+{
+  const UInt csx = getComponentScaleX(compID, format);
+  const UInt csy = getComponentScaleY(compID, format);
+
+  const UInt width_dest       = width444 >>csx;
+  const UInt height_dest      = height444>>csy;
+  const UInt stride_dest      = stride444>>csx;
+  const UInt full_width_dest  = width_dest+(pad_x444>>csx);
+  const UInt full_height_dest = height_dest+(pad_y444>>csy);
+
+  const UInt stride_file      = (width444 * (is16bit ? 2 : 1)) >> csx;
+
+  for (UInt y = 0; y < height_dest; y++, dst+=stride_dest, src+=stride_file)
+  {
+    readLine(dst, src, is16bit, width_dest, LINE_COPY);
+
+    // process right hand side padding
+    const Pel val=dst[width_dest-1];
+    for (UInt x = width_dest; x < full_width_dest; x++)
+    {
+      dst[x] = val;
+    }
+  }
+
+  // process lower padding
+  for (UInt y = height_dest; y < full_height_dest; y++, dst+=stride_dest)
+  {
+    for (UInt x = 0; x < full_width_dest; x++)
+    {
+      dst[x] = (dst - stride_dest)[x];
+    }
+  }
+  return src;
+}
+
 /**
  * Write an image plane (width444*height444 pixels) from src into output stream fd.
  *
@@ -458,51 +744,13 @@ static Bool writePlane(ostream& fd, Pel* src, Bool is16bit,
   {
     const UInt mask_y_file=(1<<csy_file)-1;
     const UInt mask_y_src =(1<<csy_src )-1;
+    const LineResampling resampling=getLineResampling(csx_src, csx_file);
     for(UInt y444=0; y444<height444; y444++)
     {
       if ((y444&mask_y_file)==0)
       {
         // write a new line
-        if (csx_file < csx_src)
-        {
-          // eg file is 444, source is 422.
-          const UInt sx=csx_src-csx_file;
-          if (!is16bit)
-          {
-            for (UInt x = 0; x < width_file; x++)
-            {
-              buf[x] = (UChar)(src[x>>sx]);
-            }
-          }
-          else
-          {
-            for (UInt x = 0; x < width_file; x++)
-            {
-              buf[2*x  ] = (src[x>>sx]>>0) & 0xff;
-              buf[2*x+1] = (src[x>>sx]>>8) & 0xff;
-            }
-          }
-        }
-        else
-        {
-          // eg file is 422, src is 444.
-          const UInt sx=csx_file-csx_src;
-          if (!is16bit)
-          {
-            for (UInt x = 0; x < width_file; x++)
-            {
-              buf[x] = (UChar)(src[x<<sx]);
-            }
-          }
-          else
-          {
-            for (UInt x = 0; x < width_file; x++)
-            {
-              buf[2*x  ] = (src[x<<sx]>>0) & 0xff;
-              buf[2*x+1] = (src[x<<sx]>>8) & 0xff;
-            }
-          }
-        }
+        writeLine(buf, src, is16bit, width_file, resampling);
 
         fd.write(reinterpret_cast<const TChar*>(buf), stride_file);
         if (fd.eof() || fd.fail() )
@@ -586,6 +834,7 @@ static Bool writeField(ostream& fd, Pel* top, Pel* bottom, Bool is16bit,
   {
     const UInt mask_y_file=(1<<csy_file)-1;
     const UInt mask_y_src =(1<<csy_src )-1;
+    const LineResampling resampling=getLineResampling(csx_src, csx_file);
     for(UInt y444=0; y444<height444; y444++)
     {
       if ((y444&mask_y_file)==0)
@@ -596,46 +845,7 @@ static Bool writeField(ostream& fd, Pel* top, Pel* bottom, Bool is16bit,
           Pel   *src         = (((field == 0) && isTff) || ((field == 1) && (!isTff))) ? top : bottom;
 
           // write a new line
-          if (csx_file < csx_src)
-          {
-            // eg file is 444, source is 422.
-            const UInt sx=csx_src-csx_file;
-            if (!is16bit)
-            {
-              for (UInt x = 0; x < width_file; x++)
-              {
-                fieldBuffer[x] = (UChar)(src[x>>sx]);
-              }
-            }
-            else
-            {
-              for (UInt x = 0; x < width_file; x++)
-              {
-                fieldBuffer[2*x  ] = (src[x>>sx]>>0) & 0xff;
-                fieldBuffer[2*x+1] = (src[x>>sx]>>8) & 0xff;
-              }
-            }
-          }
-          else
-          {
-            // eg file is 422, src is 444.
-            const UInt sx=csx_file-csx_src;
-            if (!is16bit)
-            {
-              for (UInt x = 0; x < width_file; x++)
-              {
-                fieldBuffer[x] = (UChar)(src[x<<sx]);
-              }
-            }
-            else
-            {
-              for (UInt x = 0; x < width_file; x++)
-              {
-                fieldBuffer[2*x  ] = (src[x<<sx]>>0) & 0xff;
-                fieldBuffer[2*x+1] = (src[x<<sx]>>8) & 0xff;
-              }
-            }
-          }
+          writeLine(fieldBuffer, src, is16bit, width_file, resampling);
         }
 
         fd.write(reinterpret_cast<const TChar*>(buf), (stride_file * 2));
@@ -707,6 +917,27 @@ Bool TVideoIOYuv::read ( TComPicYuv*  pPicYuvUser, TComPicYuv* pPicYuvTrueOrg, c
   const UInt width444       = width_full444 - pad_h444;
   const UInt height444      = height_full444 - pad_v444;
 
+  // a complete frame stored in the format of the picture buffer is converted straight from the mapping
+  const UChar* mappedFrame = NULL;
+  if (m_cMappedFile.isOpen() && format == pPicYuv->getChromaFormat() && format != CHROMA_400
+      && (width444  & ((1 << getComponentScaleX(COMPONENT_Cb, format)) - 1)) == 0
+      && (height444 & ((1 << getComponentScaleY(COMPONENT_Cb, format)) - 1)) == 0)
+  {
+    std::size_t frameSize = 0;
+    for(UInt comp=0; comp<getNumberValidComponents(format); comp++)
+    {
+      const ComponentID compID = ComponentID(comp);
+      frameSize += ((width444 * (is16bit ? 2 : 1)) >> getComponentScaleX(compID, format)) * (height444 >> getComponentScaleY(compID, format));
+    }
+
+    const streamoff position = m_cHandle.tellg();
+    if (position >= 0 && std::size_t(position) + frameSize <= m_cMappedFile.getSize())
+    {
+      mappedFrame = m_cMappedFile.getData() + std::size_t(position);
+      m_cHandle.seekg(streamoff(frameSize), ios::cur);
+    }
+  }
+
   for(UInt comp=0; comp<MAX_NUM_COMPONENT; comp++)
   {
     const ComponentID compID = ComponentID(comp);
@@ -718,7 +949,14 @@ Bool TVideoIOYuv::read ( TComPicYuv*  pPicYuvUser, TComPicYuv* pPicYuvTrueOrg, c
     const Pel minval = b709Compliance? ((   1 << (desired_bitdepth - 8))   ) : 0;
     const Pel maxval = b709Compliance? ((0xff << (desired_bitdepth - 8)) -1) : (1 << desired_bitdepth) - 1;
 
-    if (! readPlane(pPicYuv->getAddr(compID), m_cHandle, is16bit, stride444, width444, height444, pad_h444, pad_v444, compID, pPicYuv->getChromaFormat(), format, m_fileBitdepth[chType]))
+    if (mappedFrame != NULL)
+    {
+      if (compID < pPicYuv->getNumberValidComponents())
+      {
+        mappedFrame = readPlane(pPicYuv->getAddr(compID), mappedFrame, is16bit, stride444, width444, height444, pad_h444, pad_v444, compID, format);
+      }
+    }
+    else if (! readPlane(pPicYuv->getAddr(compID), m_cHandle, is16bit, stride444, width444, height444, pad_h444, pad_v444, compID, pPicYuv->getChromaFormat(), format, m_fileBitdepth[chType]))
     {
       return false;
     }
@@ -43,6 +43,7 @@
 #include <iostream>
 #include "TLibCommon/CommonDef.h"
 #include "TLibCommon/TComPicYuv.h"
+#include "TLibCommon/TComMappedFile.h"
 
 using namespace std;
 
@@ -58,6 +59,7 @@ private:
   Int       m_fileBitdepth[MAX_NUM_CHANNEL_TYPE]; ///< bitdepth of input/output video file
   Int       m_MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE];  ///< bitdepth after addition of MSBs (with value 0)
   Int       m_bitdepthShift[MAX_NUM_CHANNEL_TYPE];  ///< number of bits to increase or decrease image by before/after write/read
+  TComMappedFile m_cMappedFile;                             ///< mapping of the input file, used to read frames stored in the format of the picture buffer
 
 public:
   TVideoIOYuv()           {}
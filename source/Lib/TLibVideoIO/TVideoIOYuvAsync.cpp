@@ -0,0 +1,412 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TVideoIOYuvAsync.cpp
+    \brief    YUV file I/O on a separate thread
+*/
+
+#include <algorithm>
+#include <chrono>
+#include "TVideoIOYuvAsync.h"
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TVideoIOYuvAsyncReader::TVideoIOYuvAsyncReader()
+: m_pcFile        ( NULL )
+, m_readIdx       ( 0 )
+, m_getIdx        ( 0 )
+, m_numFilled     ( 0 )
+, m_bTerminate    ( false )
+, m_bFinished     ( false )
+, m_numFrames     ( 0 )
+, m_ipCSC         ( IPCOLOURSPACE_UNCHANGED )
+, m_fileFormat    ( NUM_CHROMA_FORMAT )
+, m_bClipToRec709 ( false )
+, m_numSkipFrames ( 0 )
+, m_skipWidth     ( 0 )
+, m_skipHeight    ( 0 )
+{
+  m_aiPad[0] = m_aiPad[1] = 0;
+}
+
+TVideoIOYuvAsyncReader::~TVideoIOYuvAsyncReader()
+{
+  destroy();
+}
+
+Void TVideoIOYuvAsyncReader::create( Int numBuffers, Int width, Int height, ChromaFormat format, UInt maxCUWidth, UInt maxCUHeight, UInt maxCUDepth )
+{
+  destroy();
+  for ( Int i = 0; i < numBuffers; i++ )
+  {
+    Slot* pcSlot = new Slot;
+    pcSlot->picYuv       .create( width, height, format, maxCUWidth, maxCUHeight, maxCUDepth, true );
+    pcSlot->picYuvTrueOrg.create( width, height, format, maxCUWidth, maxCUHeight, maxCUDepth, true );
+    pcSlot->bEof = false;
+    m_slots.push_back( pcSlot );
+  }
+}
+
+Void TVideoIOYuvAsyncReader::destroy()
+{
+  stop();
+  for ( UInt i = 0; i < m_slots.size(); i++ )
+  {
+    m_slots[i]->picYuv.destroy();
+    m_slots[i]->picYuvTrueOrg.destroy();
+    delete m_slots[i];
+  }
+  m_slots.clear();
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+Void TVideoIOYuvAsyncReader::start( TVideoIOYuv* pcFile, Int numFrames, const InputColourSpaceConversion ipCSC, const Int aiPad[2], ChromaFormat fileFormat, Bool bClipToRec709,
+                                    Int numSkipFrames, UInt skipWidth, UInt skipHeight )
+{
+  assert( !m_slots.empty() && !m_thread.joinable() );
+
+  m_pcFile        = pcFile;
+  m_numFrames     = numFrames;
+  m_ipCSC         = ipCSC;
+  m_aiPad[0]      = aiPad[0];
+  m_aiPad[1]      = aiPad[1];
+  m_fileFormat    = fileFormat;
+  m_bClipToRec709 = bClipToRec709;
+  m_numSkipFrames = numSkipFrames;
+  m_skipWidth     = skipWidth;
+  m_skipHeight    = skipHeight;
+
+  m_readIdx    = 0;
+  m_getIdx     = 0;
+  m_numFilled  = 0;
+  m_bTerminate = false;
+  m_bFinished  = false;
+
+  m_thread = std::thread( &TVideoIOYuvAsyncReader::xThreadLoop, this );
+}
+
+Void TVideoIOYuvAsyncReader::stop()
+{
+  if ( !m_thread.joinable() )
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_bTerminate = true;
+  }
+  m_slotReleased.notify_all();
+  m_thread.join();
+}
+
+Bool TVideoIOYuvAsyncReader::getPicture( TComPicYuv*& rpcPicYuv, TComPicYuv*& rpcPicYuvTrueOrg )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  // the slot returned by the previous call is released before the next one is requested
+  assert( m_numFilled >= 0 );
+  m_slotFilled.wait( lock, [this]() { return m_numFilled > 0 || m_bFinished; } );
+  if ( m_numFilled == 0 )
+  {
+    // all frames have been returned: behave as a read beyond the end of the file
+    rpcPicYuv        = NULL;
+    rpcPicYuvTrueOrg = NULL;
+    return false;
+  }
+
+  Slot* pcSlot     = m_slots[m_getIdx];
+  rpcPicYuv        = &pcSlot->picYuv;
+  rpcPicYuvTrueOrg = &pcSlot->picYuvTrueOrg;
+  return !pcSlot->bEof;
+}
+
+Void TVideoIOYuvAsyncReader::releasePicture()
+{
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    assert( m_numFilled > 0 );
+    m_getIdx = ( m_getIdx + 1 ) % Int( m_slots.size() );
+    m_numFilled--;
+  }
+  m_slotReleased.notify_one();
+}
+
+Bool TVideoIOYuvAsyncReader::peekPicture( Int offset, TComPicYuv*& rpcPicYuv )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  rpcPicYuv = NULL;
+  if ( offset >= Int( m_slots.size() ) )
+  {
+    return false;
+  }
+  m_slotFilled.wait( lock, [this, offset]() { return m_numFilled > offset || m_bFinished; } );
+  if ( m_numFilled <= offset )
+  {
+    return false;
+  }
+
+  Slot* pcSlot = m_slots[( m_getIdx + offset ) % Int( m_slots.size() )];
+  if ( pcSlot->bEof )
+  {
+    return false;
+  }
+  rpcPicYuv = &pcSlot->picYuv;
+  return true;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+Void TVideoIOYuvAsyncReader::xThreadLoop()
+{
+  for ( Int frame = 0; m_numFrames <= 0 || frame < m_numFrames; frame++ )
+  {
+    Slot* pcSlot;
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_slotReleased.wait( lock, [this]() { return m_numFilled < Int( m_slots.size() ) || m_bTerminate; } );
+      if ( m_bTerminate )
+      {
+        break;
+      }
+      pcSlot = m_slots[m_readIdx];
+    }
+
+    // the slot is not accessed by the consumer until it is counted as filled
+    m_pcFile->read( &pcSlot->picYuv, &pcSlot->picYuvTrueOrg, m_ipCSC, m_aiPad, m_fileFormat, m_bClipToRec709 );
+    pcSlot->bEof = m_pcFile->isEof();
+    if ( !pcSlot->bEof && m_numSkipFrames > 0 )
+    {
+      m_pcFile->skipFrames( m_numSkipFrames, m_skipWidth, m_skipHeight, m_fileFormat );
+    }
+
+    {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      m_readIdx = ( m_readIdx + 1 ) % Int( m_slots.size() );
+      m_numFilled++;
+    }
+    m_slotFilled.notify_one();
+
+    if ( pcSlot->bEof )
+    {
+      break;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_bFinished = true;
+  }
+  m_slotFilled.notify_all();
+}
+
+// ====================================================================================================================
+// Asynchronous writer
+// ====================================================================================================================
+
+TVideoIOYuvAsyncWriter::TVideoIOYuvAsyncWriter()
+: m_maxQueued   ( 0 )
+, m_bBusy       ( false )
+, m_bTerminate  ( false )
+, m_blockedTime ( 0.0 )
+{
+}
+
+TVideoIOYuvAsyncWriter::~TVideoIOYuvAsyncWriter()
+{
+  destroy();
+}
+
+Void TVideoIOYuvAsyncWriter::create( Int maxQueued )
+{
+  destroy();
+  m_maxQueued   = std::max( maxQueued, 0 );
+  m_bTerminate  = false;
+  m_blockedTime = 0.0;
+  if ( m_maxQueued > 0 )
+  {
+    m_thread = std::thread( &TVideoIOYuvAsyncWriter::xThreadLoop, this );
+  }
+}
+
+Void TVideoIOYuvAsyncWriter::destroy()
+{
+  if ( m_thread.joinable() )
+  {
+    waitForAll();
+    {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      m_bTerminate = true;
+    }
+    m_entryQueued.notify_all();
+    m_thread.join();
+  }
+  for ( UInt i = 0; i < m_freePicYuv.size(); i++ )
+  {
+    m_freePicYuv[i]->destroy();
+    delete m_freePicYuv[i];
+  }
+  m_freePicYuv.clear();
+  m_maxQueued = 0;
+}
+
+Void TVideoIOYuvAsyncWriter::write( TVideoIOYuv* pcFile, const TComPicYuv* pcPicYuv, const InputColourSpaceConversion ipCSC,
+                                    Int confLeft, Int confRight, Int confTop, Int confBottom, ChromaFormat fileFormat, const Bool bClipToRec709 )
+{
+  if ( m_maxQueued == 0 )
+  {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    pcFile->write( const_cast<TComPicYuv*>( pcPicYuv ), ipCSC, confLeft, confRight, confTop, confBottom, fileFormat, bClipToRec709 );
+    m_blockedTime += std::chrono::duration<Double>( std::chrono::steady_clock::now() - start ).count();
+    return;
+  }
+
+  TComPicYuv* pcCopy = xCopyPicture( pcPicYuv );
+  xQueue( [=]() { pcFile->write( pcCopy, ipCSC, confLeft, confRight, confTop, confBottom, fileFormat, bClipToRec709 ); }, pcCopy, NULL );
+}
+
+Void TVideoIOYuvAsyncWriter::write( TVideoIOYuv* pcFile, const TComPicYuv* pcPicYuvTop, const TComPicYuv* pcPicYuvBottom, const InputColourSpaceConversion ipCSC,
+                                    Int confLeft, Int confRight, Int confTop, Int confBottom, ChromaFormat fileFormat, const Bool isTff, const Bool bClipToRec709 )
+{
+  if ( m_maxQueued == 0 )
+  {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    pcFile->write( const_cast<TComPicYuv*>( pcPicYuvTop ), const_cast<TComPicYuv*>( pcPicYuvBottom ), ipCSC, confLeft, confRight, confTop, confBottom, fileFormat, isTff, bClipToRec709 );
+    m_blockedTime += std::chrono::duration<Double>( std::chrono::steady_clock::now() - start ).count();
+    return;
+  }
+
+  TComPicYuv* pcCopyTop    = xCopyPicture( pcPicYuvTop );
+  TComPicYuv* pcCopyBottom = xCopyPicture( pcPicYuvBottom );
+  xQueue( [=]() { pcFile->write( pcCopyTop, pcCopyBottom, ipCSC, confLeft, confRight, confTop, confBottom, fileFormat, isTff, bClipToRec709 ); }, pcCopyTop, pcCopyBottom );
+}
+
+Void TVideoIOYuvAsyncWriter::addJob( const Job& job )
+{
+  if ( m_maxQueued == 0 )
+  {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    job();
+    m_blockedTime += std::chrono::duration<Double>( std::chrono::steady_clock::now() - start ).count();
+    return;
+  }
+  xQueue( job, NULL, NULL );
+}
+
+Void TVideoIOYuvAsyncWriter::waitForAll()
+{
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_entryDone.wait( lock, [this]() { return m_queue.empty() && !m_bBusy; } );
+  m_blockedTime += std::chrono::duration<Double>( std::chrono::steady_clock::now() - start ).count();
+}
+
+TComPicYuv* TVideoIOYuvAsyncWriter::xCopyPicture( const TComPicYuv* pcPicYuv )
+{
+  TComPicYuv* pcCopy = NULL;
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    if ( !m_freePicYuv.empty() )
+    {
+      pcCopy = m_freePicYuv.back();
+      m_freePicYuv.pop_back();
+    }
+  }
+  if ( pcCopy == NULL )
+  {
+    pcCopy = new TComPicYuv;
+  }
+  if ( pcCopy->getBuf( COMPONENT_Y ) == NULL || pcCopy->getChromaFormat() != pcPicYuv->getChromaFormat()
+    || pcCopy->getWidth( COMPONENT_Y ) != pcPicYuv->getWidth( COMPONENT_Y ) || pcCopy->getHeight( COMPONENT_Y ) != pcPicYuv->getHeight( COMPONENT_Y ) )
+  {
+    pcCopy->createWithoutCUInfo( pcPicYuv->getWidth( COMPONENT_Y ), pcPicYuv->getHeight( COMPONENT_Y ), pcPicYuv->getChromaFormat() );
+  }
+  pcPicYuv->copyToPic( pcCopy );
+  return pcCopy;
+}
+
+Void TVideoIOYuvAsyncWriter::xQueue( const Job& job, TComPicYuv* pcPicYuv0, TComPicYuv* pcPicYuv1 )
+{
+  Entry entry;
+  entry.job         = job;
+  entry.pcPicYuv[0] = pcPicYuv0;
+  entry.pcPicYuv[1] = pcPicYuv1;
+
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    if ( Int( m_queue.size() ) >= m_maxQueued )
+    {
+      const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      m_entryDone.wait( lock, [this]() { return Int( m_queue.size() ) < m_maxQueued; } );
+      m_blockedTime += std::chrono::duration<Double>( std::chrono::steady_clock::now() - start ).count();
+    }
+    m_queue.push_back( entry );
+  }
+  m_entryQueued.notify_one();
+}
+
+Void TVideoIOYuvAsyncWriter::xThreadLoop()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  while ( true )
+  {
+    m_entryQueued.wait( lock, [this]() { return !m_queue.empty() || m_bTerminate; } );
+    if ( m_queue.empty() )
+    {
+      break;
+    }
+    Entry entry = m_queue.front();
+    m_queue.pop_front();
+    m_bBusy = true;
+
+    lock.unlock();
+    entry.job();
+    lock.lock();
+
+    for ( Int i = 0; i < 2; i++ )
+    {
+      if ( entry.pcPicYuv[i] != NULL )
+      {
+        m_freePicYuv.push_back( entry.pcPicYuv[i] );
+      }
+    }
+    m_bBusy = false;
+    m_entryDone.notify_all();
+  }
+}
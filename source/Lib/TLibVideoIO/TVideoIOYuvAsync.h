@@ -0,0 +1,171 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TVideoIOYuvAsync.h
+    \brief    YUV file I/O on a separate thread (header)
+*/
+
+#ifndef __TVIDEOIOYUVASYNC__
+#define __TVIDEOIOYUVASYNC__
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComPicYuv.h"
+#include "TVideoIOYuv.h"
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// reads the frames of a YUV file on a separate thread into a ring of picture buffers, ahead of their use
+class TVideoIOYuvAsyncReader
+{
+private:
+  struct Slot
+  {
+    TComPicYuv  picYuv;                                     ///< picture after colour space conversion
+    TComPicYuv  picYuvTrueOrg;                              ///< picture as read from the file
+    Bool        bEof;                                       ///< end of file was reached while reading the picture
+  };
+
+  TVideoIOYuv*               m_pcFile;
+  std::vector<Slot*>         m_slots;
+  Int                        m_readIdx;                     ///< next slot to be filled by the reading thread
+  Int                        m_getIdx;                      ///< next slot to be returned by getPicture()
+  Int                        m_numFilled;                   ///< slots filled and not yet released
+  Bool                       m_bTerminate;
+  Bool                       m_bFinished;                   ///< the reading thread has read all its frames
+
+  // reading parameters, see TVideoIOYuv::read() and TVideoIOYuv::skipFrames()
+  Int                        m_numFrames;
+  InputColourSpaceConversion m_ipCSC;
+  Int                        m_aiPad[2];
+  ChromaFormat               m_fileFormat;
+  Bool                       m_bClipToRec709;
+  Int                        m_numSkipFrames;
+  UInt                       m_skipWidth;
+  UInt                       m_skipHeight;
+
+  std::thread                m_thread;
+  std::mutex                 m_mutex;
+  std::condition_variable    m_slotFilled;
+  std::condition_variable    m_slotReleased;
+
+  Void xThreadLoop          ();
+
+public:
+  TVideoIOYuvAsyncReader();
+  ~TVideoIOYuvAsyncReader();
+
+  /// allocate numBuffers pairs of picture buffers, created as with TComPicYuv::create()
+  Void create               ( Int numBuffers, Int width, Int height, ChromaFormat format, UInt maxCUWidth, UInt maxCUHeight, UInt maxCUDepth );
+  Void destroy              ();
+
+  /// start reading numFrames frames (until the end of the file if numFrames <= 0) from the opened file pcFile,
+  /// skipping numSkipFrames frames of skipWidth x skipHeight after each of them
+  Void start                ( TVideoIOYuv* pcFile, Int numFrames, const InputColourSpaceConversion ipCSC, const Int aiPad[2], ChromaFormat fileFormat, Bool bClipToRec709,
+                              Int numSkipFrames, UInt skipWidth, UInt skipHeight );
+  /// stop the reading thread, it must be called before the file is closed
+  Void stop                 ();
+
+  /// wait for the next frame. Returns false if the end of the file was reached instead, as TVideoIOYuv::isEof() does.
+  Bool getPicture           ( TComPicYuv*& rpcPicYuv, TComPicYuv*& rpcPicYuvTrueOrg );
+  /// return the buffers of the frame obtained by the last getPicture() call to the reading thread
+  Void releasePicture       ();
+  /// wait for the frame offset frames after the one returned by getPicture(), which stays owned by the reading thread.
+  /// Returns false if the end of the file is reached before it, or if offset is not less than the number of buffers.
+  Bool peekPicture          ( Int offset, TComPicYuv*& rpcPicYuv );
+};
+
+/// writes frames to YUV files and runs other output jobs on a separate thread, in the order in which they were queued.
+/// The frames are copied, so the caller can reuse its picture buffers as soon as write() returns.
+class TVideoIOYuvAsyncWriter
+{
+public:
+  typedef std::function<Void()> Job;
+
+private:
+  struct Entry
+  {
+    Job          job;
+    TComPicYuv*  pcPicYuv[2];                               ///< copies of the pictures written by the job, recycled afterwards
+  };
+
+  Int                        m_maxQueued;                   ///< 0: output is written by the calling thread
+  std::deque<Entry>          m_queue;
+  std::vector<TComPicYuv*>   m_freePicYuv;
+  Bool                       m_bBusy;                       ///< the writing thread is running a job
+  Bool                       m_bTerminate;
+  Double                     m_blockedTime;                 ///< seconds the caller waited for output to be written
+
+  std::thread                m_thread;
+  std::mutex                 m_mutex;
+  std::condition_variable    m_entryQueued;
+  std::condition_variable    m_entryDone;
+
+  Void        xThreadLoop   ();
+  TComPicYuv* xCopyPicture  ( const TComPicYuv* pcPicYuv );
+  Void        xQueue        ( const Job& job, TComPicYuv* pcPicYuv0, TComPicYuv* pcPicYuv1 );
+
+public:
+  TVideoIOYuvAsyncWriter();
+  ~TVideoIOYuvAsyncWriter();
+
+  /// start the writing thread, allowing up to maxQueued frames or jobs to wait for output. With 0, output is written synchronously.
+  Void   create             ( Int maxQueued );
+  /// write all queued output and stop the writing thread
+  Void   destroy            ();
+
+  /// queue a frame for TVideoIOYuv::write()
+  Void   write              ( TVideoIOYuv* pcFile, const TComPicYuv* pcPicYuv, const InputColourSpaceConversion ipCSC,
+                              Int confLeft=0, Int confRight=0, Int confTop=0, Int confBottom=0, ChromaFormat fileFormat=NUM_CHROMA_FORMAT, const Bool bClipToRec709=false );
+  /// queue a pair of fields for TVideoIOYuv::write()
+  Void   write              ( TVideoIOYuv* pcFile, const TComPicYuv* pcPicYuvTop, const TComPicYuv* pcPicYuvBottom, const InputColourSpaceConversion ipCSC,
+                              Int confLeft=0, Int confRight=0, Int confTop=0, Int confBottom=0, ChromaFormat fileFormat=NUM_CHROMA_FORMAT, const Bool isTff=false, const Bool bClipToRec709=false );
+  /// queue any other output, e.g. writing a block of bitstream data
+  Void   addJob             ( const Job& job );
+
+  /// block until all queued output has been written
+  Void   waitForAll         ();
+
+  /// total time in seconds the callers of this class were blocked on output, including synchronous writes
+  Double getBlockedTime     () const { return m_blockedTime; }
+};
+
+#endif // __TVIDEOIOYUVASYNC__